@@ -0,0 +1,237 @@
+//
+// Created by henry on 2022-05-22.
+//
+
+#ifndef REFLEX_BENCH_BENCHCORPUS_H_
+#define REFLEX_BENCH_BENCHCORPUS_H_
+
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace reflex::bench {
+
+/// Generates syntactically valid reflex programs: interface hierarchies, classes implementing them
+/// and global functions with nested statements and expressions
+class CorpusGenerator {
+  public:
+    explicit CorpusGenerator(unsigned seed = 20220522) : rng(seed) {}
+
+    /// @returns a program of at least @p bytes bytes
+    std::string generate(size_t bytes) {
+        std::string out;
+        size_t count = 0;
+        while (out.size() < bytes) {
+            switch (pick(4)) {
+                case 0: interface(out, count); break;
+                case 1: klass(out, count); break;
+                case 2: out += "var g" + std::to_string(count) + ": int = " + expression(2) + ";\n"; break;
+                default: function(out, count); break;
+            }
+            ++count;
+        }
+        return out;
+    }
+
+    /// @returns global variables initialized with deep expressions, at least @p bytes bytes
+    std::string generateExpressions(size_t bytes) {
+        std::string out;
+        for (size_t count = 0; out.size() < bytes; ++count) {
+            out += "var e" + std::to_string(count) + ": int = " + expression(6) + ";\n";
+        }
+        return out;
+    }
+
+  private:
+    size_t pick(size_t n) { return std::uniform_int_distribution<size_t>(0, n - 1)(rng); }
+    std::string name(const char *prefix) { return prefix + std::to_string(pick(100)); }
+
+    std::string expression(int depth) {
+        static const char *binaryOps[] = {"+", "-", "*", "/", "%", "<", ">", "<=", ">=", "==", "!=", "and", "or", "&", "|"};
+        if (depth <= 0) {
+            switch (pick(3)) {
+                case 0: return std::to_string(pick(1000));
+                case 1: return "\"s" + std::to_string(pick(100)) + "\"";
+                default: return name("v");
+            }
+        }
+        switch (pick(8)) {
+            case 0: return name("f") + "(" + expression(depth - 1) + ", " + expression(depth - 1) + ")";
+            case 1: return name("v") + "." + name("m");
+            case 2: return name("v") + "[" + expression(depth - 1) + "]";
+            case 3: return "!" + expression(depth - 1);
+            case 4: return "(" + expression(depth - 1) + ")";
+            case 5: return "cast<int>(" + expression(depth - 1) + ")";
+            default: return expression(depth - 1) + " " + binaryOps[pick(std::size(binaryOps))] + " " + expression(depth - 1);
+        }
+    }
+
+    void statement(std::string &out, int depth, const std::string &indent) {
+        switch (depth > 0 ? pick(7) : pick(4)) {
+            case 0: out += indent + "var " + name("v") + ": int = " + expression(3) + ";\n"; break;
+            case 1: out += indent + name("v") + " = " + expression(3) + ";\n"; break;
+            case 2: out += indent + name("f") + "(" + expression(2) + ");\n"; break;
+            case 3: out += indent + name("v") + "++;\n"; break;
+            case 4:
+                out += indent + "if (" + expression(2) + ") {\n";
+                block(out, depth - 1, indent + "    ");
+                out += indent + "}\n";
+                break;
+            case 5:
+                out += indent + "while (" + expression(2) + ") {\n";
+                block(out, depth - 1, indent + "    ");
+                out += indent + "}\n";
+                break;
+            default: out += indent + "return " + expression(2) + ";\n"; break;
+        }
+    }
+
+    void block(std::string &out, int depth, const std::string &indent) {
+        auto count = 1 + pick(5);
+        for (size_t i = 0; i < count; ++i) statement(out, depth, indent);
+    }
+
+    std::string signature() {
+        std::string params;
+        auto count = pick(4);
+        for (size_t i = 0; i < count; ++i) params += (i ? ", " : "") + name("a") + ": " + (pick(2) ? "int" : "num");
+        return "(" + params + ") -> int";
+    }
+
+    void function(std::string &out, size_t id) {
+        out += "func f" + std::to_string(id) + signature() + " {\n";
+        block(out, 3, "    ");
+        out += "}\n\n";
+    }
+
+    void interface(std::string &out, size_t id) {
+        out += "interface I" + std::to_string(id);
+        if (id > 0 && pick(2)) out += " : I" + std::to_string(pick(id));
+        out += " {\n";
+        auto count = 1 + pick(4);
+        for (size_t i = 0; i < count; ++i) out += "    public func " + name("m") + signature() + ";\n";
+        out += "}\n\n";
+    }
+
+    void klass(std::string &out, size_t id) {
+        out += "class C" + std::to_string(id) + " {\n";
+        auto fields = pick(4);
+        for (size_t i = 0; i < fields; ++i) out += "    public var " + name("v") + ": int;\n";
+        auto methods = 1 + pick(3);
+        for (size_t i = 0; i < methods; ++i) {
+            out += "    public func " + name("m") + signature() + " {\n";
+            block(out, 2, "        ");
+            out += "    }\n";
+        }
+        out += "}\n\n";
+    }
+
+    std::mt19937 rng;
+};
+
+/// Generates programs that pass semantic analysis: each unit is a class with int fields and a method,
+/// followed by a function that instantiates the class, calls its method and earlier functions
+/// and only references declared ints
+class TypedCorpusGenerator {
+  public:
+    explicit TypedCorpusGenerator(unsigned seed = 20220524) : rng(seed) {}
+
+    /// @returns a program of at least @p bytes bytes
+    std::string generate(size_t bytes) {
+        std::string out;
+        for (size_t unit = 0; out.size() < bytes; ++unit) {
+            klass(out, unit);
+            function(out, unit);
+        }
+        return out;
+    }
+
+  private:
+    size_t pick(size_t n) { return std::uniform_int_distribution<size_t>(0, n - 1)(rng); }
+
+    std::string expression(int depth, const std::vector<std::string> &vars) {
+        static const char *binaryOps[] = {"+", "-", "*", "%"};
+        if (depth <= 0 || pick(4) == 0) {
+            return pick(3) ? vars[pick(vars.size())] : std::to_string(pick(1000));
+        }
+        switch (pick(4)) {
+            case 0: return "-" + expression(0, vars);
+            case 1: return "(" + expression(depth - 1, vars) + ")";
+            default:
+                return expression(depth - 1, vars) + " " + binaryOps[pick(std::size(binaryOps))] + " "
+                    + expression(depth - 1, vars);
+        }
+    }
+
+    void statements(std::string &out, std::vector<std::string> &vars, size_t unit, int depth,
+                    const std::string &indent) {
+        auto count = 2 + pick(4);
+        for (size_t i = 0; i < count; ++i) {
+            switch (depth > 0 ? pick(6) : pick(4)) {
+                case 0: {
+                    auto name = "t" + std::to_string(temporaries++);
+                    out += indent + "var " + name + ": int = " + expression(3, vars) + ";\n";
+                    vars.push_back(name);
+                    break;
+                }
+                case 1: out += indent + vars[pick(vars.size())] + " = " + expression(3, vars) + ";\n"; break;
+                case 2:
+                    if (unit > 0) {
+                        out += indent + vars[pick(vars.size())] + " = f" + std::to_string(pick(unit)) + "("
+                            + expression(2, vars) + ", " + expression(2, vars) + ");\n";
+                        break;
+                    }
+                    [[fallthrough]];
+                case 3:
+                    out += indent + "o.x" + std::to_string(unit) + " = " + expression(2, vars) + ";\n";
+                    break;
+                case 4: {
+                    out += indent + "if (" + expression(1, vars) + " < " + expression(1, vars) + ") {\n";
+                    auto scoped = vars;
+                    statements(out, scoped, unit, depth - 1, indent + "    ");
+                    out += indent + "}\n";
+                    break;
+                }
+                default: {
+                    out += indent + "while (" + expression(1, vars) + " > 0) {\n";
+                    auto scoped = vars;
+                    statements(out, scoped, unit, depth - 1, indent + "    ");
+                    out += indent + "}\n";
+                    break;
+                }
+            }
+        }
+    }
+
+    void klass(std::string &out, size_t unit) {
+        auto id = std::to_string(unit);
+        out += "class C" + id + " {\n";
+        out += "    public var x" + id + ": int;\n";
+        out += "    public var y" + id + ": num;\n";
+        out += "    public func m" + id + "(a: int, b: int) -> int {\n";
+        out += "        var t: int = " + expression(3, {"a", "b", "x" + id}) + ";\n";
+        out += "        this.x" + id + " = t;\n";
+        out += "        return t;\n";
+        out += "    }\n}\n\n";
+    }
+
+    void function(std::string &out, size_t unit) {
+        auto id = std::to_string(unit);
+        std::vector<std::string> vars{"a", "b"};
+        temporaries = 0;
+        out += "func f" + id + "(a: int, b: int) -> int {\n";
+        out += "    var o: C" + id + " = new C" + id + "();\n";
+        out += "    var r: int = o.m" + id + "(a, b);\n";
+        vars.emplace_back("r");
+        statements(out, vars, unit, 2, "    ");
+        out += "    return " + expression(3, vars) + ";\n}\n\n";
+    }
+
+    std::mt19937 rng;
+    size_t temporaries = 0;
+};
+
+}
+
+#endif //REFLEX_BENCH_BENCHCORPUS_H_
@@ -0,0 +1,39 @@
+//
+// Created by henry on 2022-05-16.
+//
+
+#ifndef REFLEX_BENCH_BENCHUTILS_H_
+#define REFLEX_BENCH_BENCHUTILS_H_
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+namespace reflex::bench {
+
+/// Runs @p fn @p repeat times and returns the fastest run in seconds
+template<class Fn>
+double measureSeconds(Fn &&fn, size_t repeat = 5) {
+    double best = 1e300;
+    for (size_t i = 0; i < repeat; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        auto end = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double>(end - start).count());
+    }
+    return best;
+}
+
+inline void report(const std::string &name, double amount, const std::string &unit, double seconds) {
+    std::printf("%-40s %12.3f ms %14.2f %s/s\n", name.c_str(), seconds * 1e3, amount / seconds, unit.c_str());
+}
+
+/// Keeps @p value alive so the optimizer cannot drop the computation producing it
+template<class T>
+void doNotOptimize(const T &value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+}
+
+#endif //REFLEX_BENCH_BENCHUTILS_H_
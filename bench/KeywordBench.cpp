@@ -0,0 +1,69 @@
+//
+// Created by henry on 2022-05-16.
+//
+
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "BenchUtils.h"
+#include "KeywordTable.h"
+#include "TokenDesc.h"
+
+using namespace reflex;
+
+/// Identifiers as they come out of the lexer, roughly one in four is a keyword
+std::vector<std::string> generateIdentifiers(size_t count) {
+    std::mt19937 rng(20220516);
+    std::uniform_int_distribution<size_t> keywordPick(0, KeywordList.size() - 1);
+    std::uniform_int_distribution<size_t> lengthPick(1, 12);
+    std::uniform_int_distribution<int> charPick(0, 25);
+    std::vector<std::string> identifiers;
+    identifiers.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        if (i % 4 == 0) {
+            identifiers.emplace_back(KeywordList[keywordPick(rng)].first);
+            continue;
+        }
+        std::string ident;
+        auto length = lengthPick(rng);
+        for (size_t j = 0; j < length; ++j) ident += static_cast<char>('a' + charPick(rng));
+        identifiers.push_back(std::move(ident));
+    }
+    return identifiers;
+}
+
+template<class Map>
+size_t classifyWithMap(Map &desc, const std::vector<std::string> &identifiers) {
+    size_t keywords = 0;
+    for (const auto &lexeme: identifiers) {
+        if (desc.count(lexeme)) keywords += desc[lexeme].getValue();
+    }
+    return keywords;
+}
+
+int main() {
+    constexpr size_t count = 2'000'000;
+    const auto identifiers = generateIdentifiers(count);
+
+    std::map<std::string, TokenType> orderedDesc;
+    for (const auto &[keyword, type]: KeywordList) orderedDesc.emplace(keyword, type);
+    auto hashedDesc = getKeywordDescription();
+
+    std::printf("classifying %zu identifiers\n", count);
+    bench::report("std::map count + operator[]", count, "ident",
+           bench::measureSeconds([&] { bench::doNotOptimize(classifyWithMap(orderedDesc, identifiers)); }));
+    bench::report("KeywordDesc count + operator[]", count, "ident",
+           bench::measureSeconds([&] { bench::doNotOptimize(classifyWithMap(hashedDesc, identifiers)); }));
+    bench::report("KeywordTable perfect hash", count, "ident",
+           bench::measureSeconds([&] {
+             size_t keywords = 0;
+             for (const auto &lexeme: identifiers) {
+                 auto type = Keywords.classify(lexeme);
+                 if (type != TokenType::Identifier) keywords += type;
+             }
+             bench::doNotOptimize(keywords);
+           }));
+    return 0;
+}
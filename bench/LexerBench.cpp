@@ -0,0 +1,117 @@
+//
+// Created by henry on 2022-05-17.
+//
+
+#include <random>
+#include <sstream>
+#include <string>
+
+#include "BenchUtils.h"
+#include "Lexer.h"
+#include "ScannerTable.h"
+#include "TokenBuffer.h"
+#include "SourceManager.h"
+
+using namespace reflex;
+
+/// Heavily indented and commented source, the shape where whitespace and comment runs dominate
+std::string generateSource(size_t bytes) {
+    std::mt19937 rng(20220517);
+    std::uniform_int_distribution<int> depthPick(1, 6);
+    std::uniform_int_distribution<int> shapePick(0, 5);
+    std::string source;
+    size_t count = 0;
+    while (source.size() < bytes) {
+        const std::string indent(4 * depthPick(rng), ' ');
+        const auto name = "identifier_number_" + std::to_string(count++);
+        switch (shapePick(rng)) {
+            case 0:
+                source += indent + "// " + std::string(60, '-') + " " + name + "\n";
+                break;
+            case 1:
+                source += indent + "/*\n" + indent + " * documentation for " + name + "\n"
+                    + indent + " * " + std::string(50, '=') + "\n" + indent + " */\n";
+                break;
+            case 2:
+                source += indent + "var " + name + ": int = " + std::to_string(count) + ";\n";
+                break;
+            case 3:
+                source += indent + "if (" + name + " >= other_" + name + ") { return " + name + "; }\n";
+                break;
+            case 4:
+                source += "\n\n" + indent + "\t\n";
+                break;
+            default:
+                source += indent + name + "." + name + "(first, second, third); // trailing\n";
+                break;
+        }
+    }
+    return source;
+}
+
+double getMegabytes(SourceFile &file) {
+    return static_cast<double>(file.content().size()) / (1 << 20);
+}
+
+int main() {
+    std::istringstream stream(generateSource(16 << 20));
+    SourceFile large("LexerBench", stream);
+
+    std::printf("lexing %.2f MB\n", getMegabytes(large));
+    bench::report("ScannerTable automaton only", getMegabytes(large), "MB", bench::measureSeconds([&] {
+      auto current = large.content();
+      TokenType::Value type;
+      size_t tokens = 0;
+      while (!current.empty()) {
+          auto length = Scanner.match(current, type);
+          current.remove_prefix(length ? length : 1);
+          ++tokens;
+      }
+      bench::doNotOptimize(tokens);
+    }));
+    for (auto isa: {ScanISA::Scalar, ScanISA::SSE42, ScanISA::AVX2}) {
+        if (!ScanKernels::isSupported(isa)) continue;
+        const auto &kernels = ScanKernels::get(isa);
+        bench::report("matchToken " + getScanISAString(isa), getMegabytes(large), "MB", bench::measureSeconds([&] {
+          Lexer lexer(large, kernels);
+          auto current = large.content();
+          TokenType::Value type;
+          size_t tokens = 0;
+          while (!current.empty()) {
+              auto length = lexer.matchToken(current, type);
+              current.remove_prefix(length ? length : 1);
+              ++tokens;
+          }
+          bench::doNotOptimize(tokens);
+        }));
+        for (bool skipTrivia: {false, true}) {
+            auto name = "nextToken " + getScanISAString(isa) + (skipTrivia ? " skip trivia" : "");
+            bench::report(name, getMegabytes(large), "MB", bench::measureSeconds([&] {
+              Lexer lexer(large, kernels);
+              lexer.setSkipTrivia(skipTrivia);
+              size_t tokens = 0;
+              while (lexer.hasNext()) {
+                  lexer.nextToken();
+                  ++tokens;
+              }
+              bench::doNotOptimize(tokens);
+            }));
+        }
+        bench::report("TokenBuffer " + getScanISAString(isa), getMegabytes(large), "MB", bench::measureSeconds([&] {
+          Lexer lexer(large, kernels);
+          TokenBuffer tokens(lexer);
+          bench::doNotOptimize(tokens.size());
+        }));
+    }
+    bench::report("TokenBuffer::findSplitPoints x8", getMegabytes(large), "MB", bench::measureSeconds([&] {
+      bench::doNotOptimize(TokenBuffer::findSplitPoints(large.content(), 8).size());
+    }));
+    for (size_t threads: {2, 4, 8}) {
+        bench::report("TokenBuffer parallel x" + std::to_string(threads), getMegabytes(large), "MB",
+                      bench::measureSeconds([&] {
+                        TokenBuffer tokens(large, threads);
+                        bench::doNotOptimize(tokens.size());
+                      }));
+    }
+    return 0;
+}
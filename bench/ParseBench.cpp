@@ -0,0 +1,105 @@
+//
+// Created by henry on 2022-05-22.
+//
+
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <memory>
+#include <sstream>
+#include <thread>
+
+#include "ASTContext.h"
+#include "AstPrinter.h"
+#include "BenchCorpus.h"
+#include "BenchUtils.h"
+#include "FlatAST.h"
+#include "FlatAstPrinter.h"
+#include "Lexer.h"
+#include "Parser.h"
+#include "SourceManager.h"
+
+using namespace reflex;
+
+double getPeakRSSMegabytes() {
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return static_cast<double>(usage.ru_maxrss) / 1024;
+}
+
+int main(int argc, char *argv[]) {
+    const size_t megabytes = argc > 1 ? std::stoul(argv[1]) : 16;
+    std::istringstream stream(bench::CorpusGenerator().generate(megabytes << 20));
+    SourceFile file("ParseBench", stream);
+    Lexer lexer(file);
+    const TokenBuffer tokens(lexer);
+    const auto baselineRSS = getPeakRSSMegabytes();
+
+    std::printf("parsing %zu MB, %zu tokens\n", megabytes, tokens.size());
+    double teardown = 0;
+    size_t nodes = 0, arenaBytes = 0;
+    bench::report("Parser::parseCompilationUnit", static_cast<double>(megabytes), "MB", bench::measureSeconds([&] {
+      auto context = std::make_unique<ASTContext>();
+      Parser parser(*context, tokens);
+      bench::doNotOptimize(parser.parseCompilationUnit());
+      nodes = context->getNodeCount();
+      arenaBytes = context->getBytesAllocated();
+      teardown = bench::measureSeconds([&] { context.reset(); }, 1);
+    }, 3));
+    bench::report("ASTContext teardown", static_cast<double>(megabytes), "MB", teardown);
+    std::printf("%zu nodes in %.1f MB of arena\n", nodes, static_cast<double>(arenaBytes) / (1 << 20));
+    std::printf("peak RSS of one AST %.1f MB\n", getPeakRSSMegabytes() - baselineRSS);
+
+    size_t deferredNodes = 0;
+    bench::report("Parser deferred function bodies", static_cast<double>(megabytes), "MB", bench::measureSeconds([&] {
+      ASTContext context;
+      Parser parser(context, tokens);
+      parser.setDeferFunctionBodies(true);
+      bench::doNotOptimize(parser.parseCompilationUnit());
+      deferredNodes = context.getNodeCount();
+    }, 3));
+    std::printf("%zu nodes with deferred bodies\n", deferredNodes);
+
+    const auto threads = std::max(1u, std::thread::hardware_concurrency());
+    bench::report("Parser top-level decls, " + std::to_string(threads) + " threads", static_cast<double>(megabytes), "MB",
+                  bench::measureSeconds([&] {
+      ASTContext context;
+      Parser parser(context, tokens);
+      bench::doNotOptimize(parser.parseCompilationUnit(threads));
+    }, 3));
+
+    std::istringstream exprStream(bench::CorpusGenerator().generateExpressions(megabytes << 20));
+    SourceFile exprFile("ExprBench", exprStream);
+    Lexer exprLexer(exprFile);
+    const TokenBuffer exprTokens(exprLexer);
+    bench::report("Parser expression-heavy corpus", static_cast<double>(megabytes), "MB", bench::measureSeconds([&] {
+      ASTContext context;
+      Parser parser(context, exprTokens);
+      bench::doNotOptimize(parser.parseCompilationUnit());
+    }, 3));
+
+    ASTContext context;
+    Parser parser(context, tokens);
+    auto unit = parser.parseCompilationUnit();
+    std::unique_ptr<FlatAST> flat;
+    bench::report("FlatAST lowering", static_cast<double>(megabytes), "MB", bench::measureSeconds([&] {
+      flat = std::make_unique<FlatAST>(*unit);
+    }, 3));
+    std::printf("flat AST %zu nodes in %.1f MB\n", flat->size(), static_cast<double>(flat->getMemoryFootprint()) / (1 << 20));
+
+    size_t binaries = 0;
+    bench::report("FlatAST linear kind scan", static_cast<double>(flat->size()) / 1e6, "Mnodes", bench::measureSeconds([&] {
+      binaries = std::ranges::count(flat->getKinds(), FlatKind::BinaryExpr);
+    }));
+    bench::doNotOptimize(binaries);
+
+    // both printers format the same lines into a stream without a buffer, the difference is the walk
+    std::ostream sink(nullptr);
+    bench::report("AstPrinter over the pointer AST", static_cast<double>(megabytes), "MB", bench::measureSeconds([&] {
+      AstPrinter(sink).visit(*unit);
+    }, 3));
+    bench::report("FlatAstPrinter over the flat AST", static_cast<double>(megabytes), "MB", bench::measureSeconds([&] {
+      FlatAstPrinter(sink, *flat).print();
+    }, 3));
+    return 0;
+}
@@ -0,0 +1,62 @@
+//
+// Created by henry on 2022-05-24.
+//
+
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+
+#include "ASTContext.h"
+#include "BenchCorpus.h"
+#include "BenchUtils.h"
+#include "Lexer.h"
+#include "LexicalContext.h"
+#include "LexicalContextDeclTypePass.h"
+#include "LexicalContextForwardPass.h"
+#include "Parser.h"
+#include "SemanticAnalysisPass.h"
+#include "SourceManager.h"
+#include "TypeContext.h"
+
+using namespace reflex;
+
+template<class Fn>
+double elapsedSeconds(Fn &&fn) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char *argv[]) {
+    const size_t megabytes = argc > 1 ? std::stoul(argv[1]) : 4;
+    std::istringstream stream(bench::TypedCorpusGenerator().generate(megabytes << 20));
+    SourceFile file("SemaBench", stream);
+    Lexer lexer(file);
+    const TokenBuffer tokens(lexer);
+    std::printf("analyzing %zu MB, %zu tokens\n", megabytes, tokens.size());
+
+    // every pass mutates the AST, so each repetition starts from a fresh parse
+    double forward = 1e300, declType = 1e300, analysis = 1e300;
+    for (int repeat = 0; repeat < 3; ++repeat) {
+        ASTContext context;
+        Parser parser(context, tokens);
+        auto unit = parser.parseCompilationUnit();
+        LexicalContext lexicalContext;
+        TypeContext typeContext;
+        LexicalScope *global = nullptr;
+
+        forward = std::min(forward, elapsedSeconds([&] {
+          global = LexicalContextForwardPass(lexicalContext, typeContext).performPass(unit);
+        }));
+        declType = std::min(declType, elapsedSeconds([&] {
+          LexicalContextDeclTypePass(typeContext).performPass(unit);
+        }));
+        analysis = std::min(analysis, elapsedSeconds([&] {
+          SemanticAnalysisPass(typeContext, context, global).visit(*unit);
+        }));
+    }
+    bench::report("LexicalContextForwardPass", static_cast<double>(megabytes), "MB", forward);
+    bench::report("LexicalContextDeclTypePass", static_cast<double>(megabytes), "MB", declType);
+    bench::report("SemanticAnalysisPass", static_cast<double>(megabytes), "MB", analysis);
+    return 0;
+}
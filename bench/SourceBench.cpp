@@ -0,0 +1,47 @@
+//
+// Created by henry on 2022-05-19.
+//
+
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+
+#include "BenchUtils.h"
+#include "SourceManager.h"
+
+using namespace reflex;
+
+/// Generated source with short and long lines, the shape of machine generated inputs
+std::string writeSource(const std::string &path, size_t bytes) {
+    std::mt19937 rng(20220519);
+    std::uniform_int_distribution<size_t> lengthPick(0, 120);
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    size_t written = 0;
+    while (written < bytes) {
+        std::string line(lengthPick(rng), 'x');
+        line += '\n';
+        file << line;
+        written += line.size();
+    }
+    return path;
+}
+
+int main() {
+    const auto path = (std::filesystem::temp_directory_path() / "reflex_source_bench.reflex").string();
+    writeSource(path, 64 << 20);
+    const double megabytes = static_cast<double>(std::filesystem::file_size(path)) / (1 << 20);
+
+    std::printf("opening %.2f MB\n", megabytes);
+    bench::report("SourceFile istream read + line index", megabytes, "MB", bench::measureSeconds([&] {
+      std::ifstream stream(path);
+      SourceFile file(path, stream);
+      bench::doNotOptimize(file.totalLine());
+    }));
+    bench::report("SourceFile mmap + line index", megabytes, "MB", bench::measureSeconds([&] {
+      SourceFile file(path);
+      bench::doNotOptimize(file.totalLine());
+    }));
+    std::filesystem::remove(path);
+    return 0;
+}
@@ -0,0 +1,175 @@
+//
+// Created by henry on 2022-05-29.
+//
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "BenchUtils.h"
+#include "TypeContext.h"
+
+using namespace reflex;
+
+/// Interns @p count distinct array types and a function type over each of them into @p context
+void internTypes(TypeContext &context, size_t count) {
+    auto intType = context.getBuiltinType(BuiltinType::Integer);
+    std::vector<Type *> params(2, context.getBuiltinType(BuiltinType::Boolean));
+    for (size_t i = 0; i < count; ++i) {
+        params[0] = context.getArrayType(intType, i);
+        bench::doNotOptimize(context.getFunctionType(intType, params));
+    }
+}
+
+/// Runs internTypes on @p context from @p threads threads at once
+void internTypesConcurrently(TypeContext &context, size_t count, size_t threads) {
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < threads; ++t) workers.emplace_back([&] { internTypes(context, count); });
+    for (auto &worker: workers) worker.join();
+}
+
+/// Declares @p layers layers of @p width interfaces in @p context, each deriving from two neighbouring
+/// interfaces of the layer below and overriding the method of the first, and a class implementing every
+/// interface of the top layer, in the order the declaration pass would
+/// @returns the classes
+std::vector<ClassType *> declareDiamonds(TypeContext &context, size_t layers, size_t width) {
+    auto method = context.getFunctionType(context.getVoidType(), {});
+    std::vector<InterfaceType *> below, layer;
+    for (size_t l = 0; l < layers; ++l) {
+        for (size_t w = 0; w < width; ++w) {
+            auto interface = context.getInterfaceType("I" + std::to_string(l) + "_" + std::to_string(w));
+            if (l > 0) {
+                interface->addInterface(below[w]);
+                interface->addInterface(below[(w + 1) % width]);
+            }
+            auto name = "m" + std::to_string(w);
+            interface->addMethod(name, context.getMemberType(Visibility::Public, interface, method));
+            layer.push_back(interface);
+        }
+        below = std::move(layer);
+        layer.clear();
+    }
+    std::vector<ClassType *> classes;
+    for (size_t w = 0; w < width; ++w) {
+        auto klass = context.getClassType("C" + std::to_string(w));
+        klass->addInterface(below[w]);
+        for (size_t m = 0; m < width; m += 2) {
+            auto name = "m" + std::to_string(m);
+            klass->addMethod(name, context.getMemberType(Visibility::Public, klass, method));
+        }
+        classes.push_back(klass);
+    }
+    return classes;
+}
+
+int main(int argc, char *argv[]) {
+    const size_t maxCount = argc > 1 ? std::stoul(argv[1]) : 100000;
+    // the time per type stays flat as the context grows
+    for (size_t count = 1000; count <= maxCount; count *= 10) {
+        const auto types = static_cast<double>(2 * count) / 1e6;
+        bench::report("TypeContext create " + std::to_string(count), types, "Mtypes", bench::measureSeconds([&] {
+          TypeContext context;
+          internTypes(context, count);
+        }, 3));
+        // every type exists, each call is a lookup
+        TypeContext context;
+        internTypes(context, count);
+        bench::report("TypeContext lookup " + std::to_string(count), types, "Mtypes", bench::measureSeconds([&] {
+          internTypes(context, count);
+        }, 3));
+    }
+    // every thread interns the same types, the first to miss creates each of them
+    const size_t threads = std::max(2u, std::thread::hardware_concurrency());
+    const auto types = static_cast<double>(2 * maxCount * threads) / 1e6;
+    const auto suffix = " " + std::to_string(maxCount) + ", " + std::to_string(threads) + " threads";
+    bench::report("TypeContext create" + suffix, types, "Mtypes", bench::measureSeconds([&] {
+      TypeContext context;
+      internTypesConcurrently(context, maxCount, threads);
+    }, 3));
+    TypeContext context;
+    internTypes(context, maxCount);
+    bench::report("TypeContext lookup" + suffix, types, "Mtypes", bench::measureSeconds([&] {
+      internTypesConcurrently(context, maxCount, threads);
+    }, 3));
+    // the check ExpressionAnalyzer makes on every operand, through the type and through its id
+    std::vector<Type *> refs;
+    for (size_t i = 0; i < maxCount; ++i) {
+        auto array = context.getArrayType(context.getBuiltinType(BuiltinType::Number), i);
+        refs.push_back(i % 2 ? static_cast<Type *>(array) : context.getReferenceType(array));
+    }
+    // operands of an AST are scattered over the types
+    std::shuffle(refs.begin(), refs.end(), std::mt19937(42));
+    const auto checks = static_cast<double>(refs.size()) / 1e6;
+    bench::report("isReferenceType Type* " + std::to_string(maxCount), checks, "Mchecks", bench::measureSeconds([&] {
+      size_t count = 0;
+      for (auto type: refs) count += type->isReferenceType();
+      bench::doNotOptimize(count);
+    }, 5));
+    std::vector<TypeID> ids;
+    for (auto type: refs) ids.push_back(type->getID());
+    bench::report("isReferenceType TypeID " + std::to_string(maxCount), checks, "Mchecks", bench::measureSeconds([&] {
+      size_t count = 0;
+      for (auto id: ids) count += context.isReferenceType(id);
+      bench::doNotOptimize(count);
+    }, 5));
+    // implicit casts between the classes of a deep hierarchy, each implementing an interface of a ladder
+    // of diamonds
+    TypeContext hierarchyContext;
+    std::vector<ClassType *> classes;
+    std::vector<InterfaceType *> interfaces;
+    for (size_t i = 0; i < 1000; ++i) {
+        classes.push_back(hierarchyContext.getClassType("C" + std::to_string(i)));
+        interfaces.push_back(hierarchyContext.getInterfaceType("I" + std::to_string(i)));
+        if (i > 0) classes[i]->setBaseclass(classes[i - 1]);
+        if (i > 0) interfaces[i]->addInterface(interfaces[i - 1]);
+        if (i > 1) interfaces[i]->addInterface(interfaces[i - 2]);
+        if (i % 10 == 0) classes[i]->addInterface(interfaces[i]);
+    }
+    hierarchyContext.buildHierarchy();
+    std::mt19937 random(42);
+    std::vector<std::pair<size_t, size_t>> queries(10000);
+    for (auto &[from, to]: queries) from = random() % classes.size(), to = random() % classes.size();
+    const auto casts = static_cast<double>(2 * queries.size()) / 1e6;
+    bench::report("subtype query walk", casts, "Mqueries", bench::measureSeconds([&] {
+      size_t count = 0;
+      for (auto [from, to]: queries) {
+          count += classes[from]->isDerivedFrom(classes[to]) + classes[from]->implements(interfaces[to]);
+      }
+      bench::doNotOptimize(count);
+    }, 3));
+    bench::report("subtype query index", casts, "Mqueries", bench::measureSeconds([&] {
+      size_t count = 0;
+      for (auto [from, to]: queries) {
+          count += hierarchyContext.isDerivedFrom(classes[from], classes[to])
+              + hierarchyContext.implements(classes[from], interfaces[to]);
+      }
+      bench::doNotOptimize(count);
+    }, 3));
+    // every interface and class asks for its traits, first computing and then reusing them
+    const size_t layers = 100, width = 100;
+    const auto interfaceCount = static_cast<double>(layers * width) / 1e6;
+    bench::report("declare diamonds " + std::to_string(layers * width), interfaceCount, "Minterfaces",
+                  bench::measureSeconds([&] {
+                    TypeContext diamondContext;
+                    declareDiamonds(diamondContext, layers, width);
+                  }, 3));
+    bench::report("declare diamonds + traits " + std::to_string(layers * width), interfaceCount, "Minterfaces",
+                  bench::measureSeconds([&] {
+                    TypeContext diamondContext;
+                    size_t abstract = 0;
+                    for (auto klass: declareDiamonds(diamondContext, layers, width)) abstract += klass->isAbstract();
+                    bench::doNotOptimize(abstract);
+                  }, 3));
+    TypeContext diamondContext;
+    auto diamondClasses = declareDiamonds(diamondContext, layers, width);
+    for (auto klass: diamondClasses) klass->isAbstract();
+    bench::report("memoized isAbstract " + std::to_string(width), static_cast<double>(width) / 1e6, "Mclasses",
+                  bench::measureSeconds([&] {
+                    size_t abstract = 0;
+                    for (auto klass: diamondClasses) abstract += klass->isAbstract();
+                    bench::doNotOptimize(abstract);
+                  }, 3));
+    return 0;
+}
@@ -8,8 +8,8 @@
 
 namespace reflex {
 
-ASTNode::ASTNode(const SourceLocation *loc) : loc(loc) {}
-const SourceLocation *ASTNode::location() const { return loc; }
+ASTNode::ASTNode(ASTKind kind, SourceLocation loc) : kind(kind), loc(loc) {}
+SourceLocation ASTNode::location() const { return loc; }
 
 }
 
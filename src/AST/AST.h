@@ -5,20 +5,84 @@
 #ifndef REFLEX_SRC_AST_AST_H_
 #define REFLEX_SRC_AST_AST_H_
 
+#include <cstdint>
+
+#include "SourceLocation.h"
+#include "Utils/ASTList.h"
+#include "Utils/Casting.h"
+
 namespace reflex {
 
-class SourceLocation;
 class ScopeMember;
 
+/// Kind tag of every concrete node class, used by isa<>/cast<>/dyn_cast<> instead of RTTI
+/// @note the subclasses of an abstract class are contiguous, classof of an abstract class is a range check
+enum class ASTKind : uint8_t {
+  ClassDecl,
+  InterfaceDecl,
+  VariableDecl,
+  FieldDecl,
+  ParamDecl,
+  FunctionDecl,
+  MethodDecl,
+  CompilationUnit,
+
+  BlockStmt,
+  DeclStmt,
+  ReturnStmt,
+  BreakStmt,
+  ContinueStmt,
+  IfStmt,
+  ForStmt,
+  WhileStmt,
+  EmptyStmt,
+  AssignmentStmt,
+  IncDecStmt,
+  ExpressionStmt,
+
+  ForRangeClause,
+  ForNormalClause,
+
+  Identifier,
+  ModuleSelector,
+  UnaryExpr,
+  BinaryExpr,
+  NewExpr,
+  ImplicitCastExpr,
+  CastExpr,
+  IndexExpr,
+  SelectorExpr,
+  ArgumentExpr,
+  NumberLiteral,
+  StringLiteral,
+  BooleanLiteral,
+  NullLiteral,
+  ArrayLiteral,
+  FunctionLiteral,
+
+  BaseTypenameExpr,
+  QualifiedTypenameExpr,
+  ArrayTypeExpr,
+  FunctionTypeExpr,
+};
+
 class ASTNode {
   public:
-    explicit ASTNode(const SourceLocation *loc);
+    ASTNode(ASTKind kind, SourceLocation loc);
     virtual ~ASTNode() = default;
 
-    [[nodiscard]] const SourceLocation *location() const;
+    [[nodiscard]] ASTKind getKind() const { return kind; }
+    [[nodiscard]] SourceLocation location() const;
+
+  protected:
+    /// @returns true if @p node is of a kind in [first, last]
+    static bool isKindInRange(const ASTNode *node, ASTKind first, ASTKind last) {
+        return node->kind >= first && node->kind <= last;
+    }
 
   private:
-    const SourceLocation *loc;
+    ASTKind kind;
+    SourceLocation loc;
 };
 
 }
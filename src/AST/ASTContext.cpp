@@ -3,3 +3,23 @@
 //
 
 #include "ASTContext.h"
+
+namespace reflex {
+
+ASTContext::~ASTContext() {
+    for (auto iter = destructors.rbegin(); iter != destructors.rend(); ++iter) iter->destroy(iter->object);
+}
+
+size_t ASTContext::getNodeCount() const {
+    auto count = nodeCount;
+    for (auto &context: adopted) count += context->getNodeCount();
+    return count;
+}
+
+size_t ASTContext::getBytesAllocated() const {
+    auto bytes = arena.getBytesAllocated();
+    for (auto &context: adopted) bytes += context->getBytesAllocated();
+    return bytes;
+}
+
+}
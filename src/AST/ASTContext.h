@@ -6,34 +6,74 @@
 #define REFLEX_SRC_AST_ASTCONTEXT_H_
 
 #include "AST.h"
+#include "Utils/Arena.h"
+#include "Utils/ASTList.h"
 
-#include <typeindex>
-#include <vector>
 #include <memory>
-#include <unordered_map>
+#include <ranges>
+#include <type_traits>
+#include <vector>
 
 namespace reflex {
 
+/// Owns every node of an AST
+/// - nodes are bump allocated in creation order, so the nodes of one declaration are contiguous
+/// - destructors of nodes that need one are run in reverse creation order when the context is destroyed
+/// - contexts filled on other threads can be adopted, their nodes live as long as the adopting context
 class ASTContext {
-    using AstContextList = std::vector<std::unique_ptr<ASTNode>>;
   public:
     ASTContext() = default;
     ASTContext(const ASTContext &) = delete;
     ASTContext(ASTContext &&) noexcept = default;
+    ASTContext &operator=(const ASTContext &) = delete;
+    ASTContext &operator=(ASTContext &&) = delete;
+    ~ASTContext();
 
     template<class ASTType, class... Arguments>
     ASTType *create(Arguments &&...args);
 
+    /// @returns a child list holding @p elements converted to T, allocated once at its final size
+    /// @note lists longer than ASTList::InlineCapacity are copied into the arena of this context
+    template<class T, std::ranges::sized_range Range>
+    ASTList<T> createList(const Range &elements);
+
+    /// Take ownership of @p other, it is destroyed after the nodes of this context
+    /// @note @p other may still create nodes, e.g. for deferred function bodies
+    void adopt(std::unique_ptr<ASTContext> other) { adopted.push_back(std::move(other)); }
+
+    /// @returns the nodes created in this context and the adopted ones
+    [[nodiscard]] size_t getNodeCount() const;
+    [[nodiscard]] size_t getBytesAllocated() const;
+
   private:
-    std::unordered_map<std::type_index, AstContextList> ctx;
+    struct Destructor {
+      void *object;
+      void (*destroy)(void *object);
+    };
+
+    BumpArena arena;
+    std::vector<Destructor> destructors;
+    size_t nodeCount = 0;
+    std::vector<std::unique_ptr<ASTContext>> adopted;
 };
 
 template<typename ASTType, typename... Arguments>
 ASTType *ASTContext::create(Arguments &&... args) {
-    auto node = std::make_unique<ASTType>(std::forward<Arguments>(args)...);
-    auto tmp = node.get();
-    ctx[typeid(ASTType)].push_back(std::move(node));
-    return tmp;
+    auto node = new(arena.allocate<ASTType>()) ASTType(std::forward<Arguments>(args)...);
+    if constexpr (!std::is_trivially_destructible_v<ASTType>) {
+        destructors.push_back({node, [](void *object) { static_cast<ASTType *>(object)->~ASTType(); }});
+    }
+    ++nodeCount;
+    return node;
+}
+
+template<class T, std::ranges::sized_range Range>
+ASTList<T> ASTContext::createList(const Range &elements) {
+    const auto count = std::ranges::size(elements);
+    T inlined[ASTList<T>::InlineCapacity];
+    auto storage = count <= ASTList<T>::InlineCapacity ? inlined : arena.allocate<T>(count);
+    std::ranges::transform(elements, storage, [](auto element) { return static_cast<T>(element); });
+    return {storage, count};
 }
 
 }
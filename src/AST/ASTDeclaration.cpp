@@ -6,89 +6,105 @@
 
 namespace reflex {
 
-Declaration::Declaration(const SourceLocation *loc, std::string declname)
-    : ASTNode(loc), declname(std::move(declname)) {}
+Declaration::Declaration(ASTKind kind, SourceLocation loc, Symbol declname)
+    : ASTNode(kind, loc), declname(declname) {}
 
-AggregateDecl::AggregateDecl(const SourceLocation *loc, Visibility visibility, std::string declname)
-    : Declaration(loc, std::move(declname)), visibility(visibility) {}
+AggregateDecl::AggregateDecl(ASTKind kind, SourceLocation loc, Visibility visibility, Symbol declname)
+    : Declaration(kind, loc, declname), visibility(visibility) {}
 
-ClassDecl::ClassDecl(const SourceLocation *loc,
+ClassDecl::ClassDecl(SourceLocation loc,
                      Visibility visibility,
-                     std::string declname,
+                     Symbol declname,
                      ReferenceTypenameExpr *baseclass,
-                     std::vector<ReferenceTypenameExpr *> interfaces,
-                     std::vector<AggregateDecl *> decls,
-                     std::vector<FieldDecl *> fields,
-                     std::vector<MethodDecl *> methods)
-    : AggregateDecl(loc, visibility, std::move(declname)),
+                     ASTList<ReferenceTypenameExpr *> interfaces,
+                     ASTList<AggregateDecl *> decls,
+                     ASTList<FieldDecl *> fields,
+                     ASTList<MethodDecl *> methods)
+    : AggregateDecl(ASTKind::ClassDecl, loc, visibility, declname),
       baseclass(baseclass),
-      interfaces(std::move(interfaces)),
-      decls(std::move(decls)),
-      fields(std::move(fields)),
-      methods(std::move(methods)) {}
+      interfaces(interfaces),
+      decls(decls),
+      fields(fields),
+      methods(methods) {}
 
-InterfaceDecl::InterfaceDecl(const SourceLocation *loc,
+InterfaceDecl::InterfaceDecl(SourceLocation loc,
                              Visibility visibility,
-                             std::string declname,
-                             std::vector<ReferenceTypenameExpr *> interfaces,
-                             std::vector<AggregateDecl *> decls,
-                             std::vector<MethodDecl *> methods)
-    : AggregateDecl(loc, visibility, std::move(declname)),
-      interfaces(std::move(interfaces)),
-      decls(std::move(decls)),
-      methods(std::move(methods)) {}
-
-VariableDecl::VariableDecl(const SourceLocation *loc,
-                           std::string declname,
+                             Symbol declname,
+                             ASTList<ReferenceTypenameExpr *> interfaces,
+                             ASTList<AggregateDecl *> decls,
+                             ASTList<MethodDecl *> methods)
+    : AggregateDecl(ASTKind::InterfaceDecl, loc, visibility, declname),
+      interfaces(interfaces),
+      decls(decls),
+      methods(methods) {}
+
+VariableDecl::VariableDecl(SourceLocation loc,
+                           Symbol declname,
                            ASTTypeExpr *type_decl,
                            Expression *initializer)
-    : Declaration(loc, std::move(declname)),
+    : VariableDecl(ASTKind::VariableDecl, loc, declname, type_decl, initializer) {}
+
+VariableDecl::VariableDecl(ASTKind kind,
+                           SourceLocation loc,
+                           Symbol declname,
+                           ASTTypeExpr *type_decl,
+                           Expression *initializer)
+    : Declaration(kind, loc, declname),
       typeDecl(type_decl),
       initializer(initializer) {}
 
-FieldDecl::FieldDecl(const SourceLocation *loc,
-                     std::string declname,
+FieldDecl::FieldDecl(SourceLocation loc,
+                     Symbol declname,
                      ASTTypeExpr *type_decl,
                      ClassDecl *parent,
                      Visibility visibility,
                      Expression *initializer)
-    : VariableDecl(loc, std::move(declname), type_decl, initializer),
+    : VariableDecl(ASTKind::FieldDecl, loc, declname, type_decl, initializer),
       parent(parent),
       visibility(visibility) {}
 
-ParamDecl::ParamDecl(const SourceLocation *loc,
-                     std::string declname,
+ParamDecl::ParamDecl(SourceLocation loc,
+                     Symbol declname,
                      ASTTypeExpr *type_decl)
-    : VariableDecl(loc, std::move(declname), type_decl, nullptr), parent(nullptr) {}
+    : VariableDecl(ASTKind::ParamDecl, loc, declname, type_decl, nullptr), parent(nullptr) {}
+
+FunctionDecl::FunctionDecl(SourceLocation loc,
+                           Symbol declname,
+                           ASTList<ParamDecl *> param_decls,
+                           ASTTypeExpr *return_type_decl,
+                           DeferredBody body)
+    : FunctionDecl(ASTKind::FunctionDecl, loc, declname, param_decls, return_type_decl, body) {}
 
-FunctionDecl::FunctionDecl(const SourceLocation *loc,
-                           std::string declname,
-                           std::vector<ParamDecl *> param_decls,
+FunctionDecl::FunctionDecl(ASTKind kind,
+                           SourceLocation loc,
+                           Symbol declname,
+                           ASTList<ParamDecl *> param_decls,
                            ASTTypeExpr *return_type_decl,
-                           BlockStmt *body) : Declaration(loc, std::move(declname)),
-                                              paramDecls(std::move(param_decls)),
+                           DeferredBody body) : Declaration(kind, loc, declname),
+                                              paramDecls(param_decls),
                                               returnTypeDecl(return_type_decl),
                                               body(body) {}
 
-MethodDecl::MethodDecl(const SourceLocation *loc,
-                       std::string declname,
-                       std::vector<ParamDecl *> param_decls,
+MethodDecl::MethodDecl(SourceLocation loc,
+                       Symbol declname,
+                       ASTList<ParamDecl *> param_decls,
                        ASTTypeExpr *return_type_decl,
-                       BlockStmt *body,
+                       DeferredBody body,
                        AggregateDecl *parent,
                        Visibility visibility)
-    : FunctionDecl(loc,
-                   std::move(declname),
-                   std::move(param_decls),
+    : FunctionDecl(ASTKind::MethodDecl,
+                   loc,
+                   declname,
+                   param_decls,
                    return_type_decl,
                    body),
       parent(parent),
       visibility(visibility) {}
 
-CompilationUnit::CompilationUnit(const SourceLocation *loc,
-                                 std::string declname,
+CompilationUnit::CompilationUnit(SourceLocation loc,
+                                 Symbol declname,
                                  std::vector<Declaration *> decls)
-    : Declaration(loc, std::move(declname)), decls(std::move(decls)) {}
+    : Declaration(ASTKind::CompilationUnit, loc, declname), decls(std::move(decls)) {}
 
 void CompilationUnit::addDecl(Declaration *decl) {
     decls.push_back(decl);
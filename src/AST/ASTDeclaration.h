@@ -6,12 +6,13 @@
 #define REFLEX_SRC_AST_ASTDECLARATION_H_
 
 #include "AST.h"
+#include "DeferredBody.h"
 
 #include <string>
 #include <vector>
 
 #include <ASTUtils.h>
-#include <ASTVisitor.h>
+#include <StringInterner.h>
 
 namespace reflex {
 
@@ -23,23 +24,32 @@ class BlockStmt;
 class FunctionTypeExpr;
 class Type;
 
-class Declaration : public ASTNode, public ASTDeclVisitable {
+class Declaration : public ASTNode {
   public:
-    Declaration(const SourceLocation *loc, std::string declname);
+    Declaration(ASTKind kind, SourceLocation loc, Symbol declname);
 
-    const std::string &getDeclname() const { return declname; }
+    static bool classof(const ASTNode *node) {
+        return isKindInRange(node, ASTKind::ClassDecl, ASTKind::CompilationUnit);
+    }
+
+    const std::string &getDeclname() const { return declname.str(); }
+    Symbol getDeclSymbol() const { return declname; }
 
     Type *getType() const { return type; }
     void setType(Type *typ) { Declaration::type = typ; }
 
   private:
-    std::string declname;
+    Symbol declname;
     Type *type = nullptr;
 };
 
 class AggregateDecl : public Declaration {
   public:
-    AggregateDecl(const SourceLocation *loc, Visibility visibility, std::string declname);
+    AggregateDecl(ASTKind kind, SourceLocation loc, Visibility visibility, Symbol declname);
+
+    static bool classof(const ASTNode *node) {
+        return isKindInRange(node, ASTKind::ClassDecl, ASTKind::InterfaceDecl);
+    }
 
     ScopeMember *getScope() const { return scope; }
     void setScope(ScopeMember *lexicalScope) { scope = lexicalScope; }
@@ -55,63 +65,72 @@ class MethodDecl;
 
 class ClassDecl : public AggregateDecl {
   public:
-    ClassDecl(const SourceLocation *loc,
+    ClassDecl(SourceLocation loc,
               Visibility visibility,
-              std::string declname,
+              Symbol declname,
               ReferenceTypenameExpr *baseclass,
-              std::vector<ReferenceTypenameExpr *> interfaces,
-              std::vector<AggregateDecl *> decls = {},
-              std::vector<FieldDecl *> fields = {},
-              std::vector<MethodDecl *> methods = {});
+              ASTList<ReferenceTypenameExpr *> interfaces,
+              ASTList<AggregateDecl *> decls = {},
+              ASTList<FieldDecl *> fields = {},
+              ASTList<MethodDecl *> methods = {});
 
     ReferenceTypenameExpr *getBaseclass() const { return baseclass; }
-    const std::vector<ReferenceTypenameExpr *> &getInterfaces() const { return interfaces; }
-    const std::vector<AggregateDecl *> &getDecls() const { return decls; }
-    const std::vector<FieldDecl *> &getFields() const { return fields; }
-    const std::vector<MethodDecl *> &getMethods() const { return methods; }
+    const ASTList<ReferenceTypenameExpr *> &getInterfaces() const { return interfaces; }
+    const ASTList<AggregateDecl *> &getDecls() const { return decls; }
+    const ASTList<FieldDecl *> &getFields() const { return fields; }
+    const ASTList<MethodDecl *> &getMethods() const { return methods; }
 
-    void addMemberDecl(AggregateDecl *decl) { decls.push_back(decl); }
-    void addMemberDecl(FieldDecl *decl) { fields.push_back(decl); }
-    void addMemberDecl(MethodDecl *decl) { methods.push_back(decl); }
+    /// Members are parsed after the class they point to as their parent, they are set once all are known
+    void setMembers(ASTList<AggregateDecl *> memberDecls, ASTList<FieldDecl *> memberFields,
+                    ASTList<MethodDecl *> memberMethods) {
+        decls = memberDecls;
+        fields = memberFields;
+        methods = memberMethods;
+    }
+
+    static bool classof(const ASTNode *node) { return node->getKind() == ASTKind::ClassDecl; }
 
-    ASTDeclVisitorDispatcher
   private:
     ReferenceTypenameExpr *baseclass;
-    std::vector<ReferenceTypenameExpr *> interfaces;
+    ASTList<ReferenceTypenameExpr *> interfaces;
 
-    std::vector<AggregateDecl *> decls;
-    std::vector<FieldDecl *> fields;
-    std::vector<MethodDecl *> methods;
+    ASTList<AggregateDecl *> decls;
+    ASTList<FieldDecl *> fields;
+    ASTList<MethodDecl *> methods;
 };
 
 class InterfaceDecl : public AggregateDecl {
   public:
-    InterfaceDecl(const SourceLocation *loc,
+    InterfaceDecl(SourceLocation loc,
                   Visibility visibility,
-                  std::string declname,
-                  std::vector<ReferenceTypenameExpr *> interfaces,
-                  std::vector<AggregateDecl *> decls = {},
-                  std::vector<MethodDecl *> methods = {});
+                  Symbol declname,
+                  ASTList<ReferenceTypenameExpr *> interfaces,
+                  ASTList<AggregateDecl *> decls = {},
+                  ASTList<MethodDecl *> methods = {});
+
+    const ASTList<ReferenceTypenameExpr *> &getInterfaces() const { return interfaces; }
+    const ASTList<AggregateDecl *> &getDecls() const { return decls; }
+    const ASTList<MethodDecl *> &getMethods() const { return methods; }
 
-    const std::vector<ReferenceTypenameExpr *> &getInterfaces() const { return interfaces; }
-    const std::vector<AggregateDecl *> &getDecls() const { return decls; }
-    const std::vector<MethodDecl *> &getMethods() const { return methods; }
+    /// Members are parsed after the interface they point to as their parent, they are set once all are known
+    void setMembers(ASTList<AggregateDecl *> memberDecls, ASTList<MethodDecl *> memberMethods) {
+        decls = memberDecls;
+        methods = memberMethods;
+    }
 
-    void addMemberDecl(MethodDecl *decl) { methods.push_back(decl); }
-    void addMemberDecl(InterfaceDecl *decl) { decls.push_back(decl); }
+    static bool classof(const ASTNode *node) { return node->getKind() == ASTKind::InterfaceDecl; }
 
-    ASTDeclVisitorDispatcher
   private:
-    std::vector<ReferenceTypenameExpr *> interfaces;
+    ASTList<ReferenceTypenameExpr *> interfaces;
 
-    std::vector<AggregateDecl *> decls;
-    std::vector<MethodDecl *> methods;
+    ASTList<AggregateDecl *> decls;
+    ASTList<MethodDecl *> methods;
 };
 
 class VariableDecl : public Declaration {
   public:
-    VariableDecl(const SourceLocation *loc,
-                 std::string declname,
+    VariableDecl(SourceLocation loc,
+                 Symbol declname,
                  ASTTypeExpr *type_decl,
                  Expression *initializer = nullptr);
 
@@ -121,8 +140,17 @@ class VariableDecl : public Declaration {
     bool isGlobalVariable() const { return isGlobal; }
     void setGlobal() { isGlobal = true; }
 
-    ASTDeclVisitorDispatcher
+    static bool classof(const ASTNode *node) {
+        return isKindInRange(node, ASTKind::VariableDecl, ASTKind::ParamDecl);
+    }
+
   protected:
+    VariableDecl(ASTKind kind,
+                 SourceLocation loc,
+                 Symbol declname,
+                 ASTTypeExpr *type_decl,
+                 Expression *initializer);
+
     ASTTypeExpr *typeDecl;
     Expression *initializer;
     bool isGlobal;
@@ -130,8 +158,8 @@ class VariableDecl : public Declaration {
 
 class FieldDecl : public VariableDecl {
   public:
-    FieldDecl(const SourceLocation *loc,
-              std::string declname,
+    FieldDecl(SourceLocation loc,
+              Symbol declname,
               ASTTypeExpr *type_decl,
               ClassDecl *parent,
               Visibility visibility,
@@ -140,7 +168,8 @@ class FieldDecl : public VariableDecl {
     ClassDecl *getParent() const { return parent; }
     Visibility getVisibility() const { return visibility; }
 
-    ASTDeclVisitorDispatcher
+    static bool classof(const ASTNode *node) { return node->getKind() == ASTKind::FieldDecl; }
+
   private:
     ClassDecl *parent;
     Visibility visibility;
@@ -149,55 +178,71 @@ class FieldDecl : public VariableDecl {
 class FunctionDecl;
 class ParamDecl : public VariableDecl {
   public:
-    ParamDecl(const SourceLocation *loc,
-              std::string declname,
+    ParamDecl(SourceLocation loc,
+              Symbol declname,
               ASTTypeExpr *type_decl);
 
     FunctionDecl *getParent() const { return parent; }
 
-    ASTDeclVisitorDispatcher
+    static bool classof(const ASTNode *node) { return node->getKind() == ASTKind::ParamDecl; }
+
   private:
     FunctionDecl *parent;
 };
 
 class FunctionDecl : public Declaration {
   public:
-    FunctionDecl(const SourceLocation *loc,
-                 std::string declname,
-                 std::vector<ParamDecl *> param_decls,
+    FunctionDecl(SourceLocation loc,
+                 Symbol declname,
+                 ASTList<ParamDecl *> param_decls,
                  ASTTypeExpr *return_type_decl,
-                 BlockStmt *body);
+                 DeferredBody body);
 
-    const std::vector<ParamDecl *> &getParamDecls() const { return paramDecls; }
+    const ASTList<ParamDecl *> &getParamDecls() const { return paramDecls; }
     ASTTypeExpr *getReturnTypeDecl() const { return returnTypeDecl; }
-    BlockStmt *getBody() const { return body; }
+    /// @returns the body, a deferred body is parsed on first access
+    BlockStmt *getBody() const { return body.get(); }
+    /// @returns true if the function has a body, without parsing a deferred one
+    bool hasBody() const { return body.hasBody(); }
+    bool isBodyDeferred() const { return body.isDeferred(); }
 
     ScopeMember *getScope() const { return scope; }
     void setScope(ScopeMember *lexicalScope) { FunctionDecl::scope = lexicalScope; }
 
-    ASTDeclVisitorDispatcher
+    static bool classof(const ASTNode *node) {
+        return isKindInRange(node, ASTKind::FunctionDecl, ASTKind::MethodDecl);
+    }
+
   protected:
-    std::vector<ParamDecl *> paramDecls;
+    FunctionDecl(ASTKind kind,
+                 SourceLocation loc,
+                 Symbol declname,
+                 ASTList<ParamDecl *> param_decls,
+                 ASTTypeExpr *return_type_decl,
+                 DeferredBody body);
+
+    ASTList<ParamDecl *> paramDecls;
     ASTTypeExpr *returnTypeDecl;
-    BlockStmt *body;
+    mutable DeferredBody body;
 
     ScopeMember *scope;
 };
 
 class MethodDecl : public FunctionDecl {
   public:
-    MethodDecl(const SourceLocation *loc,
-               std::string declname,
-               std::vector<ParamDecl *> param_decls,
+    MethodDecl(SourceLocation loc,
+               Symbol declname,
+               ASTList<ParamDecl *> param_decls,
                ASTTypeExpr *return_type_decl,
-               BlockStmt *body,
+               DeferredBody body,
                AggregateDecl *parent,
                Visibility visibility);
 
     AggregateDecl *getParent() const { return parent; }
     Visibility getVisibility() const { return visibility; }
 
-    ASTDeclVisitorDispatcher
+    static bool classof(const ASTNode *node) { return node->getKind() == ASTKind::MethodDecl; }
+
   private:
     AggregateDecl *parent;
     Visibility visibility;
@@ -206,8 +251,8 @@ class MethodDecl : public FunctionDecl {
 class LexicalScope;
 class CompilationUnit : public Declaration {
   public:
-    CompilationUnit(const SourceLocation *loc,
-                    std::string declname,
+    CompilationUnit(SourceLocation loc,
+                    Symbol declname,
                     std::vector<Declaration *> decls = {});
 
     void addDecl(Declaration *decl);
@@ -217,7 +262,8 @@ class CompilationUnit : public Declaration {
     LexicalScope *getScope() const { return scope; }
     void setScope(LexicalScope *lexicalScope) { CompilationUnit::scope = lexicalScope; }
 
-    ASTDeclVisitorDispatcher
+    static bool classof(const ASTNode *node) { return node->getKind() == ASTKind::CompilationUnit; }
+
   private:
     std::vector<Declaration *> decls;
     LexicalScope *scope;
@@ -9,55 +9,57 @@
 namespace reflex {
 
 std::string Identifier::getReferenceName() const {
-    return reference;
+    return reference.str();
 }
 
 const std::string &Identifier::getBaseRefName() const {
-    return reference;
+    return reference.str();
 }
 
 std::string ModuleSelector::getReferenceName() const {
-    return prefix + "::" + child->getReferenceName();
+    return prefix.str() + "::" + child->getReferenceName();
 }
 
 const std::string &ModuleSelector::getBaseRefName() const {
     return child->getBaseRefName();
 }
 
-Expression::Expression(const SourceLocation *loc) : ASTNode(loc) {}
+Expression::Expression(ASTKind kind, SourceLocation loc) : ASTNode(kind, loc) {}
 
-DeclRefExpr::DeclRefExpr(const SourceLocation *loc, Declaration *decl) : Expression(loc), decl(decl) {}
+DeclRefExpr::DeclRefExpr(ASTKind kind, SourceLocation loc, Declaration *decl)
+    : Expression(kind, loc), decl(decl) {}
 
-Identifier::Identifier(const SourceLocation *loc, Declaration *decl, std::string reference)
-    : DeclRefExpr(loc, decl),
-      reference(std::move(reference)) {}
+Identifier::Identifier(SourceLocation loc, Declaration *decl, Symbol reference)
+    : DeclRefExpr(ASTKind::Identifier, loc, decl),
+      reference(reference) {}
 
-ModuleSelector::ModuleSelector(const SourceLocation *loc,
+ModuleSelector::ModuleSelector(SourceLocation loc,
                                Declaration *decl,
-                               std::string prefix,
+                               Symbol prefix,
                                DeclRefExpr *child)
-    : DeclRefExpr(loc, decl), prefix(std::move(prefix)), child(child) {}
+    : DeclRefExpr(ASTKind::ModuleSelector, loc, decl), prefix(prefix), child(child),
+      reference(prefix.str() + "::" + child->getReferenceName()) {}
 
-UnaryExpr::UnaryExpr(const SourceLocation *loc, Operator::UnaryOperator op, Expression *expr)
-    : Expression(loc), op(op), expr(expr) {}
+UnaryExpr::UnaryExpr(SourceLocation loc, Operator::UnaryOperator op, Expression *expr)
+    : Expression(ASTKind::UnaryExpr, loc), op(op), expr(expr) {}
 
-BinaryExpr::BinaryExpr(const SourceLocation *loc, Operator::BinaryOperator op,
+BinaryExpr::BinaryExpr(SourceLocation loc, Operator::BinaryOperator op,
                        Expression *lhs, Expression *rhs)
-    : Expression(loc), op(op), lhs(lhs), rhs(rhs) {}
+    : Expression(ASTKind::BinaryExpr, loc), op(op), lhs(lhs), rhs(rhs) {}
 
-NewExpr::NewExpr(const SourceLocation *loc, ASTTypeExpr *instanceType)
-    : Expression(loc), instanceType(instanceType) {}
+NewExpr::NewExpr(SourceLocation loc, ASTTypeExpr *instanceType)
+    : Expression(ASTKind::NewExpr, loc), instanceType(instanceType) {}
 
-CastExpr::CastExpr(const SourceLocation *loc, ASTTypeExpr *resultType, Expression *from)
-    : Expression(loc), resultType(resultType), from(from) {}
+CastExpr::CastExpr(SourceLocation loc, ASTTypeExpr *resultType, Expression *from)
+    : Expression(ASTKind::CastExpr, loc), resultType(resultType), from(from) {}
 
-IndexExpr::IndexExpr(const SourceLocation *loc, Expression *expr, Expression *index)
-    : Expression(loc), expr(expr), index(index) {}
+IndexExpr::IndexExpr(SourceLocation loc, Expression *expr, Expression *index)
+    : Expression(ASTKind::IndexExpr, loc), expr(expr), index(index) {}
 
-SelectorExpr::SelectorExpr(const SourceLocation *loc, Expression *expr, std::string aSelector)
-    : Expression(loc), expr(expr), selector(std::move(aSelector)) {}
+SelectorExpr::SelectorExpr(SourceLocation loc, Expression *expr, Symbol aSelector)
+    : Expression(ASTKind::SelectorExpr, loc), expr(expr), selector(aSelector) {}
 
-ArgumentExpr::ArgumentExpr(const SourceLocation *loc, Expression *expr, std::vector<Expression *> arguments)
-    : Expression(loc), expr(expr), arguments(std::move(arguments)) {}
+ArgumentExpr::ArgumentExpr(SourceLocation loc, Expression *expr, ASTList<Expression *> arguments)
+    : Expression(ASTKind::ArgumentExpr, loc), expr(expr), arguments(arguments) {}
 
 }
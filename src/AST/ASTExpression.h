@@ -8,10 +8,9 @@
 #include "AST.h"
 
 #include <string>
-#include <vector>
 
 #include <Operator.h>
-#include <ASTVisitor.h>
+#include <StringInterner.h>
 
 namespace reflex {
 
@@ -20,9 +19,13 @@ class Declaration;
 class ASTTypeExpr;
 class Type;
 
-class Expression : public ASTNode, public ASTExpressionVisitable {
+class Expression : public ASTNode {
   public:
-    explicit Expression(const SourceLocation *loc);
+    Expression(ASTKind kind, SourceLocation loc);
+
+    static bool classof(const ASTNode *node) {
+        return isKindInRange(node, ASTKind::Identifier, ASTKind::FunctionLiteral);
+    }
 
     Type *getType() const { return type; }
     void setType(Type *typ) { Expression::type = typ; }
@@ -33,39 +36,51 @@ class Expression : public ASTNode, public ASTExpressionVisitable {
 
 class DeclRefExpr : public Expression {
   public:
-    DeclRefExpr(const SourceLocation *loc, Declaration *decl);
+    DeclRefExpr(ASTKind kind, SourceLocation loc, Declaration *decl);
 
     [[nodiscard]] virtual std::string getReferenceName() const = 0;
+    [[nodiscard]] virtual Symbol getReferenceSymbol() const = 0;
     [[nodiscard]] virtual const std::string &getBaseRefName() const = 0;
     void setDecl(Declaration *ref) { DeclRefExpr::decl = ref; }
     Declaration *getDecl() const { return decl; }
 
-    ASTExprVisitorDispatcher
+    static bool classof(const ASTNode *node) {
+        return isKindInRange(node, ASTKind::Identifier, ASTKind::ModuleSelector);
+    }
+
   private:
     Declaration *decl;
 };
 
 class ModuleSelector : public DeclRefExpr {
   public:
-    ModuleSelector(const SourceLocation *loc, Declaration *decl,
-                   std::string prefix, DeclRefExpr *child);
+    ModuleSelector(SourceLocation loc, Declaration *decl,
+                   Symbol prefix, DeclRefExpr *child);
 
     [[nodiscard]] std::string getReferenceName() const override;
+    [[nodiscard]] Symbol getReferenceSymbol() const override { return reference; }
     const std::string &getBaseRefName() const override;
+    Symbol getPrefix() const { return prefix; }
+    DeclRefExpr *getChild() const { return child; }
+
+    static bool classof(const ASTNode *node) { return node->getKind() == ASTKind::ModuleSelector; }
   private:
-    std::string prefix;
+    Symbol prefix;
     DeclRefExpr *child;
+    // the qualified name, interned once when the node is built
+    Symbol reference;
 };
 
 class UnaryExpr : public Expression {
   public:
-    UnaryExpr(const SourceLocation *loc, Operator::UnaryOperator op, Expression *expr);
+    UnaryExpr(SourceLocation loc, Operator::UnaryOperator op, Expression *expr);
 
     Operator::UnaryOperator getUnaryOp() const { return op; }
     Expression *getExpr() const { return expr; }
     void setExpr(Expression *subexpr) { UnaryExpr::expr = subexpr; }
 
-    ASTExprVisitorDispatcher
+    static bool classof(const ASTNode *node) { return node->getKind() == ASTKind::UnaryExpr; }
+
   private:
     Operator::UnaryOperator op;
     Expression *expr;
@@ -73,7 +88,7 @@ class UnaryExpr : public Expression {
 
 class BinaryExpr : public Expression {
   public:
-    BinaryExpr(const SourceLocation *loc, Operator::BinaryOperator op,
+    BinaryExpr(SourceLocation loc, Operator::BinaryOperator op,
                Expression *lhs, Expression *rhs);
 
     Operator::BinaryOperator getBinaryOp() const { return op; }
@@ -82,7 +97,8 @@ class BinaryExpr : public Expression {
     void setLhs(Expression *lhsExpr) { BinaryExpr::lhs = lhsExpr; }
     void setRhs(Expression *rhsExpr) { BinaryExpr::rhs = rhsExpr; }
 
-    ASTExprVisitorDispatcher
+    static bool classof(const ASTNode *node) { return node->getKind() == ASTKind::BinaryExpr; }
+
   private:
     Operator::BinaryOperator op;
     Expression *lhs;
@@ -91,25 +107,27 @@ class BinaryExpr : public Expression {
 
 class NewExpr : public Expression {
   public:
-    NewExpr(const SourceLocation *loc, ASTTypeExpr *instanceType);
+    NewExpr(SourceLocation loc, ASTTypeExpr *instanceType);
 
     ASTTypeExpr *getInstanceType() const { return instanceType; }
 
-    ASTExprVisitorDispatcher
+    static bool classof(const ASTNode *node) { return node->getKind() == ASTKind::NewExpr; }
+
   private:
     ASTTypeExpr *instanceType;
 };
 
 class ImplicitCastExpr : public Expression {
   public:
-    ImplicitCastExpr(const SourceLocation *loc, Expression *from,
+    ImplicitCastExpr(SourceLocation loc, Expression *from,
                      Operator::ImplicitConversion conversion)
-        : Expression(loc), from(from), conversion(conversion) {}
+        : Expression(ASTKind::ImplicitCastExpr, loc), from(from), conversion(conversion) {}
 
     Expression *getFrom() const { return from; }
     Operator::ImplicitConversion getConversion() const { return conversion; }
 
-    ASTExprVisitorDispatcher
+    static bool classof(const ASTNode *node) { return node->getKind() == ASTKind::ImplicitCastExpr; }
+
   private:
     Expression *from;
     Operator::ImplicitConversion conversion;
@@ -117,23 +135,27 @@ class ImplicitCastExpr : public Expression {
 
 class Identifier : public DeclRefExpr {
   public:
-    Identifier(const SourceLocation *loc, Declaration *decl, std::string reference);
+    Identifier(SourceLocation loc, Declaration *decl, Symbol reference);
 
     [[nodiscard]] std::string getReferenceName() const override;
+    [[nodiscard]] Symbol getReferenceSymbol() const override { return reference; }
     const std::string &getBaseRefName() const override;
+
+    static bool classof(const ASTNode *node) { return node->getKind() == ASTKind::Identifier; }
   private:
-    std::string reference;
+    Symbol reference;
 };
 
 class CastExpr : public Expression {
   public:
-    CastExpr(const SourceLocation *loc, ASTTypeExpr *resultType, Expression *from);
+    CastExpr(SourceLocation loc, ASTTypeExpr *resultType, Expression *from);
 
     Expression *getFrom() const { return from; }
     void setFrom(Expression *expr) { CastExpr::from = expr; }
     ASTTypeExpr *getResultType() const { return resultType; }
 
-    ASTExprVisitorDispatcher
+    static bool classof(const ASTNode *node) { return node->getKind() == ASTKind::CastExpr; }
+
   private:
     ASTTypeExpr *resultType;
     Expression *from;
@@ -141,13 +163,14 @@ class CastExpr : public Expression {
 
 class IndexExpr : public Expression {
   public:
-    IndexExpr(const SourceLocation *loc, Expression *expr, Expression *index);
+    IndexExpr(SourceLocation loc, Expression *expr, Expression *index);
 
     Expression *getBaseExpr() const { return expr; }
     Expression *getIndex() const { return index; }
     void setIndex(Expression *newIndex) { IndexExpr::index = newIndex; }
 
-    ASTExprVisitorDispatcher
+    static bool classof(const ASTNode *node) { return node->getKind() == ASTKind::IndexExpr; }
+
   private:
     Expression *expr;
     Expression *index;
@@ -155,31 +178,34 @@ class IndexExpr : public Expression {
 
 class SelectorExpr : public Expression {
   public:
-    SelectorExpr(const SourceLocation *loc, Expression *expr, std::string aSelector);
+    SelectorExpr(SourceLocation loc, Expression *expr, Symbol aSelector);
 
     Expression *getBaseExpr() const { return expr; }
     void setBaseExpr(Expression *baseexpr) { SelectorExpr::expr = baseexpr; }
-    const std::string &getSelector() const { return selector; }
+    const std::string &getSelector() const { return selector.str(); }
+    Symbol getSelectorSymbol() const { return selector; }
+
+    static bool classof(const ASTNode *node) { return node->getKind() == ASTKind::SelectorExpr; }
 
-    ASTExprVisitorDispatcher
   private:
     Expression *expr;
-    std::string selector;
+    Symbol selector;
 };
 
 class ArgumentExpr : public Expression {
   public:
-    ArgumentExpr(const SourceLocation *loc, Expression *expr, std::vector<Expression *> arguments);
+    ArgumentExpr(SourceLocation loc, Expression *expr, ASTList<Expression *> arguments);
 
     Expression *getBaseExpr() const { return expr; }
     void setBaseExpr(Expression *base) { ArgumentExpr::expr = base; }
-    const std::vector<Expression *> &getArguments() const { return arguments; }
+    const ASTList<Expression *> &getArguments() const { return arguments; }
     void setArgument(Expression *arg, size_t index) { arguments[index] = arg; }
 
-    ASTExprVisitorDispatcher
+    static bool classof(const ASTNode *node) { return node->getKind() == ASTKind::ArgumentExpr; }
+
   private:
     Expression *expr;
-    std::vector<Expression *> arguments;
+    ASTList<Expression *> arguments;
 };
 
 }
@@ -12,13 +12,13 @@ namespace reflex {
 BadLiteralError::BadLiteralError(const std::string &arg)
     : runtime_error("Bad Literal: " + arg) {}
 
-Literal::Literal(const SourceLocation *loc) : Expression(loc) {}
+Literal::Literal(ASTKind kind, SourceLocation loc) : Expression(kind, loc) {}
 
-BasicLiteral::BasicLiteral(const SourceLocation *loc, std::string value)
-    : Literal(loc), value(std::move(value)) {}
+BasicLiteral::BasicLiteral(ASTKind kind, SourceLocation loc, std::string value)
+    : Literal(kind, loc), value(std::move(value)) {}
 
-NumberLiteral::NumberLiteral(const SourceLocation *loc, std::string str)
-    : BasicLiteral(loc, std::move(str)) {
+NumberLiteral::NumberLiteral(SourceLocation loc, std::string str)
+    : BasicLiteral(ASTKind::NumberLiteral, loc, std::move(str)) {
     std::stringstream ss(value);
     double i;
     if ((ss >> i).fail() || !(ss >> std::ws).eof()) {
@@ -27,25 +27,25 @@ NumberLiteral::NumberLiteral(const SourceLocation *loc, std::string str)
     val = i;
 }
 
-StringLiteral::StringLiteral(const SourceLocation *loc, std::string value)
-    : BasicLiteral(loc, std::move(value)) {}
+StringLiteral::StringLiteral(SourceLocation loc, std::string value)
+    : BasicLiteral(ASTKind::StringLiteral, loc, std::move(value)) {}
 
-BooleanLiteral::BooleanLiteral(const SourceLocation *loc, std::string value)
-    : BasicLiteral(loc, std::move(value)) {
+BooleanLiteral::BooleanLiteral(SourceLocation loc, std::string value)
+    : BasicLiteral(ASTKind::BooleanLiteral, loc, std::move(value)) {
     std::stringstream ss(value);
     ss >> std::boolalpha >> literal;
 }
 
-NullLiteral::NullLiteral(const SourceLocation *loc, std::string value)
-    : BasicLiteral(loc, std::move(value)) {}
+NullLiteral::NullLiteral(SourceLocation loc, std::string value)
+    : BasicLiteral(ASTKind::NullLiteral, loc, std::move(value)) {}
 
-ArrayLiteral::ArrayLiteral(const SourceLocation *loc, std::vector<Expression *> list)
-    : Literal(loc), list(std::move(list)) {}
+ArrayLiteral::ArrayLiteral(SourceLocation loc, ASTList<Expression *> list)
+    : Literal(ASTKind::ArrayLiteral, loc), list(list) {}
 
-FunctionLiteral::FunctionLiteral(const SourceLocation *loc,
-                                 std::vector<ParamDecl *> parameters,
+FunctionLiteral::FunctionLiteral(SourceLocation loc,
+                                 ASTList<ParamDecl *> parameters,
                                  ASTTypeExpr *returnType,
-                                 BlockStmt *body)
-    : Literal(loc), parameters(std::move(parameters)), returnType(returnType), body(body) {}
+                                 DeferredBody body)
+    : Literal(ASTKind::FunctionLiteral, loc), parameters(parameters), returnType(returnType), body(body) {}
 
 }
@@ -6,6 +6,7 @@
 #define REFLEX_SRC_AST_ASTLITERAL_H_
 
 #include "ASTExpression.h"
+#include "DeferredBody.h"
 
 namespace reflex {
 
@@ -19,12 +20,20 @@ class BlockStmt;
 
 class Literal : public Expression {
   public:
-    explicit Literal(const SourceLocation *loc);
+    Literal(ASTKind kind, SourceLocation loc);
+
+    static bool classof(const ASTNode *node) {
+        return isKindInRange(node, ASTKind::NumberLiteral, ASTKind::FunctionLiteral);
+    }
 };
 
 class BasicLiteral : public Literal {
   public:
-    BasicLiteral(const SourceLocation *loc, std::string value);
+    BasicLiteral(ASTKind kind, SourceLocation loc, std::string value);
+
+    static bool classof(const ASTNode *node) {
+        return isKindInRange(node, ASTKind::NumberLiteral, ASTKind::NullLiteral);
+    }
 
     const std::string &getLiteral() const { return value; }
 
@@ -34,70 +43,78 @@ class BasicLiteral : public Literal {
 
 class NumberLiteral : public BasicLiteral {
   public:
-    NumberLiteral(const SourceLocation *loc, std::string str);
+    NumberLiteral(SourceLocation loc, std::string str);
 
     double getValue() const { return val; }
 
-    ASTExprVisitorDispatcher
+    static bool classof(const ASTNode *node) { return node->getKind() == ASTKind::NumberLiteral; }
+
   private:
     double val;
 };
 
 class StringLiteral : public BasicLiteral {
   public:
-    StringLiteral(const SourceLocation *loc, std::string value);
+    StringLiteral(SourceLocation loc, std::string value);
+
+    static bool classof(const ASTNode *node) { return node->getKind() == ASTKind::StringLiteral; }
 
-    ASTExprVisitorDispatcher
 };
 
 class BooleanLiteral : public BasicLiteral {
   public:
-    BooleanLiteral(const SourceLocation *loc, std::string value);
+    BooleanLiteral(SourceLocation loc, std::string value);
 
     bool getValue() const { return literal; }
 
-    ASTExprVisitorDispatcher
+    static bool classof(const ASTNode *node) { return node->getKind() == ASTKind::BooleanLiteral; }
+
   private:
     bool literal{};
 };
 
 class NullLiteral : public BasicLiteral {
   public:
-    NullLiteral(const SourceLocation *loc, std::string value);
+    NullLiteral(SourceLocation loc, std::string value);
+
+    static bool classof(const ASTNode *node) { return node->getKind() == ASTKind::NullLiteral; }
 
-    ASTExprVisitorDispatcher
 };
 
 class ArrayLiteral : public Literal {
   public:
-    ArrayLiteral(const SourceLocation *loc, std::vector<Expression *> list);
+    ArrayLiteral(SourceLocation loc, ASTList<Expression *> list);
 
-    const std::vector<Expression *> &getInitList() const { return list; }
+    const ASTList<Expression *> &getInitList() const { return list; }
+
+    static bool classof(const ASTNode *node) { return node->getKind() == ASTKind::ArrayLiteral; }
 
-    ASTExprVisitorDispatcher
   private:
-    std::vector<Expression *> list;
+    ASTList<Expression *> list;
 };
 
 class FunctionLiteral : public Literal {
   public:
-    FunctionLiteral(const SourceLocation *loc,
-                    std::vector<ParamDecl *> parameters,
+    FunctionLiteral(SourceLocation loc,
+                    ASTList<ParamDecl *> parameters,
                     ASTTypeExpr *returnType,
-                    BlockStmt *body);
+                    DeferredBody body);
 
-    const std::vector<ParamDecl *> &getParamDecls() const { return parameters; }
+    const ASTList<ParamDecl *> &getParamDecls() const { return parameters; }
     ASTTypeExpr *getReturnType() const { return returnType; }
-    BlockStmt *getBody() const { return body; }
+    /// @returns the body, a deferred body is parsed on first access
+    BlockStmt *getBody() const { return body.get(); }
+    bool isBodyDeferred() const { return body.isDeferred(); }
 
     ScopeMember *getScope() const { return scope; }
     void setScope(ScopeMember *lexicalScope) { FunctionLiteral::scope = lexicalScope; }
 
-    ASTExprVisitorDispatcher
+    static bool classof(const ASTNode *node) { return node->getKind() == ASTKind::FunctionLiteral; }
+
   private:
-    std::vector<ParamDecl *> parameters;
+    ASTList<ParamDecl *> parameters;
     ASTTypeExpr *returnType;
-    BlockStmt *body;
+    mutable DeferredBody body;
 
     ScopeMember *scope;
 };
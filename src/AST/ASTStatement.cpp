@@ -6,48 +6,48 @@
 
 namespace reflex {
 
-Statement::Statement(const SourceLocation *loc) : ASTNode(loc) {}
+Statement::Statement(ASTKind kind, SourceLocation loc) : ASTNode(kind, loc) {}
 
-BlockStmt::BlockStmt(const SourceLocation *loc, std::vector<Statement *> stmts)
-    : Statement(loc), statements(std::move(stmts)) {}
+BlockStmt::BlockStmt(SourceLocation loc, ASTList<Statement *> stmts)
+    : Statement(ASTKind::BlockStmt, loc), statements(stmts) {}
 
-SimpleStmt::SimpleStmt(const SourceLocation *loc) : Statement(loc) {}
+SimpleStmt::SimpleStmt(ASTKind kind, SourceLocation loc) : Statement(kind, loc) {}
 
-ReturnStmt::ReturnStmt(const SourceLocation *loc, Expression *returnValue)
-    : Statement(loc), returnValue(returnValue) {}
+ReturnStmt::ReturnStmt(SourceLocation loc, Expression *returnValue)
+    : Statement(ASTKind::ReturnStmt, loc), returnValue(returnValue) {}
 
-BreakStmt::BreakStmt(const SourceLocation *loc) : Statement(loc) {}
+BreakStmt::BreakStmt(SourceLocation loc) : Statement(ASTKind::BreakStmt, loc) {}
 
-ContinueStmt::ContinueStmt(const SourceLocation *loc) : Statement(loc) {}
+ContinueStmt::ContinueStmt(SourceLocation loc) : Statement(ASTKind::ContinueStmt, loc) {}
 
-IfStmt::IfStmt(const SourceLocation *loc, SimpleStmt *cond,
+IfStmt::IfStmt(SourceLocation loc, SimpleStmt *cond,
                BlockStmt *primaryBlock, BlockStmt *elseBlock)
-    : Statement(loc), cond(cond), primaryBlock(primaryBlock), elseBlock(elseBlock) {}
+    : Statement(ASTKind::IfStmt, loc), cond(cond), primaryBlock(primaryBlock), elseBlock(elseBlock) {}
 
-ForRangeClause::ForRangeClause(const SourceLocation *loc, VariableDecl *variable, Expression *iterExpr)
-    : ForClause(loc), variable(variable), iterExpr(iterExpr) {}
+ForRangeClause::ForRangeClause(SourceLocation loc, VariableDecl *variable, Expression *iterExpr)
+    : ForClause(ASTKind::ForRangeClause, loc), variable(variable), iterExpr(iterExpr) {}
 
-ForNormalClause::ForNormalClause(const SourceLocation *loc, Statement *init, Expression *cond, SimpleStmt *post)
-    : ForClause(loc), init(init), cond(cond), post(post) {}
+ForNormalClause::ForNormalClause(SourceLocation loc, Statement *init, Expression *cond, SimpleStmt *post)
+    : ForClause(ASTKind::ForNormalClause, loc), init(init), cond(cond), post(post) {}
 
-ForStmt::ForStmt(const SourceLocation *loc, ForClause *clause, BlockStmt *body)
-    : Statement(loc), clause(clause), body(body) {}
+ForStmt::ForStmt(SourceLocation loc, ForClause *clause, BlockStmt *body)
+    : Statement(ASTKind::ForStmt, loc), clause(clause), body(body) {}
 
-WhileStmt::WhileStmt(const SourceLocation *loc, SimpleStmt *cond, BlockStmt *body)
-    : Statement(loc), cond(cond), body(body) {}
+WhileStmt::WhileStmt(SourceLocation loc, SimpleStmt *cond, BlockStmt *body)
+    : Statement(ASTKind::WhileStmt, loc), cond(cond), body(body) {}
 
-EmptyStmt::EmptyStmt(const SourceLocation *loc) : SimpleStmt(loc) {}
+EmptyStmt::EmptyStmt(SourceLocation loc) : SimpleStmt(ASTKind::EmptyStmt, loc) {}
 
-AssignmentStmt::AssignmentStmt(const SourceLocation *loc,
+AssignmentStmt::AssignmentStmt(SourceLocation loc,
                                Operator::AssignOperator assignOp,
                                Expression *lhs,
                                Expression *rhs)
-    : SimpleStmt(loc), assignOp(assignOp), lhs(lhs), rhs(rhs) {}
+    : SimpleStmt(ASTKind::AssignmentStmt, loc), assignOp(assignOp), lhs(lhs), rhs(rhs) {}
 
-IncDecStmt::IncDecStmt(const SourceLocation *loc, Operator::PostfixOperator postfixOp, Expression *expr)
-    : SimpleStmt(loc), postfixOp(postfixOp), expr(expr) {}
+IncDecStmt::IncDecStmt(SourceLocation loc, Operator::PostfixOperator postfixOp, Expression *expr)
+    : SimpleStmt(ASTKind::IncDecStmt, loc), postfixOp(postfixOp), expr(expr) {}
 
-ExpressionStmt::ExpressionStmt(const SourceLocation *loc, Expression *expr)
-    : SimpleStmt(loc), expr(expr) {}
+ExpressionStmt::ExpressionStmt(SourceLocation loc, Expression *expr)
+    : SimpleStmt(ASTKind::ExpressionStmt, loc), expr(expr) {}
 
 }
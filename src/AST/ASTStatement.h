@@ -8,10 +8,8 @@
 #include "AST.h"
 
 #include <string>
-#include <vector>
 
 #include <Operator.h>
-#include <ASTVisitor.h>
 
 namespace reflex {
 
@@ -21,53 +19,64 @@ class VariableDecl;
 class Declaration;
 class Type;
 
-class Statement : public ASTNode, public ASTStmtVisitable {
+class Statement : public ASTNode {
   public:
-    explicit Statement(const SourceLocation *loc);
+    Statement(ASTKind kind, SourceLocation loc);
+
+    static bool classof(const ASTNode *node) {
+        return isKindInRange(node, ASTKind::BlockStmt, ASTKind::ExpressionStmt);
+    }
 };
 
 class BlockStmt : public Statement {
   public:
-    BlockStmt(const SourceLocation *loc, std::vector<Statement *> stmts);
+    BlockStmt(SourceLocation loc, ASTList<Statement *> stmts);
 
-    const std::vector<Statement *> &getStmts() const { return statements; }
+    const ASTList<Statement *> &getStmts() const { return statements; }
 
     ScopeMember *getScope() const { return scope; }
     void setScope(ScopeMember *lexicalScope) { BlockStmt::scope = lexicalScope; }
 
-    ASTStmtVisitorDispatcher
+    static bool classof(const ASTNode *node) { return node->getKind() == ASTKind::BlockStmt; }
+
   private:
-    std::vector<Statement *> statements;
+    ASTList<Statement *> statements;
     ScopeMember *scope;
 };
 
 class DeclStmt : public Statement {
   public:
-    DeclStmt(const SourceLocation *loc, Declaration *decl)
-        : Statement(loc), decl(decl) {}
+    DeclStmt(SourceLocation loc, Declaration *decl)
+        : Statement(ASTKind::DeclStmt, loc), decl(decl) {}
 
     Declaration *getDecl() const { return decl; }
 
-    ASTStmtVisitorDispatcher
+    static bool classof(const ASTNode *node) { return node->getKind() == ASTKind::DeclStmt; }
+
   private:
     Declaration *decl;
 };
 
 class SimpleStmt : public Statement {
   public:
-    explicit SimpleStmt(const SourceLocation *loc);
+    SimpleStmt(ASTKind kind, SourceLocation loc);
+
+    static bool classof(const ASTNode *node) {
+        return isKindInRange(node, ASTKind::EmptyStmt, ASTKind::ExpressionStmt);
+    }
 };
 
 class ReturnStmt : public Statement {
   public:
-    ReturnStmt(const SourceLocation *loc, Expression *returnValue);
+    ReturnStmt(SourceLocation loc, Expression *returnValue);
 
     Expression *getReturnValue() const { return returnValue; }
     Type *getReturnType() const { return type; }
     void setReturnType(Type *typ) { ReturnStmt::type = typ; }
     void setReturnValue(Expression *expr) { ReturnStmt::returnValue = expr; }
 
-    ASTStmtVisitorDispatcher
+    static bool classof(const ASTNode *node) { return node->getKind() == ASTKind::ReturnStmt; }
+
   private:
     Expression *returnValue;
     Type *type = nullptr;
@@ -75,26 +84,29 @@ class ReturnStmt : public Statement {
 
 class BreakStmt : public Statement {
   public:
-    explicit BreakStmt(const SourceLocation *loc);
+    explicit BreakStmt(SourceLocation loc);
+
+    static bool classof(const ASTNode *node) { return node->getKind() == ASTKind::BreakStmt; }
 
-    ASTStmtVisitorDispatcher
 };
 
 class ContinueStmt : public Statement {
   public:
-    explicit ContinueStmt(const SourceLocation *loc);
+    explicit ContinueStmt(SourceLocation loc);
+
+    static bool classof(const ASTNode *node) { return node->getKind() == ASTKind::ContinueStmt; }
 
-    ASTStmtVisitorDispatcher
 };
 
 class IfStmt : public Statement {
   public:
-    IfStmt(const SourceLocation *loc, SimpleStmt *cond, BlockStmt *primaryBlock, BlockStmt *elseBlock);
+    IfStmt(SourceLocation loc, SimpleStmt *cond, BlockStmt *primaryBlock, BlockStmt *elseBlock);
     [[nodiscard]] SimpleStmt *getCond() const { return cond; }
     [[nodiscard]] BlockStmt *getPrimaryBlock() const { return primaryBlock; }
     [[nodiscard]] BlockStmt *getElseBlock() const { return elseBlock; }
 
-    ASTStmtVisitorDispatcher
+    static bool classof(const ASTNode *node) { return node->getKind() == ASTKind::IfStmt; }
+
   private:
     SimpleStmt *cond;
     BlockStmt *primaryBlock;
@@ -103,14 +115,20 @@ class IfStmt : public Statement {
 
 class ForClause : public ASTNode {
   public:
-    explicit ForClause(const SourceLocation *loc) : ASTNode(loc) {}
+    ForClause(ASTKind kind, SourceLocation loc) : ASTNode(kind, loc) {}
+
+    static bool classof(const ASTNode *node) {
+        return isKindInRange(node, ASTKind::ForRangeClause, ASTKind::ForNormalClause);
+    }
 };
 
 class ForRangeClause : public ForClause {
   public:
-    ForRangeClause(const SourceLocation *loc, VariableDecl *variable, Expression *iterExpr);
+    ForRangeClause(SourceLocation loc, VariableDecl *variable, Expression *iterExpr);
     [[nodiscard]] VariableDecl *getVariable() const { return variable; }
     [[nodiscard]] Expression *getIterExpr() const { return iterExpr; }
+
+    static bool classof(const ASTNode *node) { return node->getKind() == ASTKind::ForRangeClause; }
   private:
     VariableDecl *variable;
     Expression *iterExpr;
@@ -118,10 +136,12 @@ class ForRangeClause : public ForClause {
 
 class ForNormalClause : public ForClause {
   public:
-    ForNormalClause(const SourceLocation *loc, Statement *init, Expression *cond, SimpleStmt *post);
+    ForNormalClause(SourceLocation loc, Statement *init, Expression *cond, SimpleStmt *post);
     [[nodiscard]] Statement *getInit() const { return init; }
     [[nodiscard]] Expression *getCond() const { return cond; }
     [[nodiscard]] SimpleStmt *getPost() const { return post; }
+
+    static bool classof(const ASTNode *node) { return node->getKind() == ASTKind::ForNormalClause; }
   private:
     Statement *init;
     Expression *cond;
@@ -130,11 +150,12 @@ class ForNormalClause : public ForClause {
 
 class ForStmt : public Statement {
   public:
-    ForStmt(const SourceLocation *loc, ForClause *clause, BlockStmt *body);
+    ForStmt(SourceLocation loc, ForClause *clause, BlockStmt *body);
     [[nodiscard]] ForClause *getClause() const { return clause; }
     [[nodiscard]] BlockStmt *getBody() const { return body; }
 
-    ASTStmtVisitorDispatcher
+    static bool classof(const ASTNode *node) { return node->getKind() == ASTKind::ForStmt; }
+
   private:
     ForClause *clause;
     BlockStmt *body;
@@ -142,11 +163,12 @@ class ForStmt : public Statement {
 
 class WhileStmt : public Statement {
   public:
-    WhileStmt(const SourceLocation *loc, SimpleStmt *cond, BlockStmt *body);
+    WhileStmt(SourceLocation loc, SimpleStmt *cond, BlockStmt *body);
     [[nodiscard]] SimpleStmt *getCond() const { return cond; }
     [[nodiscard]] BlockStmt *getBody() const { return body; }
 
-    ASTStmtVisitorDispatcher
+    static bool classof(const ASTNode *node) { return node->getKind() == ASTKind::WhileStmt; }
+
   private:
     SimpleStmt *cond;
     BlockStmt *body;
@@ -154,21 +176,23 @@ class WhileStmt : public Statement {
 
 class EmptyStmt : public SimpleStmt {
   public:
-    explicit EmptyStmt(const SourceLocation *loc);
+    explicit EmptyStmt(SourceLocation loc);
+
+    static bool classof(const ASTNode *node) { return node->getKind() == ASTKind::EmptyStmt; }
 
-    ASTStmtVisitorDispatcher
 };
 
 class AssignmentStmt : public SimpleStmt {
   public:
-    AssignmentStmt(const SourceLocation *loc, Operator::AssignOperator assignOp, Expression *lhs, Expression *rhs);
+    AssignmentStmt(SourceLocation loc, Operator::AssignOperator assignOp, Expression *lhs, Expression *rhs);
     [[nodiscard]] Operator::AssignOperator getAssignOp() const { return assignOp; }
     [[nodiscard]] Expression *getLhs() const { return lhs; }
     [[nodiscard]] Expression *getRhs() const { return rhs; }
     void setLhs(Expression *newLhs) { AssignmentStmt::lhs = newLhs; }
     void setRhs(Expression *newRhs) { AssignmentStmt::rhs = newRhs; }
 
-    ASTStmtVisitorDispatcher
+    static bool classof(const ASTNode *node) { return node->getKind() == ASTKind::AssignmentStmt; }
+
   private:
     Operator::AssignOperator assignOp;
     Expression *lhs;
@@ -177,11 +201,12 @@ class AssignmentStmt : public SimpleStmt {
 
 class IncDecStmt : public SimpleStmt {
   public:
-    IncDecStmt(const SourceLocation *loc, Operator::PostfixOperator postfixOp, Expression *expr);
+    IncDecStmt(SourceLocation loc, Operator::PostfixOperator postfixOp, Expression *expr);
     [[nodiscard]] Operator::PostfixOperator getPostfixOp() const { return postfixOp; }
     [[nodiscard]] Expression *getExpr() const { return expr; }
 
-    ASTStmtVisitorDispatcher
+    static bool classof(const ASTNode *node) { return node->getKind() == ASTKind::IncDecStmt; }
+
   private:
     Operator::PostfixOperator postfixOp;
     Expression *expr;
@@ -189,11 +214,12 @@ class IncDecStmt : public SimpleStmt {
 
 class ExpressionStmt : public SimpleStmt {
   public:
-    ExpressionStmt(const SourceLocation *loc, Expression *expr);
+    ExpressionStmt(SourceLocation loc, Expression *expr);
     [[nodiscard]] Expression *getExpr() const { return expr; }
     void setExpr(Expression *newexpr) { ExpressionStmt::expr = newexpr; }
 
-    ASTStmtVisitorDispatcher
+    static bool classof(const ASTNode *node) { return node->getKind() == ASTKind::ExpressionStmt; }
+
   private:
     Expression *expr;
 };
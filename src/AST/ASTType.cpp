@@ -6,31 +6,31 @@
 
 namespace reflex {
 
-ASTTypeExpr::ASTTypeExpr(const SourceLocation *loc) : ASTNode(loc) {}
+ASTTypeExpr::ASTTypeExpr(ASTKind kind, SourceLocation loc) : ASTNode(kind, loc) {}
 
-ReferenceTypenameExpr::ReferenceTypenameExpr(const SourceLocation *loc) : ASTTypeExpr(loc) {}
+ReferenceTypenameExpr::ReferenceTypenameExpr(ASTKind kind, SourceLocation loc) : ASTTypeExpr(kind, loc) {}
 
 std::string BaseTypenameExpr::getQualifiedString() const {
-    return typeName;
+    return typeName.str();
 }
 
-BaseTypenameExpr::BaseTypenameExpr(const SourceLocation *loc, std::string type_name)
-    : ReferenceTypenameExpr(loc), typeName(std::move(type_name)) {}
+BaseTypenameExpr::BaseTypenameExpr(SourceLocation loc, Symbol type_name)
+    : ReferenceTypenameExpr(ASTKind::BaseTypenameExpr, loc), typeName(type_name) {}
 
-QualifiedTypenameExpr::QualifiedTypenameExpr(const SourceLocation *loc,
-                                             std::string name,
+QualifiedTypenameExpr::QualifiedTypenameExpr(SourceLocation loc,
+                                             Symbol name,
                                              ReferenceTypenameExpr *prefix)
-    : ReferenceTypenameExpr(loc), name(std::move(name)), prefix(prefix) {}
+    : ReferenceTypenameExpr(ASTKind::QualifiedTypenameExpr, loc), name(name), prefix(prefix) {}
 
 std::string QualifiedTypenameExpr::getQualifiedString() const {
-    return prefix->getQualifiedString() + "::" + name;
+    return prefix->getQualifiedString() + "::" + name.str();
 }
 
-ArrayTypeExpr::ArrayTypeExpr(const SourceLocation *loc, ASTTypeExpr *element_type, NumberLiteral *size)
-    : ASTTypeExpr(loc), elementType(element_type), size(size) {}
+ArrayTypeExpr::ArrayTypeExpr(SourceLocation loc, ASTTypeExpr *element_type, NumberLiteral *size)
+    : ASTTypeExpr(ASTKind::ArrayTypeExpr, loc), elementType(element_type), size(size) {}
 
-FunctionTypeExpr::FunctionTypeExpr(const SourceLocation *loc,
+FunctionTypeExpr::FunctionTypeExpr(SourceLocation loc,
                                    ASTTypeExpr *return_type,
-                                   std::vector<ASTTypeExpr *> param_types)
-    : ASTTypeExpr(loc), returnType(return_type), paramTypes(std::move(param_types)) {}
+                                   ASTList<ASTTypeExpr *> param_types)
+    : ASTTypeExpr(ASTKind::FunctionTypeExpr, loc), returnType(return_type), paramTypes(param_types) {}
 }
@@ -8,7 +8,8 @@
 #include "AST.h"
 
 #include <string>
-#include <vector>
+
+#include <StringInterner.h>
 
 namespace reflex {
 
@@ -17,44 +18,61 @@ class NumberLiteral;
 
 class ASTTypeExpr : public ASTNode {
   public:
-    explicit ASTTypeExpr(const SourceLocation *loc);
+    ASTTypeExpr(ASTKind kind, SourceLocation loc);
+
+    static bool classof(const ASTNode *node) {
+        return isKindInRange(node, ASTKind::BaseTypenameExpr, ASTKind::FunctionTypeExpr);
+    }
 };
 
 class ReferenceTypenameExpr : public ASTTypeExpr {
   public:
-    explicit ReferenceTypenameExpr(const SourceLocation *loc);
+    ReferenceTypenameExpr(ASTKind kind, SourceLocation loc);
+
+    static bool classof(const ASTNode *node) {
+        return isKindInRange(node, ASTKind::BaseTypenameExpr, ASTKind::QualifiedTypenameExpr);
+    }
 
     [[nodiscard]] virtual std::string getQualifiedString() const = 0;
 };
 
 class BaseTypenameExpr : public ReferenceTypenameExpr {
   public:
-    BaseTypenameExpr(const SourceLocation *loc, std::string type_name);
+    BaseTypenameExpr(SourceLocation loc, Symbol type_name);
 
     [[nodiscard]] std::string getQualifiedString() const override;
-    const std::string &getTypeName() const { return typeName; }
+    const std::string &getTypeName() const { return typeName.str(); }
+    Symbol getTypeSymbol() const { return typeName; }
+
+    static bool classof(const ASTNode *node) { return node->getKind() == ASTKind::BaseTypenameExpr; }
   private:
-    std::string typeName;
+    Symbol typeName;
 };
 
 class QualifiedTypenameExpr : public ReferenceTypenameExpr {
   public:
-    QualifiedTypenameExpr(const SourceLocation *loc, std::string name, ReferenceTypenameExpr *prefix);
+    QualifiedTypenameExpr(SourceLocation loc, Symbol name, ReferenceTypenameExpr *prefix);
 
     [[nodiscard]] std::string getQualifiedString() const override;
+    ReferenceTypenameExpr *getPrefix() const { return prefix; }
+    Symbol getNameSymbol() const { return name; }
+
+    static bool classof(const ASTNode *node) { return node->getKind() == ASTKind::QualifiedTypenameExpr; }
 
   private:
     ReferenceTypenameExpr *prefix;
-    std::string name;
+    Symbol name;
 };
 
 class ArrayTypeExpr : public ASTTypeExpr {
   public:
-    ArrayTypeExpr(const SourceLocation *loc, ASTTypeExpr *element_type, NumberLiteral *size);
+    ArrayTypeExpr(SourceLocation loc, ASTTypeExpr *element_type, NumberLiteral *size);
 
     NumberLiteral *getSize() const { return size; }
     ASTTypeExpr *getElementType() const { return elementType; }
 
+    static bool classof(const ASTNode *node) { return node->getKind() == ASTKind::ArrayTypeExpr; }
+
   private:
     NumberLiteral *size;
     ASTTypeExpr *elementType;
@@ -62,16 +80,18 @@ class ArrayTypeExpr : public ASTTypeExpr {
 
 class FunctionTypeExpr : public ASTTypeExpr {
   public:
-    FunctionTypeExpr(const SourceLocation *loc,
+    FunctionTypeExpr(SourceLocation loc,
                      ASTTypeExpr *return_type,
-                     std::vector<ASTTypeExpr *> param_types);
+                     ASTList<ASTTypeExpr *> param_types);
 
     ASTTypeExpr *getReturnType() const { return returnType; }
-    const std::vector<ASTTypeExpr *> &getParamTypes() const { return paramTypes; }
+    const ASTList<ASTTypeExpr *> &getParamTypes() const { return paramTypes; }
+
+    static bool classof(const ASTNode *node) { return node->getKind() == ASTKind::FunctionTypeExpr; }
 
   private:
     ASTTypeExpr *returnType;
-    std::vector<ASTTypeExpr *> paramTypes;
+    ASTList<ASTTypeExpr *> paramTypes;
 };
 
 }
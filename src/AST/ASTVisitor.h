@@ -5,137 +5,115 @@
 #ifndef REFLEX_SRC_AST_ASTVISITOR_H_
 #define REFLEX_SRC_AST_ASTVISITOR_H_
 
-#include <Utils/Generics.h>
+#include <cassert>
+#include <cstdlib>
 
-namespace reflex {
-
-class DeclRefExpr;
-class UnaryExpr;
-class BinaryExpr;
-class NewExpr;
-class ImplicitCastExpr;
-class CastExpr;
-class IndexExpr;
-class SelectorExpr;
-class ArgumentExpr;
+#include "ASTDeclaration.h"
+#include "ASTExpression.h"
+#include "ASTLiteral.h"
+#include "ASTStatement.h"
 
-class NumberLiteral;
-class StringLiteral;
-class BooleanLiteral;
-class NullLiteral;
-class ArrayLiteral;
-class FunctionLiteral;
+namespace reflex {
 
+/// Statically typed visitors, Derived implements visit(X &) for every concrete node X of the family
+/// - visit(node *) switches on ASTNode::getKind() and calls Derived::visit directly, there is no
+///   virtual accept and no type erased result
+/// - the node must not be null, a node of a kind outside the family asserts and aborts
+/// - the result of Derived::visit is converted to RetTy, with RetTy = void individual overloads may
+///   still return a value to callers that invoke them directly
+/// - a derived class visiting several families brings the dispatchers into scope with
+///   using ASTDeclVisitor::visit; etc.
+#define REFLEX_VISITOR_DISPATCH(Kind, Class) \
+    case ASTKind::Kind: return static_cast<RetTy>(derived().visit(*cast<Class>(node)));
+
+template<class Derived, class RetTy = void>
 class ASTExprVisitor {
   public:
-    virtual ~ASTExprVisitor() = default;
-
-    virtual OpaqueType visit(DeclRefExpr &) = 0;
-    virtual OpaqueType visit(UnaryExpr &) = 0;
-    virtual OpaqueType visit(BinaryExpr &) = 0;
-    virtual OpaqueType visit(NewExpr &) = 0;
-    virtual OpaqueType visit(ImplicitCastExpr &) = 0;
-    virtual OpaqueType visit(CastExpr &) = 0;
-    virtual OpaqueType visit(IndexExpr &) = 0;
-    virtual OpaqueType visit(SelectorExpr &) = 0;
-    virtual OpaqueType visit(ArgumentExpr &) = 0;
-
-    virtual OpaqueType visit(NumberLiteral &) = 0;
-    virtual OpaqueType visit(StringLiteral &) = 0;
-    virtual OpaqueType visit(BooleanLiteral &) = 0;
-    virtual OpaqueType visit(NullLiteral &) = 0;
-    virtual OpaqueType visit(ArrayLiteral &) = 0;
-    virtual OpaqueType visit(FunctionLiteral &) = 0;
-};
-
-class ASTExpressionVisitable {
-  public:
-    virtual ~ASTExpressionVisitable() = default;
-
-    virtual OpaqueType accept(ASTExprVisitor *v) = 0;
+    RetTy visit(Expression *node) {
+        assert(node && "visiting a null node");
+        switch (node->getKind()) {
+            REFLEX_VISITOR_DISPATCH(Identifier, DeclRefExpr)
+            REFLEX_VISITOR_DISPATCH(ModuleSelector, DeclRefExpr)
+            REFLEX_VISITOR_DISPATCH(UnaryExpr, UnaryExpr)
+            REFLEX_VISITOR_DISPATCH(BinaryExpr, BinaryExpr)
+            REFLEX_VISITOR_DISPATCH(NewExpr, NewExpr)
+            REFLEX_VISITOR_DISPATCH(ImplicitCastExpr, ImplicitCastExpr)
+            REFLEX_VISITOR_DISPATCH(CastExpr, CastExpr)
+            REFLEX_VISITOR_DISPATCH(IndexExpr, IndexExpr)
+            REFLEX_VISITOR_DISPATCH(SelectorExpr, SelectorExpr)
+            REFLEX_VISITOR_DISPATCH(ArgumentExpr, ArgumentExpr)
+            REFLEX_VISITOR_DISPATCH(NumberLiteral, NumberLiteral)
+            REFLEX_VISITOR_DISPATCH(StringLiteral, StringLiteral)
+            REFLEX_VISITOR_DISPATCH(BooleanLiteral, BooleanLiteral)
+            REFLEX_VISITOR_DISPATCH(NullLiteral, NullLiteral)
+            REFLEX_VISITOR_DISPATCH(ArrayLiteral, ArrayLiteral)
+            REFLEX_VISITOR_DISPATCH(FunctionLiteral, FunctionLiteral)
+            default: break;
+        }
+        assert(false && "unhandled AST kind");
+        std::abort();
+    }
+
+  private:
+    Derived &derived() { return *static_cast<Derived *>(this); }
 };
 
-#define ASTExprVisitorDispatcher \
-OpaqueType accept(ASTExprVisitor *v) override { return v->visit(*this); }
-
-class ClassDecl;
-class InterfaceDecl;
-class VariableDecl;
-class FieldDecl;
-class ParamDecl;
-class FunctionDecl;
-class MethodDecl;
-class CompilationUnit;
-
+template<class Derived, class RetTy = void>
 class ASTDeclVisitor {
   public:
-    virtual ~ASTDeclVisitor() = default;
-
-    virtual OpaqueType visit(ClassDecl &) = 0;
-    virtual OpaqueType visit(InterfaceDecl &) = 0;
-    virtual OpaqueType visit(VariableDecl &) = 0;
-    virtual OpaqueType visit(FieldDecl &) = 0;
-    virtual OpaqueType visit(ParamDecl &) = 0;
-    virtual OpaqueType visit(FunctionDecl &) = 0;
-    virtual OpaqueType visit(MethodDecl &) = 0;
-    virtual OpaqueType visit(CompilationUnit &) = 0;
-};
-
-class ASTDeclVisitable {
-  public:
-    virtual ~ASTDeclVisitable() = default;
-
-    virtual OpaqueType accept(ASTDeclVisitor *v) = 0;
+    RetTy visit(Declaration *node) {
+        assert(node && "visiting a null node");
+        switch (node->getKind()) {
+            REFLEX_VISITOR_DISPATCH(ClassDecl, ClassDecl)
+            REFLEX_VISITOR_DISPATCH(InterfaceDecl, InterfaceDecl)
+            REFLEX_VISITOR_DISPATCH(VariableDecl, VariableDecl)
+            REFLEX_VISITOR_DISPATCH(FieldDecl, FieldDecl)
+            REFLEX_VISITOR_DISPATCH(ParamDecl, ParamDecl)
+            REFLEX_VISITOR_DISPATCH(FunctionDecl, FunctionDecl)
+            REFLEX_VISITOR_DISPATCH(MethodDecl, MethodDecl)
+            REFLEX_VISITOR_DISPATCH(CompilationUnit, CompilationUnit)
+            default: break;
+        }
+        assert(false && "unhandled AST kind");
+        std::abort();
+    }
+
+  private:
+    Derived &derived() { return *static_cast<Derived *>(this); }
 };
 
-#define ASTDeclVisitorDispatcher \
-OpaqueType accept(ASTDeclVisitor *v) override { return v->visit(*this); }
-
-class BlockStmt;
-class ReturnStmt;
-class BreakStmt;
-class ContinueStmt;
-class IfStmt;
-class ForStmt;
-class WhileStmt;
-class EmptyStmt;
-class AssignmentStmt;
-class IncDecStmt;
-class ExpressionStmt;
-class DeclStmt;
-
+template<class Derived, class RetTy = void>
 class ASTStmtVisitor {
   public:
-    virtual ~ASTStmtVisitor() = default;
-
-    virtual OpaqueType visit(BlockStmt &) = 0;
-    virtual OpaqueType visit(ReturnStmt &) = 0;
-    virtual OpaqueType visit(BreakStmt &) = 0;
-    virtual OpaqueType visit(ContinueStmt &) = 0;
-    virtual OpaqueType visit(IfStmt &) = 0;
-    virtual OpaqueType visit(ForStmt &) = 0;
-    virtual OpaqueType visit(WhileStmt &) = 0;
-    virtual OpaqueType visit(EmptyStmt &) = 0;
-    virtual OpaqueType visit(AssignmentStmt &) = 0;
-    virtual OpaqueType visit(IncDecStmt &) = 0;
-    virtual OpaqueType visit(ExpressionStmt &) = 0;
-    virtual OpaqueType visit(DeclStmt &) = 0;
-};
-
-class ASTStmtVisitable {
-  public:
-    virtual ~ASTStmtVisitable() = default;
-
-    virtual OpaqueType accept(ASTStmtVisitor *v) = 0;
+    RetTy visit(Statement *node) {
+        assert(node && "visiting a null node");
+        switch (node->getKind()) {
+            REFLEX_VISITOR_DISPATCH(BlockStmt, BlockStmt)
+            REFLEX_VISITOR_DISPATCH(ReturnStmt, ReturnStmt)
+            REFLEX_VISITOR_DISPATCH(BreakStmt, BreakStmt)
+            REFLEX_VISITOR_DISPATCH(ContinueStmt, ContinueStmt)
+            REFLEX_VISITOR_DISPATCH(IfStmt, IfStmt)
+            REFLEX_VISITOR_DISPATCH(ForStmt, ForStmt)
+            REFLEX_VISITOR_DISPATCH(WhileStmt, WhileStmt)
+            REFLEX_VISITOR_DISPATCH(EmptyStmt, EmptyStmt)
+            REFLEX_VISITOR_DISPATCH(AssignmentStmt, AssignmentStmt)
+            REFLEX_VISITOR_DISPATCH(IncDecStmt, IncDecStmt)
+            REFLEX_VISITOR_DISPATCH(ExpressionStmt, ExpressionStmt)
+            REFLEX_VISITOR_DISPATCH(DeclStmt, DeclStmt)
+            default: break;
+        }
+        assert(false && "unhandled AST kind");
+        std::abort();
+    }
+
+  private:
+    Derived &derived() { return *static_cast<Derived *>(this); }
 };
 
-#define ASTStmtVisitorDispatcher \
-OpaqueType accept(ASTStmtVisitor *v) override { return v->visit(*this); }
+#undef REFLEX_VISITOR_DISPATCH
 
 #define ASTVisitorDefImpl \
-{ return {}; }
-
-#define ASTVisitorDefRetVal {}
+{}
 
 }
 
@@ -0,0 +1,52 @@
+//
+// Created by henry on 2022-05-25.
+//
+
+#ifndef REFLEX_SRC_AST_DEFERREDBODY_H_
+#define REFLEX_SRC_AST_DEFERREDBODY_H_
+
+#include <cstdint>
+
+namespace reflex {
+
+class BlockStmt;
+
+/// Builds the BlockStmt of a function body that was skipped during parsing
+class BodyMaterializer {
+  public:
+    virtual ~BodyMaterializer() = default;
+
+    /// @returns the BlockStmt spanning the tokens [@p begin, @p end], both braces included
+    virtual BlockStmt *materializeBody(uint32_t begin, uint32_t end) = 0;
+};
+
+/// A function body that is either parsed, absent, or a token range parsed on first access
+/// @note materialization is not thread safe, the materializer must outlive the body
+class DeferredBody {
+  public:
+    DeferredBody(BlockStmt *body = nullptr) : body(body) {}
+    DeferredBody(BodyMaterializer *source, uint32_t begin, uint32_t end)
+        : source(source), begin(begin), end(end) {}
+
+    /// @returns the body, parsing it if it was deferred
+    BlockStmt *get() {
+        if (source) {
+            body = source->materializeBody(begin, end);
+            source = nullptr;
+        }
+        return body;
+    }
+
+    [[nodiscard]] bool hasBody() const { return body || source; }
+    [[nodiscard]] bool isDeferred() const { return source; }
+
+  private:
+    BlockStmt *body = nullptr;
+    BodyMaterializer *source = nullptr;
+    uint32_t begin = 0;
+    uint32_t end = 0;
+};
+
+}
+
+#endif //REFLEX_SRC_AST_DEFERREDBODY_H_
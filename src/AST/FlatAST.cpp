@@ -0,0 +1,525 @@
+//
+// Created by henry on 2022-05-23.
+//
+
+#include "FlatAST.h"
+
+#include "ASTDeclaration.h"
+#include "ASTExpression.h"
+#include "ASTLiteral.h"
+#include "ASTStatement.h"
+#include "ASTType.h"
+#include "ASTVisitor.h"
+
+#include <type_traits>
+
+namespace reflex {
+
+std::string getFlatKindString(FlatKind kind) {
+    switch (kind) {
+        case FlatKind::Null: return "Null";
+        case FlatKind::CompilationUnit: return "CompilationUnit";
+        case FlatKind::ClassDecl: return "ClassDecl";
+        case FlatKind::InterfaceDecl: return "InterfaceDecl";
+        case FlatKind::VariableDecl: return "VariableDecl";
+        case FlatKind::FieldDecl: return "FieldDecl";
+        case FlatKind::ParamDecl: return "ParamDecl";
+        case FlatKind::FunctionDecl: return "FunctionDecl";
+        case FlatKind::MethodDecl: return "MethodDecl";
+        case FlatKind::BlockStmt: return "BlockStmt";
+        case FlatKind::DeclStmt: return "DeclStmt";
+        case FlatKind::ReturnStmt: return "ReturnStmt";
+        case FlatKind::BreakStmt: return "BreakStmt";
+        case FlatKind::ContinueStmt: return "ContinueStmt";
+        case FlatKind::IfStmt: return "IfStmt";
+        case FlatKind::ForStmt: return "ForStmt";
+        case FlatKind::ForRangeClause: return "ForRangeClause";
+        case FlatKind::ForNormalClause: return "ForNormalClause";
+        case FlatKind::WhileStmt: return "WhileStmt";
+        case FlatKind::EmptyStmt: return "EmptyStmt";
+        case FlatKind::AssignmentStmt: return "AssignmentStmt";
+        case FlatKind::IncDecStmt: return "IncDecStmt";
+        case FlatKind::ExpressionStmt: return "ExpressionStmt";
+        case FlatKind::Identifier: return "Identifier";
+        case FlatKind::ModuleSelector: return "ModuleSelector";
+        case FlatKind::UnaryExpr: return "UnaryExpr";
+        case FlatKind::BinaryExpr: return "BinaryExpr";
+        case FlatKind::NewExpr: return "NewExpr";
+        case FlatKind::ImplicitCastExpr: return "ImplicitCastExpr";
+        case FlatKind::CastExpr: return "CastExpr";
+        case FlatKind::IndexExpr: return "IndexExpr";
+        case FlatKind::SelectorExpr: return "SelectorExpr";
+        case FlatKind::ArgumentExpr: return "ArgumentExpr";
+        case FlatKind::NumberLiteral: return "NumberLiteral";
+        case FlatKind::StringLiteral: return "StringLiteral";
+        case FlatKind::BooleanLiteral: return "BooleanLiteral";
+        case FlatKind::NullLiteral: return "NullLiteral";
+        case FlatKind::ArrayLiteral: return "ArrayLiteral";
+        case FlatKind::FunctionLiteral: return "FunctionLiteral";
+        case FlatKind::BaseTypenameExpr: return "BaseTypenameExpr";
+        case FlatKind::QualifiedTypenameExpr: return "QualifiedTypenameExpr";
+        case FlatKind::ArrayTypeExpr: return "ArrayTypeExpr";
+        case FlatKind::FunctionTypeExpr: return "FunctionTypeExpr";
+    }
+    return "Unknown";
+}
+
+/// Lowers a pointer AST in pre-order, a node row is reserved before its children are lowered
+/// and its operands are filled in afterwards
+class FlatASTBuilder : public ASTDeclVisitor<FlatASTBuilder, FlatAST::NodeID>,
+                       public ASTStmtVisitor<FlatASTBuilder, FlatAST::NodeID>,
+                       public ASTExprVisitor<FlatASTBuilder, FlatAST::NodeID> {
+    using NodeID = FlatAST::NodeID;
+  public:
+    using ASTDeclVisitor::visit;
+    using ASTStmtVisitor::visit;
+    using ASTExprVisitor::visit;
+
+    explicit FlatASTBuilder(FlatAST &ast) : ast(ast) {
+        add(FlatKind::Null, nullptr);
+    }
+
+    NodeID lower(Declaration *decl) { return decl ? visit(decl) : FlatAST::NullNode; }
+    NodeID lower(Statement *stmt) { return stmt ? visit(stmt) : FlatAST::NullNode; }
+    NodeID lower(Expression *expr) { return expr ? visit(expr) : FlatAST::NullNode; }
+
+    NodeID lower(ASTTypeExpr *type) {
+        if (!type) return FlatAST::NullNode;
+        switch (type->getKind()) {
+            case ASTKind::BaseTypenameExpr: {
+                auto base = cast<BaseTypenameExpr>(type);
+                return add(FlatKind::BaseTypenameExpr, base->location(), 0, {base->getTypeSymbol().getID(), 0});
+            }
+            case ASTKind::QualifiedTypenameExpr: {
+                auto qualified = cast<QualifiedTypenameExpr>(type);
+                auto node = add(FlatKind::QualifiedTypenameExpr, qualified->location());
+                set(node, {qualified->getNameSymbol().getID(), lower(qualified->getPrefix())});
+                return node;
+            }
+            case ASTKind::ArrayTypeExpr: {
+                auto array = cast<ArrayTypeExpr>(type);
+                auto node = add(FlatKind::ArrayTypeExpr, array->location());
+                auto element = lower(array->getElementType());
+                set(node, {element, lower(static_cast<Expression *>(array->getSize()))});
+                return node;
+            }
+            default: {
+                auto function = cast<FunctionTypeExpr>(type);
+                auto node = add(FlatKind::FunctionTypeExpr, function->location());
+                auto returnType = lower(function->getReturnType());
+                set(node, {returnType, addList(lowerAll(function->getParamTypes()))});
+                return node;
+            }
+        }
+    }
+
+    NodeID lower(ForClause *clause) {
+        if (!clause) return FlatAST::NullNode;
+        if (auto range = dyn_cast<ForRangeClause>(clause)) {
+            auto node = add(FlatKind::ForRangeClause, range->location());
+            auto variable = lower(static_cast<Declaration *>(range->getVariable()));
+            set(node, {variable, lower(range->getIterExpr())});
+            return node;
+        }
+        auto normal = cast<ForNormalClause>(clause);
+        auto node = add(FlatKind::ForNormalClause, normal->location());
+        auto init = lower(normal->getInit());
+        auto cond = lower(normal->getCond());
+        auto post = lower(static_cast<Statement *>(normal->getPost()));
+        set(node, {addRecord({init, cond, post}), 0});
+        return node;
+    }
+
+    NodeID visit(CompilationUnit &unit) {
+        auto node = add(FlatKind::CompilationUnit, unit.location());
+        set(node, {unit.getDeclSymbol().getID(), addList(lowerAll(unit.getDecls()))});
+        return node;
+    }
+
+    NodeID visit(ClassDecl &decl) {
+        auto node = add(FlatKind::ClassDecl, decl.location(), static_cast<uint8_t>(decl.getVisibility()));
+        auto baseclass = lower(static_cast<ASTTypeExpr *>(decl.getBaseclass()));
+        auto interfaces = addList(lowerAll(decl.getInterfaces()));
+        auto members = lowerAll(decl.getDecls());
+        lowerAll(decl.getFields(), members);
+        lowerAll(decl.getMethods(), members);
+        set(node, {decl.getDeclSymbol().getID(), addRecord({baseclass, interfaces}, members)});
+        return node;
+    }
+
+    NodeID visit(InterfaceDecl &decl) {
+        auto node = add(FlatKind::InterfaceDecl, decl.location(), static_cast<uint8_t>(decl.getVisibility()));
+        auto interfaces = addList(lowerAll(decl.getInterfaces()));
+        auto members = lowerAll(decl.getDecls());
+        lowerAll(decl.getMethods(), members);
+        set(node, {decl.getDeclSymbol().getID(), addRecord({interfaces}, members)});
+        return node;
+    }
+
+    NodeID visit(VariableDecl &decl) {
+        return lowerVariable(FlatKind::VariableDecl, decl, decl.isGlobalVariable());
+    }
+
+    NodeID visit(FieldDecl &decl) {
+        return lowerVariable(FlatKind::FieldDecl, decl, static_cast<uint8_t>(decl.getVisibility()));
+    }
+
+    NodeID visit(ParamDecl &decl) {
+        return lowerVariable(FlatKind::ParamDecl, decl, 0);
+    }
+
+    NodeID visit(FunctionDecl &decl) {
+        return lowerFunction(FlatKind::FunctionDecl, decl, 0);
+    }
+
+    NodeID visit(MethodDecl &decl) {
+        return lowerFunction(FlatKind::MethodDecl, decl, static_cast<uint8_t>(decl.getVisibility()));
+    }
+
+    NodeID visit(BlockStmt &stmt) {
+        auto node = add(FlatKind::BlockStmt, stmt.location());
+        set(node, {addList(lowerAll(stmt.getStmts())), 0});
+        return node;
+    }
+
+    NodeID visit(DeclStmt &stmt) {
+        auto node = add(FlatKind::DeclStmt, stmt.location());
+        set(node, {lower(stmt.getDecl()), 0});
+        return node;
+    }
+
+    NodeID visit(ReturnStmt &stmt) {
+        auto node = add(FlatKind::ReturnStmt, stmt.location());
+        set(node, {lower(stmt.getReturnValue()), 0});
+        return node;
+    }
+
+    NodeID visit(BreakStmt &stmt) {
+        return add(FlatKind::BreakStmt, stmt.location());
+    }
+
+    NodeID visit(ContinueStmt &stmt) {
+        return add(FlatKind::ContinueStmt, stmt.location());
+    }
+
+    NodeID visit(IfStmt &stmt) {
+        auto node = add(FlatKind::IfStmt, stmt.location());
+        auto cond = lower(static_cast<Statement *>(stmt.getCond()));
+        auto primary = lower(static_cast<Statement *>(stmt.getPrimaryBlock()));
+        auto alternative = lower(static_cast<Statement *>(stmt.getElseBlock()));
+        set(node, {cond, addRecord({primary, alternative})});
+        return node;
+    }
+
+    NodeID visit(ForStmt &stmt) {
+        auto node = add(FlatKind::ForStmt, stmt.location());
+        auto clause = lower(stmt.getClause());
+        set(node, {clause, lower(static_cast<Statement *>(stmt.getBody()))});
+        return node;
+    }
+
+    NodeID visit(WhileStmt &stmt) {
+        auto node = add(FlatKind::WhileStmt, stmt.location());
+        auto cond = lower(static_cast<Statement *>(stmt.getCond()));
+        set(node, {cond, lower(static_cast<Statement *>(stmt.getBody()))});
+        return node;
+    }
+
+    NodeID visit(EmptyStmt &stmt) {
+        return add(FlatKind::EmptyStmt, stmt.location());
+    }
+
+    NodeID visit(AssignmentStmt &stmt) {
+        auto node = add(FlatKind::AssignmentStmt, stmt.location(), static_cast<uint8_t>(stmt.getAssignOp()));
+        auto lhs = lower(stmt.getLhs());
+        set(node, {lhs, lower(stmt.getRhs())});
+        return node;
+    }
+
+    NodeID visit(IncDecStmt &stmt) {
+        auto node = add(FlatKind::IncDecStmt, stmt.location(), static_cast<uint8_t>(stmt.getPostfixOp()));
+        set(node, {lower(stmt.getExpr()), 0});
+        return node;
+    }
+
+    NodeID visit(ExpressionStmt &stmt) {
+        auto node = add(FlatKind::ExpressionStmt, stmt.location());
+        set(node, {lower(stmt.getExpr()), 0});
+        return node;
+    }
+
+    NodeID visit(DeclRefExpr &expr) {
+        if (auto selector = dyn_cast<ModuleSelector>(&expr)) {
+            auto node = add(FlatKind::ModuleSelector, expr.location());
+            set(node, {selector->getPrefix().getID(), lower(static_cast<Expression *>(selector->getChild()))});
+            return node;
+        }
+        return add(FlatKind::Identifier, expr.location(), 0, {expr.getReferenceSymbol().getID(), 0});
+    }
+
+    NodeID visit(UnaryExpr &expr) {
+        auto node = add(FlatKind::UnaryExpr, expr.location(), static_cast<uint8_t>(expr.getUnaryOp()));
+        set(node, {lower(expr.getExpr()), 0});
+        return node;
+    }
+
+    NodeID visit(BinaryExpr &expr) {
+        auto node = add(FlatKind::BinaryExpr, expr.location(), static_cast<uint8_t>(expr.getBinaryOp()));
+        auto lhs = lower(expr.getLhs());
+        set(node, {lhs, lower(expr.getRhs())});
+        return node;
+    }
+
+    NodeID visit(NewExpr &expr) {
+        auto node = add(FlatKind::NewExpr, expr.location());
+        set(node, {lower(expr.getInstanceType()), 0});
+        return node;
+    }
+
+    NodeID visit(ImplicitCastExpr &expr) {
+        auto node = add(FlatKind::ImplicitCastExpr, expr.location(), static_cast<uint8_t>(expr.getConversion()));
+        set(node, {lower(expr.getFrom()), 0});
+        return node;
+    }
+
+    NodeID visit(CastExpr &expr) {
+        auto node = add(FlatKind::CastExpr, expr.location());
+        auto type = lower(expr.getResultType());
+        set(node, {type, lower(expr.getFrom())});
+        return node;
+    }
+
+    NodeID visit(IndexExpr &expr) {
+        auto node = add(FlatKind::IndexExpr, expr.location());
+        auto base = lower(expr.getBaseExpr());
+        set(node, {base, lower(expr.getIndex())});
+        return node;
+    }
+
+    NodeID visit(SelectorExpr &expr) {
+        auto node = add(FlatKind::SelectorExpr, expr.location());
+        set(node, {lower(expr.getBaseExpr()), expr.getSelectorSymbol().getID()});
+        return node;
+    }
+
+    NodeID visit(ArgumentExpr &expr) {
+        auto node = add(FlatKind::ArgumentExpr, expr.location());
+        auto base = lower(expr.getBaseExpr());
+        set(node, {base, addList(lowerAll(expr.getArguments()))});
+        return node;
+    }
+
+    NodeID visit(NumberLiteral &literal) {
+        return add(FlatKind::NumberLiteral, literal.location(), 0, {Symbol(literal.getLiteral()).getID(), 0});
+    }
+
+    NodeID visit(StringLiteral &literal) {
+        return add(FlatKind::StringLiteral, literal.location(), 0, {Symbol(literal.getLiteral()).getID(), 0});
+    }
+
+    NodeID visit(BooleanLiteral &literal) {
+        return add(FlatKind::BooleanLiteral, literal.location(), 0, {Symbol(literal.getLiteral()).getID(), 0});
+    }
+
+    NodeID visit(NullLiteral &literal) {
+        return add(FlatKind::NullLiteral, literal.location(), 0, {Symbol(literal.getLiteral()).getID(), 0});
+    }
+
+    NodeID visit(ArrayLiteral &literal) {
+        auto node = add(FlatKind::ArrayLiteral, literal.location());
+        set(node, {addList(lowerAll(literal.getInitList())), 0});
+        return node;
+    }
+
+    NodeID visit(FunctionLiteral &literal) {
+        auto node = add(FlatKind::FunctionLiteral, literal.location());
+        auto params = lowerAll(literal.getParamDecls());
+        auto returnType = lower(literal.getReturnType());
+        auto body = lower(static_cast<Statement *>(literal.getBody()));
+        set(node, {returnType, addRecord({body}, params)});
+        return node;
+    }
+
+  private:
+    NodeID add(FlatKind kind, SourceLocation loc, uint8_t op = 0, FlatAST::Operands operands = {}) {
+        auto node = static_cast<NodeID>(ast.kinds.size());
+        ast.kinds.push_back(kind);
+        ast.operators.push_back(op);
+        ast.locations.push_back(loc);
+        ast.operands.push_back(operands);
+        return node;
+    }
+
+    void set(NodeID node, FlatAST::Operands operands) {
+        ast.operands[node] = operands;
+    }
+
+    // Nodes is a std::vector or an ASTList of node pointers
+    template<class Nodes>
+    void lowerAll(const Nodes &nodes, std::vector<NodeID> &ids) {
+        ids.reserve(ids.size() + nodes.size());
+        for (auto node: nodes) ids.push_back(lowerBase(node));
+    }
+
+    template<class Nodes>
+    std::vector<NodeID> lowerAll(const Nodes &nodes) {
+        std::vector<NodeID> ids;
+        lowerAll(nodes, ids);
+        return ids;
+    }
+
+    // resolve the overload of lower for the most derived root of Node
+    template<class Node>
+    NodeID lowerBase(Node *node) {
+        if constexpr (std::is_base_of_v<Declaration, Node>) return lower(static_cast<Declaration *>(node));
+        else if constexpr (std::is_base_of_v<Statement, Node>) return lower(static_cast<Statement *>(node));
+        else if constexpr (std::is_base_of_v<Expression, Node>) return lower(static_cast<Expression *>(node));
+        else return lower(static_cast<ASTTypeExpr *>(node));
+    }
+
+    /// @returns the offset of a record of @p fields followed by the list @p list
+    uint32_t addRecord(std::initializer_list<uint32_t> fields, const std::vector<NodeID> &list) {
+        auto offset = static_cast<uint32_t>(ast.extra.size());
+        ast.extra.insert(ast.extra.end(), fields);
+        ast.extra.push_back(static_cast<uint32_t>(list.size()));
+        ast.extra.insert(ast.extra.end(), list.begin(), list.end());
+        return offset;
+    }
+
+    uint32_t addRecord(std::initializer_list<uint32_t> fields) {
+        auto offset = static_cast<uint32_t>(ast.extra.size());
+        ast.extra.insert(ast.extra.end(), fields);
+        return offset;
+    }
+
+    uint32_t addList(const std::vector<NodeID> &list) { return addRecord({}, list); }
+
+    NodeID lowerVariable(FlatKind kind, VariableDecl &decl, uint8_t op) {
+        auto node = add(kind, decl.location(), op);
+        auto type = lower(decl.getTypeDecl());
+        auto initializer = lower(decl.getInitializer());
+        set(node, {decl.getDeclSymbol().getID(), addRecord({type, initializer})});
+        return node;
+    }
+
+    NodeID lowerFunction(FlatKind kind, FunctionDecl &decl, uint8_t op) {
+        auto node = add(kind, decl.location(), op);
+        auto params = lowerAll(decl.getParamDecls());
+        auto returnType = lower(decl.getReturnTypeDecl());
+        auto body = lower(static_cast<Statement *>(decl.getBody()));
+        set(node, {decl.getDeclSymbol().getID(), addRecord({returnType, body}, params)});
+        return node;
+    }
+
+    FlatAST &ast;
+};
+
+FlatAST::FlatAST(CompilationUnit &unit) {
+    FlatASTBuilder builder(*this);
+    builder.visit(unit);
+}
+
+Symbol FlatAST::getSymbol(NodeID node) const {
+    switch (kinds[node]) {
+        case FlatKind::SelectorExpr: return Symbol::fromID(operands[node].rhs);
+        case FlatKind::CompilationUnit:
+        case FlatKind::ClassDecl:
+        case FlatKind::InterfaceDecl:
+        case FlatKind::VariableDecl:
+        case FlatKind::FieldDecl:
+        case FlatKind::ParamDecl:
+        case FlatKind::FunctionDecl:
+        case FlatKind::MethodDecl:
+        case FlatKind::Identifier:
+        case FlatKind::ModuleSelector:
+        case FlatKind::NumberLiteral:
+        case FlatKind::StringLiteral:
+        case FlatKind::BooleanLiteral:
+        case FlatKind::NullLiteral:
+        case FlatKind::BaseTypenameExpr:
+        case FlatKind::QualifiedTypenameExpr: return Symbol::fromID(operands[node].lhs);
+        default: return {};
+    }
+}
+
+void FlatAST::getChildren(NodeID node, std::vector<NodeID> &children) const {
+    auto [lhs, rhs] = operands[node];
+    auto push = [&](NodeID child) { if (child != NullNode) children.push_back(child); };
+    auto pushList = [&](uint32_t offset) { for (auto child: getList(offset)) push(child); };
+    switch (kinds[node]) {
+        case FlatKind::CompilationUnit: pushList(rhs); break;
+        case FlatKind::ClassDecl:
+            push(extra[rhs]);
+            pushList(extra[rhs + 1]);
+            pushList(rhs + 2);
+            break;
+        case FlatKind::InterfaceDecl:
+            pushList(extra[rhs]);
+            pushList(rhs + 1);
+            break;
+        case FlatKind::VariableDecl:
+        case FlatKind::FieldDecl:
+        case FlatKind::ParamDecl:
+            push(extra[rhs]);
+            push(extra[rhs + 1]);
+            break;
+        case FlatKind::FunctionDecl:
+        case FlatKind::MethodDecl:
+            pushList(rhs + 2);
+            push(extra[rhs]);
+            push(extra[rhs + 1]);
+            break;
+        case FlatKind::BlockStmt:
+        case FlatKind::ArrayLiteral: pushList(lhs); break;
+        case FlatKind::IfStmt:
+            push(lhs);
+            push(extra[rhs]);
+            push(extra[rhs + 1]);
+            break;
+        case FlatKind::ForNormalClause:
+            push(extra[lhs]);
+            push(extra[lhs + 1]);
+            push(extra[lhs + 2]);
+            break;
+        case FlatKind::ModuleSelector:
+        case FlatKind::QualifiedTypenameExpr: push(rhs); break;
+        case FlatKind::ArgumentExpr:
+        case FlatKind::FunctionTypeExpr:
+            push(lhs);
+            pushList(rhs);
+            break;
+        case FlatKind::FunctionLiteral:
+            pushList(rhs + 1);
+            push(lhs);
+            push(extra[rhs]);
+            break;
+        case FlatKind::DeclStmt:
+        case FlatKind::ReturnStmt:
+        case FlatKind::IncDecStmt:
+        case FlatKind::ExpressionStmt:
+        case FlatKind::UnaryExpr:
+        case FlatKind::NewExpr:
+        case FlatKind::ImplicitCastExpr:
+        case FlatKind::SelectorExpr: push(lhs); break;
+        case FlatKind::ForStmt:
+        case FlatKind::ForRangeClause:
+        case FlatKind::WhileStmt:
+        case FlatKind::AssignmentStmt:
+        case FlatKind::BinaryExpr:
+        case FlatKind::CastExpr:
+        case FlatKind::IndexExpr:
+        case FlatKind::ArrayTypeExpr:
+            push(lhs);
+            push(rhs);
+            break;
+        default: break;
+    }
+}
+
+size_t FlatAST::getMemoryFootprint() const {
+    return kinds.capacity() * sizeof(FlatKind) + operators.capacity() * sizeof(uint8_t)
+        + locations.capacity() * sizeof(SourceLocation) + operands.capacity() * sizeof(Operands)
+        + extra.capacity() * sizeof(uint32_t);
+}
+
+}
@@ -0,0 +1,165 @@
+//
+// Created by henry on 2022-05-23.
+//
+
+#ifndef REFLEX_SRC_AST_FLATAST_H_
+#define REFLEX_SRC_AST_FLATAST_H_
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "SourceLocation.h"
+#include "StringInterner.h"
+
+namespace reflex {
+
+class CompilationUnit;
+
+enum class FlatKind : uint8_t {
+  Null,
+
+  CompilationUnit,
+  ClassDecl,
+  InterfaceDecl,
+  VariableDecl,
+  FieldDecl,
+  ParamDecl,
+  FunctionDecl,
+  MethodDecl,
+
+  BlockStmt,
+  DeclStmt,
+  ReturnStmt,
+  BreakStmt,
+  ContinueStmt,
+  IfStmt,
+  ForStmt,
+  ForRangeClause,
+  ForNormalClause,
+  WhileStmt,
+  EmptyStmt,
+  AssignmentStmt,
+  IncDecStmt,
+  ExpressionStmt,
+
+  Identifier,
+  ModuleSelector,
+  UnaryExpr,
+  BinaryExpr,
+  NewExpr,
+  ImplicitCastExpr,
+  CastExpr,
+  IndexExpr,
+  SelectorExpr,
+  ArgumentExpr,
+  NumberLiteral,
+  StringLiteral,
+  BooleanLiteral,
+  NullLiteral,
+  ArrayLiteral,
+  FunctionLiteral,
+
+  BaseTypenameExpr,
+  QualifiedTypenameExpr,
+  ArrayTypeExpr,
+  FunctionTypeExpr,
+};
+
+std::string getFlatKindString(FlatKind kind);
+
+/// Data oriented copy of a pointer AST, every node is a row in a structure of arrays
+/// - nodes are numbered in pre-order with 32-bit ids, a linear scan over the rows visits
+///   the program in source order, id 0 is the null node
+/// - a node has two 32-bit operands, lhs and rhs, interpreted by its kind (see below)
+/// - child lists and nodes with more than two operands store their operands in a shared
+///   extra array, a list is a count followed by that many node ids
+///
+///   kind                        op              lhs             rhs
+///   CompilationUnit                             name            list of decls
+///   ClassDecl                   visibility      name            extra [baseclass, list of interfaces, members...]
+///   InterfaceDecl               visibility      name            extra [list of interfaces, members...]
+///   Variable/Field/ParamDecl    global/visib.   name            extra [type, initializer]
+///   Function/MethodDecl         visibility      name            extra [return type, body, params...]
+///   BlockStmt                                   list of stmts
+///   DeclStmt, ReturnStmt                        decl, value
+///   IfStmt                                      cond            extra [primary block, else block]
+///   ForStmt, WhileStmt                          clause, cond    body
+///   ForRangeClause                              variable        iter expr
+///   ForNormalClause                             extra [init, cond, post]
+///   AssignmentStmt              assign op       lhs             rhs
+///   IncDecStmt                  postfix op      expr
+///   ExpressionStmt                              expr
+///   Identifier                                  name
+///   ModuleSelector                              prefix          child
+///   UnaryExpr                   unary op        expr
+///   BinaryExpr                  binary op       lhs             rhs
+///   NewExpr                                     type
+///   ImplicitCastExpr            conversion      from
+///   CastExpr                                    type            from
+///   IndexExpr                                   base            index
+///   SelectorExpr                                base            selector
+///   ArgumentExpr                                base            list of arguments
+///   Number/String/Bool/NullLit.                 literal
+///   ArrayLiteral                                list of elements
+///   FunctionLiteral                             return type     extra [body, params...]
+///   BaseTypenameExpr                            name
+///   QualifiedTypenameExpr                       name            prefix
+///   ArrayTypeExpr                               element type    size
+///   FunctionTypeExpr                            return type     list of param types
+///
+/// "members..." and "params..." are a list placed at the end of the extra record
+/// @note names, selectors and literals are stored as Symbol ids
+class FlatAST {
+  public:
+    using NodeID = uint32_t;
+    static constexpr NodeID NullNode = 0;
+
+    struct Operands {
+      uint32_t lhs;
+      uint32_t rhs;
+    };
+
+    /// Lower the pointer AST rooted at @p unit
+    explicit FlatAST(CompilationUnit &unit);
+
+    [[nodiscard]] NodeID getRoot() const { return 1; }
+    /// @returns the number of nodes including the null node
+    [[nodiscard]] size_t size() const { return kinds.size(); }
+
+    [[nodiscard]] FlatKind getKind(NodeID node) const { return kinds[node]; }
+    [[nodiscard]] uint8_t getOperator(NodeID node) const { return operators[node]; }
+    [[nodiscard]] SourceLocation getLocation(NodeID node) const { return locations[node]; }
+    [[nodiscard]] Operands getOperands(NodeID node) const { return operands[node]; }
+    [[nodiscard]] const std::vector<FlatKind> &getKinds() const { return kinds; }
+
+    /// @returns the operand at @p offset of the extra array
+    [[nodiscard]] uint32_t getExtra(uint32_t offset) const { return extra[offset]; }
+    /// @returns the list stored at @p offset of the extra array
+    [[nodiscard]] std::span<const NodeID> getList(uint32_t offset) const {
+        return {extra.data() + offset + 1, extra[offset]};
+    }
+
+    /// @returns the name, selector or literal of @p node
+    [[nodiscard]] Symbol getSymbol(NodeID node) const;
+
+    /// Append the children of @p node to @p children in source order, null children are skipped
+    void getChildren(NodeID node, std::vector<NodeID> &children) const;
+
+    /// @returns the bytes held by the node rows and the extra array
+    [[nodiscard]] size_t getMemoryFootprint() const;
+
+  private:
+    friend class FlatASTBuilder;
+
+    std::vector<FlatKind> kinds;
+    std::vector<uint8_t> operators;
+    std::vector<SourceLocation> locations;
+    std::vector<Operands> operands;
+    std::vector<uint32_t> extra;
+};
+
+}
+
+#endif //REFLEX_SRC_AST_FLATAST_H_
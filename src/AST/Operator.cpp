@@ -6,25 +6,19 @@
 
 namespace reflex::Operator {
 
+// the operator fields of TokenInfoTable hold these enumerators
+static_assert(getTokenInfo(TokenType::Or).binaryOp == static_cast<uint8_t>(BinaryOperator::Or));
+static_assert(getTokenInfo(TokenType::RAngleBracket).binaryOp == static_cast<uint8_t>(BinaryOperator::Greater));
+static_assert(getTokenInfo(TokenType::LogicalAnd).binaryOp == static_cast<uint8_t>(BinaryOperator::LogicalAnd));
+static_assert(getTokenInfo(TokenType::Sub).op == static_cast<uint8_t>(UnaryOperator::Negative));
+static_assert(getTokenInfo(TokenType::LogicalNot).op == static_cast<uint8_t>(UnaryOperator::LogicalNot));
+static_assert(getTokenInfo(TokenType::AssignSub).op == static_cast<uint8_t>(AssignOperator::SubEqual));
+static_assert(getTokenInfo(TokenType::PostDec).op == static_cast<uint8_t>(PostfixOperator::PostfixDec));
+
 BinaryOperator createBinaryOperatorFromToken(const Token &token) {
-    switch (token.getTokenType().getValue()) {
-        case TokenType::Or: return BinaryOperator::Or;
-        case TokenType::And: return BinaryOperator::And;
-        case TokenType::Compare: return BinaryOperator::Compare;
-        case TokenType::CompareNot: return BinaryOperator::CompareNot;
-        case TokenType::LAngleBracket: return BinaryOperator::Less;
-        case TokenType::RAngleBracket: return BinaryOperator::Greater;
-        case TokenType::CompareLessEqual: return BinaryOperator::CompareLessThanEqual;
-        case TokenType::CompareGreaterEqual: return BinaryOperator::CompareGreaterThanEqual;
-        case TokenType::Add: return BinaryOperator::Add;
-        case TokenType::Sub: return BinaryOperator::Sub;
-        case TokenType::LogicalOr: return BinaryOperator::LogicalOr;
-        case TokenType::Star: return BinaryOperator::Mult;
-        case TokenType::Div: return BinaryOperator::Div;
-        case TokenType::Mod: return BinaryOperator::Mod;
-        case TokenType::LogicalAnd: return BinaryOperator::LogicalAnd;
-        default: throw InvalidOperator("Invalid binary operator.");
-    }
+    auto &info = token.getTokenInfo();
+    if (!info.is(TokenInfo::BinaryOp)) throw InvalidOperator("Invalid binary operator.");
+    return static_cast<BinaryOperator>(info.binaryOp);
 }
 
 std::string getBinaryOperator(BinaryOperator op) {
@@ -48,11 +42,9 @@ std::string getBinaryOperator(BinaryOperator op) {
 }
 
 UnaryOperator createUnaryOperatorFromToken(const Token &tok) {
-    switch (tok.getTokenType().getValue()) {
-        case TokenType::LogicalNot: return UnaryOperator::LogicalNot;
-        case TokenType::Sub: return UnaryOperator::Negative;
-        default: throw InvalidOperator("Invalid unary operator.");
-    }
+    auto &info = tok.getTokenInfo();
+    if (!info.is(TokenInfo::UnaryOp)) throw InvalidOperator("Invalid unary operator.");
+    return static_cast<UnaryOperator>(info.op);
 }
 
 std::string getUnaryOperator(UnaryOperator op) {
@@ -63,12 +55,9 @@ std::string getUnaryOperator(UnaryOperator op) {
 }
 
 AssignOperator createAssignOperatorFromToken(const Token &tok) {
-    switch (tok.getTokenType().getValue()) {
-        case TokenType::Assign: return AssignOperator::Equal;
-        case TokenType::AssignAdd: return AssignOperator::AddEqual;
-        case TokenType::AssignSub: return AssignOperator::SubEqual;
-        default: throw InvalidOperator("Invalid assignment operator.");
-    }
+    auto &info = tok.getTokenInfo();
+    if (!info.is(TokenInfo::Assignment)) throw InvalidOperator("Invalid assignment operator.");
+    return static_cast<AssignOperator>(info.op);
 }
 
 std::string getAssignOperator(AssignOperator op) {
@@ -81,11 +70,9 @@ std::string getAssignOperator(AssignOperator op) {
 }
 
 PostfixOperator createPostfixOperatorFromToken(const Token &tok) {
-    switch (tok.getTokenType().getValue()) {
-        case TokenType::PostInc: return PostfixOperator::PostfixInc;
-        case TokenType::PostDec: return PostfixOperator::PostfixDec;
-        default: throw InvalidOperator("Invalid postfix operator.");
-    }
+    auto &info = tok.getTokenInfo();
+    if (!info.is(TokenInfo::PostfixOp)) throw InvalidOperator("Invalid postfix operator.");
+    return static_cast<PostfixOperator>(info.op);
 }
 
 std::string getPostfixOperator(PostfixOperator op) {
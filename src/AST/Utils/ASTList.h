@@ -0,0 +1,68 @@
+//
+// Created by henry on 2022-05-29.
+//
+
+#ifndef REFLEX_SRC_AST_UTILS_ASTLIST_H_
+#define REFLEX_SRC_AST_UTILS_ASTLIST_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace reflex {
+
+/// Fixed size list of the child nodes of an AST node, sized once when the node is created
+/// - up to InlineCapacity elements are stored inside the list itself, two keep the list as small as
+///   the header of a std::vector
+/// - longer lists refer to storage owned by someone else, ASTContext::createList puts it in the AST arena
+/// @note elements can be replaced but not added or removed
+template<class T>
+class ASTList {
+    static_assert(std::is_trivially_copyable_v<T>, "ASTList: copies of a list copy the inline elements");
+
+  public:
+    static constexpr size_t InlineCapacity = 2;
+
+    ASTList() = default;
+
+    /// Copies @p count elements of @p elements inline if they fit, otherwise refers to @p elements
+    ASTList(T *elements, size_t count) : count(static_cast<uint32_t>(count)) {
+        assert(count <= UINT32_MAX && "ASTList: too many elements");
+        if (isInline()) {
+            std::copy_n(elements, count, storage.inlined);
+        } else {
+            storage.outline = elements;
+        }
+    }
+
+    [[nodiscard]] size_t size() const { return count; }
+    [[nodiscard]] bool empty() const { return count == 0; }
+
+    T *data() { return isInline() ? storage.inlined : storage.outline; }
+    const T *data() const { return isInline() ? storage.inlined : storage.outline; }
+
+    T *begin() { return data(); }
+    T *end() { return data() + count; }
+    const T *begin() const { return data(); }
+    const T *end() const { return data() + count; }
+
+    T &operator[](size_t index) { return data()[index]; }
+    const T &operator[](size_t index) const { return data()[index]; }
+    const T &front() const { return data()[0]; }
+    const T &back() const { return data()[count - 1]; }
+
+  private:
+    [[nodiscard]] bool isInline() const { return count <= InlineCapacity; }
+
+    union Storage {
+      T inlined[InlineCapacity];
+      T *outline;
+    } storage{};
+    uint32_t count = 0;
+};
+
+}
+
+#endif //REFLEX_SRC_AST_UTILS_ASTLIST_H_
@@ -0,0 +1,86 @@
+//
+// Created by henry on 2022-05-22.
+//
+
+#ifndef REFLEX_SRC_AST_UTILS_ARENA_H_
+#define REFLEX_SRC_AST_UTILS_ARENA_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <vector>
+
+namespace reflex {
+
+/// Bump pointer allocator over geometrically growing slabs
+/// - allocation is a pointer increment, memory is only released when the arena is destroyed
+/// - allocations larger than half a slab get a slab of their own, so the current slab is not wasted
+/// - objects are not destroyed by the arena, owners register destructors themselves if needed
+class BumpArena {
+  public:
+    static constexpr size_t InitialSlabSize = size_t{64} << 10;
+    static constexpr size_t MaxSlabSize = size_t{16} << 20;
+
+    BumpArena() = default;
+    BumpArena(const BumpArena &) = delete;
+    BumpArena(BumpArena &&other) noexcept
+        : slabs(std::move(other.slabs)), current(other.current), end(other.end),
+          nextSlabSize(other.nextSlabSize), bytesAllocated(other.bytesAllocated) {
+        other.current = other.end = nullptr;
+        other.nextSlabSize = InitialSlabSize;
+        other.bytesAllocated = 0;
+    }
+    BumpArena &operator=(const BumpArena &) = delete;
+    BumpArena &operator=(BumpArena &&) = delete;
+
+    /// @returns uninitialized storage of @p size bytes aligned to @p align
+    /// @note @p align must be a power of two no larger than alignof(std::max_align_t)
+    void *allocate(size_t size, size_t align) {
+        auto aligned = (reinterpret_cast<uintptr_t>(current) + align - 1) & ~(uintptr_t{align} - 1);
+        if (current && aligned + size <= reinterpret_cast<uintptr_t>(end)) {
+            current = reinterpret_cast<std::byte *>(aligned + size);
+            bytesAllocated += size;
+            return reinterpret_cast<void *>(aligned);
+        }
+        return allocateSlow(size, align);
+    }
+
+    /// @returns uninitialized storage for @p count objects of type T
+    template<class T>
+    T *allocate(size_t count = 1) {
+        static_assert(alignof(T) <= alignof(std::max_align_t), "BumpArena: over-aligned types are not supported");
+        return static_cast<T *>(allocate(sizeof(T) * count, alignof(T)));
+    }
+
+    /// @returns bytes handed out by allocate, excluding alignment padding and slab slack
+    [[nodiscard]] size_t getBytesAllocated() const { return bytesAllocated; }
+    [[nodiscard]] size_t getSlabCount() const { return slabs.size(); }
+
+  private:
+    void *allocateSlow(size_t size, size_t align) {
+        bytesAllocated += size;
+        if (size > nextSlabSize / 2) {
+            // new[] storage is aligned for any fundamental type, bumping continues in the current slab
+            return slabs.emplace_back(new std::byte[size]).get();
+        }
+        auto &slab = slabs.emplace_back(new std::byte[nextSlabSize]);
+        current = slab.get();
+        end = current + nextSlabSize;
+        nextSlabSize = std::min(nextSlabSize * 2, MaxSlabSize);
+        auto aligned = (reinterpret_cast<uintptr_t>(current) + align - 1) & ~(uintptr_t{align} - 1);
+        current = reinterpret_cast<std::byte *>(aligned + size);
+        return reinterpret_cast<void *>(aligned);
+    }
+
+    std::vector<std::unique_ptr<std::byte[]>> slabs;
+    std::byte *current = nullptr;
+    std::byte *end = nullptr;
+    size_t nextSlabSize = InitialSlabSize;
+    size_t bytesAllocated = 0;
+};
+
+}
+
+#endif //REFLEX_SRC_AST_UTILS_ARENA_H_
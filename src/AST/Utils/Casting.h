@@ -0,0 +1,43 @@
+//
+// Created by henry on 2022-05-24.
+//
+
+#ifndef REFLEX_SRC_AST_UTILS_CASTING_H_
+#define REFLEX_SRC_AST_UTILS_CASTING_H_
+
+#include <cassert>
+#include <type_traits>
+
+namespace reflex {
+
+/// Checked downcasts over hierarchies that carry a kind tag
+/// - To must provide static bool classof(const Base *), usually a compare or range check of the kind
+/// - unlike LLVM, isa<> and dyn_cast<> accept nullptr so they can replace dynamic_cast directly
+
+template<class To, class From>
+using CastResult = std::conditional_t<std::is_const_v<From>, const To, To> *;
+
+/// @returns true if @p value is non null and an instance of To
+template<class To, class From>
+bool isa(From *value) {
+    if (!value) return false;
+    if constexpr (std::is_base_of_v<To, From>) return true;
+    else return To::classof(value);
+}
+
+/// @returns @p value as To, @p value must be an instance of To
+template<class To, class From>
+CastResult<To, From> cast(From *value) {
+    assert(isa<To>(value) && "cast<>() to an incompatible type");
+    return static_cast<CastResult<To, From>>(value);
+}
+
+/// @returns @p value as To, or nullptr if @p value is null or not an instance of To
+template<class To, class From>
+CastResult<To, From> dyn_cast(From *value) {
+    return isa<To>(value) ? static_cast<CastResult<To, From>>(value) : nullptr;
+}
+
+}
+
+#endif //REFLEX_SRC_AST_UTILS_CASTING_H_
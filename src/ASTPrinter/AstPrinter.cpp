@@ -15,7 +15,7 @@
 
 namespace reflex {
 
-Scope::Scope(AstPrinter &printer, bool isLast) : printer(printer) {
+Scope::Scope(TreePrinter &printer, bool isLast) : printer(printer) {
     printer.isLast.push(isLast);
     ++printer.depth;
 }
@@ -25,14 +25,14 @@ Scope::~Scope() {
     --printer.depth;
 }
 
-AstPrinter::AstPrinter(std::ostream &output)
+TreePrinter::TreePrinter(std::ostream &output)
     : output(output), depth(0), isLast() {
     std::vector<bool> tmp(100, true);
     depthFlag = std::move(tmp);
     isLast.push(false);
 }
 
-void AstPrinter::printTreePrefix() {
+void TreePrinter::printTreePrefix() {
     for (size_t i = 1; i < depth; ++i) {
         if (depthFlag[i]) {
             output << "| ";
@@ -42,14 +42,7 @@ void AstPrinter::printTreePrefix() {
     }
 }
 
-std::string AstPrinter::printAstType(Type *type) {
-    if (!type) {
-        return "<<unknown>>";
-    }
-    return "<" + type->getTypeString() + ">";
-}
-
-void AstPrinter::printNodePrefix(const std::string &message, bool end) {
+void TreePrinter::printNodePrefix(const std::string &message, bool end) {
     printTreePrefix();
     if (depth == 0) {
         output << message;
@@ -62,25 +55,33 @@ void AstPrinter::printNodePrefix(const std::string &message, bool end) {
     if (end) output << std::endl;
 }
 
-OpaqueType AstPrinter::visit(CompilationUnit &CU) {
+AstPrinter::AstPrinter(std::ostream &output) : TreePrinter(output) {}
+
+std::string AstPrinter::printAstType(Type *type) {
+    if (!type) {
+        return "<<unknown>>";
+    }
+    return "<" + type->getTypeString() + ">";
+}
+
+void AstPrinter::visit(CompilationUnit &CU) {
     printNodePrefix("CompilationUnit: "
-                        + CU.location()->getStringRepr() + " '"
+                        + CU.location().getStringRepr() + " '"
                         + CU.getDeclname() + "'");
     {
         int it = 0;
         for (auto i = CU.getDecls().begin(); i != CU.getDecls().end(); ++i, ++it) {
             auto isLastNode = it == CU.getDecls().size() - 1;
             Scope _(*this, isLastNode);
-            (*i)->accept(this);
+            visit(*i);
         }
     }
     depthFlag[depth] = true;
-    return {};
 }
 
-OpaqueType AstPrinter::visit(ClassDecl &klass) {
+void AstPrinter::visit(ClassDecl &klass) {
     printNodePrefix("ClassDecl: "
-                        + klass.location()->getStringRepr() + " '"
+                        + klass.location().getStringRepr() + " '"
                         + klass.getDeclname() + "' "
                         + printAstType(klass.getType()));
     {
@@ -93,16 +94,15 @@ OpaqueType AstPrinter::visit(ClassDecl &klass) {
         for (auto i = members.begin(); i != members.end(); ++i, ++it) {
             auto isLastNode = it == members.size() - 1;
             Scope _s(*this, isLastNode);
-            (*i)->accept(this);
+            visit(*i);
         }
     }
     depthFlag[depth] = true;
-    return {};
 }
 
-OpaqueType AstPrinter::visit(InterfaceDecl &inf) {
+void AstPrinter::visit(InterfaceDecl &inf) {
     printNodePrefix("InterfaceDecl: "
-                        + inf.location()->getStringRepr() + " '"
+                        + inf.location().getStringRepr() + " '"
                         + inf.getDeclname() + "' "
                         + printAstType(inf.getType()));
     {
@@ -115,82 +115,77 @@ OpaqueType AstPrinter::visit(InterfaceDecl &inf) {
              ++i, ++it) {
             auto isLastNode = it == members.size() - 1;
             Scope _(*this, isLastNode);
-            (*i)->accept(this);
+            visit(*i);
         }
     }
     depthFlag[depth] = true;
-    return {};
 }
 
-OpaqueType AstPrinter::visit(VariableDecl &decl) {
+void AstPrinter::visit(VariableDecl &decl) {
     printNodePrefix("VariableDecl: "
-                        + decl.location()->getStringRepr() + " '"
+                        + decl.location().getStringRepr() + " '"
                         + decl.getDeclname() + "' "
                         + printAstType(decl.getType()));
 
     if (decl.getInitializer()) {
         Scope _(*this, true);
-        decl.getInitializer()->accept(this);
+        visit(decl.getInitializer());
     }
 
     depthFlag[depth] = true;
-    return {};
 }
 
-OpaqueType AstPrinter::visit(FieldDecl &decl) {
+void AstPrinter::visit(FieldDecl &decl) {
     printNodePrefix("FieldDecl: "
-                        + decl.location()->getStringRepr() + " "
+                        + decl.location().getStringRepr() + " "
                         + getVisibilityString(decl.getVisibility()) + " member '"
                         + decl.getDeclname() + "' "
                         + printAstType(decl.getType()));
 
     if (decl.getInitializer()) {
         Scope _(*this, true);
-        decl.getInitializer()->accept(this);
+        visit(decl.getInitializer());
     }
 
     depthFlag[depth] = true;
-    return {};
 }
 
-OpaqueType AstPrinter::visit(ParamDecl &decl) {
+void AstPrinter::visit(ParamDecl &decl) {
     printNodePrefix("ParamDecl: "
-                        + decl.location()->getStringRepr() + " '"
+                        + decl.location().getStringRepr() + " '"
                         + decl.getDeclname() + "' "
                         + printAstType(decl.getType()));
 
     if (decl.getInitializer()) {
         Scope _(*this, true);
-        decl.getInitializer()->accept(this);
+        visit(decl.getInitializer());
     }
 
     depthFlag[depth] = true;
-    return {};
 }
 
-OpaqueType AstPrinter::visit(FunctionDecl &decl) {
+void AstPrinter::visit(FunctionDecl &decl) {
     printNodePrefix("FunctionDecl: "
-                        + decl.location()->getStringRepr() + " '"
+                        + decl.location().getStringRepr() + " '"
                         + decl.getDeclname() + "' "
                         + printAstType(decl.getType()));
     int it = 0;
     for (auto i = decl.getParamDecls().begin(); i != decl.getParamDecls().end(); ++i, ++it) {
         auto isLastNode = it == decl.getParamDecls().size() - 1;
         Scope _s(*this, decl.getBody() == nullptr && isLastNode);
-        (*i)->accept(this);
+        visit(*i);
     }
     if (decl.getBody()) {
         Scope _s(*this, true);
-        decl.getBody()->accept(this);
+        visit(decl.getBody());
     }
 
     depthFlag[depth] = true;
-    return {};
 }
 
-OpaqueType AstPrinter::visit(MethodDecl &decl) {
+void AstPrinter::visit(MethodDecl &decl) {
     printNodePrefix("MethodDecl: "
-                        + decl.location()->getStringRepr() + " "
+                        + decl.location().getStringRepr() + " "
                         + getVisibilityString(decl.getVisibility()) + " member '"
                         + decl.getDeclname() + "' "
                         + printAstType(decl.getType()));
@@ -198,341 +193,313 @@ OpaqueType AstPrinter::visit(MethodDecl &decl) {
     for (auto i = decl.getParamDecls().begin(); i != decl.getParamDecls().end(); ++i, ++it) {
         auto isLastNode = it == decl.getParamDecls().size() - 1;
         Scope _s(*this, decl.getBody() == nullptr && isLastNode);
-        (*i)->accept(this);
+        visit(*i);
     }
     if (decl.getBody()) {
         Scope _s(*this, true);
-        decl.getBody()->accept(this);
+        visit(decl.getBody());
     }
 
     depthFlag[depth] = true;
-    return {};
 }
 
-OpaqueType AstPrinter::visit(BlockStmt &stmt) {
-    printNodePrefix("BlockStmt: " + stmt.location()->getStringRepr());
+void AstPrinter::visit(BlockStmt &stmt) {
+    printNodePrefix("BlockStmt: " + stmt.location().getStringRepr());
 
     int it = 0;
     for (auto i = stmt.getStmts().begin(); i != stmt.getStmts().end(); ++i, ++it) {
         auto isLastNode = it == stmt.getStmts().size() - 1;
         Scope _s(*this, isLastNode);
-        (*i)->accept(this);
+        visit(*i);
     }
 
     depthFlag[depth] = true;
-    return {};
 }
 
-OpaqueType AstPrinter::visit(ReturnStmt &stmt) {
+void AstPrinter::visit(ReturnStmt &stmt) {
     printNodePrefix("ReturnStmt: "
-                        + stmt.location()->getStringRepr() + " "
+                        + stmt.location().getStringRepr() + " "
                         + printAstType(stmt.getReturnType()));
     if (stmt.getReturnValue()) {
         Scope _(*this, true);
-        stmt.getReturnValue()->accept(this);
+        visit(stmt.getReturnValue());
     }
     depthFlag[depth] = true;
-    return {};
 }
 
-OpaqueType AstPrinter::visit(BreakStmt &stmt) {
-    printNodePrefix("BreakStmt: " + stmt.location()->getStringRepr());
+void AstPrinter::visit(BreakStmt &stmt) {
+    printNodePrefix("BreakStmt: " + stmt.location().getStringRepr());
     depthFlag[depth] = true;
-    return {};
 }
 
-OpaqueType AstPrinter::visit(ContinueStmt &stmt) {
-    printNodePrefix("ContinueStmt: " + stmt.location()->getStringRepr());
+void AstPrinter::visit(ContinueStmt &stmt) {
+    printNodePrefix("ContinueStmt: " + stmt.location().getStringRepr());
     depthFlag[depth] = true;
-    return {};
 }
 
-OpaqueType AstPrinter::visit(IfStmt &stmt) {
-    printNodePrefix("IfStmt: " + stmt.location()->getStringRepr());
+void AstPrinter::visit(IfStmt &stmt) {
+    printNodePrefix("IfStmt: " + stmt.location().getStringRepr());
     {
         Scope _(*this, false);
-        stmt.getCond()->accept(this);
+        visit(stmt.getCond());
     }
     auto hasElseBlock = stmt.getElseBlock();
     {
         Scope _(*this, hasElseBlock);
-        stmt.getPrimaryBlock()->accept(this);
+        visit(stmt.getPrimaryBlock());
     }
     if (hasElseBlock) {
         Scope _(*this, true);
-        stmt.getElseBlock()->accept(this);
+        visit(stmt.getElseBlock());
     }
     depthFlag[depth] = true;
-    return {};
 }
 
-OpaqueType AstPrinter::visit(ForStmt &stmt) {
-    printNodePrefix("ForStmt: " + stmt.location()->getStringRepr());
+void AstPrinter::visit(ForStmt &stmt) {
+    printNodePrefix("ForStmt: " + stmt.location().getStringRepr());
     // for clause visiting
     {
         Scope _(*this, true);
-        stmt.getBody()->accept(this);
+        visit(stmt.getBody());
     }
     depthFlag[depth] = true;
-    return {};
 }
 
-OpaqueType AstPrinter::visit(WhileStmt &stmt) {
-    printNodePrefix("WhileStmt: " + stmt.location()->getStringRepr());
+void AstPrinter::visit(WhileStmt &stmt) {
+    printNodePrefix("WhileStmt: " + stmt.location().getStringRepr());
     {
         Scope _(*this, false);
-        stmt.getCond()->accept(this);
+        visit(stmt.getCond());
     }
     {
         Scope _(*this, true);
-        stmt.getBody()->accept(this);
+        visit(stmt.getBody());
     }
     depthFlag[depth] = true;
-    return {};
 }
 
-OpaqueType AstPrinter::visit(EmptyStmt &stmt) {
-    printNodePrefix("EmptyStmt: " + stmt.location()->getStringRepr());
+void AstPrinter::visit(EmptyStmt &stmt) {
+    printNodePrefix("EmptyStmt: " + stmt.location().getStringRepr());
     depthFlag[depth] = true;
-    return {};
 }
 
-OpaqueType AstPrinter::visit(AssignmentStmt &stmt) {
+void AstPrinter::visit(AssignmentStmt &stmt) {
     printNodePrefix("AssignmentStmt: '"
                         + getAssignOperator(stmt.getAssignOp()) + "' "
-                        + stmt.location()->getStringRepr());
+                        + stmt.location().getStringRepr());
     {
         Scope _s(*this, false);
-        stmt.getLhs()->accept(this);
+        visit(stmt.getLhs());
     }
     {
         Scope _s(*this, true);
-        stmt.getRhs()->accept(this);
+        visit(stmt.getRhs());
     }
     depthFlag[depth] = true;
-    return {};
 }
 
-OpaqueType AstPrinter::visit(IncDecStmt &stmt) {
+void AstPrinter::visit(IncDecStmt &stmt) {
     printNodePrefix("IncDecStmt: '"
                         + getPostfixOperator(stmt.getPostfixOp()) + "' "
-                        + stmt.location()->getStringRepr());
+                        + stmt.location().getStringRepr());
     {
         Scope _s(*this, true);
-        stmt.getExpr()->accept(this);
+        visit(stmt.getExpr());
     }
     depthFlag[depth] = true;
-    return {};
 }
 
-OpaqueType AstPrinter::visit(ExpressionStmt &stmt) {
-    printNodePrefix("ExpressionStmt: " + stmt.location()->getStringRepr());
+void AstPrinter::visit(ExpressionStmt &stmt) {
+    printNodePrefix("ExpressionStmt: " + stmt.location().getStringRepr());
     {
         Scope _s(*this, true);
-        stmt.getExpr()->accept(this);
+        visit(stmt.getExpr());
     }
     depthFlag[depth] = true;
-    return {};
 }
 
-OpaqueType AstPrinter::visit(DeclStmt &stmt) {
-    printNodePrefix("DeclStmt: " + stmt.location()->getStringRepr());
+void AstPrinter::visit(DeclStmt &stmt) {
+    printNodePrefix("DeclStmt: " + stmt.location().getStringRepr());
     {
         Scope _s(*this, true);
-        stmt.getDecl()->accept(this);
+        visit(stmt.getDecl());
     }
     depthFlag[depth] = true;
-    return {};
 }
 
-OpaqueType AstPrinter::visit(DeclRefExpr &expr) {
+void AstPrinter::visit(DeclRefExpr &expr) {
     printNodePrefix("DeclRefExpr: '"
                         + expr.getReferenceName() + "' "
-                        + expr.location()->getStringRepr() + " "
+                        + expr.location().getStringRepr() + " "
                         + printAstType(expr.getType()));
     depthFlag[depth] = true;
-    return {};
 }
 
-OpaqueType AstPrinter::visit(UnaryExpr &expr) {
+void AstPrinter::visit(UnaryExpr &expr) {
     printNodePrefix("UnaryExpr: '"
                         + Operator::getUnaryOperator(expr.getUnaryOp()) + "' "
-                        + expr.location()->getStringRepr() + " "
+                        + expr.location().getStringRepr() + " "
                         + printAstType(expr.getType()));
     {
         Scope _s(*this, true);
-        expr.getExpr()->accept(this);
+        visit(expr.getExpr());
     }
     depthFlag[depth] = true;
-    return {};
 }
 
-OpaqueType AstPrinter::visit(BinaryExpr &expr) {
+void AstPrinter::visit(BinaryExpr &expr) {
     printNodePrefix("BinaryExpr: '"
                         + Operator::getBinaryOperator(expr.getBinaryOp()) + "' "
-                        + expr.location()->getStringRepr() + " "
+                        + expr.location().getStringRepr() + " "
                         + printAstType(expr.getType()));
     {
         Scope _(*this, false);
-        expr.getLhs()->accept(this);
+        visit(expr.getLhs());
     }
     {
         Scope _(*this, true);
-        expr.getRhs()->accept(this);
+        visit(expr.getRhs());
     }
     depthFlag[depth] = true;
-    return {};
 }
 
-OpaqueType AstPrinter::visit(NewExpr &expr) {
+void AstPrinter::visit(NewExpr &expr) {
     printNodePrefix("NewExpr: "
-                        + expr.location()->getStringRepr() + " "
+                        + expr.location().getStringRepr() + " "
                         + printAstType(expr.getType()));
     depthFlag[depth] = true;
-    return {};
 }
 
-OpaqueType AstPrinter::visit(ImplicitCastExpr &expr) {
+void AstPrinter::visit(ImplicitCastExpr &expr) {
     printNodePrefix("ImplicitCastExpr: "
-                        + expr.location()->getStringRepr() + " "
+                        + expr.location().getStringRepr() + " "
                         + printAstType(expr.getType()) + " <"
                         + Operator::getImplicitConversion(expr.getConversion())
                         + ">");
     {
         Scope _(*this, true);
-        expr.getFrom()->accept(this);
+        visit(expr.getFrom());
     }
     depthFlag[depth] = true;
-    return {};
 }
 
-OpaqueType AstPrinter::visit(CastExpr &expr) {
+void AstPrinter::visit(CastExpr &expr) {
     printNodePrefix("CastExpr: "
-                        + expr.location()->getStringRepr() + " "
+                        + expr.location().getStringRepr() + " "
                         + printAstType(expr.getType()));
     {
         Scope _(*this, true);
-        expr.getFrom()->accept(this);
+        visit(expr.getFrom());
     }
     depthFlag[depth] = true;
-    return {};
 }
 
-OpaqueType AstPrinter::visit(IndexExpr &expr) {
+void AstPrinter::visit(IndexExpr &expr) {
     printNodePrefix("IndexExpr: "
-                        + expr.location()->getStringRepr() + " "
+                        + expr.location().getStringRepr() + " "
                         + printAstType(expr.getType()));
     {
         Scope _(*this, false);
-        expr.getBaseExpr()->accept(this);
+        visit(expr.getBaseExpr());
     }
     {
         Scope _(*this, true);
         if (expr.getIndex())
-            expr.getIndex()->accept(this);
+            visit(expr.getIndex());
     }
     depthFlag[depth] = true;
-    return {};
 }
 
-OpaqueType AstPrinter::visit(SelectorExpr &expr) {
+void AstPrinter::visit(SelectorExpr &expr) {
     printNodePrefix("SelectorExpr: "
                         + expr.getSelector() + " "
-                        + expr.location()->getStringRepr() + " "
+                        + expr.location().getStringRepr() + " "
                         + printAstType(expr.getType()));
     {
         Scope _(*this, true);
-        expr.getBaseExpr()->accept(this);
+        visit(expr.getBaseExpr());
     }
     depthFlag[depth] = true;
-    return {};
 }
 
-OpaqueType AstPrinter::visit(ArgumentExpr &expr) {
+void AstPrinter::visit(ArgumentExpr &expr) {
     printNodePrefix("ArgumentExpr: "
-                        + expr.location()->getStringRepr() + " "
+                        + expr.location().getStringRepr() + " "
                         + printAstType(expr.getType()));
     auto hasArgument = !expr.getArguments().empty();
     {
         Scope _(*this, !hasArgument);
-        expr.getBaseExpr()->accept(this);
+        visit(expr.getBaseExpr());
     }
     {
         int it = 0;
         for (auto i = expr.getArguments().begin(); i != expr.getArguments().end(); ++i, ++it) {
             auto isLastNode = it == expr.getArguments().size() - 1;
             Scope _s(*this, isLastNode);
-            (*i)->accept(this);
+            visit(*i);
         }
     }
     depthFlag[depth] = true;
-    return {};
 }
 
-OpaqueType AstPrinter::visit(NumberLiteral &literal) {
+void AstPrinter::visit(NumberLiteral &literal) {
     printNodePrefix("NumberLiteral: '" + literal.getLiteral() + "' "
-                        + literal.location()->getStringRepr() + " "
+                        + literal.location().getStringRepr() + " "
                         + printAstType(literal.getType()));
     depthFlag[depth] = true;
-    return {};
 }
 
-OpaqueType AstPrinter::visit(StringLiteral &literal) {
+void AstPrinter::visit(StringLiteral &literal) {
     printNodePrefix("StringLiteral: \"" + literal.getLiteral() + "\" "
-                        + literal.location()->getStringRepr() + " "
+                        + literal.location().getStringRepr() + " "
                         + printAstType(literal.getType()));
     depthFlag[depth] = true;
-    return {};
 }
 
-OpaqueType AstPrinter::visit(BooleanLiteral &literal) {
+void AstPrinter::visit(BooleanLiteral &literal) {
     printNodePrefix("BooleanLiteral: \"" + literal.getLiteral() + "\" "
-                        + literal.location()->getStringRepr() + " "
+                        + literal.location().getStringRepr() + " "
                         + printAstType(literal.getType()));
     depthFlag[depth] = true;
-    return {};
 }
 
-OpaqueType AstPrinter::visit(NullLiteral &literal) {
+void AstPrinter::visit(NullLiteral &literal) {
     printNodePrefix("NullLiteral: \"" + literal.getLiteral() + "\" "
-                        + literal.location()->getStringRepr() + " "
+                        + literal.location().getStringRepr() + " "
                         + printAstType(literal.getType()));
     depthFlag[depth] = true;
-    return {};
 }
 
-OpaqueType AstPrinter::visit(ArrayLiteral &literal) {
+void AstPrinter::visit(ArrayLiteral &literal) {
     printNodePrefix("ArrayLiteral: "
-                        + literal.location()->getStringRepr() + " "
+                        + literal.location().getStringRepr() + " "
                         + printAstType(literal.getType()));
     int it = 0;
     const auto &initLst = literal.getInitList();
     for (auto i = initLst.begin(); i != initLst.end(); ++i, ++it) {
         auto isLastNode = it == initLst.size() - 1;
         Scope _s(*this, isLastNode);
-        (*i)->accept(this);
+        visit(*i);
     }
 
     depthFlag[depth] = true;
-    return {};
 }
 
-OpaqueType AstPrinter::visit(FunctionLiteral &literal) {
+void AstPrinter::visit(FunctionLiteral &literal) {
     printNodePrefix("FunctionLiteral: " + printAstType(literal.getType()));
 
     int it = 0;
     for (auto i = literal.getParamDecls().begin(); i != literal.getParamDecls().end(); ++i, ++it) {
         auto isLastNode = it == literal.getParamDecls().size() - 1;
         Scope _s(*this, literal.getBody() == nullptr && isLastNode);
-        (*i)->accept(this);
+        visit(*i);
     }
     if (literal.getBody()) {
         Scope _s(*this, true);
-        literal.getBody()->accept(this);
+        visit(literal.getBody());
     }
 
     depthFlag[depth] = true;
-    return {};
 }
 
 }
@@ -13,65 +13,23 @@
 
 namespace reflex {
 
-class AstPrinter;
+class TreePrinter;
 class Scope {
-    AstPrinter &printer;
+    TreePrinter &printer;
   public:
-    explicit Scope(AstPrinter &printer, bool isLast = false);
+    explicit Scope(TreePrinter &printer, bool isLast = false);
     ~Scope();
 };
 
-class Type;
-class AstPrinter : public ASTDeclVisitor,
-                   public ASTStmtVisitor,
-                   public ASTExprVisitor {
+/// Draws the branches of a tree, one node per line, shared by the printers of both AST layouts
+class TreePrinter {
     friend class Scope;
   public:
-    explicit AstPrinter(std::ostream &output);
-
-    OpaqueType visit(CompilationUnit &CU) override;
-    OpaqueType visit(ClassDecl &decl) override;
-    OpaqueType visit(InterfaceDecl &decl) override;
-    OpaqueType visit(VariableDecl &decl) override;
-    OpaqueType visit(FieldDecl &decl) override;
-    OpaqueType visit(ParamDecl &decl) override;
-    OpaqueType visit(FunctionDecl &decl) override;
-    OpaqueType visit(MethodDecl &decl) override;
-
-    OpaqueType visit(BlockStmt &stmt) override;
-    OpaqueType visit(ReturnStmt &stmt) override;
-    OpaqueType visit(BreakStmt &stmt) override;
-    OpaqueType visit(ContinueStmt &stmt) override;
-    OpaqueType visit(IfStmt &stmt) override;
-    OpaqueType visit(ForStmt &stmt) override;
-    OpaqueType visit(WhileStmt &stmt) override;
-    OpaqueType visit(EmptyStmt &stmt) override;
-    OpaqueType visit(AssignmentStmt &stmt) override;
-    OpaqueType visit(IncDecStmt &stmt) override;
-    OpaqueType visit(ExpressionStmt &stmt) override;
-    OpaqueType visit(DeclStmt &stmt) override;
-
-    OpaqueType visit(DeclRefExpr &expr) override;
-    OpaqueType visit(UnaryExpr &expr) override;
-    OpaqueType visit(BinaryExpr &expr) override;
-    OpaqueType visit(NewExpr &expr) override;
-    OpaqueType visit(ImplicitCastExpr &expr) override;
-    OpaqueType visit(CastExpr &expr) override;
-    OpaqueType visit(IndexExpr &expr) override;
-    OpaqueType visit(SelectorExpr &expr) override;
-    OpaqueType visit(ArgumentExpr &expr) override;
-
-    OpaqueType visit(NumberLiteral &literal) override;
-    OpaqueType visit(StringLiteral &literal) override;
-    OpaqueType visit(BooleanLiteral &literal) override;
-    OpaqueType visit(NullLiteral &literal) override;
-    OpaqueType visit(ArrayLiteral &literal) override;
-    OpaqueType visit(FunctionLiteral &literal) override;
+    explicit TreePrinter(std::ostream &output);
 
-  private:
+  protected:
     void printTreePrefix();
     void printNodePrefix(const std::string &message, bool end = true);
-    std::string printAstType(Type *type);
 
     std::ostream &output;
     size_t depth;
@@ -79,6 +37,61 @@ class AstPrinter : public ASTDeclVisitor,
     std::stack<bool> isLast;
 };
 
+class Type;
+class AstPrinter : public TreePrinter,
+                   public ASTDeclVisitor<AstPrinter>,
+                   public ASTStmtVisitor<AstPrinter>,
+                   public ASTExprVisitor<AstPrinter> {
+  public:
+    using ASTDeclVisitor::visit;
+    using ASTStmtVisitor::visit;
+    using ASTExprVisitor::visit;
+
+    explicit AstPrinter(std::ostream &output);
+
+    void visit(CompilationUnit &CU);
+    void visit(ClassDecl &decl);
+    void visit(InterfaceDecl &decl);
+    void visit(VariableDecl &decl);
+    void visit(FieldDecl &decl);
+    void visit(ParamDecl &decl);
+    void visit(FunctionDecl &decl);
+    void visit(MethodDecl &decl);
+
+    void visit(BlockStmt &stmt);
+    void visit(ReturnStmt &stmt);
+    void visit(BreakStmt &stmt);
+    void visit(ContinueStmt &stmt);
+    void visit(IfStmt &stmt);
+    void visit(ForStmt &stmt);
+    void visit(WhileStmt &stmt);
+    void visit(EmptyStmt &stmt);
+    void visit(AssignmentStmt &stmt);
+    void visit(IncDecStmt &stmt);
+    void visit(ExpressionStmt &stmt);
+    void visit(DeclStmt &stmt);
+
+    void visit(DeclRefExpr &expr);
+    void visit(UnaryExpr &expr);
+    void visit(BinaryExpr &expr);
+    void visit(NewExpr &expr);
+    void visit(ImplicitCastExpr &expr);
+    void visit(CastExpr &expr);
+    void visit(IndexExpr &expr);
+    void visit(SelectorExpr &expr);
+    void visit(ArgumentExpr &expr);
+
+    void visit(NumberLiteral &literal);
+    void visit(StringLiteral &literal);
+    void visit(BooleanLiteral &literal);
+    void visit(NullLiteral &literal);
+    void visit(ArrayLiteral &literal);
+    void visit(FunctionLiteral &literal);
+
+  private:
+    std::string printAstType(Type *type);
+};
+
 }
 
 #endif //REFLEX_SRC_AST_VISITOR_ASTPRINTER_H_
@@ -0,0 +1,205 @@
+//
+// Created by henry on 2022-05-23.
+//
+
+#include "FlatAstPrinter.h"
+
+#include "ASTUtils.h"
+#include "Operator.h"
+
+namespace reflex {
+
+namespace {
+
+// the type column AstPrinter prints, the flat layout has no types
+const std::string UnknownType = "<<unknown>>";
+
+}
+
+FlatAstPrinter::FlatAstPrinter(std::ostream &output, const FlatAST &ast) : TreePrinter(output), ast(ast) {}
+
+void FlatAstPrinter::print(NodeID node) {
+    const auto kind = ast.getKind(node);
+    const auto op = ast.getOperator(node);
+    const auto [lhs, rhs] = ast.getOperands(node);
+    auto name = [&] { return ast.getSymbol(node).str(); };
+    switch (kind) {
+        case FlatKind::CompilationUnit:
+            printNodePrefix(getPrefix(node) + " '" + name() + "'");
+            printChildren(ast.getList(rhs));
+            break;
+        case FlatKind::ClassDecl:
+            printNodePrefix(getPrefix(node) + " '" + name() + "' " + UnknownType);
+            printChildren(ast.getList(rhs + 2));
+            break;
+        case FlatKind::InterfaceDecl:
+            printNodePrefix(getPrefix(node) + " '" + name() + "' " + UnknownType);
+            printChildren(ast.getList(rhs + 1));
+            break;
+        case FlatKind::VariableDecl:
+        case FlatKind::ParamDecl:
+            printNodePrefix(getPrefix(node) + " '" + name() + "' " + UnknownType);
+            printChild(ast.getExtra(rhs + 1), true);
+            break;
+        case FlatKind::FieldDecl:
+            printNodePrefix(getPrefix(node) + " " + getVisibilityString(static_cast<Visibility>(op)) + " member '"
+                                + name() + "' " + UnknownType);
+            printChild(ast.getExtra(rhs + 1), true);
+            break;
+        case FlatKind::FunctionDecl:
+            printNodePrefix(getPrefix(node) + " '" + name() + "' " + UnknownType);
+            printFunction(ast.getList(rhs + 2), ast.getExtra(rhs + 1));
+            break;
+        case FlatKind::MethodDecl:
+            printNodePrefix(getPrefix(node) + " " + getVisibilityString(static_cast<Visibility>(op)) + " member '"
+                                + name() + "' " + UnknownType);
+            printFunction(ast.getList(rhs + 2), ast.getExtra(rhs + 1));
+            break;
+
+        case FlatKind::BlockStmt:
+            printNodePrefix(getPrefix(node));
+            printChildren(ast.getList(lhs));
+            break;
+        case FlatKind::ReturnStmt:
+            printNodePrefix(getPrefix(node) + " " + UnknownType);
+            printChild(lhs, true);
+            break;
+        case FlatKind::IfStmt:
+            printNodePrefix(getPrefix(node));
+            printChild(lhs, false);
+            printChild(ast.getExtra(rhs), ast.getExtra(rhs + 1) != FlatAST::NullNode);
+            printChild(ast.getExtra(rhs + 1), true);
+            break;
+        case FlatKind::ForStmt:
+            printNodePrefix(getPrefix(node));
+            printChild(rhs, true);
+            break;
+        case FlatKind::WhileStmt:
+            printNodePrefix(getPrefix(node));
+            printChild(lhs, false);
+            printChild(rhs, true);
+            break;
+        case FlatKind::AssignmentStmt:
+            printNodePrefix("AssignmentStmt: '" + getAssignOperator(static_cast<Operator::AssignOperator>(op)) + "' "
+                                + ast.getLocation(node).getStringRepr());
+            printChild(lhs, false);
+            printChild(rhs, true);
+            break;
+        case FlatKind::IncDecStmt:
+            printNodePrefix("IncDecStmt: '" + getPostfixOperator(static_cast<Operator::PostfixOperator>(op)) + "' "
+                                + ast.getLocation(node).getStringRepr());
+            printChild(lhs, true);
+            break;
+        case FlatKind::ExpressionStmt:
+        case FlatKind::DeclStmt:
+            printNodePrefix(getPrefix(node));
+            printChild(lhs, true);
+            break;
+        case FlatKind::BreakStmt:
+        case FlatKind::ContinueStmt:
+        case FlatKind::EmptyStmt:
+            printNodePrefix(getPrefix(node));
+            break;
+
+        case FlatKind::Identifier:
+        case FlatKind::ModuleSelector:
+            printNodePrefix("DeclRefExpr: '" + getReferenceName(node) + "' "
+                                + ast.getLocation(node).getStringRepr() + " " + UnknownType);
+            break;
+        case FlatKind::UnaryExpr:
+            printNodePrefix("UnaryExpr: '" + Operator::getUnaryOperator(static_cast<Operator::UnaryOperator>(op))
+                                + "' " + ast.getLocation(node).getStringRepr() + " " + UnknownType);
+            printChild(lhs, true);
+            break;
+        case FlatKind::BinaryExpr:
+            printNodePrefix("BinaryExpr: '" + Operator::getBinaryOperator(static_cast<Operator::BinaryOperator>(op))
+                                + "' " + ast.getLocation(node).getStringRepr() + " " + UnknownType);
+            printChild(lhs, false);
+            printChild(rhs, true);
+            break;
+        case FlatKind::NewExpr:
+            printNodePrefix(getPrefix(node) + " " + UnknownType);
+            break;
+        case FlatKind::ImplicitCastExpr:
+            printNodePrefix(getPrefix(node) + " " + UnknownType + " <"
+                                + Operator::getImplicitConversion(static_cast<Operator::ImplicitConversion>(op)) + ">");
+            printChild(lhs, true);
+            break;
+        case FlatKind::CastExpr:
+            printNodePrefix(getPrefix(node) + " " + UnknownType);
+            printChild(rhs, true);
+            break;
+        case FlatKind::IndexExpr:
+            printNodePrefix(getPrefix(node) + " " + UnknownType);
+            printChild(lhs, false);
+            printChild(rhs, true);
+            break;
+        case FlatKind::SelectorExpr:
+            printNodePrefix("SelectorExpr: " + name() + " " + ast.getLocation(node).getStringRepr() + " "
+                                + UnknownType);
+            printChild(lhs, true);
+            break;
+        case FlatKind::ArgumentExpr: {
+            auto arguments = ast.getList(rhs);
+            printNodePrefix(getPrefix(node) + " " + UnknownType);
+            printChild(lhs, arguments.empty());
+            printChildren(arguments);
+            break;
+        }
+
+        case FlatKind::NumberLiteral:
+            printNodePrefix("NumberLiteral: '" + name() + "' " + ast.getLocation(node).getStringRepr() + " "
+                                + UnknownType);
+            break;
+        case FlatKind::StringLiteral:
+        case FlatKind::BooleanLiteral:
+        case FlatKind::NullLiteral:
+            printNodePrefix(getFlatKindString(kind) + ": \"" + name() + "\" " + ast.getLocation(node).getStringRepr()
+                                + " " + UnknownType);
+            break;
+        case FlatKind::ArrayLiteral:
+            printNodePrefix(getPrefix(node) + " " + UnknownType);
+            printChildren(ast.getList(lhs));
+            break;
+        case FlatKind::FunctionLiteral:
+            printNodePrefix("FunctionLiteral: " + UnknownType);
+            printFunction(ast.getList(rhs + 1), ast.getExtra(rhs));
+            break;
+
+        default:
+            // type expressions, for clauses and the null node are not printed
+            return;
+    }
+    depthFlag[depth] = true;
+}
+
+void FlatAstPrinter::printChild(NodeID child, bool last) {
+    if (child == FlatAST::NullNode) return;
+    Scope _(*this, last);
+    print(child);
+}
+
+void FlatAstPrinter::printChildren(std::span<const NodeID> children, bool endsNode) {
+    for (size_t i = 0; i < children.size(); ++i) {
+        Scope _(*this, endsNode && i == children.size() - 1);
+        print(children[i]);
+    }
+}
+
+void FlatAstPrinter::printFunction(std::span<const NodeID> params, NodeID body) {
+    printChildren(params, body == FlatAST::NullNode);
+    printChild(body, true);
+}
+
+std::string FlatAstPrinter::getReferenceName(NodeID node) const {
+    if (ast.getKind(node) == FlatKind::ModuleSelector) {
+        return ast.getSymbol(node).str() + "::" + getReferenceName(ast.getOperands(node).rhs);
+    }
+    return ast.getSymbol(node).str();
+}
+
+std::string FlatAstPrinter::getPrefix(NodeID node) const {
+    return getFlatKindString(ast.getKind(node)) + ": " + ast.getLocation(node).getStringRepr();
+}
+
+}
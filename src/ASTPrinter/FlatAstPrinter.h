@@ -0,0 +1,43 @@
+//
+// Created by henry on 2022-05-23.
+//
+
+#ifndef REFLEX_SRC_ASTPRINTER_FLATASTPRINTER_H_
+#define REFLEX_SRC_ASTPRINTER_FLATASTPRINTER_H_
+
+#include <span>
+
+#include "AstPrinter.h"
+#include "FlatAST.h"
+
+namespace reflex {
+
+/// Prints a FlatAST in the format of AstPrinter, reading node rows by id instead of chasing pointers
+/// - type expressions and for clauses are skipped as AstPrinter skips them
+/// @note the flat layout keeps no types, every type prints as unknown like before semantic analysis
+class FlatAstPrinter : public TreePrinter {
+    using NodeID = FlatAST::NodeID;
+  public:
+    FlatAstPrinter(std::ostream &output, const FlatAST &ast);
+
+    void print() { print(ast.getRoot()); }
+    void print(NodeID node);
+
+  private:
+    /// Prints @p child as the last child of the current node or not, a null child prints nothing
+    void printChild(NodeID child, bool last);
+    /// Prints @p children, the last one as the last child of the current node if @p endsNode
+    void printChildren(std::span<const NodeID> children, bool endsNode = true);
+    /// Prints the parameters and the body of a function declaration or literal
+    void printFunction(std::span<const NodeID> params, NodeID body);
+    /// @returns the name referenced by an identifier or module selector
+    std::string getReferenceName(NodeID node) const;
+    /// @returns the kind and location every line of @p node starts with
+    std::string getPrefix(NodeID node) const;
+
+    const FlatAST &ast;
+};
+
+}
+
+#endif //REFLEX_SRC_ASTPRINTER_FLATASTPRINTER_H_
@@ -60,7 +60,7 @@ ClassVTableLayout::ClassVTableLayout(ClassType *klass) : reference(klass) {
                                      });
             if (iter != tableLayout.end()) continue;
 
-            auto funcType = dynamic_cast<FunctionType *>(memberType->getMemberAttrType());
+            auto funcType = dyn_cast<FunctionType>(memberType->getMemberAttrType());
             tableLayout.insert(insertPos, std::make_pair(method, funcType));
         }
         klass = klass->getBaseclass();
@@ -35,93 +35,87 @@ std::string FunctionGenerator::getVariableName(VariableDecl *decl) {
     return "_x" + std::to_string(getLocalDeclRef(decl));
 }
 
-OpaqueType FunctionGenerator::visit(ParamDecl &decl) {
+void FunctionGenerator::visit(ParamDecl &decl) {
     os.stream() << getVariableName(&decl);
-    return {};
 }
 
-OpaqueType FunctionGenerator::visit(VariableDecl &decl) {
+void FunctionGenerator::visit(VariableDecl &decl) {
     os.stream() << getVariableName(&decl);
-    return {};
 }
 
-OpaqueType FunctionGenerator::visit(FunctionDecl &decl) {
+void FunctionGenerator::visit(FunctionDecl &decl) {
     os.printIndent() << "function " << decl.getDeclname() << "(";
     auto &params = decl.getParamDecls();
     if (!params.empty()) {
-        params[0]->accept(this);
+        visit(params[0]);
         for (size_t i = 1; i < params.size(); ++i) {
             os.stream() << ", ";
-            params[i]->accept(this);
+            visit(params[i]);
         }
     }
     os.printIndent() << ") {" << std::endl;
     if (decl.getBody()) {
         auto _ = os.createScopeIndent();
         for (auto stmt: decl.getBody()->getStmts()) {
-            stmt->accept(this);
+            visit(stmt);
         }
     }
     os.printIndent() << "}" << std::endl;
-    return {};
 }
 
-OpaqueType FunctionGenerator::visit(BlockStmt &stmt) {
+void FunctionGenerator::visit(BlockStmt &stmt) {
     os.printIndent() << "(function(){" << std::endl;
     auto _ = os.createScopeIndent();
     for (auto statement: stmt.getStmts()) {
-        statement->accept(this);
+        visit(statement);
     }
     os.printIndent() << "})();" << std::endl;
-    return {};
 }
 
-using StringRet = Generic<std::string>;
-
-OpaqueType FunctionGenerator::visit(NumberLiteral &literal) {
-    return StringRet::Create(std::to_string(literal.getValue()));
+std::string FunctionGenerator::visit(NumberLiteral &literal) {
+    return std::to_string(literal.getValue());
 }
 
-OpaqueType FunctionGenerator::visit(StringLiteral &literal) {
-    return StringRet::Create("\"" + literal.getLiteral() + "\"");
+std::string FunctionGenerator::visit(StringLiteral &literal) {
+    return "\"" + literal.getLiteral() + "\"";
 }
 
-OpaqueType FunctionGenerator::visit(BooleanLiteral &literal) {
-    return StringRet::Create(literal.getLiteral());
+std::string FunctionGenerator::visit(BooleanLiteral &literal) {
+    return literal.getLiteral();
 }
 
-OpaqueType FunctionGenerator::visit(NullLiteral &literal) {
-    return StringRet::Create("null");
+std::string FunctionGenerator::visit(NullLiteral &literal) {
+    return "null";
 }
 
-OpaqueType FunctionGenerator::visit(ArrayLiteral &literal) {
+std::string FunctionGenerator::visit(ArrayLiteral &literal) {
     std::stringstream arr;
     arr << "[ ";
     for (auto expr: literal.getInitList()) {
-        arr << StringRet::Get(expr->accept(this)) << ", ";
+        arr << visit(expr) << ", ";
     }
     arr << " ]";
-    return StringRet::Create(arr.str());
+    return arr.str();
 }
 
-OpaqueType FunctionGenerator::visit(DeclRefExpr &expr) {
-    auto referencedDecl = dynamic_cast<VariableDecl *>(expr.getDecl());
-    return StringRet::Create(getVariableName(referencedDecl));
+std::string FunctionGenerator::visit(DeclRefExpr &expr) {
+    auto referencedDecl = dyn_cast<VariableDecl>(expr.getDecl());
+    return getVariableName(referencedDecl);
 }
 
-OpaqueType FunctionGenerator::visit(UnaryExpr &expr) {
+std::string FunctionGenerator::visit(UnaryExpr &expr) {
     switch (expr.getUnaryOp()) {
         case Operator::UnaryOperator::Negative: {
-            return StringRet::Create("(-" + StringRet::Get(expr.getExpr()->accept(this)) + ")");
+            return "(-" + visit(expr.getExpr()) + ")";
         }
         case Operator::UnaryOperator::LogicalNot: {
-            return StringRet::Create("(!" + StringRet::Get(expr.getExpr()->accept(this)) + ")");
+            return "(!" + visit(expr.getExpr()) + ")";
         }
     }
     return {};
 }
 
-OpaqueType FunctionGenerator::visit(BinaryExpr &expr) {
+std::string FunctionGenerator::visit(BinaryExpr &expr) {
     using namespace Operator;
     std::unordered_map<BinaryOperator, std::string> mappedOp{
         {BinaryOperator::Or, "|"},
@@ -141,10 +135,10 @@ OpaqueType FunctionGenerator::visit(BinaryExpr &expr) {
         {BinaryOperator::LogicalAnd, "&&"}
     };
 
-    return StringRet::Create(
-        "(" + StringRet::Get(expr.getLhs()->accept(this)) + ") " +
+    return 
+        "(" + visit(expr.getLhs()) + ") " +
             mappedOp[expr.getBinaryOp()] +
-            " (" + StringRet::Get(expr.getRhs()->accept(this)) + ")");
+            " (" + visit(expr.getRhs()) + ")";
 }
 
 } // reflex
@@ -15,54 +15,64 @@ namespace reflex {
 
 class SourceOutputStream;
 
-class FunctionGenerator : public ASTStmtVisitor, public ASTDeclVisitor, public ASTExprVisitor {
+class FunctionGenerator : public ASTDeclVisitor<FunctionGenerator>,
+                          public ASTStmtVisitor<FunctionGenerator>,
+                          public ASTExprVisitor<FunctionGenerator, std::string> {
   public:
+    using ASTDeclVisitor::visit;
+    using ASTStmtVisitor::visit;
+    using ASTExprVisitor::visit;
+
     FunctionGenerator(SourceOutputStream &os, SourceOutputStream &declos, FunctionDecl *funcdecl)
         : os(os), declos(declos), funcdecl(funcdecl) {}
 
     virtual void emit();
 
   protected:
+    friend class ASTDeclVisitor<FunctionGenerator>;
+    friend class ASTStmtVisitor<FunctionGenerator>;
+    friend class ASTExprVisitor<FunctionGenerator, std::string>;
+
     std::string getVariableName(VariableDecl *decl);
 
-    OpaqueType visit(ClassDecl &decl) override ASTVisitorDefImpl
-    OpaqueType visit(InterfaceDecl &decl) override ASTVisitorDefImpl
-    OpaqueType visit(VariableDecl &decl) override;
-    OpaqueType visit(FieldDecl &decl) override ASTVisitorDefImpl
-    OpaqueType visit(ParamDecl &decl) override;
-    OpaqueType visit(FunctionDecl &decl) override;
-    OpaqueType visit(MethodDecl &decl) override ASTVisitorDefImpl
-    OpaqueType visit(CompilationUnit &unit) override ASTVisitorDefImpl
-
-    OpaqueType visit(BlockStmt &stmt) override;
-    OpaqueType visit(ReturnStmt &stmt) override;
-    OpaqueType visit(BreakStmt &stmt) override;
-    OpaqueType visit(ContinueStmt &stmt) override;
-    OpaqueType visit(IfStmt &stmt) override;
-    OpaqueType visit(ForStmt &stmt) override;
-    OpaqueType visit(WhileStmt &stmt) override;
-    OpaqueType visit(EmptyStmt &stmt) override;
-    OpaqueType visit(AssignmentStmt &stmt) override;
-    OpaqueType visit(IncDecStmt &stmt) override;
-    OpaqueType visit(ExpressionStmt &stmt) override;
-    OpaqueType visit(DeclStmt &stmt) override;
-
-    OpaqueType visit(DeclRefExpr &expr) override;
-    OpaqueType visit(UnaryExpr &expr) override;
-    OpaqueType visit(BinaryExpr &expr) override;
-    OpaqueType visit(NewExpr &expr) override;
-    OpaqueType visit(ImplicitCastExpr &expr) override;
-    OpaqueType visit(CastExpr &expr) override;
-    OpaqueType visit(IndexExpr &expr) override;
-    OpaqueType visit(SelectorExpr &expr) override;
-    OpaqueType visit(ArgumentExpr &expr) override;
-
-    OpaqueType visit(NumberLiteral &literal) override;
-    OpaqueType visit(StringLiteral &literal) override;
-    OpaqueType visit(BooleanLiteral &literal) override;
-    OpaqueType visit(NullLiteral &literal) override;
-    OpaqueType visit(ArrayLiteral &literal) override;
-    OpaqueType visit(FunctionLiteral &literal) override;
+    void visit(ClassDecl &decl) ASTVisitorDefImpl
+    void visit(InterfaceDecl &decl) ASTVisitorDefImpl
+    void visit(VariableDecl &decl);
+    void visit(FieldDecl &decl) ASTVisitorDefImpl
+    void visit(ParamDecl &decl);
+    void visit(FunctionDecl &decl);
+    void visit(MethodDecl &decl) ASTVisitorDefImpl
+    void visit(CompilationUnit &unit) ASTVisitorDefImpl
+
+    void visit(BlockStmt &stmt);
+    void visit(ReturnStmt &stmt);
+    void visit(BreakStmt &stmt);
+    void visit(ContinueStmt &stmt);
+    void visit(IfStmt &stmt);
+    void visit(ForStmt &stmt);
+    void visit(WhileStmt &stmt);
+    void visit(EmptyStmt &stmt);
+    void visit(AssignmentStmt &stmt);
+    void visit(IncDecStmt &stmt);
+    void visit(ExpressionStmt &stmt);
+    void visit(DeclStmt &stmt);
+
+    std::string visit(DeclRefExpr &expr);
+    std::string visit(UnaryExpr &expr);
+    std::string visit(BinaryExpr &expr);
+    std::string visit(NewExpr &expr);
+    std::string visit(ImplicitCastExpr &expr);
+    std::string visit(CastExpr &expr);
+    std::string visit(IndexExpr &expr);
+    std::string visit(SelectorExpr &expr);
+    std::string visit(ArgumentExpr &expr);
+
+    std::string visit(NumberLiteral &literal);
+    std::string visit(StringLiteral &literal);
+    std::string visit(BooleanLiteral &literal);
+    std::string visit(NullLiteral &literal);
+    std::string visit(ArrayLiteral &literal);
+    std::string visit(FunctionLiteral &literal);
 
   private:
     void registerLocalDecl(VariableDecl *decl);
@@ -0,0 +1,81 @@
+//
+// Created by henry on 2022-05-16.
+//
+
+#ifndef REFLEX_SRC_LEXER_KEYWORDTABLE_H_
+#define REFLEX_SRC_LEXER_KEYWORDTABLE_H_
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+#include "TokenDesc.h"
+
+namespace reflex {
+
+/// Perfect hash over KeywordList computed at compile time
+/// - the hash only reads the first and last character and the length
+/// - every keyword has its own slot, so classifying an identifier is one probe and one compare
+class KeywordTable {
+  public:
+    static constexpr size_t TableBits = 6;
+    static constexpr size_t TableSize = size_t{1} << TableBits;
+    static constexpr size_t NotFound = TableSize;
+
+  public:
+    constexpr KeywordTable() {
+        for (uint32_t seed = 0x9E3779B1u;; seed += 2) {
+            if (tryBuild(seed)) return;
+        }
+    }
+
+    /// @returns the slot of @p ident, or NotFound if it is not a keyword
+    [[nodiscard]] constexpr size_t find(std::string_view ident) const {
+        if (ident.empty()) return NotFound;
+        auto slot = hash(ident, seed);
+        return slots[slot].keyword == ident ? slot : NotFound;
+    }
+
+    /// @returns the keyword token type of @p ident, or Identifier if it is not a keyword
+    [[nodiscard]] constexpr TokenType::Value classify(std::string_view ident) const {
+        auto slot = find(ident);
+        return slot == NotFound ? TokenType::Identifier : slots[slot].type;
+    }
+
+    [[nodiscard]] constexpr std::string_view getKeyword(size_t slot) const { return slots[slot].keyword; }
+    [[nodiscard]] constexpr TokenType::Value getType(size_t slot) const { return slots[slot].type; }
+    [[nodiscard]] constexpr uint32_t getSeed() const { return seed; }
+
+  private:
+    struct Slot {
+      std::string_view keyword;
+      TokenType::Value type = TokenType::Identifier;
+    };
+
+    static constexpr size_t hash(std::string_view ident, uint32_t seed) {
+        const uint32_t key = (static_cast<uint32_t>(static_cast<unsigned char>(ident.front())) << 8
+            | static_cast<unsigned char>(ident.back()))
+            ^ (static_cast<uint32_t>(ident.size()) << 16);
+        return (key * seed) >> (32 - TableBits);
+    }
+
+    constexpr bool tryBuild(uint32_t candidate) {
+        slots = {};
+        for (const auto &[keyword, type]: KeywordList) {
+            auto &slot = slots[hash(keyword, candidate)];
+            if (!slot.keyword.empty()) return false;
+            slot = {keyword, type};
+        }
+        seed = candidate;
+        return true;
+    }
+
+    std::array<Slot, TableSize> slots{};
+    uint32_t seed = 0;
+};
+
+inline constexpr KeywordTable Keywords{};
+
+}
+
+#endif //REFLEX_SRC_LEXER_KEYWORDTABLE_H_
@@ -5,76 +5,99 @@
 #include "Lexer.h"
 
 #include "../Source/SourceManager.h"
+#include "ScannerTable.h"
+#include "KeywordTable.h"
 
 namespace reflex {
 
 LexerError::LexerError(const std::string &arg) : runtime_error(arg) {}
 
-Lexer::Lexer(SourceFile &source, std::string content, const TokenDesc &tokDesc, KeywordDesc keyDesc)
-    : state{0, 1, 1}, source(source), content(std::move(content)), keywordDesc(std::move(keyDesc)) {
-    for (const auto&[type, regexExpr]: tokDesc) {
-        std::regex parsedRegex{"^(" + regexExpr + ")"};
-        tokenDesc.emplace_back(type, std::move(parsedRegex));
-    }
+Lexer::Lexer(SourceFile &source, const ScanKernels &kernels)
+    : Lexer(source, 0, source.content().size(), kernels) {}
+
+Lexer::Lexer(SourceFile &source, size_t begin, size_t end, const ScanKernels &kernels)
+    : source(source), kernels(kernels), content(source.content()), index(begin), limit(end) {}
+
+/// @returns interned symbols of every keyword indexed by KeywordTable slot
+const std::array<Symbol, KeywordTable::TableSize> &getKeywordSymbols() {
+    static const auto symbols = [] {
+        std::array<Symbol, KeywordTable::TableSize> table;
+        for (size_t slot = 0; slot < table.size(); ++slot) table[slot] = Keywords.getKeyword(slot);
+        return table;
+    }();
+    return symbols;
 }
 
 bool Lexer::hasNext() const {
-    return state.index < content.size();
+    return index < limit;
 }
 
-std::string getErrorTokenLookahead(const std::string &content, size_t lookahead = 20) {
-    size_t end = content.length();
-    return content.substr(0, std::min(end, lookahead));
+std::string getErrorTokenLookahead(std::string_view content, size_t lookahead = 20) {
+    return std::string(content.substr(0, lookahead));
 }
 
-void Lexer::updateInternalState(const std::string &lexeme) {
-    state.index += lexeme.length();
-    for (const char c: lexeme) {
-        if (c == '\n') {
-            state.line += 1;
-            state.col = 1;
-        } else {
-            state.col += 1;
+size_t Lexer::matchToken(std::string_view current, TokenType::Value &type) const {
+    const char *begin = current.data();
+    const char *end = begin + current.size();
+    const auto charClass = Scanner.classOf(*begin);
+    if (charClass == ScannerTable::Space || charClass == ScannerTable::Newline) {
+        type = TokenType::WhiteSpace;
+        return kernels.skipWhitespace(begin + 1, end) - begin;
+    }
+    if (charClass == ScannerTable::Alpha) {
+        type = TokenType::Identifier;
+        return kernels.skipIdentifier(begin + 1, end) - begin;
+    }
+    if (*begin == '/' && current.size() > 1) {
+        if (begin[1] == '/') {
+            type = TokenType::SingleComment;
+            return kernels.findLineEnd(begin + 2, end) - begin;
+        }
+        if (begin[1] == '*') {
+            if (auto commentEnd = kernels.findBlockCommentEnd(begin + 2, end)) {
+                type = TokenType::MultiComment;
+                return commentEnd - begin;
+            }
         }
     }
+    return Scanner.match(current, type);
 }
 
-Lexer::LexerState Lexer::getLastValidSourceLoc() {
-    if (state.col == 1) {
-        if (state.line == 1) return {0, 1, 1};
-        return {state.index,
-                state.line - 1,
-                source.line(state.line - 1).size() + 1};
-    }
-    return state;
+bool isTrivia(TokenType::Value type) {
+    return type == TokenType::WhiteSpace
+        || type == TokenType::SingleComment
+        || type == TokenType::MultiComment;
 }
 
 Token Lexer::nextToken() {
-    if (!hasNext())
-        return {TokenType::EndOfFile, "EOF", source.getLastValidPosition()};
-
-    const std::string current = content.substr(state.index);
-
-    for (const auto &[type, regex]: tokenDesc) {
-        std::smatch matches;
-        if (std::regex_search(current, matches, regex)) {
-            auto lexeme = matches[0].str();
-            auto lastState = state;
-            updateInternalState(lexeme);
-            auto currState = getLastValidSourceLoc();
-            const auto &loc = SourceManager::createSourceLocation(
-                source,
-                lastState.line, lastState.col,
-                currState.line, currState.col - 1
-            );
-            if (type.getValue() == TokenType::Identifier && keywordDesc.count(lexeme)) {
-                return {keywordDesc[lexeme].getValue(), lexeme, loc};
-            }
-            return {type.getValue(), lexeme, loc};
-        }
+    TokenType::Value type;
+    std::string_view lexeme;
+    while (true) {
+        if (!hasNext())
+            return {TokenType::EndOfFile, "EOF", source.getLastValidPosition()};
+
+        const std::string_view current = content.substr(index);
+        const auto length = matchToken(current, type);
+        if (!length) throw LexerError("Unknown Token: " + getErrorTokenLookahead(current) + ".");
+
+        lexeme = current.substr(0, length);
+        if (!skipTrivia || !isTrivia(type)) break;
+        if (comments && type != TokenType::WhiteSpace) comments->push_back({index, index + length});
+        index += length;
     }
 
-    throw LexerError("Unknown Token: " + getErrorTokenLookahead(current) + ".");
+    const SourceLocation loc(source.getFileID(),
+                             static_cast<uint32_t>(index),
+                             static_cast<uint32_t>(index + lexeme.size()));
+    index += lexeme.size();
+    if (type == TokenType::Identifier) {
+        auto slot = Keywords.find(lexeme);
+        if (slot != KeywordTable::NotFound) {
+            return {Keywords.getType(slot), lexeme, loc, getKeywordSymbols()[slot]};
+        }
+        return {type, lexeme, loc, StringInterner::global().intern(lexeme)};
+    }
+    return {type, lexeme, loc};
 }
 
 }
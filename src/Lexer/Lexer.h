@@ -6,14 +6,15 @@
 #define REFLEX_SRC_LEXER_LEXER_H_
 
 #include <string>
-#include <regex>
+#include <string_view>
+#include <vector>
+#include <stdexcept>
 #include "../Source/Token.h"
 #include <TokenDesc.h>
+#include "ScanKernels.h"
 
 namespace reflex {
 
-using TokenRegexDesc = std::vector<std::pair<TokenType, std::regex>>;
-
 class LexerError : public std::runtime_error {
   public:
     explicit LexerError(const std::string &arg);
@@ -21,30 +22,49 @@ class LexerError : public std::runtime_error {
 
 class SourceFile;
 
+/// Byte range [begin, end) of a comment in SourceFile::content()
+struct CommentRange {
+  size_t begin;
+  size_t end;
+};
+
+/// Table driven lexer, tokens are recognized by the ScannerTable automaton
+/// with longest match semantics directly over the buffer owned by SourceFile.
+/// Whitespace, comment and identifier runs are skipped with vectorized ScanKernels
+/// - in trivia skipping mode whitespace and comments never become tokens or SourceLocations
+/// - tokens only carry byte offsets, line and column are resolved lazily by SourceLocation
 class Lexer {
-    struct LexerState {
-      size_t index;
-      size_t line;
-      size_t col;
-    };
   public:
-    explicit Lexer(SourceFile &source,
-                   std::string content,
-                   const TokenDesc &tokDesc,
-                   KeywordDesc keyDesc);
+    explicit Lexer(SourceFile &source, const ScanKernels &kernels = ScanKernels::best());
+    /// Lexes the tokens starting in [@p begin, @p end) of the content, the last token may extend past @p end
+    /// @note @p begin must be a token boundary of the whole file
+    Lexer(SourceFile &source, size_t begin, size_t end, const ScanKernels &kernels = ScanKernels::best());
 
     [[nodiscard]] bool hasNext() const;
     Token nextToken();
     SourceFile &getSource() { return source; }
+    /// @returns the number of bytes of the range in which tokens are still to be lexed
+    [[nodiscard]] size_t remaining() const { return index < limit ? limit - index : 0; }
+
+    /// Whether whitespace and comments are skipped instead of returned as tokens
+    void setSkipTrivia(bool skip) { skipTrivia = skip; }
+    [[nodiscard]] bool isSkippingTrivia() const { return skipTrivia; }
+
+    /// Side channel for tools that need comments while trivia is skipped, pass nullptr to stop collecting
+    void setCommentSink(std::vector<CommentRange> *sink) { comments = sink; }
+
+    /// Recognizes the longest token at the front of @p current without advancing the lexer
+    /// @returns the length of the token, 0 if no token matches
+    size_t matchToken(std::string_view current, TokenType::Value &type) const;
   private:
-    void updateInternalState(const std::string &lexeme);
-    LexerState getLastValidSourceLoc();
 
     SourceFile &source;
-    std::string content;
-    LexerState state;
-    TokenRegexDesc tokenDesc;
-    KeywordDesc keywordDesc;
+    const ScanKernels &kernels;
+    std::string_view content;
+    size_t index;
+    size_t limit;
+    bool skipTrivia = false;
+    std::vector<CommentRange> *comments = nullptr;
 };
 
 }
@@ -0,0 +1,269 @@
+//
+// Created by henry on 2022-05-17.
+//
+
+#include "ScanKernels.h"
+
+#include <cstdint>
+#include <stdexcept>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define REFLEX_SCAN_X86
+#include <immintrin.h>
+#define REFLEX_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+namespace reflex {
+
+std::string getScanISAString(ScanISA isa) {
+    switch (isa) {
+        case ScanISA::Scalar: return "scalar";
+        case ScanISA::SSE42: return "sse4.2";
+        case ScanISA::AVX2: return "avx2";
+    }
+    return "unknown";
+}
+
+namespace {
+
+inline bool isWhitespace(unsigned char c) { return c == ' ' || (c >= '\t' && c <= '\r'); }
+inline bool isIdentifierChar(unsigned char c) {
+    return c == '_' || static_cast<unsigned char>((c | 0x20) - 'a') < 26 || static_cast<unsigned char>(c - '0') < 10;
+}
+
+const char *skipWhitespaceScalar(const char *pos, const char *end) {
+    while (pos < end && isWhitespace(*pos)) ++pos;
+    return pos;
+}
+
+template<char First, char Second>
+const char *findEitherScalar(const char *pos, const char *end) {
+    while (pos < end && *pos != First && *pos != Second) ++pos;
+    return pos;
+}
+
+const char *findLineEndScalar(const char *pos, const char *end) {
+    return findEitherScalar<'\n', '\r'>(pos, end);
+}
+
+const char *findQuoteOrSlashScalar(const char *pos, const char *end) {
+    return findEitherScalar<'"', '/'>(pos, end);
+}
+
+const char *findBlockCommentEndScalar(const char *pos, const char *end) {
+    for (; pos + 1 < end; ++pos) {
+        if (pos[0] == '*' && pos[1] == '/') return pos + 2;
+    }
+    return nullptr;
+}
+
+const char *skipIdentifierScalar(const char *pos, const char *end) {
+    while (pos < end && isIdentifierChar(*pos)) ++pos;
+    return pos;
+}
+
+#ifdef REFLEX_SCAN_X86
+
+// SSE4.2: explicit length string compares, so NUL bytes in the source are handled like any other byte
+
+constexpr int RangeMismatch = _SIDD_UBYTE_OPS | _SIDD_CMP_RANGES | _SIDD_NEGATIVE_POLARITY | _SIDD_LEAST_SIGNIFICANT;
+constexpr int AnyMatch = _SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ANY | _SIDD_LEAST_SIGNIFICANT;
+
+REFLEX_TARGET("sse4.2")
+const char *skipWhitespaceSSE42(const char *pos, const char *end) {
+    const __m128i ranges = _mm_setr_epi8('\t', '\r', ' ', ' ', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+    for (; end - pos >= 16; pos += 16) {
+        auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pos));
+        auto index = _mm_cmpestri(ranges, 4, chunk, 16, RangeMismatch);
+        if (index != 16) return pos + index;
+    }
+    return skipWhitespaceScalar(pos, end);
+}
+
+template<char First, char Second>
+REFLEX_TARGET("sse4.2")
+const char *findEitherSSE42(const char *pos, const char *end) {
+    const __m128i set = _mm_setr_epi8(First, Second, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+    for (; end - pos >= 16; pos += 16) {
+        auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pos));
+        auto index = _mm_cmpestri(set, 2, chunk, 16, AnyMatch);
+        if (index != 16) return pos + index;
+    }
+    return findEitherScalar<First, Second>(pos, end);
+}
+
+REFLEX_TARGET("sse4.2")
+const char *findLineEndSSE42(const char *pos, const char *end) {
+    return findEitherSSE42<'\n', '\r'>(pos, end);
+}
+
+REFLEX_TARGET("sse4.2")
+const char *findQuoteOrSlashSSE42(const char *pos, const char *end) {
+    return findEitherSSE42<'"', '/'>(pos, end);
+}
+
+REFLEX_TARGET("sse4.2")
+const char *findBlockCommentEndSSE42(const char *pos, const char *end) {
+    const auto star = _mm_set1_epi8('*');
+    const auto slash = _mm_set1_epi8('/');
+    for (; end - pos >= 17; pos += 16) {
+        auto current = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pos));
+        auto following = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pos + 1));
+        auto mask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(current, star),
+                                                    _mm_cmpeq_epi8(following, slash)));
+        if (mask) return pos + __builtin_ctz(mask) + 2;
+    }
+    return findBlockCommentEndScalar(pos, end);
+}
+
+REFLEX_TARGET("sse4.2")
+const char *skipIdentifierSSE42(const char *pos, const char *end) {
+    const __m128i ranges = _mm_setr_epi8('a', 'z', 'A', 'Z', '0', '9', '_', '_', 0, 0, 0, 0, 0, 0, 0, 0);
+    for (; end - pos >= 16; pos += 16) {
+        auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pos));
+        auto index = _mm_cmpestri(ranges, 8, chunk, 16, RangeMismatch);
+        if (index != 16) return pos + index;
+    }
+    return skipIdentifierScalar(pos, end);
+}
+
+// AVX2: byte classes are built from compares, unsigned ranges use the min_epu8 trick
+
+REFLEX_TARGET("avx2")
+inline __m256i inRange(__m256i chunk, char low, char high) {
+    auto shifted = _mm256_sub_epi8(chunk, _mm256_set1_epi8(low));
+    auto bound = _mm256_set1_epi8(static_cast<char>(high - low));
+    return _mm256_cmpeq_epi8(_mm256_min_epu8(shifted, bound), shifted);
+}
+
+REFLEX_TARGET("avx2")
+const char *skipWhitespaceAVX2(const char *pos, const char *end) {
+    const auto space = _mm256_set1_epi8(' ');
+    for (; end - pos >= 32; pos += 32) {
+        auto chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pos));
+        auto whitespace = _mm256_or_si256(_mm256_cmpeq_epi8(chunk, space), inRange(chunk, '\t', '\r'));
+        auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(whitespace));
+        if (mask != UINT32_MAX) return pos + __builtin_ctz(~mask);
+    }
+    return skipWhitespaceSSE42(pos, end);
+}
+
+template<char First, char Second>
+REFLEX_TARGET("avx2")
+const char *findEitherAVX2(const char *pos, const char *end) {
+    const auto first = _mm256_set1_epi8(First);
+    const auto second = _mm256_set1_epi8(Second);
+    for (; end - pos >= 32; pos += 32) {
+        auto chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pos));
+        auto either = _mm256_or_si256(_mm256_cmpeq_epi8(chunk, first), _mm256_cmpeq_epi8(chunk, second));
+        auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(either));
+        if (mask) return pos + __builtin_ctz(mask);
+    }
+    return findEitherSSE42<First, Second>(pos, end);
+}
+
+REFLEX_TARGET("avx2")
+const char *findLineEndAVX2(const char *pos, const char *end) {
+    return findEitherAVX2<'\n', '\r'>(pos, end);
+}
+
+REFLEX_TARGET("avx2")
+const char *findQuoteOrSlashAVX2(const char *pos, const char *end) {
+    return findEitherAVX2<'"', '/'>(pos, end);
+}
+
+REFLEX_TARGET("avx2")
+const char *findBlockCommentEndAVX2(const char *pos, const char *end) {
+    const auto star = _mm256_set1_epi8('*');
+    const auto slash = _mm256_set1_epi8('/');
+    for (; end - pos >= 33; pos += 32) {
+        auto current = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pos));
+        auto following = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pos + 1));
+        auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(
+            _mm256_and_si256(_mm256_cmpeq_epi8(current, star), _mm256_cmpeq_epi8(following, slash))));
+        if (mask) return pos + __builtin_ctz(mask) + 2;
+    }
+    return findBlockCommentEndSSE42(pos, end);
+}
+
+REFLEX_TARGET("avx2")
+const char *skipIdentifierAVX2(const char *pos, const char *end) {
+    const auto lowercase = _mm256_set1_epi8(0x20);
+    const auto underscore = _mm256_set1_epi8('_');
+    for (; end - pos >= 32; pos += 32) {
+        auto chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pos));
+        auto letter = inRange(_mm256_or_si256(chunk, lowercase), 'a', 'z');
+        auto digit = inRange(chunk, '0', '9');
+        auto ident = _mm256_or_si256(_mm256_or_si256(letter, digit), _mm256_cmpeq_epi8(chunk, underscore));
+        auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(ident));
+        if (mask != UINT32_MAX) return pos + __builtin_ctz(~mask);
+    }
+    return skipIdentifierSSE42(pos, end);
+}
+
+#endif
+
+const ScanKernels ScalarKernels{
+    ScanISA::Scalar,
+    skipWhitespaceScalar,
+    findLineEndScalar,
+    findBlockCommentEndScalar,
+    skipIdentifierScalar,
+    findQuoteOrSlashScalar
+};
+
+#ifdef REFLEX_SCAN_X86
+const ScanKernels SSE42Kernels{
+    ScanISA::SSE42,
+    skipWhitespaceSSE42,
+    findLineEndSSE42,
+    findBlockCommentEndSSE42,
+    skipIdentifierSSE42,
+    findQuoteOrSlashSSE42
+};
+
+const ScanKernels AVX2Kernels{
+    ScanISA::AVX2,
+    skipWhitespaceAVX2,
+    findLineEndAVX2,
+    findBlockCommentEndAVX2,
+    skipIdentifierAVX2,
+    findQuoteOrSlashAVX2
+};
+#endif
+
+}
+
+bool ScanKernels::isSupported(ScanISA isa) {
+    switch (isa) {
+        case ScanISA::Scalar: return true;
+#ifdef REFLEX_SCAN_X86
+        case ScanISA::SSE42: return __builtin_cpu_supports("sse4.2");
+        case ScanISA::AVX2: return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("sse4.2");
+#endif
+        default: return false;
+    }
+}
+
+const ScanKernels &ScanKernels::get(ScanISA isa) {
+    if (!isSupported(isa)) {
+        throw std::invalid_argument("ScanKernels: " + getScanISAString(isa) + " is not supported");
+    }
+    switch (isa) {
+#ifdef REFLEX_SCAN_X86
+        case ScanISA::SSE42: return SSE42Kernels;
+        case ScanISA::AVX2: return AVX2Kernels;
+#endif
+        default: return ScalarKernels;
+    }
+}
+
+const ScanKernels &ScanKernels::best() {
+    static const ScanKernels &kernels = get(
+        isSupported(ScanISA::AVX2) ? ScanISA::AVX2 :
+        isSupported(ScanISA::SSE42) ? ScanISA::SSE42 : ScanISA::Scalar
+    );
+    return kernels;
+}
+
+}
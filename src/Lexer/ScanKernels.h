@@ -0,0 +1,53 @@
+//
+// Created by henry on 2022-05-17.
+//
+
+#ifndef REFLEX_SRC_LEXER_SCANKERNELS_H_
+#define REFLEX_SRC_LEXER_SCANKERNELS_H_
+
+#include <string>
+
+namespace reflex {
+
+/// Instruction sets the scan kernels are implemented for
+enum class ScanISA {
+  Scalar,
+  SSE42,
+  AVX2
+};
+
+std::string getScanISAString(ScanISA isa);
+
+/// Vectorized kernels for the byte runs that dominate real sources, every kernel
+/// scans [pos, end) and returns the first position that is not part of the run
+struct ScanKernels {
+  ScanISA isa;
+
+  /// @returns the first byte that is not one of ' ', '\\t', '\\n', '\\v', '\\f', '\\r'
+  const char *(*skipWhitespace)(const char *pos, const char *end);
+
+  /// @returns the first '\\n' or '\\r', the end of a line comment
+  const char *(*findLineEnd)(const char *pos, const char *end);
+
+  /// @returns the position after the first "*\/", or nullptr if the block comment is unterminated
+  const char *(*findBlockCommentEnd)(const char *pos, const char *end);
+
+  /// @returns the first byte that is not one of [_a-zA-Z0-9]
+  const char *(*skipIdentifier)(const char *pos, const char *end);
+
+  /// @returns the first '"' or '/', the only bytes that may open a string literal or a comment
+  const char *(*findQuoteOrSlash)(const char *pos, const char *end);
+
+  /// @returns true if the running cpu supports @p isa
+  static bool isSupported(ScanISA isa);
+
+  /// @throws std::invalid_argument if @p isa is not supported
+  static const ScanKernels &get(ScanISA isa);
+
+  /// @returns the kernels of the widest supported instruction set
+  static const ScanKernels &best();
+};
+
+}
+
+#endif //REFLEX_SRC_LEXER_SCANKERNELS_H_
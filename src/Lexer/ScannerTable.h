@@ -0,0 +1,170 @@
+//
+// Created by henry on 2022-05-14.
+//
+
+#ifndef REFLEX_SRC_LEXER_SCANNERTABLE_H_
+#define REFLEX_SRC_LEXER_SCANNERTABLE_H_
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+#include "TokenDesc.h"
+
+namespace reflex {
+
+/// Deterministic finite automaton recognizing every token in TokenDesc.h
+/// - bytes are first folded into equivalence classes by a 256 entry table
+/// - state 0 is the dead state and state 1 is the start state
+/// - the table is computed at compile time from PunctuatorDesc
+class ScannerTable {
+  public:
+    static constexpr uint8_t DeadState = 0;
+    static constexpr uint8_t StartState = 1;
+    static constexpr uint8_t NoToken = 0xFF;
+    static constexpr size_t MaxStates = 64;
+    static constexpr size_t MaxClasses = 48;
+
+    enum CharClass : uint8_t {
+      Other = 0,
+      Space,
+      Newline,
+      Alpha,
+      Digit,
+      Quote,
+      FirstPunctuator
+    };
+
+  public:
+    constexpr ScannerTable() {
+        for (size_t c = 0; c < charClass.size(); ++c) {
+            if (c == ' ' || c == '\t' || c == '\v' || c == '\f') charClass[c] = Space;
+            else if (c == '\n' || c == '\r') charClass[c] = Newline;
+            else if (c == '_' || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z')) charClass[c] = Alpha;
+            else if (c >= '0' && c <= '9') charClass[c] = Digit;
+            else if (c == '"') charClass[c] = Quote;
+        }
+        for (const auto &[lexeme, type]: PunctuatorDesc) {
+            for (const char c: lexeme) {
+                auto &cls = charClass[static_cast<unsigned char>(c)];
+                if (cls == Other) cls = numClasses++;
+            }
+        }
+        if (numClasses > MaxClasses) throw "ScannerTable: too many character classes";
+        accepting.fill(NoToken);
+
+        newState(); // dead state
+        newState(); // start state
+        for (const auto &[lexeme, type]: PunctuatorDesc) addLexeme(lexeme, type);
+
+        // \s+
+        auto whitespace = newState(TokenType::WhiteSpace);
+        addTransition(StartState, Space, whitespace);
+        addTransition(StartState, Newline, whitespace);
+        addTransition(whitespace, Space, whitespace);
+        addTransition(whitespace, Newline, whitespace);
+
+        // [_a-zA-Z][_a-zA-Z0-9]*
+        auto identifier = newState(TokenType::Identifier);
+        addTransition(StartState, Alpha, identifier);
+        addTransition(identifier, Alpha, identifier);
+        addTransition(identifier, Digit, identifier);
+
+        // ([0-9]*[.])?[0-9]+ where a leading '.' is claimed by Period first
+        auto integer = newState(TokenType::NumberLiteral);
+        auto point = newState();
+        auto fraction = newState(TokenType::NumberLiteral);
+        addTransition(StartState, Digit, integer);
+        addTransition(integer, Digit, integer);
+        addTransition(integer, classOf('.'), point);
+        addTransition(point, Digit, fraction);
+        addTransition(fraction, Digit, fraction);
+
+        // "[^"]*"
+        auto stringBody = newState();
+        auto stringEnd = newState(TokenType::StringLiteral);
+        addTransition(StartState, Quote, stringBody);
+        addTransition(stringBody, Quote, stringEnd);
+        addTransitionExcept(stringBody, Quote, stringBody);
+
+        // //.* and the lazy /\*[\s\S]*?\*/
+        auto slash = next[StartState][classOf('/')];
+        auto lineComment = newState(TokenType::SingleComment);
+        addTransition(slash, classOf('/'), lineComment);
+        addTransitionExcept(lineComment, Newline, lineComment);
+
+        auto blockBody = newState();
+        auto blockStar = newState();
+        auto blockEnd = newState(TokenType::MultiComment);
+        addTransition(slash, classOf('*'), blockBody);
+        addTransition(blockBody, classOf('*'), blockStar);
+        addTransitionExcept(blockBody, classOf('*'), blockBody);
+        addTransition(blockStar, classOf('*'), blockStar);
+        addTransition(blockStar, classOf('/'), blockEnd);
+        addTransitionExcept(blockStar, classOf('*'), blockBody);
+    }
+
+    [[nodiscard]] constexpr uint8_t classOf(char c) const { return charClass[static_cast<unsigned char>(c)]; }
+    [[nodiscard]] constexpr uint8_t transition(uint8_t state, char c) const { return next[state][classOf(c)]; }
+    [[nodiscard]] constexpr uint8_t getAccepting(uint8_t state) const { return accepting[state]; }
+    [[nodiscard]] constexpr size_t getNumStates() const { return numStates; }
+    [[nodiscard]] constexpr size_t getNumClasses() const { return numClasses; }
+
+    /// Longest match starting at the beginning of @p input
+    /// @param type set to the matched token type
+    /// @returns the length of the match, 0 if no token matches
+    constexpr size_t match(std::string_view input, TokenType::Value &type) const {
+        size_t length = 0;
+        uint8_t state = StartState;
+        for (size_t i = 0; i < input.size(); ++i) {
+            state = transition(state, input[i]);
+            if (state == DeadState) break;
+            if (accepting[state] != NoToken) {
+                length = i + 1;
+                type = static_cast<TokenType::Value>(accepting[state]);
+            }
+        }
+        return length;
+    }
+
+  private:
+    constexpr uint8_t newState(uint8_t token = NoToken) {
+        if (numStates == MaxStates) throw "ScannerTable: too many states";
+        accepting[numStates] = token;
+        return numStates++;
+    }
+
+    constexpr void addTransition(uint8_t from, uint8_t cls, uint8_t to) {
+        if (next[from][cls] != DeadState && next[from][cls] != to) throw "ScannerTable: ambiguous transition";
+        next[from][cls] = to;
+    }
+
+    /// transition on every class without an existing transition, other than @p excluded
+    constexpr void addTransitionExcept(uint8_t from, uint8_t excluded, uint8_t to) {
+        for (uint8_t cls = 0; cls < numClasses; ++cls) {
+            if (cls != excluded && next[from][cls] == DeadState) next[from][cls] = to;
+        }
+    }
+
+    constexpr void addLexeme(std::string_view lexeme, TokenType::Value type) {
+        uint8_t state = StartState;
+        for (const char c: lexeme) {
+            auto &target = next[state][classOf(c)];
+            if (target == DeadState) target = newState();
+            state = target;
+        }
+        if (accepting[state] == NoToken) accepting[state] = type;
+    }
+
+    std::array<uint8_t, 256> charClass{};
+    std::array<std::array<uint8_t, MaxClasses>, MaxStates> next{};
+    std::array<uint8_t, MaxStates> accepting{};
+    uint8_t numStates = 0;
+    uint8_t numClasses = FirstPunctuator;
+};
+
+inline constexpr ScannerTable Scanner{};
+
+}
+
+#endif //REFLEX_SRC_LEXER_SCANNERTABLE_H_
@@ -0,0 +1,136 @@
+//
+// Created by henry on 2022-05-20.
+//
+
+#include "TokenBuffer.h"
+
+#include <cstring>
+#include <exception>
+#include <optional>
+#include <thread>
+
+#include "Lexer.h"
+#include "../Source/SourceManager.h"
+
+namespace reflex {
+
+TokenBuffer::TokenBuffer(Lexer &lexer) : source(lexer.getSource()), content(source.content()) {
+    // roughly one token every four bytes once trivia is dropped, counting only the range of this lexer
+    const auto expected = lexer.remaining() / 4 + 1;
+    kinds.reserve(expected);
+    begins.reserve(expected);
+    ends.reserve(expected);
+    symbols.reserve(expected);
+
+    lexer.setSkipTrivia(true);
+    while (true) {
+        const auto token = lexer.nextToken();
+        const auto loc = token.getLocInfo();
+        kinds.push_back(token.getTokenType().getValue());
+        begins.push_back(loc.getBegin());
+        ends.push_back(loc.getEnd());
+        symbols.push_back(token.getSymbol());
+        if (token.getTokenType().getValue() == TokenType::EndOfFile) break;
+    }
+}
+
+TokenBuffer::TokenBuffer(SourceFile &source, size_t threads, const ScanKernels &kernels)
+    : source(source), content(source.content()) {
+    // below this size spawning threads costs more than lexing
+    constexpr size_t MinChunkSize = 256 << 10;
+    const auto chunks = std::max<size_t>(1, std::min(threads, content.size() / MinChunkSize));
+    auto splits = findSplitPoints(content, chunks, kernels);
+    splits.insert(splits.begin(), 0);
+    splits.push_back(content.size());
+
+    const auto count = splits.size() - 1;
+    std::vector<std::optional<TokenBuffer>> buffers(count);
+    std::vector<std::exception_ptr> errors(count);
+    auto lexChunk = [&](size_t chunk) {
+        try {
+            Lexer lexer(source, splits[chunk], splits[chunk + 1], kernels);
+            buffers[chunk].emplace(lexer);
+        } catch (...) {
+            errors[chunk] = std::current_exception();
+        }
+    };
+    std::vector<std::thread> workers;
+    for (size_t chunk = 1; chunk < count; ++chunk) workers.emplace_back(lexChunk, chunk);
+    lexChunk(0);
+    for (auto &worker: workers) worker.join();
+
+    for (auto &error: errors) {
+        if (error) std::rethrow_exception(error);
+    }
+    size_t total = 0;
+    for (auto &buffer: buffers) total += buffer->size();
+    kinds.reserve(total);
+    begins.reserve(total);
+    ends.reserve(total);
+    symbols.reserve(total);
+    for (size_t chunk = 0; chunk < count; ++chunk) append(*buffers[chunk], chunk + 1 == count);
+}
+
+void TokenBuffer::append(const TokenBuffer &chunk, bool withEndOfFile) {
+    const auto count = withEndOfFile ? chunk.size() : chunk.size() - 1;
+    kinds.insert(kinds.end(), chunk.kinds.begin(), chunk.kinds.begin() + count);
+    begins.insert(begins.end(), chunk.begins.begin(), chunk.begins.begin() + count);
+    ends.insert(ends.end(), chunk.ends.begin(), chunk.ends.begin() + count);
+    symbols.insert(symbols.end(), chunk.symbols.begin(), chunk.symbols.begin() + count);
+}
+
+/// Walks the content the way the Lexer classifies it, but only distinguishes code from string
+/// literals and comments. A newline in code always ends a whitespace token, so lexing can start after it.
+/// Unterminated strings and comments stop the walk, the rest of the file then stays in one chunk.
+std::vector<size_t> TokenBuffer::findSplitPoints(std::string_view content, size_t chunks, const ScanKernels &kernels) {
+    std::vector<size_t> splits;
+    const char *begin = content.data();
+    const char *end = begin + content.size();
+    size_t nextChunk = 1;
+    auto target = [&] { return begin + content.size() * nextChunk / chunks; };
+
+    const char *pos = begin;
+    while (nextChunk < chunks && pos < end) {
+        const char *special = kernels.findQuoteOrSlash(pos, end);
+        // split in the code segment [pos, special) at the first newline after the target
+        while (nextChunk < chunks && target() < special) {
+            const char *from = std::max(pos, target());
+            auto newline = static_cast<const char *>(std::memchr(from, '\n', special - from));
+            if (!newline) break;
+            splits.push_back(newline + 1 - begin);
+            while (nextChunk < chunks && target() <= newline + 1) ++nextChunk;
+        }
+        if (special == end) break;
+
+        if (*special == '"') {
+            auto closing = static_cast<const char *>(std::memchr(special + 1, '"', end - special - 1));
+            if (!closing) break;
+            pos = closing + 1;
+        } else if (special + 1 < end && special[1] == '/') {
+            pos = kernels.findLineEnd(special + 2, end);
+        } else if (special + 1 < end && special[1] == '*') {
+            pos = kernels.findBlockCommentEnd(special + 2, end);
+            if (!pos) break;
+        } else {
+            pos = special + 1;
+        }
+    }
+    return splits;
+}
+
+std::string_view TokenBuffer::getLexeme(size_t index) const {
+    index = clamp(index);
+    if (kinds[index] == TokenType::EndOfFile) return "EOF";
+    return content.substr(begins[index], ends[index] - begins[index]);
+}
+
+SourceLocation TokenBuffer::getLocation(size_t index) const {
+    index = clamp(index);
+    return {source.getFileID(), begins[index], ends[index]};
+}
+
+Token TokenBuffer::getToken(size_t index) const {
+    return {getKind(index), getLexeme(index), getLocation(index), getSymbol(index)};
+}
+
+}
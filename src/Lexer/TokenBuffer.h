@@ -0,0 +1,64 @@
+//
+// Created by henry on 2022-05-20.
+//
+
+#ifndef REFLEX_SRC_LEXER_TOKENBUFFER_H_
+#define REFLEX_SRC_LEXER_TOKENBUFFER_H_
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "../Source/Token.h"
+#include "ScanKernels.h"
+
+namespace reflex {
+
+class Lexer;
+class SourceFile;
+
+/// Token stream of a whole file lexed up front into parallel arrays
+/// - whitespace and comments are not stored, the last token is always EndOfFile
+/// - indices past the end clamp to the EndOfFile token, so any lookahead is safe
+class TokenBuffer {
+  public:
+    /// Lexes everything @p lexer has left, switching it to trivia skipping mode
+    explicit TokenBuffer(Lexer &lexer);
+
+    /// Lexes @p source on up to @p threads threads, the result is identical to lexing it sequentially
+    /// - the content is split after newlines that a pre-scan proves to be outside strings and comments
+    /// - if several chunks fail to lex, the error of the first one in source order is rethrown
+    TokenBuffer(SourceFile &source, size_t threads, const ScanKernels &kernels = ScanKernels::best());
+
+    /// @returns offsets where lexing can start independently, ascending and excluding 0,
+    ///          close to multiples of content.size() / @p chunks
+    static std::vector<size_t> findSplitPoints(std::string_view content, size_t chunks,
+                                               const ScanKernels &kernels = ScanKernels::best());
+
+    [[nodiscard]] size_t size() const { return kinds.size(); }
+    [[nodiscard]] SourceFile &getSource() const { return source; }
+
+    [[nodiscard]] TokenType::Value getKind(size_t index) const {
+        return static_cast<TokenType::Value>(kinds[clamp(index)]);
+    }
+    [[nodiscard]] Symbol getSymbol(size_t index) const { return symbols[clamp(index)]; }
+    [[nodiscard]] std::string_view getLexeme(size_t index) const;
+    [[nodiscard]] SourceLocation getLocation(size_t index) const;
+    [[nodiscard]] Token getToken(size_t index) const;
+
+  private:
+    void append(const TokenBuffer &chunk, bool withEndOfFile);
+
+    [[nodiscard]] size_t clamp(size_t index) const { return index < kinds.size() ? index : kinds.size() - 1; }
+
+    SourceFile &source;
+    std::string_view content;
+    std::vector<uint8_t> kinds;
+    std::vector<uint32_t> begins;
+    std::vector<uint32_t> ends;
+    std::vector<Symbol> symbols;
+};
+
+}
+
+#endif //REFLEX_SRC_LEXER_TOKENBUFFER_H_
@@ -5,9 +5,11 @@
 #ifndef REFLEX_SRC_LEXER_TOKENDESC_H_
 #define REFLEX_SRC_LEXER_TOKENDESC_H_
 
+#include <array>
 #include <vector>
 #include <unordered_map>
 #include <string>
+#include <string_view>
 
 #include "../Source/TokenType.h"
 
@@ -16,6 +18,70 @@ namespace reflex {
 using TokenDesc = std::vector<std::pair<TokenType, std::string>>;
 using KeywordDesc = std::unordered_map<std::string, TokenType>;
 
+/// Fixed lexeme tokens in matching priority order, a lexeme must appear before its prefixes
+inline constexpr std::array<std::pair<std::string_view, TokenType::Value>, 33> PunctuatorDesc{{
+    {"::", TokenType::NameSeparator},
+    {":", TokenType::Colon},
+    {";", TokenType::SemiColon},
+    {",", TokenType::Comma},
+    {".", TokenType::Period},
+    {"~", TokenType::Complement},
+    {"==", TokenType::Compare},
+    {"!=", TokenType::CompareNot},
+    {"<=", TokenType::CompareLessEqual},
+    {">=", TokenType::CompareGreaterEqual},
+    {"++", TokenType::PostInc},
+    {"--", TokenType::PostDec},
+    {"<", TokenType::LAngleBracket},
+    {">", TokenType::RAngleBracket},
+    {"->", TokenType::ReturnArrow},
+    {"+=", TokenType::AssignAdd},
+    {"-=", TokenType::AssignSub},
+    {"+", TokenType::Add},
+    {"-", TokenType::Sub},
+    {"*", TokenType::Star},
+    {"/", TokenType::Div},
+    {"%", TokenType::Mod},
+    {"|", TokenType::LogicalOr},
+    {"&", TokenType::LogicalAnd},
+    {"!", TokenType::LogicalNot},
+    {"=", TokenType::Assign},
+    {"@", TokenType::Annotation},
+    {"[", TokenType::LBracket},
+    {"]", TokenType::RBracket},
+    {"(", TokenType::LParen},
+    {")", TokenType::RParen},
+    {"{", TokenType::LBrace},
+    {"}", TokenType::RBrace},
+}};
+
+/// Reserved identifiers and the token type they are lexed as
+inline constexpr std::array<std::pair<std::string_view, TokenType::Value>, 22> KeywordList{{
+    {"const", TokenType::Const},
+    {"var", TokenType::Var},
+    {"func", TokenType::Func},
+    {"return", TokenType::Return},
+    {"true", TokenType::BoolLiteral},
+    {"false", TokenType::BoolLiteral},
+    {"null", TokenType::NullLiteral},
+    {"class", TokenType::Class},
+    {"new", TokenType::New},
+    {"interface", TokenType::Interface},
+    {"or", TokenType::Or},
+    {"and", TokenType::And},
+    {"if", TokenType::If},
+    {"else", TokenType::Else},
+    {"for", TokenType::For},
+    {"while", TokenType::While},
+    {"cast", TokenType::Cast},
+    {"try", TokenType::Try},
+    {"in", TokenType::In},
+    {"catch", TokenType::Catch},
+    {"break", TokenType::Break},
+    {"continue", TokenType::Continue},
+}};
+
+/// @returns the regex description of every token, in matching priority order
 TokenDesc getTokenDescription();
 KeywordDesc getKeywordDescription();
 
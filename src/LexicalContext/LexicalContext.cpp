@@ -56,7 +56,7 @@ std::ostream &printIndent(std::ostream &os, size_t indent) {
 void LexicalContext::dump(std::ostream &os, LexicalScope *start, size_t indent) {
     printIndent(os, indent) << "Scope(" << start->getScopename() << ") ";
     if (start->getNodeDecl()->location()) {
-        os << start->getNodeDecl()->location()->getStringRepr() << " {";
+        os << start->getNodeDecl()->location().getStringRepr() << " {";
     } else {
         os << " <noloc> {";
     }
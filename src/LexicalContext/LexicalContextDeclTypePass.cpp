@@ -23,20 +23,22 @@ LexicalContextDeclTypePass::ReleaseScope::~ReleaseScope() { pass.scopes.pop(); }
 
 void LexicalContextDeclTypePass::performPass(CompilationUnit *unit) {
     visit(*unit);
+    // all inheritance and methods are declared, the analysis pass only queries the index and the traits
+    typeContext.buildHierarchy();
+    typeContext.buildTraits();
 }
 
-OpaqueType LexicalContextDeclTypePass::visit(CompilationUnit &unit) {
+void LexicalContextDeclTypePass::visit(CompilationUnit &unit) {
     ReleaseScope _(*this, unit.getScope());
     for (auto decl: unit.getDecls()) {
-        decl->accept(this);
+        visit(decl);
     }
-    return {};
 }
 
-OpaqueType LexicalContextDeclTypePass::visit(ClassDecl &decl) {
+void LexicalContextDeclTypePass::visit(ClassDecl &decl) {
     ReleaseScope _(*this, decl.getScope()->getChild());
     auto scope = scopes.top();
-    auto classType = dynamic_cast<ClassType *>(decl.getType());
+    auto classType = dyn_cast<ClassType>(decl.getType());
 
     if (decl.getBaseclass()) {
         auto baseclass = typeParser.parseClassType(decl.getBaseclass(), scope);
@@ -48,30 +50,26 @@ OpaqueType LexicalContextDeclTypePass::visit(ClassDecl &decl) {
         classType->addInterface(interface);
     }
 
-    for (auto nested: decl.getDecls()) nested->accept(this);
-    for (auto field: decl.getFields()) field->accept(this);
-    for (auto method: decl.getMethods()) method->accept(this);
-
-    return {};
+    for (auto nested: decl.getDecls()) visit(nested);
+    for (auto field: decl.getFields()) visit(field);
+    for (auto method: decl.getMethods()) visit(method);
 }
 
-OpaqueType LexicalContextDeclTypePass::visit(InterfaceDecl &decl) {
+void LexicalContextDeclTypePass::visit(InterfaceDecl &decl) {
     ReleaseScope _(*this, decl.getScope()->getChild());
     auto scope = scopes.top();
-    auto interfaceType = dynamic_cast<InterfaceType *>(decl.getType());
+    auto interfaceType = dyn_cast<InterfaceType>(decl.getType());
 
     for (auto interfaceRef: decl.getInterfaces()) {
         auto interface = typeParser.parseInterfaceType(interfaceRef, scope);
         interfaceType->addInterface(interface);
     }
 
-    for (auto nested: decl.getDecls()) nested->accept(this);
-    for (auto method: decl.getMethods()) method->accept(this);
-
-    return {};
+    for (auto nested: decl.getDecls()) visit(nested);
+    for (auto method: decl.getMethods()) visit(method);
 }
 
-OpaqueType LexicalContextDeclTypePass::visit(VariableDecl &decl) {
+void LexicalContextDeclTypePass::visit(VariableDecl &decl) {
     if (decl.isGlobalVariable()) {
         auto type = typeParser.parseReferenceTypeExpr(decl.getTypeDecl(), scopes.top());
         auto member = scopes.top()->resolve(decl.getDeclname());
@@ -79,14 +77,13 @@ OpaqueType LexicalContextDeclTypePass::visit(VariableDecl &decl) {
         member->setMemberType(type);
     }
     if (decl.getInitializer()) {
-        decl.getInitializer()->accept(this);
+        visit(decl.getInitializer());
     }
-    return {};
 }
 
-OpaqueType LexicalContextDeclTypePass::visit(FieldDecl &decl) {
+void LexicalContextDeclTypePass::visit(FieldDecl &decl) {
     auto classMember = scopes.top()->getParentMember();
-    auto klass = dynamic_cast<ClassType *>(classMember->getMemberType());
+    auto klass = dyn_cast<ClassType>(classMember->getMemberType());
     auto baseType = typeParser.parseReferenceTypeExpr(decl.getTypeDecl(), scopes.top());
     auto type = typeContext.getMemberType(decl.getVisibility(), klass, baseType);
     decl.setType(baseType);
@@ -99,25 +96,24 @@ OpaqueType LexicalContextDeclTypePass::visit(FieldDecl &decl) {
     }
 
     if (decl.getInitializer()) {
-        decl.getInitializer()->accept(this);
+        visit(decl.getInitializer());
     }
-    return {};
 }
 
-OpaqueType LexicalContextDeclTypePass::visit(ParamDecl &decl) {
+Type * LexicalContextDeclTypePass::visit(ParamDecl &decl) {
     auto type = typeParser.parseReferenceTypeExpr(decl.getTypeDecl(), scopes.top());
     decl.setType(type);
-    return Generic<Type *>::Create(type);
+    return type;
 }
 
-OpaqueType LexicalContextDeclTypePass::visit(FunctionDecl &decl) {
+void LexicalContextDeclTypePass::visit(FunctionDecl &decl) {
     ReleaseScope _(*this, decl.getScope()->getChild());
     auto scope = scopes.top();
 
     std::vector<Type *> paramTypes;
     for (auto param: decl.getParamDecls()) {
-        auto paramType = param->accept(this);
-        paramTypes.push_back(Generic<Type *>::Get(paramType));
+        auto paramType = visit(*param);
+        paramTypes.push_back(paramType);
     }
     Type *returnType = typeParser.parseReferenceTypeExpr(decl.getReturnTypeDecl(), scope);
 
@@ -125,19 +121,17 @@ OpaqueType LexicalContextDeclTypePass::visit(FunctionDecl &decl) {
     decl.setType(funcType);
     decl.getScope()->setMemberType(funcType);
 
-    if (decl.getBody()) decl.getBody()->accept(this);
-
-    return {};
+    if (decl.getBody()) visit(decl.getBody());
 }
 
-OpaqueType LexicalContextDeclTypePass::visit(MethodDecl &decl) {
+void LexicalContextDeclTypePass::visit(MethodDecl &decl) {
     ReleaseScope _(*this, decl.getScope()->getChild());
     auto scope = scopes.top();
 
     std::vector<Type *> paramTypes;
     for (auto param: decl.getParamDecls()) {
-        auto paramType = param->accept(this);
-        paramTypes.push_back(Generic<Type *>::Get(paramType));
+        auto paramType = visit(*param);
+        paramTypes.push_back(paramType);
     }
     Type *returnType = typeParser.parseReferenceTypeExpr(decl.getReturnTypeDecl(), scope);
 
@@ -145,13 +139,13 @@ OpaqueType LexicalContextDeclTypePass::visit(MethodDecl &decl) {
     decl.setType(funcType);
 
     auto compositeScope = decl.getScope()->getParent()->getParentMember();
-    if (auto interfaceType = dynamic_cast<InterfaceType *>(compositeScope->getMemberType())) {
+    if (auto interfaceType = dyn_cast<InterfaceType>(compositeScope->getMemberType())) {
         auto methodType = typeContext.getMemberType(decl.getVisibility(), interfaceType, funcType);
         if (decl.getVisibility() != Visibility::Static)
             interfaceType->addMethod(decl.getDeclname(), methodType);
         decl.setType(methodType);
         decl.getScope()->setMemberType(methodType);
-    } else if (auto classType = dynamic_cast<ClassType *>(compositeScope->getMemberType())) {
+    } else if (auto classType = dyn_cast<ClassType>(compositeScope->getMemberType())) {
         auto methodType = typeContext.getMemberType(decl.getVisibility(), classType, funcType);
         if (decl.getVisibility() != Visibility::Static)
             classType->addMethod(decl.getDeclname(), methodType);
@@ -159,27 +153,24 @@ OpaqueType LexicalContextDeclTypePass::visit(MethodDecl &decl) {
         decl.getScope()->setMemberType(methodType);
     } else throw TypeError{"MethodDecl must be part of a Class or Interface LexicalScope"};
 
-    if (decl.getBody()) decl.getBody()->accept(this);
-
-    return {};
+    if (decl.getBody()) visit(decl.getBody());
 }
 
-OpaqueType LexicalContextDeclTypePass::visit(BlockStmt &stmt) {
+void LexicalContextDeclTypePass::visit(BlockStmt &stmt) {
     ReleaseScope _(*this, stmt.getScope()->getChild());
     for (auto statement: stmt.getStmts()) {
-        statement->accept(this);
+        visit(statement);
     }
-    return {};
 }
 
-OpaqueType LexicalContextDeclTypePass::visit(FunctionLiteral &literal) {
+void LexicalContextDeclTypePass::visit(FunctionLiteral &literal) {
     ReleaseScope _(*this, literal.getScope()->getChild());
     auto scope = scopes.top();
 
     std::vector<Type *> paramTypes;
     for (auto param: literal.getParamDecls()) {
-        auto paramType = param->accept(this);
-        paramTypes.push_back(Generic<Type *>::Get(paramType));
+        auto paramType = visit(*param);
+        paramTypes.push_back(paramType);
     }
     Type *returnType = typeParser.parseReferenceTypeExpr(literal.getReturnType(), scope);
     auto funcType = typeContext.getFunctionType(returnType, paramTypes);
@@ -187,109 +178,91 @@ OpaqueType LexicalContextDeclTypePass::visit(FunctionLiteral &literal) {
     literal.setType(funcType);
     literal.getScope()->setMemberType(funcType);
 
-    if (literal.getBody()) literal.getBody()->accept(this);
-
-    return {};
+    if (literal.getBody()) visit(literal.getBody());
 }
 
-OpaqueType LexicalContextDeclTypePass::visit(NewExpr &expr) {
+void LexicalContextDeclTypePass::visit(NewExpr &expr) {
     auto instanceType = typeParser.parseBaseType(expr.getInstanceType(), scopes.top());
-    if (auto classType = dynamic_cast<ClassType *>(instanceType)) {
+    if (auto classType = dyn_cast<ClassType>(instanceType)) {
         // keep class type, argument constructor will construct this to a reference type
         expr.setType(classType);
-    } else if (auto arrayType = dynamic_cast<ArrayType *>(instanceType)) {
+    } else if (auto arrayType = dyn_cast<ArrayType>(instanceType)) {
         // discard array size
         auto baseArrayType = typeContext.getArrayType(arrayType->getElementType());
         expr.setType(typeContext.getReferenceType(baseArrayType, false));
     } else {
         throw TypeError{"Cannot instantiate type " + instanceType->getTypeString()};
     }
-    return {};
 }
 
-OpaqueType LexicalContextDeclTypePass::visit(CastExpr &expr) {
+void LexicalContextDeclTypePass::visit(CastExpr &expr) {
     expr.setType(typeParser.parseReferenceTypeExpr(expr.getResultType(), scopes.top()));
-    return {};
 }
 
-OpaqueType LexicalContextDeclTypePass::visit(UnaryExpr &expr) {
-    expr.getExpr()->accept(this);
-    return {};
+void LexicalContextDeclTypePass::visit(UnaryExpr &expr) {
+    visit(expr.getExpr());
 }
 
-OpaqueType LexicalContextDeclTypePass::visit(BinaryExpr &expr) {
-    expr.getLhs()->accept(this);
-    expr.getRhs()->accept(this);
-    return {};
+void LexicalContextDeclTypePass::visit(BinaryExpr &expr) {
+    visit(expr.getLhs());
+    visit(expr.getRhs());
 }
 
-OpaqueType LexicalContextDeclTypePass::visit(IndexExpr &expr) {
-    if (expr.getIndex()) expr.getIndex()->accept(this);
-    expr.getBaseExpr()->accept(this);
-    return {};
+void LexicalContextDeclTypePass::visit(IndexExpr &expr) {
+    if (expr.getIndex()) visit(expr.getIndex());
+    visit(expr.getBaseExpr());
 }
 
-OpaqueType LexicalContextDeclTypePass::visit(SelectorExpr &expr) {
-    expr.getBaseExpr()->accept(this);
-    return {};
+void LexicalContextDeclTypePass::visit(SelectorExpr &expr) {
+    visit(expr.getBaseExpr());
 }
 
-OpaqueType LexicalContextDeclTypePass::visit(ArgumentExpr &expr) {
-    expr.getBaseExpr()->accept(this);
-    for (auto arg: expr.getArguments()) arg->accept(this);
-    return {};
+void LexicalContextDeclTypePass::visit(ArgumentExpr &expr) {
+    visit(expr.getBaseExpr());
+    for (auto arg: expr.getArguments()) visit(arg);
 }
 
-OpaqueType LexicalContextDeclTypePass::visit(ReturnStmt &stmt) {
-    stmt.getReturnValue()->accept(this);
-    return {};
+void LexicalContextDeclTypePass::visit(ReturnStmt &stmt) {
+    visit(stmt.getReturnValue());
 }
 
-OpaqueType LexicalContextDeclTypePass::visit(IfStmt &stmt) {
-    stmt.getCond()->accept(this);
-    stmt.getPrimaryBlock()->accept(this);
-    if (stmt.getElseBlock()) stmt.getElseBlock()->accept(this);
-    return {};
+void LexicalContextDeclTypePass::visit(IfStmt &stmt) {
+    visit(stmt.getCond());
+    visit(stmt.getPrimaryBlock());
+    if (stmt.getElseBlock()) visit(stmt.getElseBlock());
 }
 
-OpaqueType LexicalContextDeclTypePass::visit(ForStmt &stmt) {
+void LexicalContextDeclTypePass::visit(ForStmt &stmt) {
     // visit for clause
-    stmt.getBody()->accept(this);
-    return {};
+    visit(stmt.getBody());
 }
 
-OpaqueType LexicalContextDeclTypePass::visit(WhileStmt &stmt) {
-    stmt.getCond()->accept(this);
-    stmt.getBody()->accept(this);
-    return {};
+void LexicalContextDeclTypePass::visit(WhileStmt &stmt) {
+    visit(stmt.getCond());
+    visit(stmt.getBody());
 }
 
-OpaqueType LexicalContextDeclTypePass::visit(AssignmentStmt &stmt) {
-    stmt.getLhs()->accept(this);
-    stmt.getRhs()->accept(this);
-    return {};
+void LexicalContextDeclTypePass::visit(AssignmentStmt &stmt) {
+    visit(stmt.getLhs());
+    visit(stmt.getRhs());
 }
 
-OpaqueType LexicalContextDeclTypePass::visit(IncDecStmt &stmt) {
-    stmt.getExpr()->accept(this);
-    return {};
+void LexicalContextDeclTypePass::visit(IncDecStmt &stmt) {
+    visit(stmt.getExpr());
 }
 
-OpaqueType LexicalContextDeclTypePass::visit(ExpressionStmt &stmt) {
-    stmt.getExpr()->accept(this);
-    return {};
+void LexicalContextDeclTypePass::visit(ExpressionStmt &stmt) {
+    visit(stmt.getExpr());
 }
 
-OpaqueType LexicalContextDeclTypePass::visit(DeclStmt &stmt) {
-    stmt.getDecl()->accept(this);
-    return {};
+void LexicalContextDeclTypePass::visit(DeclStmt &stmt) {
+    visit(stmt.getDecl());
 }
 
-OpaqueType LexicalContextDeclTypePass::visit(ArrayLiteral &literal) {
+void LexicalContextDeclTypePass::visit(ArrayLiteral &literal) {
     for (auto lit: literal.getInitList()) {
-        lit->accept(this);
+        visit(lit);
     }
-    return {};
 }
 
 } // reflex
@@ -14,9 +14,9 @@ namespace reflex {
 
 class TypeContext;
 class LexicalScope;
-class LexicalContextDeclTypePass : public ASTDeclVisitor,
-                                   public ASTStmtVisitor,
-                                   public ASTExprVisitor {
+class LexicalContextDeclTypePass : public ASTDeclVisitor<LexicalContextDeclTypePass>,
+                                   public ASTStmtVisitor<LexicalContextDeclTypePass>,
+                                   public ASTExprVisitor<LexicalContextDeclTypePass> {
   private:
     class ReleaseScope {
       public:
@@ -27,49 +27,53 @@ class LexicalContextDeclTypePass : public ASTDeclVisitor,
     };
     friend class ReleaseScope;
   public:
+    using ASTDeclVisitor::visit;
+    using ASTStmtVisitor::visit;
+    using ASTExprVisitor::visit;
+
     explicit LexicalContextDeclTypePass(TypeContext &typeContext)
         : typeContext(typeContext), typeParser(typeContext) {}
 
     void performPass(CompilationUnit *unit);
 
-    OpaqueType visit(CompilationUnit &unit) override;
-    OpaqueType visit(ClassDecl &decl) override;
-    OpaqueType visit(InterfaceDecl &decl) override;
-    OpaqueType visit(VariableDecl &decl) override;
-    OpaqueType visit(FieldDecl &decl) override;
-    OpaqueType visit(ParamDecl &decl) override;
-    OpaqueType visit(FunctionDecl &decl) override;
-    OpaqueType visit(MethodDecl &decl) override;
+    void visit(CompilationUnit &unit);
+    void visit(ClassDecl &decl);
+    void visit(InterfaceDecl &decl);
+    void visit(VariableDecl &decl);
+    void visit(FieldDecl &decl);
+    Type * visit(ParamDecl &decl);
+    void visit(FunctionDecl &decl);
+    void visit(MethodDecl &decl);
 
-    OpaqueType visit(BlockStmt &stmt) override;
-    OpaqueType visit(ReturnStmt &stmt) override;
-    OpaqueType visit(BreakStmt &stmt) override ASTVisitorDefImpl;
-    OpaqueType visit(ContinueStmt &stmt) override ASTVisitorDefImpl;
-    OpaqueType visit(IfStmt &stmt) override;
-    OpaqueType visit(ForStmt &stmt) override;
-    OpaqueType visit(WhileStmt &stmt) override;
-    OpaqueType visit(EmptyStmt &stmt) override ASTVisitorDefImpl;
-    OpaqueType visit(AssignmentStmt &stmt) override;
-    OpaqueType visit(IncDecStmt &stmt) override;
-    OpaqueType visit(ExpressionStmt &stmt) override;
-    OpaqueType visit(DeclStmt &stmt) override;
+    void visit(BlockStmt &stmt);
+    void visit(ReturnStmt &stmt);
+    void visit(BreakStmt &stmt) ASTVisitorDefImpl
+    void visit(ContinueStmt &stmt) ASTVisitorDefImpl
+    void visit(IfStmt &stmt);
+    void visit(ForStmt &stmt);
+    void visit(WhileStmt &stmt);
+    void visit(EmptyStmt &stmt) ASTVisitorDefImpl
+    void visit(AssignmentStmt &stmt);
+    void visit(IncDecStmt &stmt);
+    void visit(ExpressionStmt &stmt);
+    void visit(DeclStmt &stmt);
 
-    OpaqueType visit(DeclRefExpr &expr) override ASTVisitorDefImpl;
-    OpaqueType visit(UnaryExpr &expr) override;
-    OpaqueType visit(BinaryExpr &expr) override;
-    OpaqueType visit(NewExpr &expr) override;
-    OpaqueType visit(ImplicitCastExpr &expr) override ASTVisitorDefImpl;
-    OpaqueType visit(CastExpr &expr) override;
-    OpaqueType visit(IndexExpr &expr) override;
-    OpaqueType visit(SelectorExpr &expr) override;
-    OpaqueType visit(ArgumentExpr &expr) override;
+    void visit(DeclRefExpr &expr) ASTVisitorDefImpl
+    void visit(UnaryExpr &expr);
+    void visit(BinaryExpr &expr);
+    void visit(NewExpr &expr);
+    void visit(ImplicitCastExpr &expr) ASTVisitorDefImpl
+    void visit(CastExpr &expr);
+    void visit(IndexExpr &expr);
+    void visit(SelectorExpr &expr);
+    void visit(ArgumentExpr &expr);
 
-    OpaqueType visit(NumberLiteral &literal) override ASTVisitorDefImpl;
-    OpaqueType visit(StringLiteral &literal) override ASTVisitorDefImpl;
-    OpaqueType visit(BooleanLiteral &literal) override ASTVisitorDefImpl;
-    OpaqueType visit(NullLiteral &literal) override ASTVisitorDefImpl;
-    OpaqueType visit(ArrayLiteral &literal) override;
-    OpaqueType visit(FunctionLiteral &literal) override;
+    void visit(NumberLiteral &literal) ASTVisitorDefImpl
+    void visit(StringLiteral &literal) ASTVisitorDefImpl
+    void visit(BooleanLiteral &literal) ASTVisitorDefImpl
+    void visit(NullLiteral &literal) ASTVisitorDefImpl
+    void visit(ArrayLiteral &literal);
+    void visit(FunctionLiteral &literal);
 
   private:
     TypeContext &typeContext;
@@ -14,21 +14,21 @@
 namespace reflex {
 
 LexicalScope *LexicalContextForwardPass::performPass(CompilationUnit *unit) {
-    return Generic<LexicalScope *>::Get(visit(*unit));
+    return visit(*unit);
 }
 
-OpaqueType LexicalContextForwardPass::visit(CompilationUnit &unit) {
+LexicalScope *LexicalContextForwardPass::visit(CompilationUnit &unit) {
     auto globalScope = context.createGlobalScope(&unit);
     unit.setScope(globalScope);
     scope.push(globalScope);
     for (auto decl: unit.getDecls()) {
-        decl->accept(this);
+        visit(decl);
     }
     scope.pop();
-    return Generic<LexicalScope *>::Create(globalScope);
+    return globalScope;
 }
 
-OpaqueType LexicalContextForwardPass::visit(ClassDecl &decl) {
+void LexicalContextForwardPass::visit(ClassDecl &decl) {
     auto [classScope, member] = scope.top()->createCompositeScope(&decl);
 
     auto type = typeContext.getClassType(member->getStringQualifier(), &decl);
@@ -37,15 +37,14 @@ OpaqueType LexicalContextForwardPass::visit(ClassDecl &decl) {
     decl.setScope(member);
     scope.push(classScope);
 
-    for (auto nested: decl.getDecls()) nested->accept(this);
-    for (auto field: decl.getFields()) field->accept(this);
-    for (auto method: decl.getMethods()) method->accept(this);
+    for (auto nested: decl.getDecls()) visit(nested);
+    for (auto field: decl.getFields()) visit(field);
+    for (auto method: decl.getMethods()) visit(method);
 
     scope.pop();
-    return {};
 }
 
-OpaqueType LexicalContextForwardPass::visit(InterfaceDecl &decl) {
+void LexicalContextForwardPass::visit(InterfaceDecl &decl) {
     auto [interfaceScope, member] = scope.top()->createCompositeScope(&decl);
 
     auto type = typeContext.getInterfaceType(member->getStringQualifier(), &decl);
@@ -54,87 +53,80 @@ OpaqueType LexicalContextForwardPass::visit(InterfaceDecl &decl) {
     decl.setScope(member);
     scope.push(interfaceScope);
 
-    for (auto nested: decl.getDecls()) nested->accept(this);
-    for (auto method: decl.getMethods()) method->accept(this);
+    for (auto nested: decl.getDecls()) visit(nested);
+    for (auto method: decl.getMethods()) visit(method);
 
     scope.pop();
-    return {};
 }
 
-OpaqueType LexicalContextForwardPass::visit(VariableDecl &decl) {
+void LexicalContextForwardPass::visit(VariableDecl &decl) {
     if (decl.isGlobalVariable()) {
-        scope.top()->addScopeMember(decl.getDeclname(), nullptr);
+        scope.top()->addScopeMember(decl.getDeclSymbol(), nullptr);
     }
-    if (decl.getInitializer()) decl.getInitializer()->accept(this);
-    return {};
+    if (decl.getInitializer()) visit(decl.getInitializer());
 }
 
-OpaqueType LexicalContextForwardPass::visit(FieldDecl &decl) {
+void LexicalContextForwardPass::visit(FieldDecl &decl) {
     if (decl.getVisibility() == Visibility::Static) {
-        scope.top()->addScopeMember(decl.getDeclname(), nullptr);
+        scope.top()->addScopeMember(decl.getDeclSymbol(), nullptr);
     }
-    if (decl.getInitializer()) decl.getInitializer()->accept(this);
-    return {};
+    if (decl.getInitializer()) visit(decl.getInitializer());
 }
 
-OpaqueType LexicalContextForwardPass::visit(ParamDecl &decl) {
-//    scope.top()->addScopeMember(decl.getDeclname(), nullptr);
-    return {};
+void LexicalContextForwardPass::visit(ParamDecl &decl) {
+//    scope.top()->addScopeMember(decl.getDeclSymbol(), nullptr);
 }
 
-OpaqueType LexicalContextForwardPass::visit(FunctionDecl &decl) {
+void LexicalContextForwardPass::visit(FunctionDecl &decl) {
     auto [funcScope, member] = scope.top()->createFunctionScope(&decl);
     decl.setScope(member);
 
     scope.push(funcScope);
     generateBlockScope = false;
 
-    for (auto param: decl.getParamDecls()) param->accept(this);
-    if (decl.getBody()) decl.getBody()->accept(this);
+    for (auto param: decl.getParamDecls()) visit(param);
+    if (decl.getBody()) visit(decl.getBody());
 
     generateBlockScope = true;
     scope.pop();
-    return {};
 }
 
-OpaqueType LexicalContextForwardPass::visit(MethodDecl &decl) {
+void LexicalContextForwardPass::visit(MethodDecl &decl) {
     auto [methodScope, member] = scope.top()->createFunctionScope(&decl);
     decl.setScope(member);
 
     scope.push(methodScope);
     generateBlockScope = false;
 
-    for (auto param: decl.getParamDecls()) param->accept(this);
-    if (decl.getBody()) decl.getBody()->accept(this);
+    for (auto param: decl.getParamDecls()) visit(param);
+    if (decl.getBody()) visit(decl.getBody());
 
     generateBlockScope = true;
     scope.pop();
-    return {};
 }
 
-OpaqueType LexicalContextForwardPass::visit(FunctionLiteral &literal) {
+void LexicalContextForwardPass::visit(FunctionLiteral &literal) {
     auto [lambdaScope, lambdaMember] = scope.top()->createLambdaScope(&literal);
     literal.setScope(lambdaMember);
 
     scope.push(lambdaScope);
     generateBlockScope = false;
 
-    for (auto param: literal.getParamDecls()) param->accept(this);
-    if (literal.getBody()) literal.getBody()->accept(this);
+    for (auto param: literal.getParamDecls()) visit(param);
+    if (literal.getBody()) visit(literal.getBody());
 
     generateBlockScope = true;
     scope.pop();
-    return {};
 }
 
-OpaqueType LexicalContextForwardPass::visit(BlockStmt &stmt) {
+void LexicalContextForwardPass::visit(BlockStmt &stmt) {
     if (generateBlockScope) {
         auto [blockScope, blockMember] = scope.top()->createBlockScope(&stmt);
         stmt.setScope(blockMember);
 
         scope.push(blockScope);
         generateBlockScope = true;
-        for (auto statement: stmt.getStmts()) statement->accept(this);
+        for (auto statement: stmt.getStmts()) visit(statement);
         generateBlockScope = false;
         scope.pop();
     } else {
@@ -142,94 +134,78 @@ OpaqueType LexicalContextForwardPass::visit(BlockStmt &stmt) {
 
         stmt.setScope(scope.top()->getParentMember());
 
-        for (auto statement: stmt.getStmts()) statement->accept(this);
+        for (auto statement: stmt.getStmts()) visit(statement);
         generateBlockScope = false;
     }
-    return {};
 }
 
-OpaqueType LexicalContextForwardPass::visit(UnaryExpr &expr) {
-    expr.getExpr()->accept(this);
-    return {};
+void LexicalContextForwardPass::visit(UnaryExpr &expr) {
+    visit(expr.getExpr());
 }
 
-OpaqueType LexicalContextForwardPass::visit(BinaryExpr &expr) {
-    expr.getLhs()->accept(this);
-    expr.getRhs()->accept(this);
-    return {};
+void LexicalContextForwardPass::visit(BinaryExpr &expr) {
+    visit(expr.getLhs());
+    visit(expr.getRhs());
 }
 
-OpaqueType LexicalContextForwardPass::visit(CastExpr &expr) {
-    expr.getFrom()->accept(this);
-    return {};
+void LexicalContextForwardPass::visit(CastExpr &expr) {
+    visit(expr.getFrom());
 }
 
-OpaqueType LexicalContextForwardPass::visit(IndexExpr &expr) {
-    if (expr.getIndex()) expr.getIndex()->accept(this);
-    expr.getBaseExpr()->accept(this);
-    return {};
+void LexicalContextForwardPass::visit(IndexExpr &expr) {
+    if (expr.getIndex()) visit(expr.getIndex());
+    visit(expr.getBaseExpr());
 }
 
-OpaqueType LexicalContextForwardPass::visit(SelectorExpr &expr) {
-    expr.getBaseExpr()->accept(this);
-    return {};
+void LexicalContextForwardPass::visit(SelectorExpr &expr) {
+    visit(expr.getBaseExpr());
 }
 
-OpaqueType LexicalContextForwardPass::visit(ArgumentExpr &expr) {
-    expr.getBaseExpr()->accept(this);
-    for (auto arg: expr.getArguments()) arg->accept(this);
-    return {};
+void LexicalContextForwardPass::visit(ArgumentExpr &expr) {
+    visit(expr.getBaseExpr());
+    for (auto arg: expr.getArguments()) visit(arg);
 }
 
-OpaqueType LexicalContextForwardPass::visit(ReturnStmt &stmt) {
-    stmt.getReturnValue()->accept(this);
-    return {};
+void LexicalContextForwardPass::visit(ReturnStmt &stmt) {
+    visit(stmt.getReturnValue());
 }
-OpaqueType LexicalContextForwardPass::visit(IfStmt &stmt) {
-    stmt.getCond()->accept(this);
-    stmt.getPrimaryBlock()->accept(this);
-    if (stmt.getElseBlock()) stmt.getElseBlock()->accept(this);
-    return {};
+void LexicalContextForwardPass::visit(IfStmt &stmt) {
+    visit(stmt.getCond());
+    visit(stmt.getPrimaryBlock());
+    if (stmt.getElseBlock()) visit(stmt.getElseBlock());
 }
 
-OpaqueType LexicalContextForwardPass::visit(ForStmt &stmt) {
+void LexicalContextForwardPass::visit(ForStmt &stmt) {
     // visit for clause
-    stmt.getBody()->accept(this);
-    return {};
+    visit(stmt.getBody());
 }
 
-OpaqueType LexicalContextForwardPass::visit(WhileStmt &stmt) {
-    stmt.getCond()->accept(this);
-    stmt.getBody()->accept(this);
-    return {};
+void LexicalContextForwardPass::visit(WhileStmt &stmt) {
+    visit(stmt.getCond());
+    visit(stmt.getBody());
 }
 
-OpaqueType LexicalContextForwardPass::visit(AssignmentStmt &stmt) {
-    stmt.getLhs()->accept(this);
-    stmt.getRhs()->accept(this);
-    return {};
+void LexicalContextForwardPass::visit(AssignmentStmt &stmt) {
+    visit(stmt.getLhs());
+    visit(stmt.getRhs());
 }
 
-OpaqueType LexicalContextForwardPass::visit(IncDecStmt &stmt) {
-    stmt.getExpr()->accept(this);
-    return {};
+void LexicalContextForwardPass::visit(IncDecStmt &stmt) {
+    visit(stmt.getExpr());
 }
 
-OpaqueType LexicalContextForwardPass::visit(ExpressionStmt &stmt) {
-    stmt.getExpr()->accept(this);
-    return {};
+void LexicalContextForwardPass::visit(ExpressionStmt &stmt) {
+    visit(stmt.getExpr());
 }
 
-OpaqueType LexicalContextForwardPass::visit(DeclStmt &stmt) {
-    stmt.getDecl()->accept(this);
-    return {};
+void LexicalContextForwardPass::visit(DeclStmt &stmt) {
+    visit(stmt.getDecl());
 }
 
-OpaqueType LexicalContextForwardPass::visit(ArrayLiteral &literal) {
+void LexicalContextForwardPass::visit(ArrayLiteral &literal) {
     for (auto lit: literal.getInitList()) {
-        lit->accept(this);
+        visit(lit);
     }
-    return {};
 }
 
 }
@@ -34,7 +34,7 @@ bool ScopeMember::operator==(const ScopeMember &rhs) const {
 
 QuantifierList ScopeMember::getQualifier() const {
     QuantifierList list;
-    list.push_front(membername);
+    list.push_front(membername.str());
     parent->getScopeQualifierPrefix(list);
     return list;
 }
@@ -42,31 +42,31 @@ QuantifierList ScopeMember::getQualifier() const {
 LexicalError::LexicalError(const std::string &arg)
     : runtime_error("LexicalError: " + arg) {}
 
-ScopeMember &LexicalScope::addScopeMember(std::string name, Type *memberType,
+ScopeMember &LexicalScope::addScopeMember(Symbol name, Type *memberType,
                                           LexicalScope *child) {
     // find member of same name
     auto res = std::find_if(members.begin(), members.end(),
-                            [&name](const auto &existing) {
-                              return existing->getMembername() == name;
+                            [name](const auto &existing) {
+                              return existing->getMemberSymbol() == name;
                             });
     if (res != members.end()) {
         // no impl for any types of overloading
-        throw LexicalError{"Cannot overload " + name + " in " + getScopename()};
+        throw LexicalError{"Cannot overload " + name.str() + " in " + getScopename()};
     }
-    members.push_back(std::make_unique<ScopeMember>(std::move(name), memberType, this, child));
+    members.push_back(std::make_unique<ScopeMember>(name, memberType, this, child));
     return *members.back().get();
 }
 
-ScopeMember *LexicalScope::bind(const std::string &name) const {
+ScopeMember *LexicalScope::bind(Symbol name) const {
     for (const auto &member: members) {
-        if (member->getMembername() == name) {
+        if (member->getMemberSymbol() == name) {
             return member.get();
         }
     }
     if (parentMember) {
         return parentMember->getParent()->bind(name);
     }
-    throw LexicalError{"Cannot bind " + name + " in any of its parent lexical scopes"};
+    throw LexicalError{"Cannot bind " + name.str() + " in any of its parent lexical scopes"};
 }
 
 ScopeMember *ScopeMember::follow(const std::string &qualifiedName) {
@@ -83,8 +83,9 @@ ScopeMember *ScopeMember::follow(const std::string &qualifiedName) {
     }
 
     if (!hasScope()) throw LexicalError{"Cannot resolve " + rest + " in current scope " + getStringQualifier()};
+    const Symbol prefixSymbol(prefix);
     for (auto &member: child->getMembers()) {
-        if (member->getMembername() == prefix) {
+        if (member->getMemberSymbol() == prefixSymbol) {
             return member->follow(rest);
         }
     }
@@ -114,7 +115,7 @@ void LexicalScope::getScopeQualifierPrefix(QuantifierList &prefix) const {
 }
 
 std::pair<LexicalScope *, ScopeMember *> LexicalScope::createCompositeScope(AggregateDecl *declscope) {
-    auto &newScopeMember = addScopeMember(declscope->getDeclname(), nullptr);
+    auto &newScopeMember = addScopeMember(declscope->getDeclSymbol(), nullptr);
     auto scope = newScopeMember.setChild(
         context.createCompositeScope(declscope, &newScopeMember)
     );
@@ -122,7 +123,7 @@ std::pair<LexicalScope *, ScopeMember *> LexicalScope::createCompositeScope(Aggr
 }
 
 std::pair<LexicalScope *, ScopeMember *> LexicalScope::createFunctionScope(FunctionDecl *declscope) {
-    auto &newScopeMember = addScopeMember(declscope->getDeclname(), nullptr);
+    auto &newScopeMember = addScopeMember(declscope->getDeclSymbol(), nullptr);
     auto scope = newScopeMember.setChild(
         context.createFunctionScope(declscope, &newScopeMember)
     );
@@ -130,7 +131,7 @@ std::pair<LexicalScope *, ScopeMember *> LexicalScope::createFunctionScope(Funct
 }
 
 std::pair<LexicalScope *, ScopeMember *> LexicalScope::createMethodScope(MethodDecl *declscope) {
-    auto &newScopeMember = addScopeMember(declscope->getDeclname(), nullptr);
+    auto &newScopeMember = addScopeMember(declscope->getDeclSymbol(), nullptr);
     auto scope = newScopeMember.setChild(
         context.createMethodScope(declscope, &newScopeMember)
     );
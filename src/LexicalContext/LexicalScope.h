@@ -12,6 +12,8 @@
 #include <memory>
 #include <list>
 
+#include "StringInterner.h"
+
 namespace reflex {
 
 class Type;
@@ -33,15 +35,16 @@ class LexicalError : public std::runtime_error {
 
 class ScopeMember {
   public:
-    ScopeMember(std::string membername, Type *memberType,
+    ScopeMember(Symbol membername, Type *memberType,
                 LexicalScope *parent, LexicalScope *child)
-        : membername(std::move(membername)), memberType(memberType),
+        : membername(membername), memberType(memberType),
           parent(parent), child(child) {
         if (!parent) throw LexicalError{"ScopeMember must be part of a parent scope"};
     }
 
-    const std::string &getMembername() const { return membername; }
-    void setMembername(const std::string &membername) { ScopeMember::membername = membername; }
+    const std::string &getMembername() const { return membername.str(); }
+    Symbol getMemberSymbol() const { return membername; }
+    void setMembername(Symbol name) { ScopeMember::membername = name; }
     Type *getMemberType() const { return memberType; }
     bool hasScope() const { return child; }
     LexicalScope *getChild() const { return child; }
@@ -65,7 +68,7 @@ class ScopeMember {
     /// @throws LexicalError if qualifier cannot be resolved in its child scope
     ScopeMember *follow(const std::string &qualifiedName);
   private:
-    std::string membername;
+    Symbol membername;
     Type *memberType;
     LexicalScope *parent;
     LexicalScope *child;
@@ -87,7 +90,7 @@ class LexicalScope {
     /// Adds a scope member to the current LexicalScope with associated type and name
     /// by default it has no associated children scope.
     /// @note name is not unique in the lexical scope for the sake of implementing overloading
-    ScopeMember &addScopeMember(std::string name, Type *memberType, LexicalScope *child = nullptr);
+    ScopeMember &addScopeMember(Symbol name, Type *memberType, LexicalScope *child = nullptr);
 
     LexicalContext &getContext() const { return context; }
     ScopeMember *getParentMember() const { return parentMember; }
@@ -108,7 +111,7 @@ class LexicalScope {
     /// to find a lexical scope member that has the same name
     /// @return the bound scope with the same name
     /// @throws LexicalError if no such member exists
-    ScopeMember *bind(const std::string &name) const;
+    ScopeMember *bind(Symbol name) const;
 
     ScopeMember *resolve(const std::string &qualifier) const;
 
@@ -13,25 +13,23 @@
 
 namespace reflex {
 
-OpaqueType SemanticAnalysisPass::visit(CompilationUnit &unit) {
+void SemanticAnalysisPass::visit(CompilationUnit &unit) {
     for (auto decl: unit.getDecls()) {
-        decl->accept(this);
+        visit(decl);
     }
-    return {};
 }
 
-OpaqueType SemanticAnalysisPass::visit(VariableDecl &decl) {
+void SemanticAnalysisPass::visit(VariableDecl &decl) {
     if (decl.isGlobalVariable()) {
         SemanticAnalyzer analyzer(typeContext, context);
         analyzer.analyzeStaticVars(&decl, globalScope);
     }
-    return {};
 }
 
-OpaqueType SemanticAnalysisPass::visit(ClassDecl &decl) {
+void SemanticAnalysisPass::visit(ClassDecl &decl) {
     auto classScope = decl.getScope()->getChild();
     for (auto nested: decl.getDecls()) {
-        nested->accept(this);
+        visit(nested);
     }
     for (auto field: decl.getFields()) {
         SemanticAnalyzer analyzer(typeContext, context);
@@ -49,120 +47,100 @@ OpaqueType SemanticAnalysisPass::visit(ClassDecl &decl) {
             analyzer.analyzeMethod(method);
         }
     }
-    return {};
 }
 
-OpaqueType SemanticAnalysisPass::visit(FunctionDecl &decl) {
+void SemanticAnalysisPass::visit(FunctionDecl &decl) {
     SemanticAnalyzer analyzer(typeContext, context);
     analyzer.analyzeFunction(&decl);
-    return {};
 }
 
-OpaqueType SemanticAnalysisPass::visit(FunctionLiteral &literal) {
+void SemanticAnalysisPass::visit(FunctionLiteral &literal) {
     SemanticAnalyzer analyzer(typeContext, context);
     analyzer.analyzeLambda(&literal);
-    return {};
 }
 
-OpaqueType SemanticAnalysisPass::visit(DeclStmt &stmt) {
-    stmt.getDecl()->accept(this);
-    return {};
+void SemanticAnalysisPass::visit(DeclStmt &stmt) {
+    visit(stmt.getDecl());
 }
 
-OpaqueType SemanticAnalysisPass::visit(BlockStmt &stmt) {
+void SemanticAnalysisPass::visit(BlockStmt &stmt) {
     for (auto statement: stmt.getStmts()) {
-        statement->accept(this);
+        visit(statement);
     }
-    return {};
 }
 
-OpaqueType SemanticAnalysisPass::visit(ReturnStmt &stmt) {
+void SemanticAnalysisPass::visit(ReturnStmt &stmt) {
     if (stmt.getReturnValue()) {
-        stmt.getReturnValue()->accept(this);
+        visit(stmt.getReturnValue());
     }
-    return {};
 }
 
-OpaqueType SemanticAnalysisPass::visit(IfStmt &stmt) {
-    stmt.getCond()->accept(this);
-    stmt.getPrimaryBlock()->accept(this);
-    if (stmt.getElseBlock()) stmt.getElseBlock()->accept(this);
-    return {};
+void SemanticAnalysisPass::visit(IfStmt &stmt) {
+    visit(stmt.getCond());
+    visit(stmt.getPrimaryBlock());
+    if (stmt.getElseBlock()) visit(stmt.getElseBlock());
 }
 
-OpaqueType SemanticAnalysisPass::visit(ForStmt &stmt) {
+void SemanticAnalysisPass::visit(ForStmt &stmt) {
     // visit for clause
-    stmt.getBody()->accept(this);
-    return {};
+    visit(stmt.getBody());
 }
 
-OpaqueType SemanticAnalysisPass::visit(WhileStmt &stmt) {
-    stmt.getCond()->accept(this);
-    stmt.getBody()->accept(this);
-    return {};
+void SemanticAnalysisPass::visit(WhileStmt &stmt) {
+    visit(stmt.getCond());
+    visit(stmt.getBody());
 }
 
-OpaqueType SemanticAnalysisPass::visit(AssignmentStmt &stmt) {
-    stmt.getLhs()->accept(this);
-    stmt.getRhs()->accept(this);
-    return {};
+void SemanticAnalysisPass::visit(AssignmentStmt &stmt) {
+    visit(stmt.getLhs());
+    visit(stmt.getRhs());
 }
 
-OpaqueType SemanticAnalysisPass::visit(IncDecStmt &stmt) {
-    stmt.getExpr()->accept(this);
-    return {};
+void SemanticAnalysisPass::visit(IncDecStmt &stmt) {
+    visit(stmt.getExpr());
 }
 
-OpaqueType SemanticAnalysisPass::visit(ExpressionStmt &stmt) {
-    stmt.getExpr()->accept(this);
-    return {};
+void SemanticAnalysisPass::visit(ExpressionStmt &stmt) {
+    visit(stmt.getExpr());
 }
 
-OpaqueType SemanticAnalysisPass::visit(ArrayLiteral &literal) {
+void SemanticAnalysisPass::visit(ArrayLiteral &literal) {
     for (auto lit: literal.getInitList()) {
-        lit->accept(this);
+        visit(lit);
     }
-    return {};
 }
 
-OpaqueType SemanticAnalysisPass::visit(UnaryExpr &expr) {
-    expr.getExpr()->accept(this);
-    return {};
+void SemanticAnalysisPass::visit(UnaryExpr &expr) {
+    visit(expr.getExpr());
 }
 
-OpaqueType SemanticAnalysisPass::visit(BinaryExpr &expr) {
-    expr.getLhs()->accept(this);
-    expr.getRhs()->accept(this);
-    return {};
+void SemanticAnalysisPass::visit(BinaryExpr &expr) {
+    visit(expr.getLhs());
+    visit(expr.getRhs());
 }
 
-OpaqueType SemanticAnalysisPass::visit(CastExpr &expr) {
-    expr.getFrom()->accept(this);
-    return {};
+void SemanticAnalysisPass::visit(CastExpr &expr) {
+    visit(expr.getFrom());
 }
 
-OpaqueType SemanticAnalysisPass::visit(IndexExpr &expr) {
-    if (expr.getIndex()) expr.getIndex()->accept(this);
-    expr.getBaseExpr()->accept(this);
-    return {};
+void SemanticAnalysisPass::visit(IndexExpr &expr) {
+    if (expr.getIndex()) visit(expr.getIndex());
+    visit(expr.getBaseExpr());
 }
 
-OpaqueType SemanticAnalysisPass::visit(ImplicitCastExpr &expr) {
-    expr.getFrom()->accept(this);
-    return {};
+void SemanticAnalysisPass::visit(ImplicitCastExpr &expr) {
+    visit(expr.getFrom());
 }
 
-OpaqueType SemanticAnalysisPass::visit(SelectorExpr &expr) {
-    expr.getBaseExpr()->accept(this);
-    return {};
+void SemanticAnalysisPass::visit(SelectorExpr &expr) {
+    visit(expr.getBaseExpr());
 }
 
-OpaqueType SemanticAnalysisPass::visit(ArgumentExpr &expr) {
-    expr.getBaseExpr()->accept(this);
+void SemanticAnalysisPass::visit(ArgumentExpr &expr) {
+    visit(expr.getBaseExpr());
     for (auto arg: expr.getArguments()) {
-        arg->accept(this);
+        visit(arg);
     }
-    return {};
 }
 
 } // reflex
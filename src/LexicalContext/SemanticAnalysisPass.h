@@ -14,51 +14,55 @@ class ASTContext;
 class LexicalScope;
 
 /// run @class SemanticAnalyzer on all decls
-class SemanticAnalysisPass : public ASTDeclVisitor,
-                             public ASTStmtVisitor,
-                             public ASTExprVisitor {
+class SemanticAnalysisPass : public ASTDeclVisitor<SemanticAnalysisPass>,
+                             public ASTStmtVisitor<SemanticAnalysisPass>,
+                             public ASTExprVisitor<SemanticAnalysisPass> {
   public:
+    using ASTDeclVisitor::visit;
+    using ASTStmtVisitor::visit;
+    using ASTExprVisitor::visit;
+
     SemanticAnalysisPass(TypeContext &typeContext, ASTContext &context, LexicalScope *global)
         : typeContext(typeContext), context(context), globalScope(global) {}
 
-    OpaqueType visit(CompilationUnit &unit) override;
+    void visit(CompilationUnit &unit);
 
-    OpaqueType visit(VariableDecl &decl) override;
-    OpaqueType visit(ClassDecl &decl) override;
-    OpaqueType visit(InterfaceDecl &decl) override ASTVisitorDefImpl
-    OpaqueType visit(FieldDecl &decl) override ASTVisitorDefImpl
-    OpaqueType visit(ParamDecl &decl) override ASTVisitorDefImpl
-    OpaqueType visit(FunctionDecl &decl) override;
-    OpaqueType visit(MethodDecl &decl) override ASTVisitorDefImpl;
+    void visit(VariableDecl &decl);
+    void visit(ClassDecl &decl);
+    void visit(InterfaceDecl &decl) ASTVisitorDefImpl
+    void visit(FieldDecl &decl) ASTVisitorDefImpl
+    void visit(ParamDecl &decl) ASTVisitorDefImpl
+    void visit(FunctionDecl &decl);
+    void visit(MethodDecl &decl) ASTVisitorDefImpl
 
-    OpaqueType visit(BlockStmt &stmt) override;
-    OpaqueType visit(ReturnStmt &stmt) override;
-    OpaqueType visit(BreakStmt &stmt) override ASTVisitorDefImpl
-    OpaqueType visit(ContinueStmt &stmt) override ASTVisitorDefImpl
-    OpaqueType visit(IfStmt &stmt) override;
-    OpaqueType visit(ForStmt &stmt) override;
-    OpaqueType visit(WhileStmt &stmt) override;
-    OpaqueType visit(EmptyStmt &stmt) override ASTVisitorDefImpl
-    OpaqueType visit(AssignmentStmt &stmt) override;
-    OpaqueType visit(IncDecStmt &stmt) override;
-    OpaqueType visit(ExpressionStmt &stmt) override;
-    OpaqueType visit(DeclStmt &stmt) override;
+    void visit(BlockStmt &stmt);
+    void visit(ReturnStmt &stmt);
+    void visit(BreakStmt &stmt) ASTVisitorDefImpl
+    void visit(ContinueStmt &stmt) ASTVisitorDefImpl
+    void visit(IfStmt &stmt);
+    void visit(ForStmt &stmt);
+    void visit(WhileStmt &stmt);
+    void visit(EmptyStmt &stmt) ASTVisitorDefImpl
+    void visit(AssignmentStmt &stmt);
+    void visit(IncDecStmt &stmt);
+    void visit(ExpressionStmt &stmt);
+    void visit(DeclStmt &stmt);
 
-    OpaqueType visit(DeclRefExpr &expr) override ASTVisitorDefImpl
-    OpaqueType visit(UnaryExpr &expr) override;
-    OpaqueType visit(BinaryExpr &expr) override;
-    OpaqueType visit(NewExpr &expr) override ASTVisitorDefImpl
-    OpaqueType visit(ImplicitCastExpr &expr) override;
-    OpaqueType visit(CastExpr &expr) override;
-    OpaqueType visit(IndexExpr &expr) override;
-    OpaqueType visit(SelectorExpr &expr) override;
-    OpaqueType visit(ArgumentExpr &expr) override;
-    OpaqueType visit(NumberLiteral &literal) override ASTVisitorDefImpl
-    OpaqueType visit(StringLiteral &literal) override ASTVisitorDefImpl
-    OpaqueType visit(BooleanLiteral &literal) override ASTVisitorDefImpl
-    OpaqueType visit(NullLiteral &literal) override ASTVisitorDefImpl
-    OpaqueType visit(ArrayLiteral &literal) override;
-    OpaqueType visit(FunctionLiteral &literal) override;
+    void visit(DeclRefExpr &expr) ASTVisitorDefImpl
+    void visit(UnaryExpr &expr);
+    void visit(BinaryExpr &expr);
+    void visit(NewExpr &expr) ASTVisitorDefImpl
+    void visit(ImplicitCastExpr &expr);
+    void visit(CastExpr &expr);
+    void visit(IndexExpr &expr);
+    void visit(SelectorExpr &expr);
+    void visit(ArgumentExpr &expr);
+    void visit(NumberLiteral &literal) ASTVisitorDefImpl
+    void visit(StringLiteral &literal) ASTVisitorDefImpl
+    void visit(BooleanLiteral &literal) ASTVisitorDefImpl
+    void visit(NullLiteral &literal) ASTVisitorDefImpl
+    void visit(ArrayLiteral &literal);
+    void visit(FunctionLiteral &literal);
 
   private:
     TypeContext &typeContext;
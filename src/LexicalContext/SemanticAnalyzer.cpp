@@ -21,22 +21,22 @@ ReferenceError::ReferenceError(const std::string &arg)
 AnalysisError::AnalysisError(const std::string &arg)
     : runtime_error("AnalysisError: " + arg) {}
 
-Declaration *SymbolTable::find(const std::string &name) {
-    if (symbolTable.contains(name)) return symbolTable.at(name);
+Declaration *SymbolTable::find(Symbol name) {
+    auto iter = symbolTable.find(name);
+    if (iter != symbolTable.end()) return iter->second;
     if (isGlobalTable()) {
-        throw ReferenceError{"Cannot find reference to " + name};
+        throw ReferenceError{"Cannot find reference to " + name.str()};
     }
     auto decl = parent->find(name); // captures from parent scope
     captures.emplace(decl);
     return decl;
 }
 
-void SymbolTable::add(Declaration *decl, const std::string &name) {
-    auto declname = name.empty() ? decl->getDeclname() : name;
-    if (symbolTable.contains(declname)) {
-        throw ReferenceError{declname + " already exists in current scope"};
+void SymbolTable::add(Declaration *decl, Symbol name) {
+    auto declname = name.empty() ? decl->getDeclSymbol() : name;
+    if (!symbolTable.try_emplace(declname, decl).second) {
+        throw ReferenceError{declname.str() + " already exists in current scope"};
     }
-    symbolTable[declname] = decl;
 }
 
 void SemanticAnalyzer::analyzeFunction(FunctionDecl *decl) {
@@ -55,7 +55,7 @@ void SemanticAnalyzer::analyzeFunction(FunctionDecl *decl) {
     if (decl->getBody()) {
         auto stmts = decl->getBody();
         for (auto stmt: stmts->getStmts()) {
-            stmt->accept(this);
+            visit(stmt);
         }
     }
 
@@ -68,10 +68,10 @@ void SemanticAnalyzer::analyzeMethod(MethodDecl *decl) {
     lexicalScopes.push(decl->getParent()->getScope()->getChild());
 
     auto &scope = symbolTables.top();
-    auto klass = dynamic_cast<ClassDecl *>(decl->getParent());
+    auto klass = dyn_cast<ClassDecl>(decl->getParent());
 
     auto thisDecl = std::make_unique<VariableDecl>(klass->location(), "this", nullptr);
-    auto thisRefType = typeContext.getReferenceType(dynamic_cast<ReferenceableType *>(klass->getType()));
+    auto thisRefType = typeContext.getReferenceType(dyn_cast<ReferenceableType>(klass->getType()));
     thisDecl->setType(thisRefType);
 
     scope->add(thisDecl.get(), "this");
@@ -97,7 +97,7 @@ void SemanticAnalyzer::analyzeLambda(FunctionLiteral *literal) {
     if (literal->getBody()) {
         auto stmts = literal->getBody();
         for (auto stmt: stmts->getStmts()) {
-            stmt->accept(this);
+            visit(stmt);
         }
     }
 
@@ -110,7 +110,7 @@ void SemanticAnalyzer::analyzeField(FieldDecl *decl) {
     lexicalScopes.push(decl->getParent()->getScope()->getChild());
 
     if (decl->getInitializer()) {
-        decl->getInitializer()->accept(&exprAnalysisPass);
+        exprAnalysisPass.visit(decl->getInitializer());
     }
 
     lexicalScopes.pop();
@@ -122,108 +122,100 @@ void SemanticAnalyzer::analyzeStaticVars(VariableDecl *var, LexicalScope *scope)
     lexicalScopes.push(scope);
 
     if (var->getInitializer()) {
-        var->getInitializer()->accept(&exprAnalysisPass);
+        exprAnalysisPass.visit(var->getInitializer());
     }
 
     lexicalScopes.pop();
     symbolTables.pop();
 }
 
-OpaqueType SemanticAnalyzer::visit(BlockStmt &stmt) {
+void SemanticAnalyzer::visit(BlockStmt &stmt) {
     symbolTables.push(std::make_unique<SymbolTable>(symbolTables.top().get()));
     lexicalScopes.push(stmt.getScope()->getChild());
 
     for (auto s: stmt.getStmts()) {
-        s->accept(this);
+        visit(s);
     }
 
     lexicalScopes.pop();
     symbolTables.pop();
-    return {};
 }
 
-OpaqueType SemanticAnalyzer::visit(DeclStmt &stmt) {
+void SemanticAnalyzer::visit(DeclStmt &stmt) {
     auto decl = stmt.getDecl();
-    if (auto var = dynamic_cast<VariableDecl *>(decl)) {
+    if (auto var = dyn_cast<VariableDecl>(decl)) {
         auto type = typeParser.parseReferenceTypeExpr(var->getTypeDecl(), lexicalScopes.top());
         var->setType(type);
         decl->setType(type);
         symbolTables.top()->add(decl);
 
         if (var->getInitializer()) {
-            auto rvalue = Generic<Expression *>::Get(var->getInitializer()->accept(&exprAnalysisPass));
+            auto rvalue = exprAnalysisPass.visit(var->getInitializer());
             auto declType = typeParser.parseReferenceTypeExpr(var->getTypeDecl(), lexicalScopes.top());
             var->setInitializer(exprAnalysisPass.insertImplicitCast(rvalue, declType));
         }
     }
-    return {};
 }
 
-OpaqueType SemanticAnalyzer::visit(BreakStmt &stmt) {
+void SemanticAnalyzer::visit(BreakStmt &stmt) {
     if (!inloop) throw AnalysisError{"BreakStmt is not contained in a loop"};
-    return {};
 }
 
-OpaqueType SemanticAnalyzer::visit(ContinueStmt &stmt) {
+void SemanticAnalyzer::visit(ContinueStmt &stmt) {
     if (!inloop) throw AnalysisError{"ContinueStmt is not contained in a loop"};
-    return {};
 }
 
-OpaqueType SemanticAnalyzer::visit(ReturnStmt &stmt) {
+void SemanticAnalyzer::visit(ReturnStmt &stmt) {
     if (stmt.getReturnValue()) {
-        auto expr = Generic<Expression *>::Get(stmt.getReturnValue()->accept(&exprAnalysisPass));
+        auto expr = exprAnalysisPass.visit(stmt.getReturnValue());
         stmt.setReturnValue(expr);
         stmt.setReturnType(expr->getType());
     } else {
         stmt.setReturnType(typeContext.getVoidType());
     }
-    return {};
 }
 
-OpaqueType SemanticAnalyzer::visit(IfStmt &stmt) {
+void SemanticAnalyzer::visit(IfStmt &stmt) {
     // visit conditionals
-    stmt.getPrimaryBlock()->accept(this);
-    if (stmt.getElseBlock()) stmt.getElseBlock()->accept(this);
-    return {};
+    visit(stmt.getPrimaryBlock());
+    if (stmt.getElseBlock()) visit(stmt.getElseBlock());
 }
 
-OpaqueType SemanticAnalyzer::visit(ForStmt &stmt) {
+void SemanticAnalyzer::visit(ForStmt &stmt) {
     // visit range clause
     inloop = true;
-    stmt.getBody()->accept(this);
+    visit(stmt.getBody());
     inloop = false;
-    return {};
 }
 
-OpaqueType SemanticAnalyzer::visit(WhileStmt &stmt) {
+void SemanticAnalyzer::visit(WhileStmt &stmt) {
     // visit cond
     inloop = true;
-    stmt.getBody()->accept(this);
+    visit(stmt.getBody());
     inloop = false;
-    return {};
 }
 
-OpaqueType SemanticAnalyzer::visit(AssignmentStmt &stmt) {
-    auto lvalue = Generic<Expression *>::Get(stmt.getLhs()->accept(&exprAnalysisPass));
-    auto rvalue = Generic<Expression *>::Get(stmt.getRhs()->accept(&exprAnalysisPass));
+void SemanticAnalyzer::visit(AssignmentStmt &stmt) {
+    auto lvalue = exprAnalysisPass.visit(stmt.getLhs());
+    auto rvalue = exprAnalysisPass.visit(stmt.getRhs());
     stmt.setLhs(lvalue);
     if (stmt.getAssignOp() != Operator::AssignOperator::Equal) throw TypeError{"Unsupported assignment operator"};
     // lhs must be DeclRefExpr or ArrayIndexExpr or Selector to be assignable
-    if (auto declLValue = dynamic_cast<DeclRefExpr *>(lvalue)) {
+    if (auto declLValue = dyn_cast<DeclRefExpr>(lvalue)) {
         auto lvalueType = declLValue->getType();
         auto convertedRValue = exprAnalysisPass.insertImplicitCast(rvalue, lvalueType);
         stmt.setRhs(convertedRValue);
-        return {};
-    } else if (auto indexLValue = dynamic_cast<IndexExpr *>(lvalue)) {
+        return;
+    } else if (auto indexLValue = dyn_cast<IndexExpr>(lvalue)) {
         auto indexedType = indexLValue->getType();
         auto convertedRValue = exprAnalysisPass.insertImplicitCast(rvalue, indexedType);
         stmt.setRhs(convertedRValue);
-        return {};
-    } else if (auto selectorLValue = dynamic_cast<SelectorExpr *>(lvalue)) {
+        return;
+    } else if (auto selectorLValue = dyn_cast<SelectorExpr>(lvalue)) {
         auto selectedType = selectorLValue->getType();
         auto convertedRValue = exprAnalysisPass.insertImplicitCast(rvalue, selectedType);
         stmt.setRhs(convertedRValue);
-        return {};
+        return;
     }
     stmt.setRhs(rvalue); // default new state
     throw TypeError{
@@ -232,61 +224,60 @@ OpaqueType SemanticAnalyzer::visit(AssignmentStmt &stmt) {
     };
 }
 
-OpaqueType SemanticAnalyzer::visit(ExpressionStmt &stmt) {
-    stmt.setExpr(Generic<Expression *>::Get(
-        stmt.getExpr()->accept(&exprAnalysisPass))
+void SemanticAnalyzer::visit(ExpressionStmt &stmt) {
+    stmt.setExpr(
+        exprAnalysisPass.visit(stmt.getExpr())
     );
-    return {};
 }
 
-OpaqueType ExpressionAnalyzer::visit(DeclRefExpr &expr) {
-    auto name = expr.getReferenceName();
+Expression * ExpressionAnalyzer::visit(DeclRefExpr &expr) {
+    auto name = expr.getReferenceSymbol();
     try { // resolve in local scope
         auto decl = parent.symbolTables.top()->find(name);
         expr.setType(decl->getType());
         expr.setDecl(decl);
     } catch (ReferenceError &_) {
         try { // resolve in lexical scope
-            auto member = parent.lexicalScopes.top()->resolve(name);
+            auto member = parent.lexicalScopes.top()->resolve(name.str());
             expr.setType(member->getMemberType());
-            expr.setDecl(dynamic_cast<Declaration *>(member->getParent()->getNodeDecl()));
+            expr.setDecl(dyn_cast<Declaration>(member->getParent()->getNodeDecl()));
         } catch (LexicalError &err) {
             throw ReferenceError{err.what()};
         }
     }
-    return Generic<Expression *>::Create(&expr);
+    return &expr;
 }
 
-OpaqueType ExpressionAnalyzer::visit(NewExpr &expr) {
-    return Generic<Expression *>::Create(&expr);
+Expression * ExpressionAnalyzer::visit(NewExpr &expr) {
+    return &expr;
 }
 
-OpaqueType ExpressionAnalyzer::visit(NumberLiteral &literal) {
+Expression * ExpressionAnalyzer::visit(NumberLiteral &literal) {
     if (static_cast<int>(literal.getValue()) == literal.getValue()) {
         literal.setType(typeContext.getBuiltinType(BuiltinType::Integer));
     } else {
         literal.setType(typeContext.getBuiltinType(BuiltinType::Number));
     }
-    return Generic<Expression *>::Create(&literal);
+    return &literal;
 }
 
-OpaqueType ExpressionAnalyzer::visit(StringLiteral &literal) {
+Expression * ExpressionAnalyzer::visit(StringLiteral &literal) {
     return {}; // todo: implement string
 }
 
-OpaqueType ExpressionAnalyzer::visit(BooleanLiteral &literal) {
+Expression * ExpressionAnalyzer::visit(BooleanLiteral &literal) {
     literal.setType(typeContext.getBuiltinType(BuiltinType::Boolean));
-    return Generic<Expression *>::Create(&literal);
+    return &literal;
 }
 
-OpaqueType ExpressionAnalyzer::visit(NullLiteral &literal) {
+Expression * ExpressionAnalyzer::visit(NullLiteral &literal) {
     literal.setType(typeContext.getReferenceType(nullptr));
-    return Generic<Expression *>::Create(&literal);
+    return &literal;
 }
 
-OpaqueType ExpressionAnalyzer::visit(UnaryExpr &expr) {
-    auto subexpr = Generic<Expression *>::Get(expr.getExpr()->accept(this));
-    auto builtin = dynamic_cast<BuiltinType *>(subexpr->getType());
+Expression * ExpressionAnalyzer::visit(UnaryExpr &expr) {
+    auto subexpr = visit(expr.getExpr());
+    auto builtin = dyn_cast<BuiltinType>(subexpr->getType());
     if (!builtin) throw TypeError{"Only Builtin type support UnaryExpr for now"};
 
     auto supported = builtin->getSupportedUnaryOps();
@@ -300,14 +291,14 @@ OpaqueType ExpressionAnalyzer::visit(UnaryExpr &expr) {
     auto resultType = supported[expr.getUnaryOp()];
     expr.setType(typeContext.getBuiltinType(resultType));
 
-    return Generic<Expression *>::Create(&expr);
+    return &expr;
 }
 
-OpaqueType ExpressionAnalyzer::visit(BinaryExpr &expr) {
-    auto lhsExpr = Generic<Expression *>::Get(expr.getLhs()->accept(this));
-    auto rhsExpr = Generic<Expression *>::Get(expr.getRhs()->accept(this));
-    auto lhs = dynamic_cast<BuiltinType *>(lhsExpr->getType());
-    auto rhs = dynamic_cast<BuiltinType *>(rhsExpr->getType());
+Expression * ExpressionAnalyzer::visit(BinaryExpr &expr) {
+    auto lhsExpr = visit(expr.getLhs());
+    auto rhsExpr = visit(expr.getRhs());
+    auto lhs = dyn_cast<BuiltinType>(lhsExpr->getType());
+    auto rhs = dyn_cast<BuiltinType>(rhsExpr->getType());
     if (lhs && rhs) {
         auto lhsSupported = lhs->getSupportedBinaryOps();
         auto rhsSupported = rhs->getSupportedBinaryOps();
@@ -316,7 +307,7 @@ OpaqueType ExpressionAnalyzer::visit(BinaryExpr &expr) {
             try {
                 expr.setRhs(insertImplicitCast(rhsExpr, targetType));
                 expr.setType(targetType);
-                return Generic<Expression *>::Create(&expr);
+                return &expr;
             } catch (TypeError &err) {}
         }
         if (rhsSupported.contains(expr.getBinaryOp())) {
@@ -324,7 +315,7 @@ OpaqueType ExpressionAnalyzer::visit(BinaryExpr &expr) {
             try {
                 expr.setLhs(insertImplicitCast(lhsExpr, targetType));
                 expr.setType(targetType);
-                return Generic<Expression *>::Create(&expr);
+                return &expr;
             } catch (TypeError &err) {}
         }
     }
@@ -334,53 +325,55 @@ OpaqueType ExpressionAnalyzer::visit(BinaryExpr &expr) {
     };
 }
 
-OpaqueType ExpressionAnalyzer::visit(CastExpr &expr) {
+Expression * ExpressionAnalyzer::visit(CastExpr &expr) {
     // no type check is required, programmer takes responsibility of the validity of the cast
-    expr.setFrom(Generic<Expression *>::Get(expr.getFrom()->accept(this)));
-    return Generic<Expression *>::Create(&expr);
+    expr.setFrom(visit(expr.getFrom()));
+    return &expr;
 }
 
-OpaqueType ExpressionAnalyzer::visit(IndexExpr &expr) {
-    expr.getBaseExpr()->accept(this);
+Expression * ExpressionAnalyzer::visit(IndexExpr &expr) {
+    visit(expr.getBaseExpr());
     expr.setIndex(insertImplicitCast(
-        Generic<Expression *>::Get(expr.getIndex()->accept(this)),
+        visit(expr.getIndex()),
         typeContext.getBuiltinType(BuiltinType::Integer))
     );
     auto baseType = expr.getType();
-    if (!baseType->isReferenceType()) throw TypeError{"Cannot index into " + baseType->getTypeString()};
+    if (!typeContext.isReferenceType(baseType)) {
+        throw TypeError{"Cannot index into " + baseType->getTypeString()};
+    }
 
-    auto arrRefType = dynamic_cast<ReferenceType *>(baseType);
-    if (auto array = dynamic_cast<ArrayType *>(arrRefType->getRefType())) {
+    auto arrRefType = dyn_cast<ReferenceType>(baseType);
+    if (auto array = dyn_cast<ArrayType>(arrRefType->getRefType())) {
         auto resultType = array->getElementType();
         expr.setType(resultType);
-        return Generic<Expression *>::Create(&expr);
+        return &expr;
     }
     throw TypeError{"Cannot index into non array type " + baseType->getTypeString()};
 }
 
-OpaqueType ExpressionAnalyzer::visit(SelectorExpr &expr) {
-    auto baseexpr = Generic<Expression *>::Get(expr.getBaseExpr()->accept(this));
+Expression * ExpressionAnalyzer::visit(SelectorExpr &expr) {
+    auto baseexpr = visit(expr.getBaseExpr());
     expr.setBaseExpr(baseexpr);
-    if (!baseexpr->getType()->isReferenceType()) {
+    if (!typeContext.isReferenceType(baseexpr->getType())) {
         throw TypeError{
             "Cannot access attribute " + expr.getSelector() +
                 " of a non-reference type " + baseexpr->getType()->getTypeString()
         };
     }
-    auto baseRefType = dynamic_cast<ReferenceType *>(baseexpr->getType());
-    if (auto classType = dynamic_cast<ClassType *>(baseRefType->getRefType())) {
+    auto baseRefType = dyn_cast<ReferenceType>(baseexpr->getType());
+    if (auto classType = dyn_cast<ClassType>(baseRefType->getRefType())) {
         auto member = classType->getMemberReference(expr.getSelector());
         expr.setType(member->getMemberAttrType());
-        return Generic<Expression *>::Create(&expr);
-    } else if (auto interfaceType = dynamic_cast<ClassType *>(baseRefType->getRefType())) {
+        return &expr;
+    } else if (auto interfaceType = dyn_cast<InterfaceType>(baseRefType->getRefType())) {
         auto member = interfaceType->getMemberReference(expr.getSelector());
         expr.setType(member->getMemberAttrType());
-        return Generic<Expression *>::Create(&expr);
+        return &expr;
     } else if (expr.getSelector() == "size") {
-        auto arrayType = dynamic_cast<ArrayType *>(baseRefType->getRefType());
+        auto arrayType = dyn_cast<ArrayType>(baseRefType->getRefType());
         if (!arrayType) throw TypeError{baseRefType->getRefType()->getTypeString() + " does not have attr size"};
         expr.setType(typeContext.getBuiltinType(BuiltinType::Integer));
-        return Generic<Expression *>::Create(&expr);
+        return &expr;
     }
     throw TypeError{
         baseexpr->getType()->getTypeString() + " does not have attribute " + expr.getSelector()
@@ -396,7 +389,7 @@ ArgumentExpr *ExpressionAnalyzer::verifyFunctionType(FunctionType *funcType, Arg
     }
     size_t index = 0;
     for (auto arg: expr.getArguments()) {
-        auto given = Generic<Expression *>::Get(arg->accept(this));
+        auto given = visit(arg);
         auto expected = insertImplicitCast(given, funcType->getParamTypes()[index]);
         expr.setArgument(expected, index);
         ++index;
@@ -405,25 +398,25 @@ ArgumentExpr *ExpressionAnalyzer::verifyFunctionType(FunctionType *funcType, Arg
     return &expr;
 }
 
-OpaqueType ExpressionAnalyzer::visit(ArgumentExpr &expr) {
-    auto base = Generic<Expression *>::Get(expr.getBaseExpr()->accept(this));
+Expression * ExpressionAnalyzer::visit(ArgumentExpr &expr) {
+    auto base = visit(expr.getBaseExpr());
     expr.setBaseExpr(base);
     // check for class instantiation
-    if (auto classType = dynamic_cast<ClassType *>(base->getType())) {
+    if (auto classType = dyn_cast<ClassType>(base->getType())) {
         if (classType->isAbstract())
             throw TypeError{"Cannot instantiate abstract class " + classType->getTypeString()};
         try { // has user defined ctor
             auto ctor = classType->getMemberReference("__init__");
-            auto ctorFunc = dynamic_cast<FunctionType *>(ctor->getMemberAttrType());
+            auto ctorFunc = dyn_cast<FunctionType>(ctor->getMemberAttrType());
             if (!ctorFunc) {
                 throw TypeError{
                     "Invalid ctor type " + ctor->getTypeString() +
                         " for " + base->getType()->getTypeString()};
             }
-            auto ctorRetType = dynamic_cast<ReferenceType *>(ctorFunc->getReturnType());
+            auto ctorRetType = dyn_cast<ReferenceType>(ctorFunc->getReturnType());
             if (!ctorRetType)
                 throw TypeError{"Invalid ctor ret type " + ctorFunc->getReturnType()->getTypeString()};
-            auto retInstanceType = dynamic_cast<ClassType *>(ctorRetType->getRefType());
+            auto retInstanceType = dyn_cast<ClassType>(ctorRetType->getRefType());
             if (!retInstanceType)
                 throw TypeError{"Invalid ctor ret type " + ctorFunc->getReturnType()->getTypeString()};
 
@@ -438,94 +431,96 @@ OpaqueType ExpressionAnalyzer::visit(ArgumentExpr &expr) {
 
         auto instanceType = typeContext.getReferenceType(classType, false);
         expr.setType(instanceType);
-        return Generic<Expression *>::Create(&expr);
+        return &expr;
     }
     FunctionType *funcType = nullptr;
     // regular function calls
-    if (auto regularFunc = dynamic_cast<FunctionType *>(base->getType())) {
+    if (auto regularFunc = dyn_cast<FunctionType>(base->getType())) {
         funcType = regularFunc;
-    } else if (auto funcRef = dynamic_cast<ReferenceType *>(base->getType())) {
+    } else if (auto funcRef = dyn_cast<ReferenceType>(base->getType())) {
         // lambda ref calls
-        if (auto baseFuncType = dynamic_cast<FunctionType *>(funcRef->getRefType())) {
+        if (auto baseFuncType = dyn_cast<FunctionType>(funcRef->getRefType())) {
             funcType = baseFuncType;
         }
     }
     if (funcType) {
-        return Generic<Expression *>::Create(verifyFunctionType(funcType, expr));
+        return verifyFunctionType(funcType, expr);
     }
     throw TypeError{"Unable to apply arguments to " + base->getType()->getTypeString()};
 }
 
-OpaqueType ExpressionAnalyzer::visit(ArrayLiteral &literal) {
+Expression * ExpressionAnalyzer::visit(ArrayLiteral &literal) {
     // todo: implement type hints
     return {};
 }
 
-OpaqueType ExpressionAnalyzer::visit(FunctionLiteral &literal) {
+Expression * ExpressionAnalyzer::visit(FunctionLiteral &literal) {
     parent.analyzeLambda(&literal);
-    return Generic<Expression *>::Create(&literal);
+    return &literal;
 }
 
-OpaqueType ExpressionAnalyzer::visit(ImplicitCastExpr &expr) {
-    return Generic<Expression *>::Create(&expr);
+Expression * ExpressionAnalyzer::visit(ImplicitCastExpr &expr) {
+    return &expr;
 }
 
 Expression *ExpressionAnalyzer::insertImplicitCast(Expression *expr, Type *targetType) {
     // todo: refactor this
-    if (dynamic_cast<VoidType *>(expr->getType()))
-        throw TypeError{"Cannot convert from void type"};
-
     auto fromType = expr->getType();
-    if (fromType == targetType) return expr; // type identity expect ref type
+    // the checks below compare ids and load flags of the type info table
+    const auto from = fromType->getID(), target = targetType->getID();
+    if (from == TypeID::Void) throw TypeError{"Cannot convert from void type"};
+    // a type not created by the type context has no id of its own, all of them share Invalid
+    const bool indexed = from != TypeID::Invalid && target != TypeID::Invalid;
+    if (indexed ? from == target : fromType == targetType) return expr; // type identity expect ref type
 
     // implicit bool conversion
-    if (targetType == typeContext.getBuiltinType(BuiltinType::Boolean)) {
+    if (target == TypeID::Boolean) {
         Operator::ImplicitConversion conversion;
-        if (fromType == typeContext.getBuiltinType(BuiltinType::Character)) {
+        if (from == TypeID::Character) {
             conversion = Operator::ImplicitConversion::CharToBool;
-        } else if (fromType == typeContext.getBuiltinType(BuiltinType::Integer)) {
+        } else if (from == TypeID::Integer) {
             conversion = Operator::ImplicitConversion::IntToBool;
-        } else if (fromType == typeContext.getBuiltinType(BuiltinType::Number)) {
+        } else if (from == TypeID::Number) {
             conversion = Operator::ImplicitConversion::NumToBool;
-        } else if (fromType->isReferenceType()) {
+        } else if (typeContext.isReferenceType(fromType)) {
             conversion = Operator::ImplicitConversion::RefToBool;
         } else {
             throw TypeError{"Unreachable: Cannot perform implicit bool conversion"}; // unreachable
         }
-        auto cast = astContext.create<ImplicitCastExpr>(expr->location(), expr, conversion);
-        cast->setType(targetType);
-        return cast;
+        auto implicitCast = astContext.create<ImplicitCastExpr>(expr->location(), expr, conversion);
+        implicitCast->setType(targetType);
+        return implicitCast;
     }
 
     // builtin type promotion and widening
     Operator::ImplicitConversion conversion = Operator::ImplicitConversion::Invalid;
-    if (fromType == typeContext.getBuiltinType(BuiltinType::Boolean)) {
-        if (targetType == typeContext.getBuiltinType(BuiltinType::Character)) {
+    if (from == TypeID::Boolean) {
+        if (target == TypeID::Character) {
             conversion = Operator::ImplicitConversion::BoolToChar;
-        } else if (targetType == typeContext.getBuiltinType(BuiltinType::Integer)) {
+        } else if (target == TypeID::Integer) {
             conversion = Operator::ImplicitConversion::BoolToInt;
-        } else if (targetType == typeContext.getBuiltinType(BuiltinType::Number)) {
+        } else if (target == TypeID::Number) {
             conversion = Operator::ImplicitConversion::BoolToNum;
         } else {
             throw TypeError{"Cannot promote BooleanType to " + targetType->getTypeString()};
         }
-    } else if (fromType == typeContext.getBuiltinType(BuiltinType::Character)) {
-        if (targetType == typeContext.getBuiltinType(BuiltinType::Integer)) {
+    } else if (from == TypeID::Character) {
+        if (target == TypeID::Integer) {
             conversion = Operator::ImplicitConversion::CharToInt;
-        } else if (targetType == typeContext.getBuiltinType(BuiltinType::Number)) {
+        } else if (target == TypeID::Number) {
             conversion = Operator::ImplicitConversion::CharToNum;
         } else {
             throw TypeError{"Cannot promote CharacterType to " + targetType->getTypeString()};
         }
-    } else if (fromType == typeContext.getBuiltinType(BuiltinType::Integer)) {
-        if (targetType == typeContext.getBuiltinType(BuiltinType::Number)) {
+    } else if (from == TypeID::Integer) {
+        if (target == TypeID::Number) {
             conversion = Operator::ImplicitConversion::IntToNum;
         } else {
             throw TypeError{"Cannot promote IntegerType to " + targetType->getTypeString()};
         }
-    } else if (fromType->isReferenceType() && targetType->isReferenceType()) {
-        auto fromRefType = dynamic_cast<ReferenceType *>(fromType);
-        auto targetRefType = dynamic_cast<ReferenceType *>(targetType);
+    } else if (typeContext.isReferenceType(fromType) && typeContext.isReferenceType(targetType)) {
+        auto fromRefType = dyn_cast<ReferenceType>(fromType);
+        auto targetRefType = dyn_cast<ReferenceType>(targetType);
 
         // nullptr conversion
         if (!fromRefType->getRefType()) {
@@ -535,9 +530,9 @@ Expression *ExpressionAnalyzer::insertImplicitCast(Expression *expr, Type *targe
                     "ImplicitCast from " + fromType->getTypeString() +
                         " drops null qualifier " + targetType->getTypeString()};
             }
-            auto cast = astContext.create<ImplicitCastExpr>(expr->location(), expr, conversion);
-            cast->setType(targetRefType);
-            return cast;
+            auto implicitCast = astContext.create<ImplicitCastExpr>(expr->location(), expr, conversion);
+            implicitCast->setType(targetRefType);
+            return implicitCast;
         }
 
         // reference null cast
@@ -548,26 +543,26 @@ Expression *ExpressionAnalyzer::insertImplicitCast(Expression *expr, Type *targe
                     "ImplicitCast from " + fromType->getTypeString() +
                         " drops null qualifier " + targetType->getTypeString()};
             }
-            auto cast = astContext.create<ImplicitCastExpr>(expr->location(), expr, conversion);
-            cast->setType(targetRefType);
-            return cast;
+            auto implicitCast = astContext.create<ImplicitCastExpr>(expr->location(), expr, conversion);
+            implicitCast->setType(targetRefType);
+            return implicitCast;
         }
 
         // reference down cast
         if (fromRefType->getRefType()->isClassOrInterfaceType() &&
             targetRefType->getRefType()->isClassOrInterfaceType()) {
             conversion = Operator::ImplicitConversion::RefDownCast;
-            auto from = dynamic_cast<CompositeType *>(fromRefType->getRefType());
-            auto target = dynamic_cast<CompositeType *>(targetRefType->getRefType());
+            auto from = dyn_cast<CompositeType>(fromRefType->getRefType());
+            auto target = dyn_cast<CompositeType>(targetRefType->getRefType());
 
             // class downcast conversion
             if (from->isClassType() && target->isClassType()) {
-                auto fromClass = dynamic_cast<ClassType *>(from);
-                auto targetClass = dynamic_cast<ClassType *>(target);
-                if (fromClass->isDerivedFrom(targetClass)) {
-                    auto cast = astContext.create<ImplicitCastExpr>(expr->location(), expr, conversion);
-                    cast->setType(targetRefType);
-                    return cast;
+                auto fromClass = dyn_cast<ClassType>(from);
+                auto targetClass = dyn_cast<ClassType>(target);
+                if (typeContext.isDerivedFrom(fromClass, targetClass)) {
+                    auto implicitCast = astContext.create<ImplicitCastExpr>(expr->location(), expr, conversion);
+                    implicitCast->setType(targetRefType);
+                    return implicitCast;
                 }
                 throw TypeError{
                     fromClass->getTypeString() + " is not derived from " +
@@ -576,12 +571,12 @@ Expression *ExpressionAnalyzer::insertImplicitCast(Expression *expr, Type *targe
             }
             // interface downcast conversion
             if (!from->isClassType() && !target->isClassType()) {
-                auto fromInterface = dynamic_cast<InterfaceType *>(from);
-                auto targetInterface = dynamic_cast<InterfaceType *>(target);
-                if (fromInterface->isDerivedFrom(targetInterface)) {
-                    auto cast = astContext.create<ImplicitCastExpr>(expr->location(), expr, conversion);
-                    cast->setType(targetRefType);
-                    return cast;
+                auto fromInterface = dyn_cast<InterfaceType>(from);
+                auto targetInterface = dyn_cast<InterfaceType>(target);
+                if (typeContext.isDerivedFrom(fromInterface, targetInterface)) {
+                    auto implicitCast = astContext.create<ImplicitCastExpr>(expr->location(), expr, conversion);
+                    implicitCast->setType(targetRefType);
+                    return implicitCast;
                 }
                 throw TypeError{
                     fromInterface->getTypeString() + " is not derived from " +
@@ -590,12 +585,12 @@ Expression *ExpressionAnalyzer::insertImplicitCast(Expression *expr, Type *targe
             }
             // class to interface conversion
             if (from->isClassType() && !target->isClassType()) {
-                auto fromClass = dynamic_cast<ClassType *>(from);
-                auto targetInterface = dynamic_cast<InterfaceType *>(target);
-                if (fromClass->implements(targetInterface)) {
-                    auto cast = astContext.create<ImplicitCastExpr>(expr->location(), expr, conversion);
-                    cast->setType(targetRefType);
-                    return cast;
+                auto fromClass = dyn_cast<ClassType>(from);
+                auto targetInterface = dyn_cast<InterfaceType>(target);
+                if (typeContext.implements(fromClass, targetInterface)) {
+                    auto implicitCast = astContext.create<ImplicitCastExpr>(expr->location(), expr, conversion);
+                    implicitCast->setType(targetRefType);
+                    return implicitCast;
                 }
                 throw TypeError{
                     fromClass->getTypeString() + " does not implement " +
@@ -612,9 +607,9 @@ Expression *ExpressionAnalyzer::insertImplicitCast(Expression *expr, Type *targe
         };
     }
 
-    auto cast = astContext.create<ImplicitCastExpr>(expr->location(), expr, conversion);
-    cast->setType(targetType);
-    return cast;
+    auto implicitCast = astContext.create<ImplicitCastExpr>(expr->location(), expr, conversion);
+    implicitCast->setType(targetType);
+    return implicitCast;
 }
 
 } // reflex
@@ -9,9 +9,11 @@
 #include <stack>
 #include <memory>
 #include <set>
+#include <unordered_map>
 
 #include "ASTVisitor.h"
 #include "TypeParser.h"
+#include "StringInterner.h"
 
 namespace reflex {
 
@@ -35,19 +37,19 @@ class SymbolTable final {
     /// @param name find the referenced decl
     /// @returns the VariableDecl in the nearest scope
     /// @throws ReferenceError if name can't be found
-    Declaration *find(const std::string &name);
+    Declaration *find(Symbol name);
 
     /// add decl to the current scope
     /// @param decl decl to be added
     /// @param name name override, defaults to use @p decl declname
     /// @throws ReferenceError if name already exists in current scope
-    void add(Declaration *decl, const std::string &name = "");
+    void add(Declaration *decl, Symbol name = {});
 
     bool isGlobalTable() const { return parent == nullptr; }
 
   private:
     SymbolTable *parent;
-    std::map<std::string, Declaration *> symbolTable;
+    std::unordered_map<Symbol, Declaration *> symbolTable;
     std::set<Declaration *> captures;
 };
 
@@ -58,31 +60,33 @@ class Expression;
 class SemanticAnalyzer;
 
 /// Class for preforming type analysis on Expression and inserts ImplicitCastExpr
-class ExpressionAnalyzer : public ASTExprVisitor {
+class ExpressionAnalyzer : public ASTExprVisitor<ExpressionAnalyzer, Expression *> {
     friend class SemanticAnalyzer;
   public:
+    using ASTExprVisitor::visit;
+
     ExpressionAnalyzer(TypeContext &typeContext,
                        ASTContext &astContext,
                        SemanticAnalyzer &parent)
         : typeContext(typeContext), astContext(astContext), parent(parent) {}
 
-    OpaqueType visit(DeclRefExpr &expr) override;
-    OpaqueType visit(NewExpr &expr) override;
-    OpaqueType visit(NumberLiteral &literal) override;
-    OpaqueType visit(StringLiteral &literal) override;
-    OpaqueType visit(BooleanLiteral &literal) override;
-    OpaqueType visit(NullLiteral &literal) override;
+    Expression * visit(DeclRefExpr &expr);
+    Expression * visit(NewExpr &expr);
+    Expression * visit(NumberLiteral &literal);
+    Expression * visit(StringLiteral &literal);
+    Expression * visit(BooleanLiteral &literal);
+    Expression * visit(NullLiteral &literal);
 
-    OpaqueType visit(UnaryExpr &expr) override;
-    OpaqueType visit(BinaryExpr &expr) override;
-    OpaqueType visit(CastExpr &expr) override;
-    OpaqueType visit(IndexExpr &expr) override;
-    OpaqueType visit(SelectorExpr &expr) override;
-    OpaqueType visit(ArgumentExpr &expr) override;
-    OpaqueType visit(ArrayLiteral &literal) override;
-    OpaqueType visit(ImplicitCastExpr &expr) override;
+    Expression * visit(UnaryExpr &expr);
+    Expression * visit(BinaryExpr &expr);
+    Expression * visit(CastExpr &expr);
+    Expression * visit(IndexExpr &expr);
+    Expression * visit(SelectorExpr &expr);
+    Expression * visit(ArgumentExpr &expr);
+    Expression * visit(ArrayLiteral &literal);
+    Expression * visit(ImplicitCastExpr &expr);
 
-    OpaqueType visit(FunctionLiteral &literal) override;
+    Expression * visit(FunctionLiteral &literal);
 
     ArgumentExpr *verifyFunctionType(FunctionType *expected, ArgumentExpr &expr);
 
@@ -98,9 +102,11 @@ class ExpressionAnalyzer : public ASTExprVisitor {
 };
 
 /// Class for performing semantic analysis on FunctionDecl, MethodDecl, FunctionLiteral
-class SemanticAnalyzer : public ASTStmtVisitor {
+class SemanticAnalyzer : public ASTStmtVisitor<SemanticAnalyzer> {
     friend class ExpressionAnalyzer;
   public:
+    using ASTStmtVisitor::visit;
+
     SemanticAnalyzer(TypeContext &typeContext, ASTContext &context)
         : typeContext(typeContext), typeParser(typeContext),
           exprAnalysisPass(typeContext, context, *this) {}
@@ -111,19 +117,19 @@ class SemanticAnalyzer : public ASTStmtVisitor {
     void analyzeField(FieldDecl *decl);
     void analyzeStaticVars(VariableDecl *var, LexicalScope *scope);
 
-    OpaqueType visit(BlockStmt &stmt) override;
-    OpaqueType visit(DeclStmt &stmt) override;
-
-    OpaqueType visit(ReturnStmt &stmt) override;
-    OpaqueType visit(BreakStmt &stmt) override;
-    OpaqueType visit(ContinueStmt &stmt) override;
-    OpaqueType visit(IfStmt &stmt) override;
-    OpaqueType visit(ForStmt &stmt) override;
-    OpaqueType visit(WhileStmt &stmt) override;
-    OpaqueType visit(EmptyStmt &stmt) override ASTVisitorDefImpl
-    OpaqueType visit(AssignmentStmt &stmt) override;
-    OpaqueType visit(IncDecStmt &stmt) override ASTVisitorDefImpl
-    OpaqueType visit(ExpressionStmt &stmt) override;
+    void visit(BlockStmt &stmt);
+    void visit(DeclStmt &stmt);
+
+    void visit(ReturnStmt &stmt);
+    void visit(BreakStmt &stmt);
+    void visit(ContinueStmt &stmt);
+    void visit(IfStmt &stmt);
+    void visit(ForStmt &stmt);
+    void visit(WhileStmt &stmt);
+    void visit(EmptyStmt &stmt) ASTVisitorDefImpl
+    void visit(AssignmentStmt &stmt);
+    void visit(IncDecStmt &stmt) ASTVisitorDefImpl
+    void visit(ExpressionStmt &stmt);
 
   private:
     TypeContext &typeContext;
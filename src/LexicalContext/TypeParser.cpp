@@ -32,7 +32,7 @@ CompositeType *TypeParser::parseCompositeType(ReferenceTypenameExpr *expr, Lexic
     auto qualifier = expr->getQualifiedString();
     try {
         auto found = starting->resolve(qualifier);
-        auto compositeType = dynamic_cast<CompositeType *>(found->getMemberType());
+        auto compositeType = dyn_cast<CompositeType>(found->getMemberType());
 
         if (compositeType) return compositeType;
         throw TypeError{
@@ -69,27 +69,30 @@ FunctionType *TypeParser::parseRefFunctionType(FunctionTypeExpr *expr, LexicalSc
 }
 
 Type *TypeParser::parseReferenceTypeExpr(ASTTypeExpr *expr, LexicalScope *starting) {
-    if (auto typname = dynamic_cast<ReferenceTypenameExpr *>(expr)) {
-        try {
-            return parseVoidType(typname, starting);
-        } catch (TypeError &err) {}
-        try {
-            return parseBuiltinType(typname, starting);
-        } catch (TypeError &err) {}
-        return context.getReferenceType(parseCompositeType(typname, starting));
+    switch (expr->getKind()) {
+        case ASTKind::BaseTypenameExpr:
+        case ASTKind::QualifiedTypenameExpr: {
+            auto typname = cast<ReferenceTypenameExpr>(expr);
+            try {
+                return parseVoidType(typname, starting);
+            } catch (TypeError &err) {}
+            try {
+                return parseBuiltinType(typname, starting);
+            } catch (TypeError &err) {}
+            return context.getReferenceType(parseCompositeType(typname, starting));
+        }
+        case ASTKind::ArrayTypeExpr:
+            return context.getReferenceType(parseRefArrayType(cast<ArrayTypeExpr>(expr), starting));
+        case ASTKind::FunctionTypeExpr:
+            return context.getReferenceType(parseRefFunctionType(cast<FunctionTypeExpr>(expr), starting));
+        default:
+            throw TypeError{"Cannot parse type"};
     }
-    if (auto array = dynamic_cast<ArrayTypeExpr *>(expr)) {
-        return context.getReferenceType(parseRefArrayType(array, starting));
-    }
-    if (auto func = dynamic_cast<FunctionTypeExpr *>(expr)) {
-        return context.getReferenceType(parseRefFunctionType(func, starting));
-    }
-    throw TypeError{"Cannot parse type"};
 }
 
 ClassType *TypeParser::parseClassType(ReferenceTypenameExpr *expr, LexicalScope *starting) {
     auto compositeType = parseCompositeType(expr, starting);
-    auto classType = dynamic_cast<ClassType *>(compositeType);
+    auto classType = dyn_cast<ClassType>(compositeType);
     if (!classType)
         throw TypeError{
             compositeType->getTypeString() + "is not a ClassType"
@@ -99,7 +102,7 @@ ClassType *TypeParser::parseClassType(ReferenceTypenameExpr *expr, LexicalScope
 
 InterfaceType *TypeParser::parseInterfaceType(ReferenceTypenameExpr *expr, LexicalScope *starting) {
     auto compositeType = parseCompositeType(expr, starting);
-    auto interfaceType = dynamic_cast<InterfaceType *>(compositeType);
+    auto interfaceType = dyn_cast<InterfaceType>(compositeType);
     if (!interfaceType)
         throw TypeError{
             compositeType->getTypeString() + "is not an InterfaceType"
@@ -129,22 +132,25 @@ FunctionType *TypeParser::parseFunctionType(FunctionTypeExpr *expr, LexicalScope
 }
 
 Type *TypeParser::parseBaseType(ASTTypeExpr *expr, LexicalScope *starting) {
-    if (auto typname = dynamic_cast<ReferenceTypenameExpr *>(expr)) {
-        try {
-            return parseVoidType(typname, starting);
-        } catch (TypeError &err) {}
-        try {
-            return parseBuiltinType(typname, starting);
-        } catch (TypeError &err) {}
-        return parseCompositeType(typname, starting);
-    }
-    if (auto array = dynamic_cast<ArrayTypeExpr *>(expr)) {
-        return parseArrayType(array, starting);
-    }
-    if (auto func = dynamic_cast<FunctionTypeExpr *>(expr)) {
-        return parseFunctionType(func, starting);
+    switch (expr->getKind()) {
+        case ASTKind::BaseTypenameExpr:
+        case ASTKind::QualifiedTypenameExpr: {
+            auto typname = cast<ReferenceTypenameExpr>(expr);
+            try {
+                return parseVoidType(typname, starting);
+            } catch (TypeError &err) {}
+            try {
+                return parseBuiltinType(typname, starting);
+            } catch (TypeError &err) {}
+            return parseCompositeType(typname, starting);
+        }
+        case ASTKind::ArrayTypeExpr:
+            return parseArrayType(cast<ArrayTypeExpr>(expr), starting);
+        case ASTKind::FunctionTypeExpr:
+            return parseFunctionType(cast<FunctionTypeExpr>(expr), starting);
+        default:
+            throw TypeError{"Cannot parse type"};
     }
-    throw TypeError{"Cannot parse type"};
 }
 
 }
@@ -4,12 +4,15 @@
 
 #include "Parser.h"
 
+#include <algorithm>
+#include <thread>
+
 #include "ASTContext.h"
 
 namespace reflex {
 
-DeclStmt *Parser::parseDeclStmt() {
-    Declaration *decl;
+ParseResult<DeclStmt *> Parser::parseDeclStmt() {
+    ParseResult<Declaration *> decl = ParseError();
     if (check(TokenType::Class)) {
         decl = parseClassDecl(Visibility::Private);
     } else if (check(TokenType::Interface)) {
@@ -17,221 +20,390 @@ DeclStmt *Parser::parseDeclStmt() {
     } else {
         decl = parseVariableDecl();
     }
-    return context.create<DeclStmt>(decl->location(), decl);
+    if (!decl) return ParseError();
+    return context.create<DeclStmt>(decl->location(), *decl);
 }
 
-std::pair<std::vector<ParamDecl *>, ASTTypeExpr *> Parser::parseSignature() {
-    expect(TokenType::LParen);
+ParseResult<std::pair<ASTList<ParamDecl *>, ASTTypeExpr *>> Parser::parseSignature() {
+    if (!expect(TokenType::LParen)) return ParseError();
     auto params = parseParamList();
+    if (!params) return ParseError();
     auto end = expect(TokenType::RParen);
-    ASTTypeExpr *returnType = context.create<BaseTypenameExpr>(end.getLocInfo(), "void");
+    if (!end) return ParseError();
+    ASTTypeExpr *returnType = context.create<BaseTypenameExpr>(end->getLocInfo(), "void");
     if (check(TokenType::ReturnArrow)) {
         next();
-        returnType = parseType();
+        auto type = parseType();
+        if (!type) return ParseError();
+        returnType = *type;
     }
-    return {params, returnType};
+    return std::pair{*params, returnType};
 }
 
-std::vector<ParamDecl *> Parser::parseParamList() {
+ParseResult<ASTList<ParamDecl *>> Parser::parseParamList() {
+    const auto base = listStack.size();
     if (check(TokenType::RParen)) {
-        return {};
+        return ASTList<ParamDecl *>();
     }
-    std::vector<ParamDecl *> params;
-    params.push_back(parseFuncParam());
+    auto param = parseFuncParam();
+    if (!param) return dropList(base);
+    listStack.push_back(*param);
     while (!check(TokenType::RParen)) {
-        expect(TokenType::Comma);
-        params.push_back(parseFuncParam());
+        if (!expect(TokenType::Comma)) return dropList(base);
+        param = parseFuncParam();
+        if (!param) return dropList(base);
+        listStack.push_back(*param);
     }
-    return params;
+    return popList<ParamDecl *>(base);
 }
 
-ParamDecl *Parser::parseFuncParam() {
+ParseResult<ParamDecl *> Parser::parseFuncParam() {
     auto ident = parseBaseTypenameType();
-    expect(TokenType::Colon);
+    if (!ident || !expect(TokenType::Colon)) return ParseError();
+    auto type = parseType();
+    if (!type) return ParseError();
     return context.create<ParamDecl>(
         ident->location(),
-        ident->getTypeName(),
-        parseType()
+        ident->getTypeSymbol(),
+        *type
     );
 }
 
-FunctionDecl *Parser::parseFunctionDecl() {
-    auto startToken = expect(TokenType::Func);
+ParseResult<FunctionDecl *> Parser::parseFunctionDecl() {
+    if (!expect(TokenType::Func)) return ParseError();
     auto name = parseBaseTypenameType();
-    auto [params, ret] = parseSignature();
-    BlockStmt *body = nullptr;
+    if (!name) return ParseError();
+    auto signature = parseSignature();
+    if (!signature) return ParseError();
+    auto &[params, ret] = *signature;
+    DeferredBody body;
     if (!check(TokenType::SemiColon)) {
-        body = parseBlockStmt();
+        auto parsed = parseFunctionBody();
+        if (!parsed) return ParseError();
+        body = *parsed;
     }
     return context.create<FunctionDecl>(
         name->location(),
-        name->getTypeName(), params, ret, body
+        name->getTypeSymbol(), params, ret, body
     );
 }
 
-MethodDecl *Parser::parseMethodDecl(Visibility visibility, AggregateDecl *parent) {
-    auto startToken = expect(TokenType::Func);
+ParseResult<MethodDecl *> Parser::parseMethodDecl(Visibility visibility, AggregateDecl *parent) {
+    if (!expect(TokenType::Func)) return ParseError();
     auto name = parseBaseTypenameType();
-    auto [params, ret] = parseSignature();
-    BlockStmt *body = nullptr;
+    if (!name) return ParseError();
+    auto signature = parseSignature();
+    if (!signature) return ParseError();
+    auto &[params, ret] = *signature;
+    DeferredBody body;
     if (!check(TokenType::SemiColon)) {
-        body = parseBlockStmt();
+        auto parsed = parseFunctionBody();
+        if (!parsed) return ParseError();
+        body = *parsed;
     }
     return context.create<MethodDecl>(
         name->location(),
-        name->getTypeName(), params, ret, body, parent, visibility
+        name->getTypeSymbol(), params, ret, body, parent, visibility
     );
 }
 
-VariableDecl *Parser::parseVariableDecl() {
-    expect(TokenType::Var);
+ParseResult<VariableDecl *> Parser::parseVariableDecl() {
+    if (!expect(TokenType::Var)) return ParseError();
     auto name = parseBaseDeclRef();
+    if (!name) return ParseError();
     ASTTypeExpr *varType = nullptr;
     Expression *initializer = nullptr;
     if (check(TokenType::Colon)) {
         next();
-        varType = parseType();
+        auto type = parseType();
+        if (!type) return ParseError();
+        varType = *type;
     }
     if (check(TokenType::Assign)) {
         next();
-        initializer = parseExpr();
+        auto value = parseExpr();
+        if (!value) return ParseError();
+        initializer = *value;
     }
     return context.create<VariableDecl>(
         name->location(),
-        name->getBaseRefName(), varType, initializer
+        name->getReferenceSymbol(), varType, initializer
     );
 }
 
-FieldDecl *Parser::parseFieldDecl(Visibility visibility, ClassDecl *parent) {
-    expect(TokenType::Var);
+ParseResult<FieldDecl *> Parser::parseFieldDecl(Visibility visibility, ClassDecl *parent) {
+    if (!expect(TokenType::Var)) return ParseError();
     auto name = parseBaseDeclRef();
+    if (!name) return ParseError();
     ASTTypeExpr *varType = nullptr;
     Expression *initializer = nullptr;
     if (check(TokenType::Colon)) {
         next();
-        varType = parseType();
+        auto type = parseType();
+        if (!type) return ParseError();
+        varType = *type;
     }
     if (check(TokenType::Assign)) {
         next();
-        initializer = parseExpr();
+        auto value = parseExpr();
+        if (!value) return ParseError();
+        initializer = *value;
     }
     return context.create<FieldDecl>(
         name->location(),
-        name->getBaseRefName(), varType, parent, visibility, initializer
+        name->getReferenceSymbol(), varType, parent, visibility, initializer
     );
 }
 
-ReferenceTypenameExpr *Parser::parseBaseClass() {
+ParseResult<ReferenceTypenameExpr *> Parser::parseBaseClass() {
     if (!check(TokenType::LParen)) return nullptr;
     next();
-    ReferenceTypenameExpr *baseclass = parseBaseTypenameType();
-    if (check(TokenType::NameSeparator)) {
-        baseclass = parseQualifiedType(baseclass);
-    }
-    expect(TokenType::RParen);
+    auto baseclass = parseDerivedInterface();
+    if (!baseclass || !expect(TokenType::RParen)) return ParseError();
     return baseclass;
 }
 
-ReferenceTypenameExpr *Parser::parseDerivedInterface() {
-    ReferenceTypenameExpr *baseclass = parseBaseTypenameType();
-    if (check(TokenType::NameSeparator)) {
-        baseclass = parseQualifiedType(baseclass);
+ParseResult<ReferenceTypenameExpr *> Parser::parseDerivedInterface() {
+    ParseResult<ReferenceTypenameExpr *> baseclass = parseBaseTypenameType();
+    if (baseclass && check(TokenType::NameSeparator)) {
+        baseclass = parseQualifiedType(*baseclass);
     }
     return baseclass;
 }
 
-std::vector<ReferenceTypenameExpr *> Parser::parseInterfaceList() {
-    if (!check(TokenType::Colon)) return {};
+ParseResult<ASTList<ReferenceTypenameExpr *>> Parser::parseInterfaceList() {
+    const auto base = listStack.size();
+    if (!check(TokenType::Colon)) return ASTList<ReferenceTypenameExpr *>();
     next();
-    std::vector<ReferenceTypenameExpr *> interfaces;
-    interfaces.push_back(parseDerivedInterface());
+    auto interface = parseDerivedInterface();
+    if (!interface) return dropList(base);
+    listStack.push_back(*interface);
     while (check(TokenType::Comma)) {
         next();
-        interfaces.push_back(parseDerivedInterface());
+        interface = parseDerivedInterface();
+        if (!interface) return dropList(base);
+        listStack.push_back(*interface);
     }
-    return interfaces;
+    return popList<ReferenceTypenameExpr *>(base);
 }
 
-ClassDecl *Parser::parseClassDecl(Visibility visibility) {
+ParseResult<ClassDecl *> Parser::parseClassDecl(Visibility visibility) {
     auto startToken = expect(TokenType::Class);
+    if (!startToken) return ParseError();
     auto classname = parseBaseTypenameType();
+    if (!classname) return ParseError();
     auto baseclass = parseBaseClass();
+    if (!baseclass) return ParseError();
     auto interfaces = parseInterfaceList();
+    if (!interfaces) return ParseError();
     auto klassDecl = context.create<ClassDecl>(
-        startToken.getLocInfo(), visibility,
-        classname->getTypeName(), baseclass, interfaces
+        startToken->getLocInfo(), visibility,
+        classname->getTypeSymbol(), *baseclass, *interfaces
     );
-    parseClassBody(klassDecl);
-    return klassDecl;
+    return parseClassBody(klassDecl);
 }
 
-InterfaceDecl *Parser::parseInterfaceDecl(Visibility visibility) {
+ParseResult<InterfaceDecl *> Parser::parseInterfaceDecl(Visibility visibility) {
     auto startToken = expect(TokenType::Interface);
+    if (!startToken) return ParseError();
     auto name = parseBaseTypenameType();
+    if (!name) return ParseError();
     auto interfaces = parseInterfaceList();
+    if (!interfaces) return ParseError();
     auto interfaceDecl = context.create<InterfaceDecl>(
-        startToken.getLocInfo(), visibility,
-        name->getTypeName(), interfaces
+        startToken->getLocInfo(), visibility,
+        name->getTypeSymbol(), *interfaces
     );
-    parseInterfaceBody(interfaceDecl);
-    return interfaceDecl;
+    return parseInterfaceBody(interfaceDecl);
+}
+
+ParseResult<Visibility> Parser::parseVisibility() {
+    auto visToken = expect(TokenType::Identifier);
+    if (!visToken) return ParseError();
+    auto modifier = visToken->getLexeme();
+    if (modifier != "public" && modifier != "private" && modifier != "protected" && modifier != "static") {
+        errorList.push_back(std::make_unique<ParsingUnknownModifierError>(*visToken));
+        return ParseError();
+    }
+    return getVisibilityFromString(std::string(modifier));
 }
 
-void Parser::parseClassBody(ClassDecl *klass) {
-    expect(TokenType::LBrace);
+ParseResult<ClassDecl *> Parser::parseClassBody(ClassDecl *klass) {
+    const auto base = listStack.size();
+    if (!expect(TokenType::LBrace)) return ParseError();
     while (!check(TokenType::RBrace)) {
-        auto visToken = expect(TokenType::Identifier);
-        auto visibility = getVisibilityFromString(visToken.getLexeme());
-        if (check(TokenType::Class)) {
-            klass->addMemberDecl(parseClassDecl(visibility));
-        } else if (check(TokenType::Interface)) {
-            klass->addMemberDecl(parseInterfaceDecl(visibility));
-        } else if (check(TokenType::Func)) {
-            klass->addMemberDecl(parseMethodDecl(visibility, klass));
-        } else {
-            klass->addMemberDecl(parseFieldDecl(visibility, klass));
-            expect(TokenType::SemiColon);
+        auto visibility = parseVisibility();
+        ParseResult<Declaration *> member = ParseError();
+        if (visibility && check(TokenType::Class)) {
+            member = parseClassDecl(*visibility);
+        } else if (visibility && check(TokenType::Interface)) {
+            member = parseInterfaceDecl(*visibility);
+        } else if (visibility && check(TokenType::Func)) {
+            member = parseMethodDecl(*visibility, klass);
+        } else if (visibility) {
+            member = parseFieldDecl(*visibility, klass);
+            if (member && !expect(TokenType::SemiColon)) member = ParseError();
+        }
+        if (member) {
+            listStack.push_back(*member);
+            continue;
         }
+        recover();
+        if (check(TokenType::EndOfFile)) return dropList(base);
     }
-    expect(TokenType::RBrace);
+    next();
+    // members are collected in source order, group them by kind keeping that order within each kind
+    auto members = listStack.begin() + static_cast<ptrdiff_t>(base);
+    auto fields = std::stable_partition(members, listStack.end(), [](auto node) { return isa<AggregateDecl>(node); });
+    auto methods = std::stable_partition(fields, listStack.end(), [](auto node) { return isa<FieldDecl>(node); });
+    klass->setMembers(
+        context.createList<AggregateDecl *>(std::ranges::subrange(members, fields)),
+        context.createList<FieldDecl *>(std::ranges::subrange(fields, methods)),
+        context.createList<MethodDecl *>(std::ranges::subrange(methods, listStack.end()))
+    );
+    listStack.resize(base);
+    return klass;
 }
 
-void Parser::parseInterfaceBody(InterfaceDecl *interface) {
-    expect(TokenType::LBrace);
+ParseResult<InterfaceDecl *> Parser::parseInterfaceBody(InterfaceDecl *interface) {
+    const auto base = listStack.size();
+    if (!expect(TokenType::LBrace)) return ParseError();
     while (!check(TokenType::RBrace)) {
-        auto visToken = expect(TokenType::Identifier);
-        auto visibility = getVisibilityFromString(visToken.getLexeme());
-        if (check(TokenType::Interface)) {
-            interface->addMemberDecl(parseInterfaceDecl(visibility));
-        } else if (check(TokenType::Func)) {
-            interface->addMemberDecl(parseMethodDecl(visibility, interface));
-            expect(TokenType::SemiColon);
+        auto visibility = parseVisibility();
+        ParseResult<Declaration *> member = ParseError();
+        if (visibility && check(TokenType::Interface)) {
+            member = parseInterfaceDecl(*visibility);
+        } else if (visibility) {
+            member = parseMethodDecl(*visibility, interface);
+            if (member && !expect(TokenType::SemiColon)) member = ParseError();
+        }
+        if (member) {
+            listStack.push_back(*member);
+            continue;
         }
+        recover();
+        if (check(TokenType::EndOfFile)) return dropList(base);
     }
-    expect(TokenType::RBrace);
+    next();
+    auto members = listStack.begin() + static_cast<ptrdiff_t>(base);
+    auto methods = std::stable_partition(members, listStack.end(), [](auto node) { return isa<AggregateDecl>(node); });
+    interface->setMembers(
+        context.createList<AggregateDecl *>(std::ranges::subrange(members, methods)),
+        context.createList<MethodDecl *>(std::ranges::subrange(methods, listStack.end()))
+    );
+    listStack.resize(base);
+    return interface;
 }
 
 CompilationUnit *Parser::parseCompilationUnit() {
     std::vector<Declaration *> decls;
     auto startToken = lookahead;
-    while (!check(TokenType::EndOfFile) && !check(TokenType::WhiteSpace)) {
+    parseTopLevelDecls(tokens.size(), decls);
+    if (!errorList.empty()) throw makeUnrecoverable(*errorList.front());
+    return context.create<CompilationUnit>(
+        startToken.getLocInfo(),
+        "CompilationUnit", decls
+    );
+}
+
+CompilationUnit *Parser::parseCompilationUnit(size_t threads) {
+    // below this many tokens per worker spawning threads costs more than parsing
+    constexpr size_t MinChunkTokens = 64 << 10;
+    const auto chunkTokens = std::max(MinChunkTokens, tokens.size() / std::max<size_t>(threads, 1));
+    std::vector<size_t> splits{cursor};
+    for (auto boundary: findDeclBoundaries(tokens)) {
+        if (boundary > splits.back() && boundary - splits.back() >= chunkTokens) splits.push_back(boundary);
+    }
+    if (splits.size() == 1) return parseCompilationUnit();
+    splits.push_back(tokens.size() - 1);
+
+    const auto count = splits.size() - 1;
+    std::vector<std::unique_ptr<ASTContext>> contexts(count);
+    std::vector<std::unique_ptr<Parser>> parsers(count);
+    std::vector<std::vector<Declaration *>> decls(count);
+    // a chunk fails on an error or when its last declaration does not end at the next boundary
+    std::vector<char> failed(count);
+    for (size_t chunk = 0; chunk < count; ++chunk) {
+        contexts[chunk] = std::make_unique<ASTContext>();
+        parsers[chunk].reset(new Parser(*contexts[chunk], tokens, splits[chunk]));
+        parsers[chunk]->deferFunctionBodies = deferFunctionBodies;
+    }
+    auto parseChunk = [&](size_t chunk) {
+        try {
+            parsers[chunk]->parseTopLevelDecls(splits[chunk + 1], decls[chunk]);
+            failed[chunk] = !parsers[chunk]->errorList.empty() || parsers[chunk]->cursor != splits[chunk + 1];
+        } catch (...) {
+            failed[chunk] = true;
+        }
+    };
+    std::vector<std::thread> threadPool;
+    for (size_t chunk = 1; chunk < count; ++chunk) threadPool.emplace_back(parseChunk, chunk);
+    parseChunk(0);
+    for (auto &thread: threadPool) thread.join();
+
+    // the sequential parse reports the errors of all chunks in source order, start over
+    if (std::ranges::find(failed, true) != failed.end()) return parseCompilationUnit();
+
+    auto startToken = lookahead;
+    std::vector<Declaration *> merged;
+    for (size_t chunk = 0; chunk < count; ++chunk) {
+        merged.insert(merged.end(), decls[chunk].begin(), decls[chunk].end());
+        context.adopt(std::move(contexts[chunk]));
+        workers.push_back(std::move(parsers[chunk]));
+    }
+    cursor = splits.back();
+    lookahead = tokens.getToken(cursor);
+    return context.create<CompilationUnit>(
+        startToken.getLocInfo(),
+        "CompilationUnit", merged
+    );
+}
+
+std::vector<size_t> Parser::findDeclBoundaries(const TokenBuffer &tokens) {
+    std::vector<size_t> boundaries;
+    size_t depth = 0;
+    auto previous = TokenType::EndOfFile;
+    for (size_t i = 0; i < tokens.size(); ++i) {
+        auto kind = tokens.getKind(i);
+        if (kind == TokenType::LBrace) {
+            ++depth;
+        } else if (kind == TokenType::RBrace) {
+            if (depth) --depth;
+        } else if (depth == 0 && i > 0 && (previous == TokenType::RBrace || previous == TokenType::SemiColon)
+            && (kind == TokenType::Func || kind == TokenType::Var || kind == TokenType::Class
+                || kind == TokenType::Interface)) {
+            boundaries.push_back(i);
+        }
+        previous = kind;
+    }
+    return boundaries;
+}
+
+void Parser::parseTopLevelDecls(size_t end, std::vector<Declaration *> &decls) {
+    while (cursor < end && !check(TokenType::EndOfFile) && !check(TokenType::WhiteSpace)) {
+        const auto start = cursor;
+        ParseResult<Declaration *> decl = ParseError();
         if (check(TokenType::Func)) {
-            decls.push_back(parseFunctionDecl());
+            decl = parseFunctionDecl();
         } else if (check(TokenType::Var)) {
             auto var = parseVariableDecl();
-            var->setGlobal();
-            decls.push_back(var);
-            expect(TokenType::SemiColon);
+            if (var && expect(TokenType::SemiColon)) {
+                (*var)->setGlobal();
+                decl = var;
+            }
         } else if (check(TokenType::Class)) {
-            decls.push_back(parseClassDecl(Visibility::Public));
+            decl = parseClassDecl(Visibility::Public);
         } else {
-            decls.push_back(parseInterfaceDecl(Visibility::Public));
+            decl = parseInterfaceDecl(Visibility::Public);
         }
+        if (decl) {
+            decls.push_back(*decl);
+            continue;
+        }
+        recover();
+        // a stray } stops the recovery before it
+        if (cursor == start) next();
     }
-    return context.create<CompilationUnit>(
-        startToken.getLocInfo(),
-        "CompilationUnit", decls
-    );
 }
 
 }
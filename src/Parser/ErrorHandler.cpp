@@ -4,6 +4,27 @@
 
 #include "ErrorHandler.h"
 
+#include "Parser.h"
+
 namespace reflex {
 
+void TokenSyncErrorHandler::resumeParsingHandler() {
+    size_t depth = 0;
+    while (!parser.check(TokenType::EndOfFile)) {
+        if (parser.check(TokenType::LBrace)) {
+            ++depth;
+        } else if (parser.check(TokenType::RBrace)) {
+            if (depth == 0) return;
+            if (--depth == 0) {
+                parser.next();
+                return;
+            }
+        } else if (parser.check(TokenType::SemiColon) && depth == 0) {
+            parser.next();
+            return;
+        }
+        parser.next();
+    }
+}
+
 }
@@ -16,17 +16,21 @@ class ErrorHandler {
     explicit ErrorHandler(Parser &parser) : parser(parser) {}
     virtual ~ErrorHandler() = default;
 
+    /// Moves the parser past the construct that failed to parse
     virtual void resumeParsingHandler() = 0;
-  private:
+  protected:
     Parser &parser;
 };
 
+/// Skips to the end of the failed statement or declaration
+/// - stops after a ; outside of braces, or after the } closing a { skipped on the way
+/// - stops before a } of an enclosing block and at the end of the file
+/// - always consumes at least one token unless at such a } or the end of the file
 class TokenSyncErrorHandler : public ErrorHandler {
   public:
-    TokenSyncErrorHandler(Parser &parser, const TokenType &syncTokenType)
-        : ErrorHandler(parser), syncTokenType(syncTokenType) {}
-  private:
-    TokenType syncTokenType;
+    explicit TokenSyncErrorHandler(Parser &parser) : ErrorHandler(parser) {}
+
+    void resumeParsingHandler() override;
 };
 
 }
@@ -9,194 +9,262 @@
 
 namespace reflex {
 
-Identifier *Parser::parseBaseDeclRef() {
+ParseResult<Identifier *> Parser::parseBaseDeclRef() {
     auto token = expect(TokenType::Identifier);
-    return context.create<Identifier>(token.getLocInfo(), nullptr, token.getLexeme());
+    if (!token) return ParseError();
+    return context.create<Identifier>(token->getLocInfo(), nullptr, token->getSymbol());
 }
 
-ModuleSelector *Parser::parseModuleSelector(DeclRefExpr *base) {
-    expect(TokenType::NameSeparator);
+ParseResult<ModuleSelector *> Parser::parseModuleSelector(DeclRefExpr *base) {
+    if (!expect(TokenType::NameSeparator)) return ParseError();
     auto name = parseBaseTypenameType();
+    if (!name) return ParseError();
     auto selector = context.create<ModuleSelector>(
         name->location(), nullptr,
-        name->getTypeName(), base
+        name->getTypeSymbol(), base
     );
     while (check(TokenType::NameSeparator)) {
         next();
         name = parseBaseTypenameType();
+        if (!name) return ParseError();
         selector = context.create<ModuleSelector>(
             name->location(), nullptr,
-            name->getTypeName(), base
+            name->getTypeSymbol(), base
         );
     }
     return selector;
 }
 
-Expression *Parser::parseNamedOperand() {
-    if (check(TokenType::Identifier)) {
-        DeclRefExpr *ident = parseBaseDeclRef();
-        if (check(TokenType::NameSeparator)) {
-            ident = parseModuleSelector(ident);
-        }
-        return ident;
-    }
-    if (check(TokenType::LParen)) {
-        next();
-        auto subexpr = parseExpr();
-        expect(TokenType::RParen);
-        return subexpr;
-    }
-    return parseLiteral();
-}
-
-Expression *Parser::parseUnaryExpr() {
-    if (lookahead.isUnaryOp()) {
-        auto unaryOp = lookahead;
-        next();
-        return context.create<UnaryExpr>(
-            unaryOp.getLocInfo(),
-            Operator::createUnaryOperatorFromToken(unaryOp),
-            parseExpr()
-        );
-    }
-    return parsePrimaryExpr();
-}
-
-Expression *Parser::parseOperand() {
-    if (check(TokenType::Identifier)) {
-        DeclRefExpr *ident = parseBaseDeclRef();
-        if (check(TokenType::NameSeparator)) {
-            ident = parseModuleSelector(ident);
-        }
-        return ident;
-    }
-    if (check(TokenType::LParen)) {
-        next();
-        auto subexpr = parseExpr();
-        expect(TokenType::RParen);
-        return subexpr;
-    }
-    return parseLiteral();
-}
-
-Expression *Parser::parsePrimaryExpr() {
-    Expression *base;
-    if (check(TokenType::New)) {
-        base = parseNewExpr();
-    } else if (check(TokenType::Cast)) {
-        base = parseConversion();
-    } else {
-        base = parseOperand();
-    }
-    return parsePrimaryExpr2(base);
-}
-
-Expression *Parser::parsePrimaryExpr1(Expression *base) {
-    if (check(TokenType::Period)) {
-        return parseSelectorExpr(base);
-    }
-    if (check(TokenType::LBracket)) {
-        return parseIndexExpr(base);
-    }
-    return parseArgument(base);
-}
-
-Expression *Parser::parsePrimaryExpr2(Expression *base) {
-    auto type = lookahead.getTokenType().getValue();
-    if (type == TokenType::Period ||
-        type == TokenType::LBracket ||
-        type == TokenType::LParen) {
-        auto newbase = parsePrimaryExpr1(base);
-        return parsePrimaryExpr2(newbase);
-    }
-    return base;
-}
-
-Expression *Parser::parseNewExpr() {
-    expect(TokenType::New);
+ParseResult<Expression *> Parser::parseNewExpr() {
+    if (!expect(TokenType::New)) return ParseError();
     auto instanceTyp = parseType();
+    if (!instanceTyp) return ParseError();
     return context.create<NewExpr>(
         instanceTyp->location(),
-        instanceTyp
-    );
-}
-
-Expression *Parser::parseConversion() {
-    auto startToken = expect(TokenType::Cast);
-    expect(TokenType::LAngleBracket);
-    auto typ = parseType();
-    expect(TokenType::RAngleBracket);
-    expect(TokenType::LParen);
-    auto expr = parseExpr();
-    expect(TokenType::RParen);
-    return context.create<CastExpr>(
-        startToken.getLocInfo(),
-        typ, expr
+        *instanceTyp
     );
 }
 
-Expression *Parser::parseSelectorExpr(Expression *base) {
-    expect(TokenType::Period);
+ParseResult<Expression *> Parser::parseSelectorExpr(Expression *base) {
+    if (!expect(TokenType::Period)) return ParseError();
     auto ident = parseBaseDeclRef();
+    if (!ident) return ParseError();
     return context.create<SelectorExpr>(
         ident->location(),
-        base, ident->getBaseRefName()
+        base, ident->getReferenceSymbol()
     );
 }
 
-IndexExpr *Parser::parseIndexExpr(Expression *base) {
-    auto startToken = expect(TokenType::LBracket);
-    auto index = parseExpr();
-    expect(TokenType::RBracket);
-    return context.create<IndexExpr>(
-        startToken.getLocInfo(),
-        base, index
-    );
-}
-
-ArgumentExpr *Parser::parseArgument(Expression *base) {
-    auto startToken = expect(TokenType::LParen);
-    auto args = parseArgumentList();
-    expect(TokenType::RParen);
-    return context.create<ArgumentExpr>(
-        startToken.getLocInfo(),
-        base, args
-    );
+Parser::ExprFrame &Parser::openExprFrame(ExprFrame::Kind kind, const Token &token) {
+    return exprFrames.emplace_back(ExprFrame{
+        kind, token, nullptr, nullptr,
+        exprOperands.size(), exprOperators.size(), exprElements.size()
+    });
 }
 
-std::vector<Expression *> Parser::parseArgumentList() {
-    if (check(TokenType::RParen)) {
-        return {};
-    }
-    std::vector<Expression *> args;
-    args.push_back(parseExpr());
-    while (!check(TokenType::RParen)) {
-        expect(TokenType::Comma);
-        args.push_back(parseExpr());
+void Parser::reduceBinaryExprs(const ExprFrame &frame, int minPrec) {
+    while (exprOperators.size() > frame.operators && exprOperators.back().getTokenPrec() >= minPrec) {
+        auto binOp = exprOperators.back();
+        exprOperators.pop_back();
+        auto rhs = exprOperands.back();
+        exprOperands.pop_back();
+        auto &lhs = exprOperands.back();
+        lhs = context.create<BinaryExpr>(
+            binOp.getLocInfo(),
+            static_cast<Operator::BinaryOperator>(binOp.getTokenInfo().binaryOp),
+            lhs, rhs
+        );
     }
-    return args;
 }
 
-Expression *Parser::parseExpr() {
-    return parseExpr1(0, parseUnaryExpr());
-}
+ParseResult<Expression *> Parser::parseExpr() {
+    // where the parser is within the innermost frame
+    enum class Position {
+      Prefix,       // before an operand
+      Postfix,      // after an operand, before selectors, indices and calls
+      Infix,        // after an operand and its postfixes, before a binary operator
+      Element,      // before an element of an array literal
+      ElementDone,  // after an element of an array literal
+    };
 
-Expression *Parser::parseExpr1(int minPrec, Expression *lhs) {
-    while (lookahead.isBinaryOp() && lookahead.getTokenPrec() >= minPrec) {
-        auto binOp = lookahead;
+    const auto frames = exprFrames.size(), operands = exprOperands.size();
+    const auto operators = exprOperators.size(), elements = exprElements.size();
+    openExprFrame(ExprFrame::Root, lookahead);
+    // drops the frames of this call after a parse error
+    auto abandon = [&]() -> ParseResult<Expression *> {
+        exprFrames.erase(exprFrames.begin() + static_cast<ptrdiff_t>(frames), exprFrames.end());
+        exprOperands.resize(operands);
+        exprOperators.erase(exprOperators.begin() + static_cast<ptrdiff_t>(operators), exprOperators.end());
+        exprElements.resize(elements);
+        return ParseError();
+    };
+    auto position = Position::Prefix;
+    Expression *operand = nullptr;
+    auto takeElements = [&](const ExprFrame &frame) {
+        auto elements = context.createList<Expression *>(
+            std::ranges::subrange(exprElements.begin() + static_cast<ptrdiff_t>(frame.elements), exprElements.end())
+        );
+        exprElements.resize(frame.elements);
+        return elements;
+    };
+    auto closeArrayLit = [&] {
+        auto frame = exprFrames.back();
+        exprFrames.pop_back();
         next();
-        auto rhs = parseUnaryExpr();
-        while (lookahead.getTokenPrec() > binOp.getTokenPrec()) {
-            auto prec = binOp.getTokenPrec() + 1;
-            rhs = parseExpr1(prec, rhs);
+        auto literal = context.create<ArrayLiteral>(frame.token.getLocInfo(), takeElements(frame));
+        if (frame.kind == ExprFrame::ArrayElement) {
+            exprElements.push_back(literal);
+            position = Position::ElementDone;
+        } else {
+            operand = literal;
+            position = Position::Postfix;
+        }
+    };
+
+    for (;;) {
+        switch (position) {
+            case Position::Prefix:
+                if (lookahead.isUnaryOp()) {
+                    openExprFrame(ExprFrame::Unary, lookahead);
+                    next();
+                } else if (check(TokenType::New)) {
+                    auto expr = parseNewExpr();
+                    if (!expr) return abandon();
+                    operand = *expr;
+                    position = Position::Postfix;
+                } else if (check(TokenType::Cast)) {
+                    auto startToken = lookahead;
+                    next();
+                    if (!expect(TokenType::LAngleBracket)) return abandon();
+                    auto typ = parseType();
+                    if (!typ || !expect(TokenType::RAngleBracket) || !expect(TokenType::LParen)) return abandon();
+                    openExprFrame(ExprFrame::Cast, startToken).type = *typ;
+                } else if (check(TokenType::Identifier)) {
+                    auto ident = parseBaseDeclRef();
+                    if (!ident) return abandon();
+                    operand = *ident;
+                    if (check(TokenType::NameSeparator)) {
+                        auto selector = parseModuleSelector(*ident);
+                        if (!selector) return abandon();
+                        operand = *selector;
+                    }
+                    position = Position::Postfix;
+                } else if (check(TokenType::LParen)) {
+                    openExprFrame(ExprFrame::Paren, lookahead);
+                    next();
+                } else if (check(TokenType::LBrace)) {
+                    openExprFrame(ExprFrame::Array, lookahead);
+                    next();
+                    if (check(TokenType::RBrace)) closeArrayLit();
+                    else position = Position::Element;
+                } else {
+                    auto literal = parseLiteral();
+                    if (!literal) return abandon();
+                    operand = *literal;
+                    position = Position::Postfix;
+                }
+                break;
+            case Position::Postfix:
+                if (check(TokenType::Period)) {
+                    auto selector = parseSelectorExpr(operand);
+                    if (!selector) return abandon();
+                    operand = *selector;
+                } else if (check(TokenType::LBracket)) {
+                    openExprFrame(ExprFrame::Index, lookahead).base = operand;
+                    next();
+                    position = Position::Prefix;
+                } else if (check(TokenType::LParen)) {
+                    auto startToken = lookahead;
+                    next();
+                    if (check(TokenType::RParen)) {
+                        next();
+                        operand = context.create<ArgumentExpr>(startToken.getLocInfo(), operand, ASTList<Expression *>());
+                    } else {
+                        openExprFrame(ExprFrame::Call, startToken).base = operand;
+                        position = Position::Prefix;
+                    }
+                } else {
+                    position = Position::Infix;
+                }
+                break;
+            case Position::Infix: {
+                exprOperands.push_back(operand);
+                auto &info = lookahead.getTokenInfo();
+                if (info.is(TokenInfo::BinaryOp)) {
+                    reduceBinaryExprs(exprFrames.back(), info.prec + info.is(TokenInfo::RightAssoc));
+                    exprOperators.push_back(lookahead);
+                    next();
+                    position = Position::Prefix;
+                    break;
+                }
+                reduceBinaryExprs(exprFrames.back(), 0);
+                auto result = exprOperands.back();
+                exprOperands.pop_back();
+
+                auto frame = exprFrames.back();
+                if (frame.kind == ExprFrame::Call || frame.kind == ExprFrame::Array
+                    || frame.kind == ExprFrame::ArrayElement) {
+                    exprElements.push_back(result);
+                    position = Position::ElementDone;
+                    break;
+                }
+                exprFrames.pop_back();
+                position = Position::Postfix;
+                switch (frame.kind) {
+                    case ExprFrame::Root:
+                        return result;
+                    case ExprFrame::Unary:
+                        operand = context.create<UnaryExpr>(
+                            frame.token.getLocInfo(),
+                            static_cast<Operator::UnaryOperator>(frame.token.getTokenInfo().op),
+                            result
+                        );
+                        position = Position::Infix;
+                        break;
+                    case ExprFrame::Paren:
+                        if (!expect(TokenType::RParen)) return abandon();
+                        operand = result;
+                        break;
+                    case ExprFrame::Index:
+                        if (!expect(TokenType::RBracket)) return abandon();
+                        operand = context.create<IndexExpr>(frame.token.getLocInfo(), frame.base, result);
+                        break;
+                    case ExprFrame::Cast:
+                        if (!expect(TokenType::RParen)) return abandon();
+                        operand = context.create<CastExpr>(frame.token.getLocInfo(), frame.type, result);
+                        break;
+                    default:
+                        break;
+                }
+                break;
+            }
+            case Position::Element:
+                if (check(TokenType::LBrace)) {
+                    openExprFrame(ExprFrame::ArrayElement, lookahead);
+                    next();
+                    if (check(TokenType::RBrace)) closeArrayLit();
+                } else {
+                    position = Position::Prefix;
+                }
+                break;
+            case Position::ElementDone: {
+                auto closing = exprFrames.back().kind == ExprFrame::Call ? TokenType::RParen : TokenType::RBrace;
+                if (!check(closing)) {
+                    if (!expect(TokenType::Comma)) return abandon();
+                    position = exprFrames.back().kind == ExprFrame::Call ? Position::Prefix : Position::Element;
+                } else if (closing == TokenType::RParen) {
+                    auto frame = exprFrames.back();
+                    exprFrames.pop_back();
+                    next();
+                    operand = context.create<ArgumentExpr>(frame.token.getLocInfo(), frame.base, takeElements(frame));
+                    position = Position::Postfix;
+                } else {
+                    closeArrayLit();
+                }
+                break;
+            }
         }
-        lhs = context.create<BinaryExpr>(
-            binOp.getLocInfo(),
-            Operator::createBinaryOperatorFromToken(binOp),
-            lhs, rhs
-        );
     }
-    return lhs;
 }
 
 }
@@ -8,15 +8,13 @@
 
 namespace reflex {
 
-Literal *Parser::parseLiteral() {
+ParseResult<Literal *> Parser::parseLiteral() {
     if (lookahead.isBasicLiteral())
         return parseBasicLit();
-    if (check(TokenType::LBrace))
-        return parseArrayLit();
     return parseFunctionLit();
 }
 
-Literal *Parser::parseBasicLit() {
+ParseResult<Literal *> Parser::parseBasicLit() {
     switch (lookahead.getTokenType().getValue()) {
         case TokenType::BoolLiteral: return parseBoolLit();
         case TokenType::NumberLiteral: return parseNumberLit();
@@ -25,73 +23,46 @@ Literal *Parser::parseBasicLit() {
     }
 }
 
-NumberLiteral *Parser::parseNumberLit() {
+ParseResult<NumberLiteral *> Parser::parseNumberLit() {
     auto token = expect(TokenType::NumberLiteral);
-    return context.create<NumberLiteral>(token.getLocInfo(), token.getLexeme());
+    if (!token) return ParseError();
+    return context.create<NumberLiteral>(token->getLocInfo(), std::string(token->getLexeme()));
 }
 
-StringLiteral *Parser::parseStringLit() {
+ParseResult<StringLiteral *> Parser::parseStringLit() {
     auto token = expect(TokenType::StringLiteral);
-    auto &lit = token.getLexeme();
+    if (!token) return ParseError();
+    auto lit = token->getLexeme();
     return context.create<StringLiteral>(
-        token.getLocInfo(),
-        lit.substr(1, lit.size() - 2)
+        token->getLocInfo(),
+        std::string(lit.substr(1, lit.size() - 2))
     );
 }
 
-BooleanLiteral *Parser::parseBoolLit() {
+ParseResult<BooleanLiteral *> Parser::parseBoolLit() {
     auto token = expect(TokenType::BoolLiteral);
-    return context.create<BooleanLiteral>(token.getLocInfo(), token.getLexeme());
+    if (!token) return ParseError();
+    return context.create<BooleanLiteral>(token->getLocInfo(), std::string(token->getLexeme()));
 }
 
-NullLiteral *Parser::parseNullLit() {
+ParseResult<NullLiteral *> Parser::parseNullLit() {
     auto token = expect(TokenType::NullLiteral);
-    return context.create<NullLiteral>(token.getLocInfo(), token.getLexeme());
+    if (!token) return ParseError();
+    return context.create<NullLiteral>(token->getLocInfo(), std::string(token->getLexeme()));
 }
 
-Literal *Parser::parseArrayLit() {
-    auto startToken = lookahead;
-    return context.create<ArrayLiteral>(
-        startToken.getLocInfo(),
-        parseLiteralValue()
-    );
-}
-
-std::vector<Expression *> Parser::parseLiteralValue() {
-    expect(TokenType::LBrace);
-    auto elements = parseElementList();
-    expect(TokenType::RBrace);
-    return elements;
-}
-
-std::vector<Expression *> Parser::parseElementList() {
-    if (check(TokenType::RBrace))
-        return {};
-    std::vector<Expression *> elements;
-    elements.push_back(parseElement());
-    while (!check(TokenType::RBrace)) {
-        expect(TokenType::Comma);
-        elements.push_back(parseElement());
-    }
-    return elements;
-}
-
-Expression *Parser::parseElement() {
-    if (check(TokenType::LBrace)) {
-        return parseArrayLit();
-    }
-    return parseExpr();
-}
-
-Literal *Parser::parseFunctionLit() {
+ParseResult<Literal *> Parser::parseFunctionLit() {
     auto start = expect(TokenType::Func);
-    auto[params, ret] = parseSignature();
-    auto body = parseBlockStmt();
+    if (!start) return ParseError();
+    auto signature = parseSignature();
+    if (!signature) return ParseError();
+    auto body = parseFunctionBody();
+    if (!body) return ParseError();
+    auto &[params, ret] = *signature;
     return context.create<FunctionLiteral>(
-        start.getLocInfo(),
-        params, ret, body
+        start->getLocInfo(),
+        params, ret, *body
     );
 }
 
 }
-
@@ -0,0 +1,46 @@
+//
+// Created by henry on 2022-05-28.
+//
+
+#ifndef REFLEX_SRC_PARSER_PARSERESULT_H_
+#define REFLEX_SRC_PARSER_PARSERESULT_H_
+
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace reflex {
+
+/// A failed parse, the diagnostic is already in the error list of the parser
+struct ParseError {};
+
+/// Value of a parse routine or a ParseError, parse routines return it instead of throwing
+/// - a routine that sees a failed result returns ParseError() to its caller, until a routine
+///   that can resynchronize on ; or } catches up with it
+template<class T>
+class [[nodiscard]] ParseResult {
+  public:
+    ParseResult(ParseError) {}
+    ParseResult(T value) : value(std::move(value)) {}
+
+    template<class U> requires std::is_convertible_v<U, T>
+    ParseResult(ParseResult<U> other) {
+        if (other) value = *other;
+    }
+
+    explicit operator bool() const { return value.has_value(); }
+    T &operator*() { return *value; }
+    const T &operator*() const { return *value; }
+    /// members of the value, or of the node a pointer value points to
+    auto operator->() {
+        if constexpr (std::is_pointer_v<T>) return *value;
+        else return &*value;
+    }
+
+  private:
+    std::optional<T> value;
+};
+
+}
+
+#endif //REFLEX_SRC_PARSER_PARSERESULT_H_
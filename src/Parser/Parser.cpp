@@ -8,19 +8,18 @@
 
 namespace reflex {
 
-Parser::Parser(ASTContext &context, Lexer &lex)
-    : context(context), lexer(lex),
-      lookahead(TokenType::EndOfFile, "EOF",
-                lex.getSource().createSourceLocation(1, 1, 1, 1)),
-      state{} {
-    lookahead = next();
-}
+Parser::Parser(ASTContext &context, Lexer &lex) : Parser(context, TokenBuffer(lex)) {}
+
+Parser::Parser(ASTContext &context, TokenBuffer tokens)
+    : context(context), ownedTokens(std::move(tokens)), tokens(*ownedTokens),
+      lookahead(this->tokens.getToken(0)), state{} {}
+
+Parser::Parser(ASTContext &context, const TokenBuffer &tokens, size_t begin)
+    : context(context), tokens(tokens), cursor(begin), lookahead(tokens.getToken(begin)), state{} {}
 
 Token Parser::next() {
-    lookahead = lexer.nextToken();
-    while (lookahead.isTrivial()) {
-        lookahead = lexer.nextToken();
-    }
+    if (cursor + 1 < tokens.size()) ++cursor;
+    lookahead = tokens.getToken(cursor);
     return lookahead;
 }
 
@@ -28,30 +27,30 @@ bool Parser::check(TokenType::Value tokenType) const {
     return lookahead.getTokenType().getValue() == tokenType;
 }
 
-Token Parser::expect(TokenType::Value expectedType, ErrorHandler *handler) {
+ParseResult<Token> Parser::expect(TokenType::Value expectedType) {
     auto curr = lookahead;
     if (!check(expectedType)) {
-        if (handler) {
-            errorList.push_back(std::make_unique<ParsingExpectedTokenError>(
-                curr.getLocInfo(), TokenType(expectedType), curr
-            ));
-            handler->resumeParsingHandler();
-        } else {
-            throw UnrecoverableError(
-                curr.getLocInfo(),
-                "error: expected " + TokenType(expectedType).getTypeString() +
-                    " but got " + curr.getTokenType().getTypeString()
-            );
-        }
-    } else {
-        next();
+        errorList.push_back(std::make_unique<ParsingExpectedTokenError>(
+            curr.getLocInfo(), TokenType(expectedType), curr
+        ));
+        return ParseError();
     }
+    next();
     return curr;
 }
 
-std::string Parser::parseString() {
+void Parser::recover() {
+    TokenSyncErrorHandler(*this).resumeParsingHandler();
+}
+
+UnrecoverableError Parser::makeUnrecoverable(const ParsingErrorMessage &error) const {
+    return {error.getLocation(), "error: " + error.getMessage()};
+}
+
+ParseResult<std::string> Parser::parseString() {
     auto name = expect(TokenType::Identifier);
-    return name.getLexeme();
+    if (!name) return ParseError();
+    return std::string(name->getLexeme());
 }
 
 }
@@ -10,11 +10,15 @@
 #include <string>
 #include <memory>
 #include <exception>
+#include <optional>
 
 #include <Token.h>
+#include <TokenBuffer.h>
 #include <SourceManager.h>
 #include <ErrorHandler.h>
 #include <ParsingError.h>
+#include <ParseResult.h>
+#include <ASTContext.h>
 #include <ASTType.h>
 #include <ASTLiteral.h>
 #include <ASTDeclaration.h>
@@ -22,20 +26,19 @@
 
 namespace reflex {
 
-class ASTContext;
 class Lexer;
 class Parser;
 
-/// UnrecoverableError is thrown to propagate unrecoverable parsing error to the
-/// parent parsing context to handle
+/// UnrecoverableError reports a syntax error to callers of the parser that cannot continue without
+/// an AST, parse routines themselves return ParseResult
 class UnrecoverableError : public std::exception {
   public:
-    UnrecoverableError(const SourceLocation *loc, std::string msg)
+    UnrecoverableError(SourceLocation loc, std::string msg)
         : loc(loc), msg(std::move(msg)) {}
-    const SourceLocation *getErrorLocation() const { return loc; }
+    SourceLocation getErrorLocation() const { return loc; }
     const std::string &getErrorMessage() const { return msg; }
   private:
-    const SourceLocation *loc;
+    SourceLocation loc;
     std::string msg;
 };
 
@@ -51,110 +54,209 @@ class ParsingContext final {
     std::string context;
 };
 
-class Parser final {
+class Parser final : public BodyMaterializer {
     struct ParserState {
       int depth = 0;
     };
+
+    /// An expression construct whose operands parseExpr() is still reading
+    struct ExprFrame {
+      enum Kind : uint8_t { Root, Unary, Paren, Cast, Index, Call, Array, ArrayElement };
+      Kind kind;
+      Token token;
+      Expression *base;
+      ASTTypeExpr *type;
+      // sizes of exprOperands, exprOperators and exprElements when the frame was opened
+      size_t operands;
+      size_t operators;
+      size_t elements;
+    };
+
+    /// A compound statement whose block parseCompoundStmt() is still reading
+    struct StmtFrame {
+      enum Kind : uint8_t { Block, If, Else, While, For };
+      Kind kind;
+      Token start;
+      Token brace;
+      SimpleStmt *cond;
+      ForClause *clause;
+      BlockStmt *body;
+      // size of stmtStack when the block was opened
+      size_t stmts;
+    };
     friend class ErrorHandler;
     friend class ParsingContext;
   public:
+    /// Lexes the rest of @p lex into a TokenBuffer up front
+    /// @note switches @p lex to trivia skipping mode
     Parser(ASTContext &context, Lexer &lex);
+    Parser(ASTContext &context, TokenBuffer tokens);
+    Parser(const Parser &) = delete;
+    Parser &operator=(const Parser &) = delete;
 
-    /// sets lookahead to next available token in the lexer
-    /// @note skips all whitespace and comment tokens
+    /// Skip function bodies as balanced brace token ranges, they are parsed on first access
+    /// @note the parser must outlive the AST while deferred bodies remain
+    void setDeferFunctionBodies(bool defer) { deferFunctionBodies = defer; }
+    BlockStmt *materializeBody(uint32_t begin, uint32_t end) override;
+
+    /// sets lookahead to next token in the token buffer
+    /// @note whitespace and comments are skipped by the lexer
     Token next();
 
+    /// @returns the kind of the token @p k positions after lookahead, EndOfFile past the end
+    [[nodiscard]] TokenType::Value peek(size_t k = 0) const { return tokens.getKind(cursor + k); }
+    [[nodiscard]] Token peekToken(size_t k = 0) const { return tokens.getToken(cursor + k); }
+
     [[nodiscard]] bool check(TokenType::Value tokenType) const;
 
     /// check if lookahead is of @param expectedType returns the consumed token
-    /// @param handler invokes the resume handler if token type does not match
-    ///                if handler is not provided, then throws the ExpectToken
-    Token expect(TokenType::Value expectedType, ErrorHandler *handler = nullptr);
+    /// @returns ParseError after recording a ParsingExpectedTokenError if the type does not match
+    ParseResult<Token> expect(TokenType::Value expectedType);
+
+    /// @returns the syntax errors recorded so far, in source order within each declaration
+    [[nodiscard]] const std::vector<std::unique_ptr<ParsingErrorMessage>> &getErrors() const { return errorList; }
 
   public:
-    ASTTypeExpr *parseType();
-    BaseTypenameExpr *parseBaseTypenameType();
-    QualifiedTypenameExpr *parseQualifiedType(ReferenceTypenameExpr *expr);
-    ArrayTypeExpr *parseArrayType();
-    ArrayTypeExpr *parseElementType1(ArrayTypeExpr *baseType);
-    FunctionTypeExpr *parseFunctionType();
-    std::vector<ASTTypeExpr *> parseParamTypeList();
-
-    Literal *parseLiteral();
-    Literal *parseBasicLit();
-    NumberLiteral *parseNumberLit();
-    StringLiteral *parseStringLit();
-    BooleanLiteral *parseBoolLit();
-    NullLiteral *parseNullLit();
-
-    Literal *parseArrayLit();
-    std::vector<Expression *> parseLiteralValue();
-    std::vector<Expression *> parseElementList();
-    Expression *parseElement();
-    Literal *parseFunctionLit();
-
-    std::pair<std::vector<ParamDecl *>, ASTTypeExpr *> parseSignature();
-    std::vector<ParamDecl *> parseParamList();
-    ParamDecl *parseFuncParam();
-
-    Expression *parseExpr();
-    Identifier *parseBaseDeclRef();
-    ModuleSelector *parseModuleSelector(DeclRefExpr *base);
-    Expression *parseNamedOperand();
-    Expression *parseExpr1(int minPrec, Expression *lhs);
-    Expression *parseUnaryExpr();
-    Expression *parseOperand();
-    Expression *parsePrimaryExpr1(Expression *base);
-    Expression *parsePrimaryExpr2(Expression *base);
-    Expression *parseNewExpr();
-    Expression *parseConversion();
-    Expression *parsePrimaryExpr();
-    Expression *parseSelectorExpr(Expression *base);
-    IndexExpr *parseIndexExpr(Expression *base);
-    std::vector<Expression *> parseArgumentList();
-    ArgumentExpr *parseArgument(Expression *base);
-
-    std::vector<Statement *> parseStmtList();
-    Statement *parseStatement();
-
-    BlockStmt *parseBlockStmt();
-
-    DeclStmt *parseDeclStmt();
-
-    Statement *parseReturnStmt();
-    Statement *parseBreakStmt();
-    Statement *parseContinueStmt();
-    Statement *parseIfStmt();
-    Statement *parseForStmt();
-    ForClause *parseForClause();
-    Statement *parseWhileStmt();
-    SimpleStmt *parseSimpleStmt();
-
-    FunctionDecl *parseFunctionDecl();
-    MethodDecl *parseMethodDecl(Visibility visibility, AggregateDecl *parent);
-    VariableDecl *parseVariableDecl();
-    FieldDecl *parseFieldDecl(Visibility visibility, ClassDecl *parent);
-
-    ReferenceTypenameExpr *parseBaseClass();
-    ReferenceTypenameExpr *parseDerivedInterface();
-    std::vector<ReferenceTypenameExpr *> parseInterfaceList();
-
-    ClassDecl *parseClassDecl(Visibility visibility);
-    InterfaceDecl *parseInterfaceDecl(Visibility visibility);
-    void parseClassBody(ClassDecl *klass);
-    void parseInterfaceBody(InterfaceDecl *interface);
+    ParseResult<ASTTypeExpr *> parseType();
+    ParseResult<BaseTypenameExpr *> parseBaseTypenameType();
+    ParseResult<QualifiedTypenameExpr *> parseQualifiedType(ReferenceTypenameExpr *expr);
+    ParseResult<ArrayTypeExpr *> parseArrayType();
+    ParseResult<ArrayTypeExpr *> parseElementType1(ArrayTypeExpr *baseType);
+    ParseResult<FunctionTypeExpr *> parseFunctionType();
+    ParseResult<ASTList<ASTTypeExpr *>> parseParamTypeList();
+
+    /// Basic and function literals, array literals nest and are parsed by parseExpr()
+    ParseResult<Literal *> parseLiteral();
+    ParseResult<Literal *> parseBasicLit();
+    ParseResult<NumberLiteral *> parseNumberLit();
+    ParseResult<StringLiteral *> parseStringLit();
+    ParseResult<BooleanLiteral *> parseBoolLit();
+    ParseResult<NullLiteral *> parseNullLit();
+
+    ParseResult<Literal *> parseFunctionLit();
+
+    ParseResult<std::pair<ASTList<ParamDecl *>, ASTTypeExpr *>> parseSignature();
+    ParseResult<ASTList<ParamDecl *>> parseParamList();
+    ParseResult<ParamDecl *> parseFuncParam();
+
+    /// Parses an expression on explicit stacks, native stack use does not grow with nesting
+    /// - parentheses, unary operators, casts, indices, calls and array literals open an ExprFrame
+    /// - binary operators are reduced by precedence from TokenInfo within the innermost frame
+    ParseResult<Expression *> parseExpr();
+    ParseResult<Identifier *> parseBaseDeclRef();
+    ParseResult<ModuleSelector *> parseModuleSelector(DeclRefExpr *base);
+    ParseResult<Expression *> parseNewExpr();
+    ParseResult<Expression *> parseSelectorExpr(Expression *base);
+
+    ParseResult<Statement *> parseStatement();
+
+    /// Parses a block, if, while or for statement on an explicit stack of StmtFrames,
+    /// native stack use does not grow with nesting
+    /// @note a statement that fails to parse is dropped after its error is recorded, parsing
+    ///       resumes after the next ; or } with TokenSyncErrorHandler
+    ParseResult<Statement *> parseCompoundStmt();
+    ParseResult<BlockStmt *> parseBlockStmt();
+    ParseResult<DeferredBody> parseFunctionBody();
 
+    ParseResult<DeclStmt *> parseDeclStmt();
+
+    ParseResult<Statement *> parseReturnStmt();
+    ParseResult<Statement *> parseBreakStmt();
+    ParseResult<Statement *> parseContinueStmt();
+    ParseResult<ForClause *> parseForClause();
+    ParseResult<SimpleStmt *> parseSimpleStmt();
+
+    ParseResult<FunctionDecl *> parseFunctionDecl();
+    ParseResult<MethodDecl *> parseMethodDecl(Visibility visibility, AggregateDecl *parent);
+    ParseResult<VariableDecl *> parseVariableDecl();
+    ParseResult<FieldDecl *> parseFieldDecl(Visibility visibility, ClassDecl *parent);
+
+    ParseResult<ReferenceTypenameExpr *> parseBaseClass();
+    ParseResult<ReferenceTypenameExpr *> parseDerivedInterface();
+    ParseResult<ASTList<ReferenceTypenameExpr *>> parseInterfaceList();
+
+    ParseResult<ClassDecl *> parseClassDecl(Visibility visibility);
+    ParseResult<InterfaceDecl *> parseInterfaceDecl(Visibility visibility);
+    /// @returns the access modifier starting a class or interface member
+    ParseResult<Visibility> parseVisibility();
+    /// Members that fail to parse are dropped, parsing resumes with the next member
+    ParseResult<ClassDecl *> parseClassBody(ClassDecl *klass);
+    ParseResult<InterfaceDecl *> parseInterfaceBody(InterfaceDecl *interface);
+
+    /// Parses every top-level declaration, declarations that fail to parse are dropped and parsing
+    /// resumes with the next one, so one run reports all syntax errors in getErrors()
+    /// @throws UnrecoverableError for the first syntax error once the whole file was parsed
     CompilationUnit *parseCompilationUnit();
 
-    std::string parseString();
+    /// Parses top-level declarations on up to @p threads threads, the result is identical to
+    /// parseCompilationUnit()
+    /// - a pre-scan over token kinds splits the file at top-level declaration boundaries
+    /// - every worker fills its own ASTContext, which the context of this parser adopts
+    /// - if any worker fails, the file is parsed again sequentially to report the same errors
+    CompilationUnit *parseCompilationUnit(size_t threads);
+
+    /// @returns token indices of top-level declarations that can be parsed independently,
+    ///          ascending and excluding 0
+    static std::vector<size_t> findDeclBoundaries(const TokenBuffer &tokens);
+
+    ParseResult<std::string> parseString();
   private:
+    /// Parser for the top-level declarations starting at @p begin, sharing @p tokens
+    Parser(ASTContext &context, const TokenBuffer &tokens, size_t begin);
+
+    ExprFrame &openExprFrame(ExprFrame::Kind kind, const Token &token);
+    /// Folds binary operators of precedence @p minPrec and above on top of @p frame
+    void reduceBinaryExprs(const ExprFrame &frame, int minPrec);
+    /// Parses the head of the compound statement at lookahead up to and including its {
+    ParseResult<StmtFrame *> openStmtFrame();
+    /// Consumes the } of the innermost block
+    /// @returns the finished statement, or nullptr if the frame continues with an else block
+    ParseResult<Statement *> closeStmtFrame();
+
+    /// Parses top-level declarations into @p decls until the token at @p end
+    void parseTopLevelDecls(size_t end, std::vector<Declaration *> &decls);
+    /// Skips the rest of a construct that failed to parse, see TokenSyncErrorHandler
+    void recover();
+    /// @returns the first recorded error as an exception for callers that cannot continue
+    UnrecoverableError makeUnrecoverable(const ParsingErrorMessage &error) const;
+
+    /// @returns the nodes above @p base of listStack as a child list, removing them from the stack
+    template<class T>
+    ASTList<T> popList(size_t base) {
+        auto list = context.createList<T>(std::ranges::subrange(listStack.begin() + static_cast<ptrdiff_t>(base), listStack.end()));
+        listStack.resize(base);
+        return list;
+    }
+    /// Drops a list that failed to parse
+    ParseError dropList(size_t base) {
+        listStack.resize(base);
+        return {};
+    }
+
     ASTContext &context;
-    Lexer &lexer;
+    std::optional<TokenBuffer> ownedTokens;
+    const TokenBuffer &tokens;
+    size_t cursor = 0;
     Token lookahead;
     ParserState state;
+    bool deferFunctionBodies = false;
 
     std::vector<ParsingContext> contextStack;
     std::vector<std::unique_ptr<ParsingErrorMessage>> errorList;
+
+    // explicit parse stacks shared by nested parseExpr() and parseCompoundStmt() calls, every call
+    // only looks above the sizes it started with and truncates them back to those on a parse error
+    std::vector<ExprFrame> exprFrames;
+    std::vector<Expression *> exprOperands;
+    std::vector<Token> exprOperators;
+    std::vector<Expression *> exprElements;
+    std::vector<StmtFrame> stmtFrames;
+    std::vector<Statement *> stmtStack;
+    // elements of the parameter, interface and member lists being parsed, lists nest like the stacks above
+    std::vector<ASTNode *> listStack;
+
+    // kept alive for the deferred bodies of the declarations they parsed
+    std::vector<std::unique_ptr<Parser>> workers;
 };
 
 }
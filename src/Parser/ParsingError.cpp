@@ -8,12 +8,17 @@
 
 namespace reflex {
 
-void ParsingExpectedTokenError::printErrorMessage(std::ostream &os) const {
-    const auto location = actualToken.getLocInfo();
-    os << location->getLocationString() << ": ";
-    os << "expected " << expectedType.getTypeString() << " ";
-    os << "but got " << actualToken.getTokenType().getTypeString() << std::endl;
-    location->printSourceRegion(os, true);
+void ParsingErrorMessage::printErrorMessage(std::ostream &os) const {
+    os << loc.getLocationString() << ": " << getMessage() << std::endl;
+    loc.printSourceRegion(os, true);
+}
+
+std::string ParsingExpectedTokenError::getMessage() const {
+    return "expected " + expectedType.getTypeString() + " but got " + actualToken.getTokenType().getTypeString();
+}
+
+std::string ParsingUnknownModifierError::getMessage() const {
+    return "unknown access modifier " + std::string(modifier.getLexeme());
 }
 
 }
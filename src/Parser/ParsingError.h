@@ -10,31 +10,43 @@
 
 namespace reflex {
 
-class SourceLocation;
-
 class ParsingErrorMessage {
   public:
-    explicit ParsingErrorMessage(const SourceLocation *loc) : loc(loc) {}
+    explicit ParsingErrorMessage(SourceLocation loc) : loc(loc) {}
     virtual ~ParsingErrorMessage() = default;
 
-    virtual void printErrorMessage(std::ostream &os) const = 0;
+    [[nodiscard]] SourceLocation getLocation() const { return loc; }
+    /// @returns the message without location, e.g. expected SEMICOLON but got EOF
+    [[nodiscard]] virtual std::string getMessage() const = 0;
+    void printErrorMessage(std::ostream &os) const;
   private:
-    const SourceLocation *loc;
+    SourceLocation loc;
 };
 
 class ParsingExpectedTokenError : public ParsingErrorMessage {
   public:
-    ParsingExpectedTokenError(const SourceLocation *loc, TokenType expectedType, Token actualToken)
+    ParsingExpectedTokenError(SourceLocation loc, TokenType expectedType, Token actualToken)
         : ParsingErrorMessage(loc),
           expectedType(expectedType), actualToken(std::move(actualToken)) {}
 
-    void printErrorMessage(std::ostream &os) const override;
+    [[nodiscard]] std::string getMessage() const override;
 
   private:
     TokenType expectedType;
     Token actualToken;
 };
 
+class ParsingUnknownModifierError : public ParsingErrorMessage {
+  public:
+    explicit ParsingUnknownModifierError(Token modifier)
+        : ParsingErrorMessage(modifier.getLocInfo()), modifier(std::move(modifier)) {}
+
+    [[nodiscard]] std::string getMessage() const override;
+
+  private:
+    Token modifier;
+};
+
 }
 
 #endif //REFLEX_SRC_PARSER_PARSINGERROR_H_
@@ -7,39 +7,188 @@
 #include "ASTContext.h"
 #include "Operator.h"
 
+#include <cassert>
+
 namespace reflex {
 
-BlockStmt *Parser::parseBlockStmt() {
-    auto start = expect(TokenType::LBrace);
-    auto stmts = parseStmtList();
-    auto end = expect(TokenType::RBrace);
-    return context.create<BlockStmt>(
-        SourceManager::mergeSourceLocation(start.getLocInfo(), end.getLocInfo()),
-        std::move(stmts)
+ParseResult<BlockStmt *> Parser::parseBlockStmt() {
+    if (!check(TokenType::LBrace) && !expect(TokenType::LBrace)) return ParseError();
+    auto block = parseCompoundStmt();
+    if (!block) return ParseError();
+    return cast<BlockStmt>(*block);
+}
+
+ParseResult<Statement *> Parser::parseCompoundStmt() {
+    const auto base = stmtFrames.size();
+    const auto stmts = stmtStack.size();
+    auto abandon = [&]() -> ParseResult<Statement *> {
+        stmtFrames.erase(stmtFrames.begin() + static_cast<ptrdiff_t>(base), stmtFrames.end());
+        stmtStack.resize(stmts);
+        return ParseError();
+    };
+    if (!openStmtFrame()) return abandon();
+    for (;;) {
+        if (!check(TokenType::RBrace)) {
+            bool parsed;
+            if (check(TokenType::LBrace) || check(TokenType::If) || check(TokenType::While) || check(TokenType::For)) {
+                parsed = static_cast<bool>(openStmtFrame());
+            } else {
+                auto stmt = parseStatement();
+                if (stmt) stmtStack.push_back(*stmt);
+                parsed = static_cast<bool>(stmt);
+            }
+            if (!parsed) {
+                recover();
+                if (check(TokenType::EndOfFile)) return abandon();
+            }
+            continue;
+        }
+        auto stmt = closeStmtFrame();
+        if (!stmt) {
+            // the else block of the innermost if failed to open, the if statement is dropped
+            if (stmtFrames.size() == base) return abandon();
+            recover();
+            if (check(TokenType::EndOfFile)) return abandon();
+            continue;
+        }
+        if (!*stmt) continue;
+        if (stmtFrames.size() == base) return *stmt;
+        stmtStack.push_back(*stmt);
+    }
+}
+
+ParseResult<Parser::StmtFrame *> Parser::openStmtFrame() {
+    StmtFrame frame{StmtFrame::Block, lookahead, lookahead, nullptr, nullptr, nullptr, stmtStack.size()};
+    if (check(TokenType::If) || check(TokenType::While)) {
+        frame.kind = check(TokenType::If) ? StmtFrame::If : StmtFrame::While;
+        next();
+        if (!expect(TokenType::LParen)) return ParseError();
+        auto cond = parseSimpleStmt();
+        if (!cond || !expect(TokenType::RParen)) return ParseError();
+        frame.cond = *cond;
+    } else if (check(TokenType::For)) {
+        frame.kind = StmtFrame::For;
+        next();
+        if (!expect(TokenType::LParen)) return ParseError();
+        auto clause = parseForClause();
+        if (!clause || !expect(TokenType::RParen)) return ParseError();
+        frame.clause = *clause;
+    }
+    auto brace = expect(TokenType::LBrace);
+    if (!brace) return ParseError();
+    frame.brace = *brace;
+    return &stmtFrames.emplace_back(frame);
+}
+
+ParseResult<Statement *> Parser::closeStmtFrame() {
+    auto &frame = stmtFrames.back();
+    auto end = lookahead;
+    next();
+    auto block = context.create<BlockStmt>(
+        SourceManager::mergeSourceLocation(frame.brace.getLocInfo(), end.getLocInfo()),
+        context.createList<Statement *>(
+            std::ranges::subrange(stmtStack.begin() + static_cast<ptrdiff_t>(frame.stmts), stmtStack.end())
+        )
     );
+    stmtStack.resize(frame.stmts);
+    if (frame.kind == StmtFrame::If && check(TokenType::Else)) {
+        frame.kind = StmtFrame::Else;
+        frame.body = block;
+        auto brace = expect(TokenType::LBrace);
+        if (!brace) {
+            stmtFrames.pop_back();
+            return ParseError();
+        }
+        frame.brace = *brace;
+        return nullptr;
+    }
+
+    auto closed = frame;
+    stmtFrames.pop_back();
+    switch (closed.kind) {
+        case StmtFrame::If:
+            return context.create<IfStmt>(closed.start.getLocInfo(), closed.cond, block, nullptr);
+        case StmtFrame::Else:
+            return context.create<IfStmt>(closed.start.getLocInfo(), closed.cond, closed.body, block);
+        case StmtFrame::While:
+            return context.create<WhileStmt>(closed.start.getLocInfo(), closed.cond, block);
+        case StmtFrame::For:
+            return context.create<ForStmt>(closed.start.getLocInfo(), closed.clause, block);
+        default:
+            return block;
+    }
 }
 
-std::vector<Statement *> Parser::parseStmtList() {
-    std::vector<Statement *> stmts;
-    while (!check(TokenType::RBrace)) {
-        stmts.push_back(parseStatement());
+ParseResult<DeferredBody> Parser::parseFunctionBody() {
+    if (!deferFunctionBodies) {
+        auto body = parseBlockStmt();
+        if (!body) return ParseError();
+        return DeferredBody(*body);
     }
-    return stmts;
+    if (!check(TokenType::LBrace) && !expect(TokenType::LBrace)) return ParseError();
+
+    // find the matching brace on token kinds alone, nothing is allocated for the body
+    auto begin = cursor;
+    auto end = cursor;
+    for (size_t depth = 0;; ++end) {
+        auto kind = tokens.getKind(end);
+        if (kind == TokenType::LBrace) {
+            ++depth;
+        } else if (kind == TokenType::RBrace) {
+            if (--depth == 0) break;
+        } else if (kind == TokenType::EndOfFile) {
+            auto eof = tokens.getToken(end);
+            errorList.push_back(std::make_unique<ParsingExpectedTokenError>(
+                eof.getLocInfo(), TokenType(TokenType::RBrace), eof
+            ));
+            return ParseError();
+        }
+    }
+    cursor = end;
+    next();
+    return DeferredBody(this, static_cast<uint32_t>(begin), static_cast<uint32_t>(end));
+}
+
+BlockStmt *Parser::materializeBody(uint32_t begin, uint32_t end) {
+    struct RestoreState {
+      Parser &parser;
+      size_t cursor;
+      Token lookahead;
+      ParserState state;
+      ~RestoreState() {
+          parser.cursor = cursor;
+          parser.lookahead = lookahead;
+          parser.state = state;
+      }
+    } restore{*this, cursor, lookahead, state};
+
+    cursor = begin;
+    lookahead = tokens.getToken(cursor);
+    state = {};
+    // the braces were matched when the body was skipped, only statements inside can fail, and
+    // callers of getBody() expect a complete body
+    const auto errors = errorList.size();
+    auto body = parseBlockStmt();
+    if (errorList.size() > errors) throw makeUnrecoverable(*errorList[errors]);
+    assert(cursor == end + 1 && "deferred body must end at its closing brace");
+    return *body;
 }
 
-SimpleStmt *Parser::parseSimpleStmt() {
+ParseResult<SimpleStmt *> Parser::parseSimpleStmt() {
     if (check(TokenType::SemiColon)) {
         return context.create<EmptyStmt>(lookahead.getLocInfo());
     }
     auto expr = parseExpr();
+    if (!expr) return ParseError();
     if (lookahead.isAssignment()) {
         auto op = lookahead;
         next();
         auto value = parseExpr();
+        if (!value) return ParseError();
         return context.create<AssignmentStmt>(
             op.getLocInfo(),
             Operator::createAssignOperatorFromToken(op),
-            expr, value
+            *expr, *value
         );
     }
     if (lookahead.isPostfixOp()) {
@@ -48,120 +197,64 @@ SimpleStmt *Parser::parseSimpleStmt() {
         return context.create<IncDecStmt>(
             postfix.getLocInfo(),
             Operator::createPostfixOperatorFromToken(postfix),
-            expr
+            *expr
         );
     }
-    return context.create<ExpressionStmt>(expr->location(), expr);
+    return context.create<ExpressionStmt>(expr->location(), *expr);
 }
 
-Statement *Parser::parseStatement() {
+ParseResult<Statement *> Parser::parseStatement() {
+    if (check(TokenType::LBrace) || check(TokenType::If) || check(TokenType::While) || check(TokenType::For)) {
+        return parseCompoundStmt();
+    }
+    ParseResult<Statement *> ret = ParseError();
     if (lookahead.isDeclaration()) {
         auto isVarDecl = check(TokenType::Var);
-        auto ret = parseDeclStmt();
-        if (isVarDecl) expect(TokenType::SemiColon);
-        return ret;
-    }
-    if (check(TokenType::Return)) {
-        auto ret = parseReturnStmt();
-        expect(TokenType::SemiColon);
-        return ret;
-    }
-    if (check(TokenType::Break)) {
-        auto ret = parseBreakStmt();
-        expect(TokenType::SemiColon);
-        return ret;
-    }
-    if (check(TokenType::Continue)) {
-        auto ret = parseContinueStmt();
-        expect(TokenType::SemiColon);
-        return ret;
-    }
-    if (check(TokenType::LBrace)) {
-        return parseBlockStmt();
+        ret = parseDeclStmt();
+        if (!isVarDecl) return ret;
+    } else if (check(TokenType::Return)) {
+        ret = parseReturnStmt();
+    } else if (check(TokenType::Break)) {
+        ret = parseBreakStmt();
+    } else if (check(TokenType::Continue)) {
+        ret = parseContinueStmt();
+    } else {
+        ret = parseSimpleStmt();
     }
-    if (check(TokenType::If)) {
-        return parseIfStmt();
-    }
-    if (check(TokenType::While)) {
-        return parseWhileStmt();
-    }
-    if (check(TokenType::For)) {
-        return parseForStmt();
-    }
-    auto ret = parseSimpleStmt();
-    expect(TokenType::SemiColon);
+    if (!ret || !expect(TokenType::SemiColon)) return ParseError();
     return ret;
 }
 
-Statement *Parser::parseReturnStmt() {
+ParseResult<Statement *> Parser::parseReturnStmt() {
     auto token = lookahead;
-    expect(TokenType::Return);
+    if (!expect(TokenType::Return)) return ParseError();
+    auto value = parseExpr();
+    if (!value) return ParseError();
     return context.create<ReturnStmt>(
         token.getLocInfo(),
-        parseExpr()
+        *value
     );
 }
 
-Statement *Parser::parseBreakStmt() {
+ParseResult<Statement *> Parser::parseBreakStmt() {
     auto token = lookahead;
-    expect(TokenType::Break);
+    if (!expect(TokenType::Break)) return ParseError();
     return context.create<BreakStmt>(
         token.getLocInfo()
     );
 }
 
-Statement *Parser::parseContinueStmt() {
+ParseResult<Statement *> Parser::parseContinueStmt() {
     auto token = lookahead;
-    expect(TokenType::Continue);
+    if (!expect(TokenType::Continue)) return ParseError();
     return context.create<ContinueStmt>(
         token.getLocInfo()
     );
 }
 
-Statement *Parser::parseIfStmt() {
-    auto startToken = lookahead;
-    expect(TokenType::If);
-    expect(TokenType::LParen);
-    auto cond = parseSimpleStmt();
-    expect(TokenType::RParen);
-    BlockStmt *bodyBlock = parseBlockStmt();
-    BlockStmt *elseBlock = nullptr;
-    if (check(TokenType::Else)) {
-        elseBlock = parseBlockStmt();
-    }
-    return context.create<IfStmt>(
-        startToken.getLocInfo(),
-        cond, bodyBlock, elseBlock
-    );
-}
-
-Statement *Parser::parseForStmt() {
-    auto startToken = lookahead;
-    expect(TokenType::For);
-    expect(TokenType::LParen);
-    auto clause = parseForClause();
-    expect(TokenType::RParen);
-    return context.create<ForStmt>(
-        startToken.getLocInfo(),
-        clause, parseBlockStmt()
-    );
-}
-
-ForClause *Parser::parseForClause() {
+ParseResult<ForClause *> Parser::parseForClause() {
     // todo: impl parsing for ForClause
     return nullptr;
 }
 
-Statement *Parser::parseWhileStmt() {
-    auto startToken = lookahead;
-    expect(TokenType::While);
-    expect(TokenType::LParen);
-    auto cond = parseSimpleStmt();
-    expect(TokenType::RParen);
-    return context.create<WhileStmt>(
-        startToken.getLocInfo(),
-        cond, parseBlockStmt()
-    );
-}
-
 }
@@ -8,43 +8,54 @@
 
 namespace reflex {
 
-ASTTypeExpr *Parser::parseType() {
+ParseResult<ASTTypeExpr *> Parser::parseType() {
     if (check(TokenType::LParen)) {
         next();
         auto nestedTyp = parseType();
-        expect(TokenType::RParen);
+        if (!nestedTyp || !expect(TokenType::RParen)) return ParseError();
         if (check(TokenType::LBracket)) {
             next();
             NumberLiteral *size = nullptr;
             if (!check(TokenType::RBracket)) {
-                size = parseNumberLit();
+                auto number = parseNumberLit();
+                if (!number) return ParseError();
+                size = *number;
             }
-            expect(TokenType::RBracket);
+            if (!expect(TokenType::RBracket)) return ParseError();
             auto loc = nestedTyp->location();
-            auto arrTyp = parseElementType1(context.create<ArrayTypeExpr>(loc, nestedTyp, size));
+            auto arrTyp = parseElementType1(context.create<ArrayTypeExpr>(loc, *nestedTyp, size));
+            if (!arrTyp) return ParseError();
             return parseElementType1(
-                context.create<ArrayTypeExpr>(loc, arrTyp, size)
+                context.create<ArrayTypeExpr>(loc, *arrTyp, size)
             );
         }
         return nestedTyp;
     }
     ASTTypeExpr *baseTyp;
     if (!check(TokenType::Func)) {
-        ReferenceTypenameExpr *typ = parseBaseTypenameType();
+        auto name = parseBaseTypenameType();
+        if (!name) return ParseError();
+        ReferenceTypenameExpr *typ = *name;
         if (check(TokenType::NameSeparator)) {
-            typ = parseQualifiedType(typ);
+            auto qualified = parseQualifiedType(typ);
+            if (!qualified) return ParseError();
+            typ = *qualified;
         }
         baseTyp = typ;
     } else {
-        baseTyp = parseFunctionType();
+        auto function = parseFunctionType();
+        if (!function) return ParseError();
+        baseTyp = *function;
     }
     if (check(TokenType::LBracket)) {
         next();
         NumberLiteral *size = nullptr;
         if (!check(TokenType::RBracket)) {
-            size = parseNumberLit();
+            auto number = parseNumberLit();
+            if (!number) return ParseError();
+            size = *number;
         }
-        expect(TokenType::RBracket);
+        if (!expect(TokenType::RBracket)) return ParseError();
         return parseElementType1(
             context.create<ArrayTypeExpr>(baseTyp->location(), baseTyp, size)
         );
@@ -52,65 +63,79 @@ ASTTypeExpr *Parser::parseType() {
     return baseTyp;
 }
 
-BaseTypenameExpr *Parser::parseBaseTypenameType() {
+ParseResult<BaseTypenameExpr *> Parser::parseBaseTypenameType() {
     auto token = expect(TokenType::Identifier);
-    return context.create<BaseTypenameExpr>(token.getLocInfo(), token.getLexeme());
+    if (!token) return ParseError();
+    return context.create<BaseTypenameExpr>(token->getLocInfo(), token->getSymbol());
 }
 
-QualifiedTypenameExpr *Parser::parseQualifiedType(ReferenceTypenameExpr *base) {
-    expect(TokenType::NameSeparator);
+ParseResult<QualifiedTypenameExpr *> Parser::parseQualifiedType(ReferenceTypenameExpr *base) {
+    if (!expect(TokenType::NameSeparator)) return ParseError();
     auto name = parseBaseTypenameType();
+    if (!name) return ParseError();
     auto selector = context.create<QualifiedTypenameExpr>(
         name->location(),
-        name->getTypeName(),
+        name->getTypeSymbol(),
         base
     );
     while (check(TokenType::NameSeparator)) {
         next();
         name = parseBaseTypenameType();
+        if (!name) return ParseError();
         selector = context.create<QualifiedTypenameExpr>(
             name->location(),
-            name->getTypeName(),
+            name->getTypeSymbol(),
             selector
         );
     }
     return selector;
 }
 
-ArrayTypeExpr *Parser::parseArrayType() {
+ParseResult<ArrayTypeExpr *> Parser::parseArrayType() {
     ASTTypeExpr *base;
     if (check(TokenType::LParen)) {
         next();
-        base = parseType();
-        expect(TokenType::RParen);
+        auto nested = parseType();
+        if (!nested || !expect(TokenType::RParen)) return ParseError();
+        base = *nested;
     } else if (check(TokenType::Func)) {
-        base = parseFunctionType();
+        auto function = parseFunctionType();
+        if (!function) return ParseError();
+        base = *function;
     } else {
-        ReferenceTypenameExpr *type = parseBaseTypenameType();
+        auto name = parseBaseTypenameType();
+        if (!name) return ParseError();
+        ReferenceTypenameExpr *type = *name;
         if (check(TokenType::NameSeparator)) {
-            type = parseQualifiedType(type);
+            auto qualified = parseQualifiedType(type);
+            if (!qualified) return ParseError();
+            type = *qualified;
         }
         base = type;
     }
     NumberLiteral *size = nullptr;
-    expect(TokenType::LBracket);
+    if (!expect(TokenType::LBracket)) return ParseError();
     if (!check(TokenType::RBracket)) {
-        size = parseNumberLit();
+        auto number = parseNumberLit();
+        if (!number) return ParseError();
+        size = *number;
     }
-    expect(TokenType::RBracket);
+    if (!expect(TokenType::RBracket)) return ParseError();
     return parseElementType1(
         context.create<ArrayTypeExpr>(base->location(), base, size)
     );
 }
 
-ArrayTypeExpr *Parser::parseElementType1(ArrayTypeExpr *baseType) {
+ParseResult<ArrayTypeExpr *> Parser::parseElementType1(ArrayTypeExpr *baseType) {
     if (check(TokenType::LBracket)) {
         NumberLiteral *size = nullptr;
-        expect(TokenType::LBracket);
+        next();
         if (!check(TokenType::RBracket)) {
-            size = parseNumberLit();
+            auto number = parseNumberLit();
+            if (!number) return ParseError();
+            size = *number;
         }
-        expect(TokenType::RBracket);
+        if (!expect(TokenType::RBracket)) return ParseError();
         return parseElementType1(
             context.create<ArrayTypeExpr>(baseType->location(), baseType, size)
         );
@@ -118,33 +143,41 @@ ArrayTypeExpr *Parser::parseElementType1(ArrayTypeExpr *baseType) {
     return baseType;
 }
 
-FunctionTypeExpr *Parser::parseFunctionType() {
+ParseResult<FunctionTypeExpr *> Parser::parseFunctionType() {
     auto start = expect(TokenType::Func);
-    expect(TokenType::LParen);
+    if (!start || !expect(TokenType::LParen)) return ParseError();
     auto typeParams = parseParamTypeList();
+    if (!typeParams) return ParseError();
     auto end = expect(TokenType::RParen);
+    if (!end) return ParseError();
 
-    ASTTypeExpr *returnType = context.create<BaseTypenameExpr>(end.getLocInfo(), "void");
+    ASTTypeExpr *returnType = context.create<BaseTypenameExpr>(end->getLocInfo(), "void");
     if (check(TokenType::ReturnArrow)) {
         next();
-        returnType = parseType();
+        auto type = parseType();
+        if (!type) return ParseError();
+        returnType = *type;
     }
     return context.create<FunctionTypeExpr>(
-        start.getLocInfo(),
+        start->getLocInfo(),
         returnType,
-        typeParams
+        *typeParams
     );
 }
 
-std::vector<ASTTypeExpr *> Parser::parseParamTypeList() {
-    if (check(TokenType::RParen)) return {};
-    std::vector<ASTTypeExpr *> params;
-    params.push_back(parseType());
+ParseResult<ASTList<ASTTypeExpr *>> Parser::parseParamTypeList() {
+    const auto base = listStack.size();
+    if (check(TokenType::RParen)) return ASTList<ASTTypeExpr *>();
+    auto param = parseType();
+    if (!param) return dropList(base);
+    listStack.push_back(*param);
     while (!check(TokenType::RParen)) {
-        expect(TokenType::Comma);
-        params.push_back(parseType());
+        if (!expect(TokenType::Comma)) return dropList(base);
+        param = parseType();
+        if (!param) return dropList(base);
+        listStack.push_back(*param);
     }
-    return params;
+    return popList<ASTTypeExpr *>(base);
 }
 
 }
@@ -0,0 +1,66 @@
+//
+// Created by henry on 2022-05-18.
+//
+
+#ifndef REFLEX_SRC_SOURCE_SOURCELOCATION_H_
+#define REFLEX_SRC_SOURCE_SOURCELOCATION_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <utility>
+
+namespace reflex {
+
+class SourceFile;
+
+/// Compact source range [begin, end) in bytes of SourceFile::content(), passed by value
+/// - line and column are only resolved when a location is printed, by binary search over
+///   the line table of the file
+/// - the default constructed location, or one made from nullptr, is invalid and converts to false
+class SourceLocation {
+  public:
+    static constexpr uint32_t InvalidFileID = 0;
+
+    constexpr SourceLocation() = default;
+    constexpr SourceLocation(std::nullptr_t) {}
+    constexpr SourceLocation(uint32_t fileID, uint32_t begin, uint32_t end)
+        : fileID(fileID), begin(begin), end(end) {}
+
+    [[nodiscard]] constexpr bool isValid() const { return fileID != InvalidFileID; }
+    constexpr explicit operator bool() const { return isValid(); }
+
+    [[nodiscard]] constexpr uint32_t getFileID() const { return fileID; }
+    [[nodiscard]] constexpr uint32_t getBegin() const { return begin; }
+    [[nodiscard]] constexpr uint32_t getEnd() const { return end; }
+    [[nodiscard]] SourceFile &getSource() const;
+
+    void printSourceRegion(std::ostream &os, bool underline = false) const;
+
+    /// Produce a string representation with filename and source location
+    /// @return <filename>: <startline:startcol, endline,endcol>
+    [[nodiscard]] std::string getLocationString() const;
+
+    /// Produce a string representation of source location
+    /// @return <startline:startcol, endline,endcol>
+    [[nodiscard]] std::string getStringRepr() const;
+
+    /// @returns line and column of the first character
+    [[nodiscard]] std::pair<size_t, size_t> getStartLocation() const;
+    /// @returns line and column of the last character
+    [[nodiscard]] std::pair<size_t, size_t> getEndLocation() const;
+
+    constexpr bool operator==(const SourceLocation &rhs) const = default;
+
+  private:
+    uint32_t fileID = InvalidFileID;
+    uint32_t begin = 0;
+    uint32_t end = 0;
+};
+
+static_assert(sizeof(SourceLocation) == 12);
+
+}
+
+#endif //REFLEX_SRC_SOURCE_SOURCELOCATION_H_
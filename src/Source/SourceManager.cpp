@@ -4,7 +4,23 @@
 
 #include "SourceManager.h"
 
-#include <sstream>
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+#include <mutex>
+#include <shared_mutex>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define REFLEX_SOURCE_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 namespace reflex {
 
@@ -14,20 +30,64 @@ InvalidSourceLocationError::InvalidSourceLocationError(const std::string &msg)
 SourceError::SourceError(const std::string &msg)
     : std::runtime_error("Source Error: " + msg) {}
 
-SourceLocation::SourceLocation(SourceFile &parent, size_t startline, size_t startcol, size_t endline, size_t endcol)
-    : parent(parent), startline(startline), startcol(startcol),
-      endline(endline), endcol(endcol) {
-    // source validation
-    if (0 == startline || startline > parent.totalLine() ||
-        0 == endline || endline > parent.totalLine() ||
-        0 == startcol || startcol > parent.line(startline).size() ||
-        0 == endcol || endcol > parent.line(startline).size()) {
+namespace {
+
+/// Process wide table from file id to the live SourceFile, ids are never reused
+class SourceFileRegistry {
+  public:
+    static SourceFileRegistry &global() {
+        static SourceFileRegistry registry;
+        return registry;
+    }
+
+    uint32_t add(SourceFile *file) {
+        std::unique_lock lock(mutex);
+        files.push_back(file);
+        return static_cast<uint32_t>(files.size() - 1);
+    }
 
-        throw InvalidSourceLocationError{"Failed to create SourceLocation at " + getStringRepr()};
+    void remove(uint32_t fileID) {
+        std::unique_lock lock(mutex);
+        files[fileID] = nullptr;
     }
+
+    SourceFile *get(uint32_t fileID) {
+        std::shared_lock lock(mutex);
+        return fileID < files.size() ? files[fileID] : nullptr;
+    }
+
+  private:
+    std::shared_mutex mutex;
+    std::vector<SourceFile *> files{nullptr}; // SourceLocation::InvalidFileID
+};
+
+/// the file content is followed by at most two newlines, see SourceFile
+constexpr size_t MaxTrailer = 2;
+constexpr size_t MaxSourceSize = UINT32_MAX - MaxTrailer;
+
+void appendTrailer(std::string &buffer) {
+    if (!buffer.empty() && buffer.back() != '\n') buffer += '\n';
+    buffer += '\n';
+}
+
+}
+
+SourceFile &SourceLocation::getSource() const {
+    return SourceFile::get(fileID);
+}
+
+std::pair<size_t, size_t> SourceLocation::getStartLocation() const {
+    return getSource().getLineColumn(begin);
+}
+
+std::pair<size_t, size_t> SourceLocation::getEndLocation() const {
+    return getSource().getLineColumn(end > begin ? end - 1 : begin);
 }
 
 void SourceLocation::printSourceRegion(std::ostream &os, bool underline) const {
+    const auto &parent = getSource();
+    const auto [startline, startcol] = getStartLocation();
+    const auto [endline, endcol] = getEndLocation();
     for (size_t line = startline; line <= endline; ++line) {
         const auto &sourceLine = parent.line(line);
         for (size_t i = 0; i < sourceLine.size() - 1; ++i) {
@@ -50,92 +110,164 @@ void SourceLocation::printSourceRegion(std::ostream &os, bool underline) const {
 }
 
 std::string SourceLocation::getStringRepr() const {
+    const auto [startline, startcol] = getStartLocation();
+    const auto [endline, endcol] = getEndLocation();
     return "<" + std::to_string(startline) + ":" + std::to_string(startcol)
         + ", " + std::to_string(endline) + ":" + std::to_string(endcol) + ">";
 }
 
 std::string SourceLocation::getLocationString() const {
-    return parent.getFilename() + ": " + getStringRepr();
+    return getSource().getFilename() + ": " + getStringRepr();
 }
 
-std::pair<size_t, size_t> SourceLocation::getStartLocation() const {
-    return std::make_pair(startline, startcol);
+SourceFile::SourceFile(std::string filename)
+    : filename{std::move(filename)} {
+    if (!mapFile()) {
+        std::ifstream file{this->filename};
+        if (!file) throw SourceError{"Cannot open " + this->filename};
+        buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        appendTrailer(buffer);
+        source = buffer;
+    }
+    buildLineOffsets();
+    fileID = SourceFileRegistry::global().add(this);
 }
 
-std::pair<size_t, size_t> SourceLocation::getEndLocation() const {
-    return std::make_pair(endline, endcol);
+SourceFile::SourceFile(std::string filename, std::istream &is)
+    : filename{std::move(filename)},
+      buffer{std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>()} {
+    appendTrailer(buffer);
+    source = buffer;
+    buildLineOffsets();
+    fileID = SourceFileRegistry::global().add(this);
 }
 
-bool SourceLocation::operator==(const SourceLocation &rhs) const {
-    return parent == rhs.parent &&
-        startline == rhs.startline &&
-        startcol == rhs.startcol &&
-        endline == rhs.endline &&
-        endcol == rhs.endcol;
+SourceFile::~SourceFile() {
+    SourceFileRegistry::global().remove(fileID);
+#ifdef REFLEX_SOURCE_MMAP
+    if (mapping) ::munmap(mapping, mappingSize);
+#endif
 }
 
-std::size_t SourceLocationHash::operator()(const SourceLocation &loc) const noexcept {
-    auto[startline, startcol] = loc.getStartLocation();
-    auto[endline, endcol] = loc.getEndLocation();
-    return std::hash<size_t>{}(startline)
-        ^ std::hash<size_t>{}(startcol)
-        ^ std::hash<size_t>{}(endline)
-        ^ std::hash<size_t>{}(endcol);
-}
+/// Maps the file privately over an anonymous reservation that leaves room for the trailer,
+/// writing the trailer only copies the last page, afterwards the whole mapping is made read-only
+bool SourceFile::mapFile() {
+#ifdef REFLEX_SOURCE_MMAP
+    const int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat info{};
+    if (::fstat(fd, &info) != 0 || !S_ISREG(info.st_mode)) {
+        ::close(fd);
+        return false;
+    }
+    const auto fileSize = static_cast<size_t>(info.st_size);
+    if (fileSize > MaxSourceSize) {
+        ::close(fd);
+        throw SourceError{"File " + filename + " exceeds 4 GiB"};
+    }
 
-SourceFile::SourceFile(std::string filename, std::istream &is) : filename{std::move(filename)} {
-    std::string line;
-    while (getline(is, line)) {
-        line += '\n';
-        source.emplace_back(std::move(line));
+    const auto pageSize = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+    const auto reserved = (fileSize + MaxTrailer + pageSize - 1) / pageSize * pageSize;
+    void *base = ::mmap(nullptr, reserved, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == MAP_FAILED) {
+        ::close(fd);
+        return false;
+    }
+    if (fileSize && ::mmap(base, fileSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, fd, 0) == MAP_FAILED) {
+        ::munmap(base, reserved);
+        ::close(fd);
+        return false;
     }
-    source.emplace_back("\n");
+    ::close(fd);
+
+    auto data = static_cast<char *>(base);
+    auto size = fileSize;
+    if (size && data[size - 1] != '\n') data[size++] = '\n';
+    data[size++] = '\n';
+    ::mprotect(base, reserved, PROT_READ);
+    ::madvise(base, reserved, MADV_SEQUENTIAL);
+
+    mapping = base;
+    mappingSize = reserved;
+    source = std::string_view(data, size);
+    return true;
+#else
+    return false;
+#endif
 }
 
-std::string SourceFile::content() const {
-    std::stringstream file;
-    for (const auto &line: source) {
-        file << line;
+/// Collects the start of every line, newlines are located 16 bytes at a time
+void SourceFile::buildLineOffsets() {
+    if (source.size() > UINT32_MAX) throw SourceError{"File " + filename + " exceeds 4 GiB"};
+
+    lineOffsets.clear();
+    lineOffsets.push_back(0);
+    // the final newline terminates the content and does not start another line
+    const char *data = source.data();
+    const size_t size = source.size() - 1;
+    size_t i = 0;
+#ifdef __SSE2__
+    const auto newline = _mm_set1_epi8('\n');
+    for (; i + 16 <= size; i += 16) {
+        auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+        auto mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, newline)));
+        while (mask) {
+            lineOffsets.push_back(static_cast<uint32_t>(i + __builtin_ctz(mask) + 1));
+            mask &= mask - 1;
+        }
+    }
+#endif
+    for (; i < size; ++i) {
+        if (data[i] == '\n') lineOffsets.push_back(static_cast<uint32_t>(i + 1));
     }
-    return file.str();
 }
 
-const std::string &SourceFile::line(size_t line) const {
-    if (line == 0 || line > source.size())
+SourceFile &SourceFile::get(uint32_t fileID) {
+    auto file = SourceFileRegistry::global().get(fileID);
+    if (!file) throw InvalidSourceLocationError{"no source file with id " + std::to_string(fileID)};
+    return *file;
+}
+
+std::string_view SourceFile::line(size_t line) const {
+    if (line == 0 || line > lineOffsets.size())
         throw InvalidSourceLocationError{
             "line " + std::to_string(line) +
-                " out of bound, expected 1 to " + std::to_string(source.size())
+                " out of bound, expected 1 to " + std::to_string(lineOffsets.size())
         };
-    return source[line - 1];
+    auto begin = lineOffsets[line - 1];
+    auto end = line < lineOffsets.size() ? lineOffsets[line] : source.size();
+    return source.substr(begin, end - begin);
 }
 
-const SourceLocation *SourceFile::createSourceLocation(size_t startline,
-                                                       size_t startcol,
-                                                       size_t endline,
-                                                       size_t endcol) {
-    auto result = locationContext.emplace(*this, startline, startcol, endline, endcol);
-    return &*result.first;
+std::pair<size_t, size_t> SourceFile::getLineColumn(uint32_t offset) const {
+    auto next = std::upper_bound(lineOffsets.begin(), lineOffsets.end(), offset);
+    auto line = static_cast<size_t>(next - lineOffsets.begin());
+    return {line, offset - lineOffsets[line - 1] + 1};
 }
 
-using Loc = std::pair<size_t, size_t>;
-template<class Compare = std::less<size_t>>
-Loc &selectLocation(Loc &loc1, Loc &loc2, Compare cmp) {
-    if (loc1.first == loc2.first) {
-        return cmp(loc1.second, loc2.second) ? loc1 : loc2;
+SourceLocation SourceFile::createSourceLocation(uint32_t begin, uint32_t end) const {
+    if (begin > end || end > source.size()) {
+        throw InvalidSourceLocationError{
+            "Failed to create SourceLocation at [" + std::to_string(begin) + ", " + std::to_string(end) + ")"
+        };
     }
-    return cmp(loc1, loc2) ? loc1 : loc2;
+    return {fileID, begin, end};
 }
 
-const SourceLocation *SourceFile::mergeSourceLocation(const SourceLocation *loc1, const SourceLocation *loc2) {
-    auto starting1 = loc1->getStartLocation();
-    auto starting2 = loc2->getStartLocation();
-    auto ending1 = loc1->getEndLocation();
-    auto ending2 = loc2->getEndLocation();
-
-    auto &[sline, scol] = selectLocation(starting1, starting2, std::less<>());
-    auto &[eline, ecol] = selectLocation(ending1, ending2, std::greater<>());
+SourceLocation SourceFile::createSourceLocation(size_t startline, size_t startcol,
+                                                size_t endline, size_t endcol) const {
+    if (0 == startline || startline > totalLine() ||
+        0 == endline || endline > totalLine() ||
+        0 == startcol || startcol > line(startline).size() ||
+        0 == endcol || endcol > line(endline).size()) {
 
-    return createSourceLocation(sline, scol, eline, ecol);
+        throw InvalidSourceLocationError{
+            "Failed to create SourceLocation at <" + std::to_string(startline) + ":" + std::to_string(startcol)
+                + ", " + std::to_string(endline) + ":" + std::to_string(endcol) + ">"
+        };
+    }
+    return createSourceLocation(lineOffsets[startline - 1] + startcol - 1,
+                                lineOffsets[endline - 1] + endcol);
 }
 
 bool SourceFile::operator==(const SourceFile &rhs) const {
@@ -145,30 +277,25 @@ bool SourceFile::operator==(const SourceFile &rhs) const {
 const std::string &SourceFile::getFilename() const {
     return filename;
 }
-const SourceLocation *SourceFile::getLastValidPosition() {
-    auto endline = totalLine() - 1;
-    auto endcol = line(endline).size();
-    return createSourceLocation(endline, endcol, endline, endcol);
+
+SourceLocation SourceFile::getLastValidPosition() const {
+    auto lastLine = line(totalLine() - 1);
+    auto offset = static_cast<uint32_t>(lastLine.data() - source.data() + lastLine.size() - 1);
+    return {fileID, offset, offset + 1};
 }
 
 SourceFile &SourceManager::open(const std::string &filename) {
-    std::ifstream file{filename};
-    if (!file) throw SourceError{"Cannot open " + filename};
     if (fileContext.contains(filename)) throw SourceError{"File " + filename + " already opened"};
-    fileContext.try_emplace(filename, filename, file);
-    return fileContext.at(filename);
-}
-
-const SourceLocation *
-SourceManager::mergeSourceLocation(const SourceLocation *loc1, const SourceLocation *loc2) {
-    return loc1->getSource().mergeSourceLocation(loc1, loc2);
+    return fileContext.try_emplace(filename, filename).first->second;
 }
 
-const SourceLocation *
-SourceManager::createSourceLocation(SourceFile &source,
-                                    size_t startline, size_t startcol,
-                                    size_t endline, size_t endcol) {
-    return source.createSourceLocation(startline, startcol, endline, endcol);
+SourceLocation SourceManager::mergeSourceLocation(SourceLocation loc1, SourceLocation loc2) {
+    if (!loc1) return loc2;
+    if (!loc2) return loc1;
+    assert(loc1.getFileID() == loc2.getFileID() && "mergeSourceLocation: locations of different files");
+    return {loc1.getFileID(),
+            std::min(loc1.getBegin(), loc2.getBegin()),
+            std::max(loc1.getEnd(), loc2.getEnd())};
 }
 
 }
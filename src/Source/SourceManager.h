@@ -6,6 +6,7 @@
 #define REFLEX_SRC_LEXER_SOURCEMANAGER_H_
 
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 #include <map>
@@ -13,8 +14,10 @@
 #include <ostream>
 #include <fstream>
 #include <memory>
-#include <unordered_set>
-#include <functional>
+#include <stdexcept>
+#include <cstdint>
+
+#include "SourceLocation.h"
 
 namespace reflex {
 
@@ -28,73 +31,64 @@ class SourceError : public std::runtime_error {
     explicit SourceError(const std::string &msg);
 };
 
-class SourceFile;
-class SourceLocation {
-  public:
-    SourceLocation(SourceFile &parent,
-                   size_t startline, size_t startcol,
-                   size_t endline, size_t endcol);
-
-    void printSourceRegion(std::ostream &os, bool underline = false) const;
-
-    /// Produce a string representation with filename and source location
-    /// @return <filename>: <startline:startcol, endline,endcol>
-    [[nodiscard]] std::string getLocationString() const;
-
-    /// Produce a string representation of source location
-    /// @return <startline:startcol, endline,endcol>
-    [[nodiscard]] std::string getStringRepr() const;
-
-    [[nodiscard]] std::pair<size_t, size_t> getStartLocation() const;
-    [[nodiscard]] std::pair<size_t, size_t> getEndLocation() const;
-    [[nodiscard]] SourceFile &getSource() const { return parent; }
-    bool operator==(const SourceLocation &rhs) const;
-
-  private:
-    SourceFile &parent;
-
-    size_t startline;
-    size_t startcol;
-    size_t endline;
-    size_t endcol;
-};
-
-struct SourceLocationHash {
-  std::size_t operator()(const SourceLocation &loc) const noexcept;
-};
-
+/// Owns the buffer of one source file, every file gets a process wide id that SourceLocation refers to
+/// - files opened by name are memory mapped read-only where mmap is available
+/// - the content is normalized so the last line ends in a newline, followed by one empty line
 class SourceFile {
   public:
+    /// Maps @p filename, falling back to reading it when it cannot be mapped
+    /// @throws SourceError if the file cannot be opened
+    explicit SourceFile(std::string filename);
     SourceFile(std::string filename, std::istream &is);
+    ~SourceFile();
+    SourceFile(const SourceFile &) = delete;
+    SourceFile &operator=(const SourceFile &) = delete;
 
-    [[nodiscard]] std::string content() const;
+    /// @returns the file registered under @p fileID
+    /// @throws InvalidSourceLocationError if no such file is alive
+    static SourceFile &get(uint32_t fileID);
 
-    /// @param line line number representing the line number [1, n]
-    [[nodiscard]] const std::string &line(size_t line) const;
-    [[nodiscard]] size_t totalLine() const { return source.size(); }
-    [[nodiscard]] const SourceLocation *getLastValidPosition();
+    /// @returns view of the whole file, every line is terminated by a newline
+    [[nodiscard]] std::string_view content() const { return source; }
+    [[nodiscard]] uint32_t getFileID() const { return fileID; }
 
-    const SourceLocation *createSourceLocation(size_t startline, size_t startcol,
-                                               size_t endline, size_t endcol);
-    const SourceLocation *mergeSourceLocation(const SourceLocation *loc1, const SourceLocation *loc2);
+    /// @param line line number representing the line number [1, n]
+    [[nodiscard]] std::string_view line(size_t line) const;
+    [[nodiscard]] size_t totalLine() const { return lineOffsets.size(); }
+
+    /// @returns line and column [1, n] of the byte at @p offset
+    [[nodiscard]] std::pair<size_t, size_t> getLineColumn(uint32_t offset) const;
+    [[nodiscard]] SourceLocation getLastValidPosition() const;
+
+    /// @param begin @param end byte range [begin, end) in content()
+    [[nodiscard]] SourceLocation createSourceLocation(uint32_t begin, uint32_t end) const;
+    /// @note @p endcol is the column of the last character in the range
+    [[nodiscard]] SourceLocation createSourceLocation(size_t startline, size_t startcol,
+                                                      size_t endline, size_t endcol) const;
     bool operator==(const SourceFile &rhs) const;
 
     [[nodiscard]] const std::string &getFilename() const;
 
   private:
+    bool mapFile();
+    void buildLineOffsets();
+
     std::string filename;
-    std::vector<std::string> source;
-    std::unordered_set<SourceLocation, SourceLocationHash> locationContext;
+    std::string buffer;
+    void *mapping = nullptr;
+    size_t mappingSize = 0;
+    std::string_view source;
+    std::vector<uint32_t> lineOffsets;
+    uint32_t fileID;
 };
 
 class SourceManager {
   public:
     SourceFile &open(const std::string &filename);
 
-    static const SourceLocation *mergeSourceLocation(const SourceLocation *loc1, const SourceLocation *loc2);
-    static const SourceLocation *createSourceLocation(SourceFile &source,
-                                                      size_t startline, size_t startcol,
-                                                      size_t endline, size_t endcol);
+    /// @returns the smallest location covering both @p loc1 and @p loc2
+    /// @note both must be in the same file, an invalid location is ignored
+    static SourceLocation mergeSourceLocation(SourceLocation loc1, SourceLocation loc2);
   private:
     std::map<std::string, SourceFile> fileContext;
 };
@@ -0,0 +1,67 @@
+//
+// Created by henry on 2022-05-15.
+//
+
+#include "StringInterner.h"
+
+#include <bit>
+#include <mutex>
+#include <stdexcept>
+
+namespace reflex {
+
+Symbol::Symbol(std::string_view str) : id(StringInterner::global().intern(str).id) {}
+
+const std::string &Symbol::str() const {
+    return StringInterner::global().str(*this);
+}
+
+StringInterner::StringInterner() {
+    intern("");
+}
+
+StringInterner::~StringInterner() {
+    for (auto &chunk: chunks) delete[] chunk.load();
+}
+
+StringInterner &StringInterner::global() {
+    static StringInterner interner;
+    return interner;
+}
+
+std::pair<size_t, size_t> StringInterner::locate(uint32_t id) {
+    const auto biased = static_cast<uint64_t>(id) + FirstChunkSize;
+    const auto chunk = std::bit_width(biased) - 1 - FirstChunkBits;
+    return {chunk, biased - (uint64_t{1} << (chunk + FirstChunkBits))};
+}
+
+Symbol StringInterner::intern(std::string_view str) {
+    {
+        std::shared_lock lock(mutex);
+        auto iter = index.find(str);
+        if (iter != index.end()) return Symbol(iter->second, nullptr);
+    }
+    std::unique_lock lock(mutex);
+    auto iter = index.find(str);
+    if (iter != index.end()) return Symbol(iter->second, nullptr);
+
+    const auto id = count.load(std::memory_order_relaxed);
+    if (id == UINT32_MAX) throw std::length_error("StringInterner: symbol ids exhausted");
+    auto [chunk, offset] = locate(id);
+    auto entries = chunks[chunk].load(std::memory_order_relaxed);
+    if (!entries) {
+        entries = new std::string[FirstChunkSize << chunk];
+        chunks[chunk].store(entries, std::memory_order_release);
+    }
+    entries[offset] = str;
+    index.emplace(entries[offset], id);
+    count.store(id + 1, std::memory_order_release);
+    return Symbol(id, nullptr);
+}
+
+const std::string &StringInterner::str(Symbol symbol) const {
+    auto [chunk, offset] = locate(symbol.id);
+    return chunks[chunk].load(std::memory_order_acquire)[offset];
+}
+
+}
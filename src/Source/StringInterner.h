@@ -0,0 +1,83 @@
+//
+// Created by henry on 2022-05-15.
+//
+
+#ifndef REFLEX_SRC_SOURCE_STRINGINTERNER_H_
+#define REFLEX_SRC_SOURCE_STRINGINTERNER_H_
+
+#include <array>
+#include <atomic>
+#include <compare>
+#include <cstdint>
+#include <functional>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace reflex {
+
+/// Compact handle to an interned string, two symbols are equal iff their strings are equal
+/// @note the default constructed symbol is the empty string
+class Symbol {
+  public:
+    constexpr Symbol() = default;
+    Symbol(std::string_view str);
+    Symbol(const std::string &str) : Symbol(std::string_view(str)) {}
+    Symbol(const char *str) : Symbol(std::string_view(str)) {}
+
+    /// @returns the symbol of an id previously returned by getID
+    static constexpr Symbol fromID(uint32_t id) { return Symbol(id, nullptr); }
+
+    [[nodiscard]] uint32_t getID() const { return id; }
+    [[nodiscard]] bool empty() const { return id == 0; }
+    [[nodiscard]] const std::string &str() const;
+
+    bool operator==(const Symbol &rhs) const = default;
+    auto operator<=>(const Symbol &rhs) const = default;
+
+  private:
+    friend class StringInterner;
+    explicit constexpr Symbol(uint32_t id, std::nullptr_t) : id(id) {}
+
+    uint32_t id = 0;
+};
+
+/// Compiler wide string table mapping strings to 32-bit symbol ids
+/// - interning is thread safe
+/// - resolving a symbol back to its string is lock free and the string is never moved
+class StringInterner {
+  public:
+    StringInterner();
+    ~StringInterner();
+    StringInterner(const StringInterner &) = delete;
+    StringInterner &operator=(const StringInterner &) = delete;
+
+    static StringInterner &global();
+
+    Symbol intern(std::string_view str);
+    [[nodiscard]] const std::string &str(Symbol symbol) const;
+    [[nodiscard]] size_t size() const { return count.load(std::memory_order_acquire); }
+
+  private:
+    /// chunk i holds FirstChunkSize << i strings, so the table grows without moving entries
+    static constexpr size_t FirstChunkBits = 6;
+    static constexpr size_t FirstChunkSize = size_t{1} << FirstChunkBits;
+    static constexpr size_t MaxChunks = 33 - FirstChunkBits;
+
+    static std::pair<size_t, size_t> locate(uint32_t id);
+
+    mutable std::shared_mutex mutex;
+    std::unordered_map<std::string_view, uint32_t> index;
+    std::array<std::atomic<std::string *>, MaxChunks> chunks{};
+    std::atomic<uint32_t> count = 0;
+};
+
+}
+
+template<>
+struct std::hash<reflex::Symbol> {
+  size_t operator()(reflex::Symbol symbol) const noexcept { return symbol.getID(); }
+};
+
+#endif //REFLEX_SRC_SOURCE_STRINGINTERNER_H_
@@ -6,39 +6,47 @@
 #define REFLEX_SRC_LEXER_TOKEN_H_
 
 #include <string>
+#include <string_view>
 #include <ostream>
 #include "TokenType.h"
+#include "TokenInfo.h"
+#include "StringInterner.h"
+#include "SourceLocation.h"
 
 namespace reflex {
 
-class SourceLocation;
-
+/// Lightweight token, the lexeme is a view into the SourceFile buffer
+/// and identifiers and keywords carry their interned Symbol
 class Token {
     TokenType tokenType;
-    std::string lexeme;
-    const SourceLocation *loc;
+    std::string_view lexeme;
+    Symbol symbol;
+    SourceLocation loc;
   public:
-    Token(TokenType::Value tokenType, std::string lexeme, const SourceLocation *loc);
+    Token(TokenType::Value tokenType, std::string_view lexeme, SourceLocation loc, Symbol symbol = {});
 
-    [[nodiscard]]
-    const std::string &getLexeme() const { return lexeme; }
-    [[nodiscard]] const SourceLocation *getLocInfo() const { return loc; }
+    [[nodiscard]] std::string_view getLexeme() const { return lexeme; }
+    [[nodiscard]] Symbol getSymbol() const { return symbol; }
+    [[nodiscard]] SourceLocation getLocInfo() const { return loc; }
     [[nodiscard]] TokenType getTokenType() const { return tokenType; }
 
     [[nodiscard]] std::string getTokenTypeString() const;
     [[nodiscard]] std::string toString() const;
 
-    [[nodiscard]] bool isBasicLiteral() const;
-    [[nodiscard]] bool isUnaryOp() const;
+    /// @returns the parser facts of the token type, see TokenInfo.h
+    [[nodiscard]] const TokenInfo &getTokenInfo() const { return reflex::getTokenInfo(tokenType.getValue()); }
+
+    [[nodiscard]] bool isBasicLiteral() const { return getTokenInfo().is(TokenInfo::BasicLiteral); }
+    [[nodiscard]] bool isUnaryOp() const { return getTokenInfo().is(TokenInfo::UnaryOp); }
 
-    [[nodiscard]] int getTokenPrec() const;
-    [[nodiscard]] bool isBinaryOp() const;
+    [[nodiscard]] int getTokenPrec() const { return getTokenInfo().prec; }
+    [[nodiscard]] bool isBinaryOp() const { return getTokenInfo().is(TokenInfo::BinaryOp); }
 
-    [[nodiscard]] bool isAssignment() const;
-    [[nodiscard]] bool isPostfixOp() const;
+    [[nodiscard]] bool isAssignment() const { return getTokenInfo().is(TokenInfo::Assignment); }
+    [[nodiscard]] bool isPostfixOp() const { return getTokenInfo().is(TokenInfo::PostfixOp); }
 
-    [[nodiscard]] bool isDeclaration() const;
-    [[nodiscard]] bool isTrivial() const;
+    [[nodiscard]] bool isDeclaration() const { return getTokenInfo().is(TokenInfo::Declaration); }
+    [[nodiscard]] bool isTrivial() const { return getTokenInfo().is(TokenInfo::Trivial); }
 
     friend std::ostream &operator<<(std::ostream &os, const Token &token);
 };
@@ -0,0 +1,107 @@
+//
+// Created by henry on 2022-05-26.
+//
+
+#ifndef REFLEX_SRC_SOURCE_TOKENINFO_H_
+#define REFLEX_SRC_SOURCE_TOKENINFO_H_
+
+#include <array>
+#include <cstdint>
+
+#include "TokenType.h"
+
+namespace reflex {
+
+/// Parser facts about one TokenType, packed into four bytes
+/// - prec is the binary operator precedence, 0 if the token is not a binary operator
+/// - binaryOp is the Operator::BinaryOperator of a binary operator
+/// - op is the Operator::UnaryOperator, AssignOperator or PostfixOperator of the other operator classes,
+///   a token belongs to at most one of them
+struct TokenInfo {
+    enum Flags : uint8_t {
+      BinaryOp = 1 << 0,
+      UnaryOp = 1 << 1,
+      Assignment = 1 << 2,
+      PostfixOp = 1 << 3,
+      Declaration = 1 << 4,
+      Trivial = 1 << 5,
+      BasicLiteral = 1 << 6,
+      RightAssoc = 1 << 7,
+    };
+
+    uint8_t prec = 0;
+    uint8_t flags = 0;
+    uint8_t binaryOp = 0;
+    uint8_t op = 0;
+
+    [[nodiscard]] constexpr bool is(Flags flag) const { return flags & flag; }
+};
+
+/// Table of TokenInfo indexed by TokenType::Value, computed at compile time
+class TokenInfoTable {
+  public:
+    static constexpr size_t Size = TokenType::Continue + 1;
+
+    constexpr TokenInfoTable() {
+        // binary operators by ascending precedence, all left associative
+        binary(TokenType::Or, 1, 0);
+        binary(TokenType::And, 2, 1);
+        binary(TokenType::Compare, 3, 2);
+        binary(TokenType::CompareNot, 3, 3);
+        binary(TokenType::LAngleBracket, 3, 4);
+        binary(TokenType::RAngleBracket, 3, 5);
+        binary(TokenType::CompareLessEqual, 3, 6);
+        binary(TokenType::CompareGreaterEqual, 3, 7);
+        binary(TokenType::Add, 4, 8);
+        binary(TokenType::Sub, 4, 9);
+        binary(TokenType::LogicalOr, 4, 10);
+        binary(TokenType::Star, 5, 11);
+        binary(TokenType::Div, 5, 12);
+        binary(TokenType::Mod, 5, 13);
+        binary(TokenType::LogicalAnd, 5, 14);
+
+        other(TokenType::Sub, TokenInfo::UnaryOp, 0);
+        other(TokenType::LogicalNot, TokenInfo::UnaryOp, 1);
+        other(TokenType::Assign, TokenInfo::Assignment, 0);
+        other(TokenType::AssignAdd, TokenInfo::Assignment, 1);
+        other(TokenType::AssignSub, TokenInfo::Assignment, 2);
+        other(TokenType::PostInc, TokenInfo::PostfixOp, 0);
+        other(TokenType::PostDec, TokenInfo::PostfixOp, 1);
+
+        for (auto type: {TokenType::Var, TokenType::Class, TokenType::Interface, TokenType::Annotation}) {
+            infos[type].flags |= TokenInfo::Declaration;
+        }
+        for (auto type: {TokenType::WhiteSpace, TokenType::SingleComment, TokenType::MultiComment}) {
+            infos[type].flags |= TokenInfo::Trivial;
+        }
+        for (auto type: {TokenType::BoolLiteral, TokenType::NumberLiteral, TokenType::StringLiteral,
+                         TokenType::NullLiteral}) {
+            infos[type].flags |= TokenInfo::BasicLiteral;
+        }
+    }
+
+    [[nodiscard]] constexpr const TokenInfo &operator[](TokenType::Value type) const { return infos[type]; }
+
+  private:
+    constexpr void binary(TokenType::Value type, uint8_t prec, uint8_t op) {
+        infos[type].prec = prec;
+        infos[type].flags |= TokenInfo::BinaryOp;
+        infos[type].binaryOp = op;
+    }
+
+    constexpr void other(TokenType::Value type, TokenInfo::Flags flag, uint8_t op) {
+        infos[type].flags |= flag;
+        infos[type].op = op;
+    }
+
+    std::array<TokenInfo, Size> infos{};
+};
+
+inline constexpr TokenInfoTable TokenInfos{};
+
+/// @returns the parser facts of @p type
+constexpr const TokenInfo &getTokenInfo(TokenType::Value type) { return TokenInfos[type]; }
+
+}
+
+#endif //REFLEX_SRC_SOURCE_TOKENINFO_H_
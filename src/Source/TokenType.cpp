@@ -74,8 +74,4 @@ std::string TokenType::getTypeString() const {
     }
 }
 
-TokenType::Value TokenType::getValue() const {
-    return value;
-}
-
 }
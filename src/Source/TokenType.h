@@ -91,7 +91,7 @@ class TokenType {
     constexpr bool operator!=(TokenType a) const { return value != a.value; }
 
     [[nodiscard]] std::string getTypeString() const;
-    [[nodiscard]] TokenType::Value getValue() const;
+    [[nodiscard]] constexpr TokenType::Value getValue() const { return value; }
   private:
     Value value;
 };
@@ -3,8 +3,10 @@
 //
 
 #include "Type.h"
+#include "TypeHierarchy.h"
 
-#include <unordered_map>
+#include <algorithm>
+#include <unordered_set>
 #include <vector>
 
 namespace reflex {
@@ -124,6 +126,19 @@ std::string MemberAttrType::getTypeString() const {
     return getVisibilityString(visibility) + " " + type->getTypeString();
 }
 
+void CompositeType::invalidateTraits() {
+    std::vector<CompositeType *> pending{this};
+    while (!pending.empty()) {
+        auto type = pending.back();
+        pending.pop_back();
+        if (type->dropTraits()) pending.insert(pending.end(), type->subtypes.begin(), type->subtypes.end());
+    }
+}
+
+void CompositeType::inheritanceChanged() {
+    if (hierarchy) hierarchy->invalidate();
+}
+
 bool MemberAttrType::hasSameBaseAttr(const MemberAttrType *other) const {
     return other->visibility == visibility
         && other->type == type;
@@ -134,46 +149,84 @@ std::string ReferenceType::getTypeString() const {
     else return "nullptr";
 }
 
-bool hasCyclicInterfaceReference(std::unordered_map<InterfaceType *, bool> &visited,
-                                 InterfaceType *interface) {
-    if (visited[interface]) return true;
-    visited[interface] = true;
-    for (auto derived: interface->getInterfaces()) {
-        if (hasCyclicInterfaceReference(visited, derived)) return true;
+/// @returns if @p interface is or derives from @p base
+/// @note shared bases are walked once, so diamonds cost no more than the number of interfaces
+bool reachesInterface(const InterfaceType *interface, const InterfaceType *base,
+                      std::unordered_set<const InterfaceType *> &visited) {
+    std::vector<const InterfaceType *> pending{interface};
+    while (!pending.empty()) {
+        auto current = pending.back();
+        pending.pop_back();
+        if (current == base) return true;
+        if (!visited.insert(current).second) continue;
+        pending.insert(pending.end(), current->getInterfaces().begin(), current->getInterfaces().end());
     }
-    visited[interface] = false;
     return false;
 }
 
-/// @returns if a cycle is detected or not
-bool detectDerivedInterfaceCycle(InterfaceType *interface, InterfaceType *toBeDerived) {
-    std::unordered_map<InterfaceType *, bool> visited;
-    visited[interface] = true;
-    return hasCyclicInterfaceReference(visited, toBeDerived);
+void TraitTable::add(const std::string &name, MemberAttrType *method, bool agrees) {
+    auto [iter, inserted] = index.try_emplace(name, methods.size());
+    if (inserted) {
+        methods.emplace_back(name, method);
+        agreeing.push_back(agrees);
+    } else {
+        agreeing[iter->second] = agreeing[iter->second] && agrees
+            && methods[iter->second].second->hasSameBaseAttr(method);
+    }
 }
 
-MemberAttrType *InterfaceType::hasOverrideAttrError(const std::string &name, MemberAttrType *method) {
-    if (methods.contains(name) &&
-        !methods.at(name)->hasSameBaseAttr(method)) {
-        return methods.at(name);
-    }
-    for (auto interface: interfaces) {
-        if (auto parent = interface->hasOverrideAttrError(name, method)) {
-            return parent;
-        }
+bool TraitTable::agreesWith(const std::string &name, const MemberAttrType *method) const {
+    auto iter = index.find(name);
+    if (iter == index.end()) return true;
+    return agreeing[iter->second] && methods[iter->second].second->hasSameBaseAttr(method);
+}
+
+/// @returns the first method named @p name satisfying @p matches, in preorder from @p interface over the
+///          interfaces it derives from, nullptr if there is none
+/// @note an interface reached again was already searched without a match, so each is searched once
+template<class Matches>
+MemberAttrType *findInheritedMethod(const InterfaceType *interface, const std::string &name, Matches &&matches) {
+    std::unordered_set<const InterfaceType *> visited;
+    std::vector<const InterfaceType *> pending{interface};
+    while (!pending.empty()) {
+        auto current = pending.back();
+        pending.pop_back();
+        if (!visited.insert(current).second) continue;
+        auto iter = current->getMethods().find(name);
+        if (iter != current->getMethods().end() && matches(iter->second)) return iter->second;
+        pending.insert(pending.end(), current->getInterfaces().rbegin(), current->getInterfaces().rend());
     }
     return nullptr;
 }
 
+MemberAttrType *InterfaceType::hasOverrideAttrError(const std::string &name, MemberAttrType *method) {
+    // the traits of the bases tell if any inherited method conflicts, only then is the conflict searched for
+    auto own = methods.find(name);
+    if ((own == methods.end() || own->second->hasSameBaseAttr(method)) &&
+        std::ranges::all_of(interfaces, [&](const InterfaceType *interface) {
+          return interface->getInterfaceTraits().agreesWith(name, method);
+        })) {
+        return nullptr;
+    }
+    return findInheritedMethod(this, name, [method](const MemberAttrType *parent) {
+      return !parent->hasSameBaseAttr(method);
+    });
+}
+
 void InterfaceType::addInterface(InterfaceType *interface) {
-    if (detectDerivedInterfaceCycle(this, interface)) {
+    // the hierarchy is acyclic, the new edge closes a cycle iff interface already derives from this,
+    // which needs something to derive from this
+    if (interface == this || (hasSubtypes() && interface->isDerivedFrom(this))) {
         throw TypeError{interface->getTypeString() + " is part of cyclic inheritance with " + getTypeString()};
     }
     interfaces.push_back(interface);
+    interface->addSubtype(this);
+    inheritanceChanged();
+    invalidateTraits();
 }
 
 void InterfaceType::addMethod(const std::string &name, MemberAttrType *method) {
-    auto funcType = dynamic_cast<FunctionType *>(method->getMemberAttrType());
+    auto funcType = dyn_cast<FunctionType>(method->getMemberAttrType());
     if (!funcType) throw TypeError{name + " must be a function"};
     if (methods.contains(name)) throw TypeError{"Cannot overload " + name + ", it already exists"};
     if (auto parent = hasOverrideAttrError(name, method)) {
@@ -182,87 +235,65 @@ void InterfaceType::addMethod(const std::string &name, MemberAttrType *method) {
                 method->getTypeString() + " expected " + parent->getTypeString()};
     }
     methods[name] = method;
+    invalidateTraits();
 }
 
-void addInheritedTrait(std::vector<Method> &methods, const std::string &name, MemberAttrType *type) {
-    auto res = std::find_if(methods.begin(), methods.end(),
-                            [&](const auto &method) -> bool {
-                              return method.first == name;
-                            });
-    if (res == methods.end()) {
-        methods.emplace_back(name, type);
-    }
+const TraitTable &InterfaceType::getInterfaceTraits() const {
+    return traits.get([this](TraitTable &table) {
+      for (auto interface: interfaces) table.add(interface->getInterfaceTraits());
+      for (const auto &[name, type]: methods) table.add(name, type);
+    });
 }
 
-std::vector<Method> InterfaceType::getInterfaceTraits() const {
-    std::vector<Method> members;
-    for (auto interface: interfaces) {
-        const auto inherited = interface->getInterfaceTraits();
-        for (const auto &[name, type]: inherited) {
-            addInheritedTrait(members, name, type);
-        }
-    }
-    for (const auto &[name, type]: methods) {
-        addInheritedTrait(members, name, type);
-    }
-    return members;
+bool InterfaceType::dropTraits() {
+    return traits.reset();
 }
 
 bool InterfaceType::isDerivedFrom(InterfaceType *type) const {
-    if (type == this) return true;
-    return std::any_of(interfaces.begin(), interfaces.end(),
-                       [type](const InterfaceType *interface) {
-                         return interface->isDerivedFrom(type);
-                       });
+    std::unordered_set<const InterfaceType *> visited;
+    return reachesInterface(this, type, visited);
 }
 
 MemberAttrType *InterfaceType::getMemberReference(const std::string &name) const {
-    if (methods.contains(name)) return methods.at(name);
-    for (auto interface: interfaces) {
-        try {
-            return interface->getMemberReference(name);
-        } catch (TypeError &err) {}
-    }
+    if (auto method = findInheritedMethod(this, name, [](const MemberAttrType *) { return true; })) return method;
     throw TypeError{"Cannot find member reference " + name};
 }
 
-std::vector<Method> ClassType::getClassImplTraits() const {
-    std::vector<Method> traits;
-    if (baseclass) {
-        const auto inherited = baseclass->getClassImplTraits();
-        for (const auto &[name, type]: inherited) {
-            addInheritedTrait(traits, name, type);
-        }
-    }
-    for (const auto &[name, type]: methods) {
-        addInheritedTrait(traits, name, type);
-    }
-    return traits;
+const TraitTable &ClassType::getClassImplTraits() const {
+    return implTraits.get([this](TraitTable &table) {
+      if (baseclass) table.add(baseclass->getClassImplTraits());
+      for (const auto &[name, type]: methods) table.add(name, type);
+    });
 }
 
-bool hasCyclicClassReference(std::unordered_map<ClassType *, bool> &visited,
-                             ClassType *klass) {
-    if (visited[klass]) return true;
-    visited[klass] = true;
-    if (klass->getBaseclass()) {
-        if (hasCyclicClassReference(visited, klass->getBaseclass())) return true;
-    }
-    visited[klass] = false;
-    return false;
+const TraitTable &ClassType::getRequiredTraits() const {
+    return requiredTraits.get([this](TraitTable &table) {
+      for (auto interface: interfaces) table.add(interface->getInterfaceTraits());
+    });
 }
 
-/// @returns if a cycle is detected or not
-bool detectDerivedClassCycle(ClassType *klass, ClassType *toBeDerived) {
-    std::unordered_map<ClassType *, bool> visited;
-    visited[klass] = true;
-    return hasCyclicClassReference(visited, toBeDerived);
+bool ClassType::dropTraits() {
+    const bool implemented = implTraits.reset();
+    return requiredTraits.reset() || implemented;
 }
 
 void ClassType::setBaseclass(ClassType *klass) {
-    if (detectDerivedClassCycle(this, klass)) {
+    // the hierarchy is acyclic, the new edge closes a cycle iff klass already derives from this,
+    // which needs something to derive from this
+    if (klass == this || (hasSubtypes() && klass->isDerivedFrom(this))) {
         throw TypeError{klass->getTypeString() + " is part of cyclic inheritance with " + getTypeString()};
     }
     baseclass = klass;
+    klass->addSubtype(this);
+    inheritanceChanged();
+    invalidateTraits();
+}
+
+void ClassType::addInterface(InterfaceType *interface) {
+    interfaces.push_back(interface);
+    interface->addSubtype(this);
+    inheritanceChanged();
+    invalidateTraits();
 }
 
 MemberAttrType *ClassType::hasOverrideAttrError(const std::string &name, MemberAttrType *method) {
@@ -285,8 +316,8 @@ MemberAttrType *ClassType::shadowsFieldAttrError(const std::string &name) {
 }
 
 void ClassType::addField(const std::string &name, MemberAttrType *field) {
-    auto refType = dynamic_cast<ReferenceType *>(field->getMemberAttrType());
-    auto builtinType = dynamic_cast<BuiltinType *>(field->getMemberAttrType());
+    auto refType = dyn_cast<ReferenceType>(field->getMemberAttrType());
+    auto builtinType = dyn_cast<BuiltinType>(field->getMemberAttrType());
     if (!refType && !builtinType) {
         throw TypeError{name + " must be either ReferenceType or BuiltinType"};
     }
@@ -306,7 +337,7 @@ void ClassType::addField(const std::string &name, MemberAttrType *field) {
 }
 
 void ClassType::addMethod(const std::string &name, MemberAttrType *method) {
-    auto funcType = dynamic_cast<FunctionType *>(method->getMemberAttrType());
+    auto funcType = dyn_cast<FunctionType>(method->getMemberAttrType());
     if (!funcType) throw TypeError{name + " must be a function"};
     if (methods.contains(name)) throw TypeError{"Cannot overload " + name + ", it already exists"};
     if (auto field = shadowsFieldAttrError(name)) {
@@ -321,41 +352,31 @@ void ClassType::addMethod(const std::string &name, MemberAttrType *method) {
                 method->getTypeString() + " expected " + parent->getTypeString()};
     }
     methods[name] = method;
+    invalidateTraits();
 }
 
 bool ClassType::isAbstract() const {
-    std::vector<Method> mustImpl;
-    for (auto interface: interfaces) {
-        auto inherited = interface->getInterfaceTraits();
-        for (auto &[name, type]: inherited) {
-            addInheritedTrait(mustImpl, name, type);
-        }
-    }
-    auto implemented = getClassImplTraits();
-    for (auto &trait: mustImpl) {
-        auto iter = std::find_if(implemented.begin(), implemented.end(),
-                                 [&trait](const Method &item) -> bool {
-                                   return item.first == trait.first
-                                       && item.second->hasSameBaseAttr(trait.second);
-                                 });
-        if (iter == implemented.end()) return true;
-    }
-    return false;
+    const auto &implemented = getClassImplTraits();
+    return std::ranges::any_of(getRequiredTraits(), [&implemented](const Method &trait) {
+      auto method = implemented.find(trait.first);
+      return !method || !method->hasSameBaseAttr(trait.second);
+    });
 }
 
 bool ClassType::implements(InterfaceType *type) const {
-    for (auto interface: interfaces) {
-        if (interface->isDerivedFrom(type)) return true;
-    }
-    if (baseclass) {
-        return baseclass->implements(type);
+    std::unordered_set<const InterfaceType *> visited;
+    for (auto klass = this; klass; klass = klass->baseclass) {
+        for (auto interface: klass->interfaces) {
+            if (reachesInterface(interface, type, visited)) return true;
+        }
     }
     return false;
 }
 
 bool ClassType::isDerivedFrom(ClassType *type) const {
-    if (this == type) return true;
-    if (baseclass) return baseclass->isDerivedFrom(type);
+    for (auto klass = this; klass; klass = klass->baseclass) {
+        if (klass == type) return true;
+    }
     return false;
 }
 
@@ -5,24 +5,63 @@
 #ifndef REFLEX_SRC_TYPE_TYPE_H_
 #define REFLEX_SRC_TYPE_TYPE_H_
 
+#include <atomic>
 #include <string>
 #include <vector>
 #include <optional>
 #include <cassert>
+#include <cstdint>
 #include <map>
+#include <memory>
 #include <stdexcept>
+#include <unordered_map>
 
 #include "ASTUtils.h"
 #include "Operator.h"
+#include "Utils/Casting.h"
 
 namespace reflex {
 
+/// Kind tag of every concrete type class, used by isa<>/cast<>/dyn_cast<> instead of RTTI
+/// @note the subclasses of an abstract class are contiguous, classof of an abstract class is a range check
+enum class TypeKind : uint8_t {
+  Void,
+  Builtin,
+  Array,
+  Function,
+  Interface,
+  Class,
+  MemberAttr,
+  Reference,
+};
+
+/// Dense index of a type in the TypeContext that created it, its metadata is looked up in the
+/// TypeContext by this index instead of through the type
+/// @note the void and builtin types have fixed ids, a type not created by a TypeContext has Invalid
+enum class TypeID : uint32_t {
+  Void = 0,
+  Integer = 1,
+  Number = 2,
+  Character = 3,
+  Boolean = 4,
+  Invalid = UINT32_MAX,
+};
+
 class Type {
   public:
+    explicit Type(TypeKind kind) : kind(kind) {}
     virtual ~Type() = default;
 
+    TypeKind getKind() const { return kind; }
+    TypeID getID() const { return id; }
     virtual std::string getTypeString() const = 0;
     virtual bool isReferenceType() const = 0;
+
+  private:
+    friend class TypeContext;
+
+    TypeKind kind;
+    TypeID id = TypeID::Invalid;
 };
 
 class TypeError : public std::runtime_error {
@@ -32,7 +71,9 @@ class TypeError : public std::runtime_error {
 
 class VoidType : public Type {
   public:
-    VoidType() = default;
+    VoidType() : Type(TypeKind::Void) {}
+
+    static bool classof(const Type *type) { return type->getKind() == TypeKind::Void; }
 
     std::string getTypeString() const override { return "void"; }
     bool isReferenceType() const override { return false; }
@@ -47,7 +88,9 @@ class BuiltinType : public Type {
       Boolean = 3,
     };
   public:
-    explicit BuiltinType(BaseType baseType) : baseType(baseType) {}
+    explicit BuiltinType(BaseType baseType) : Type(TypeKind::Builtin), baseType(baseType) {}
+
+    static bool classof(const Type *type) { return type->getKind() == TypeKind::Builtin; }
 
     std::string getTypeString() const override;
     bool isReferenceType() const override { return false; }
@@ -61,17 +104,25 @@ class BuiltinType : public Type {
 
 class ReferenceableType : public Type {
   public:
+    explicit ReferenceableType(TypeKind kind) : Type(kind) {}
+
+    static bool classof(const Type *type) {
+        return type->getKind() >= TypeKind::Array && type->getKind() <= TypeKind::Class;
+    }
+
     virtual bool isClassOrInterfaceType() const = 0;
 };
 
 class ArrayType : public ReferenceableType {
   public:
     explicit ArrayType(Type *elemType, std::optional<size_t> size = std::nullopt)
-        : elementType(elemType), size(size) {
-        if (dynamic_cast<VoidType *>(elemType))
+        : ReferenceableType(TypeKind::Array), elementType(elemType), size(size) {
+        if (isa<VoidType>(elemType))
             throw TypeError{"ArrayType cannot have void type"};
     }
 
+    static bool classof(const Type *type) { return type->getKind() == TypeKind::Array; }
+
     bool hasDefinedSize() const { return size.has_value(); }
     std::string getTypeString() const override;
     bool isReferenceType() const override { return false; }
@@ -88,11 +139,13 @@ class ArrayType : public ReferenceableType {
 class FunctionType : public ReferenceableType {
   public:
     FunctionType(std::vector<Type *> paramTypes, Type *returnType)
-        : paramTypes(std::move(paramTypes)), returnType(returnType) {}
+        : ReferenceableType(TypeKind::Function), paramTypes(std::move(paramTypes)), returnType(returnType) {}
+
+    static bool classof(const Type *type) { return type->getKind() == TypeKind::Function; }
 
     std::string getTypeString() const override;
     bool isReferenceType() const override { return false; }
-    bool isReturnVoid() const { return dynamic_cast<VoidType *>(returnType); }
+    bool isReturnVoid() const { return isa<VoidType>(returnType); }
     bool isClassOrInterfaceType() const override { return false; }
 
     const std::vector<Type *> &getParamTypes() const { return paramTypes; }
@@ -106,10 +159,15 @@ class FunctionType : public ReferenceableType {
 
 class AggregateDecl;
 class MemberAttrType;
+class TypeHierarchy;
 class CompositeType : public ReferenceableType {
   public:
-    CompositeType(std::string name, AggregateDecl *decl)
-        : name(std::move(name)), decl(decl) {};
+    CompositeType(TypeKind kind, std::string name, AggregateDecl *decl)
+        : ReferenceableType(kind), name(std::move(name)), decl(decl) {};
+
+    static bool classof(const Type *type) {
+        return type->getKind() == TypeKind::Interface || type->getKind() == TypeKind::Class;
+    }
 
     virtual bool isClassType() const = 0;
     const std::string &getDeclName() const { return name; }
@@ -120,24 +178,49 @@ class CompositeType : public ReferenceableType {
     AggregateDecl *getDecl() const { return decl; }
     void setDecl(AggregateDecl *aggregateDecl) { CompositeType::decl = aggregateDecl; }
 
+    /// Registers @p type as deriving from or implementing this type, its traits are dropped with ours
+    void addSubtype(CompositeType *type) { subtypes.push_back(type); }
+
+  protected:
+    bool hasSubtypes() const { return !subtypes.empty(); }
+
+    /// Drops the memoized traits of this type and of every type inheriting from it, to be called
+    /// whenever this type changes in a way its traits depend on
+    void invalidateTraits();
+
+    /// Marks the hierarchy index covering this type stale, to be called whenever this type gains a
+    /// baseclass or interface
+    void inheritanceChanged();
+
   private:
+    friend class TypeContext;
+
+    /// Drops the memoized traits of this type only
+    /// @returns if there were any, if not the types inheriting from it have none either
+    virtual bool dropTraits() = 0;
+
 //    virtual std::vector<MemberAttrType *> getStaticAttribute(const std::string &name) const = 0;
 //    virtual std::vector<MemberAttrType *> getInstanceAttribute(const std::string &name) const = 0;
 
     AggregateDecl *decl;
     std::string name;
+    std::vector<CompositeType *> subtypes;
+    // the index of the TypeContext once it covers this type
+    TypeHierarchy *hierarchy = nullptr;
 };
 
 class MemberAttrType : public Type {
   public:
     MemberAttrType(Visibility visibility, CompositeType *parent, Type *type)
-        : visibility(visibility), parent(parent), type(type) {
-        if (dynamic_cast<MemberAttrType *>(type))
+        : Type(TypeKind::MemberAttr), visibility(visibility), parent(parent), type(type) {
+        if (isa<MemberAttrType>(type))
             throw TypeError{"MemberAttrType cannot have nested MemberAttrType"};
         if (!parent) throw TypeError{"MemberAttrType must have parent CompositeType"};
-        if (dynamic_cast<VoidType *>(type)) throw TypeError{"MemberAttrType cannot have void type"};
+        if (isa<VoidType>(type)) throw TypeError{"MemberAttrType cannot have void type"};
     }
 
+    static bool classof(const Type *type) { return type->getKind() == TypeKind::MemberAttr; }
+
     std::string getTypeString() const override;
     bool isReferenceType() const override { return type->isReferenceType(); }
     Type *getType() const { return type; }
@@ -155,6 +238,78 @@ class MemberAttrType : public Type {
 
 using Method = std::pair<std::string, MemberAttrType *>;
 
+/// Methods a composite type supports in inheritance order, the first method of a name wins
+/// - finding a method by name is a hashed probe instead of a linear search
+/// - whether all methods of a name agree is kept, so overrides are checked without walking the hierarchy
+class TraitTable {
+  public:
+    /// Adds @p method unless a method named @p name is already present
+    /// @param agrees if the methods @p method stands for all have the same base attribute
+    void add(const std::string &name, MemberAttrType *method, bool agrees = true);
+
+    /// Adds the methods of @p other in its order
+    void add(const TraitTable &other) {
+        for (size_t i = 0; i < other.methods.size(); ++i) {
+            add(other.methods[i].first, other.methods[i].second, other.agreeing[i]);
+        }
+    }
+
+    /// @returns the method named @p name, nullptr if there is none
+    MemberAttrType *find(const std::string &name) const {
+        auto iter = index.find(name);
+        return iter != index.end() ? methods[iter->second].second : nullptr;
+    }
+
+    /// @returns if every method named @p name the table was built from has the same base attribute
+    ///          as @p method, trivially if there is none
+    bool agreesWith(const std::string &name, const MemberAttrType *method) const;
+
+    [[nodiscard]] size_t size() const { return methods.size(); }
+    [[nodiscard]] bool empty() const { return methods.empty(); }
+    std::vector<Method>::const_iterator begin() const { return methods.begin(); }
+    std::vector<Method>::const_iterator end() const { return methods.end(); }
+
+  private:
+    std::vector<Method> methods;
+    std::vector<bool> agreeing;
+    std::unordered_map<std::string, size_t> index;
+};
+
+/// A TraitTable built on first use and published with an atomic pointer, so readers on several
+/// threads may race to build it, one table wins and the others are discarded
+/// @note dropping the table must not race with readers, it happens only when the hierarchy changes
+class MemoizedTraits {
+  public:
+    MemoizedTraits() = default;
+    MemoizedTraits(const MemoizedTraits &) = delete;
+    MemoizedTraits &operator=(const MemoizedTraits &) = delete;
+    ~MemoizedTraits() { delete table.load(std::memory_order_relaxed); }
+
+    /// @returns the published table, calling @p build on a new table if there is none
+    template<class Build>
+    const TraitTable &get(Build &&build) const {
+        if (auto current = table.load(std::memory_order_acquire)) return *current;
+        auto built = std::make_unique<TraitTable>();
+        build(*built);
+        TraitTable *current = nullptr;
+        if (!table.compare_exchange_strong(current, built.get(), std::memory_order_acq_rel, std::memory_order_acquire)) {
+            return *current;
+        }
+        return *built.release();
+    }
+
+    /// Drops the table
+    /// @returns if there was one
+    bool reset() {
+        auto current = table.exchange(nullptr, std::memory_order_acq_rel);
+        delete current;
+        return current != nullptr;
+    }
+
+  private:
+    mutable std::atomic<TraitTable *> table = nullptr;
+};
+
 /// Represent an Interface
 /// Responsible for maintaining the interface invariants:
 /// - no cyclic inheritance
@@ -162,7 +317,9 @@ using Method = std::pair<std::string, MemberAttrType *>;
 class InterfaceType : public CompositeType {
   public:
     InterfaceType(const std::string &name, AggregateDecl *decl)
-        : CompositeType(name, decl) {}
+        : CompositeType(TypeKind::Interface, name, decl) {}
+
+    static bool classof(const Type *type) { return type->getKind() == TypeKind::Interface; }
 
     const std::vector<InterfaceType *> &getInterfaces() const { return interfaces; }
     bool isClassType() const override { return false; }
@@ -188,16 +345,21 @@ class InterfaceType : public CompositeType {
     MemberAttrType *getMemberReference(const std::string &name) const;
 
     /// Get all traits "the methods that the interface supports" a class can implement
-    /// @returns the trait of the interface
-    std::vector<Method> getInterfaceTraits() const;
+    /// @returns the trait of the interface, computed once and kept until the interface or one it derives from changes,
+    ///          the reference is valid only until the next change to the hierarchy
+    /// @note safe to call concurrently as long as the hierarchy does not change
+    const TraitTable &getInterfaceTraits() const;
 
   private:
+    bool dropTraits() override;
+
     /// Search parents for override attribute error
     /// @returns MemberAttrType which has the defined method, nullptr otherwise;
     MemberAttrType *hasOverrideAttrError(const std::string &name, MemberAttrType *method);
 
     std::vector<InterfaceType *> interfaces;
     std::map<std::string, MemberAttrType *> methods;
+    MemoizedTraits traits;
 };
 
 /// Represent a Class
@@ -207,7 +369,9 @@ class InterfaceType : public CompositeType {
 /// - no member name conflicts
 class ClassType : public CompositeType {
   public:
-    ClassType(const std::string &name, AggregateDecl *decl) : CompositeType(name, decl) {}
+    ClassType(const std::string &name, AggregateDecl *decl) : CompositeType(TypeKind::Class, name, decl) {}
+
+    static bool classof(const Type *type) { return type->getKind() == TypeKind::Class; }
 
     ClassType *getBaseclass() const { return baseclass; }
     const std::vector<InterfaceType *> &getInterfaces() const { return interfaces; }
@@ -218,7 +382,7 @@ class ClassType : public CompositeType {
     /// @throws TypeError if cyclic inheritance is detected
     void setBaseclass(ClassType *klass);
 
-    void addInterface(InterfaceType *interface) { interfaces.push_back(interface); }
+    void addInterface(InterfaceType *interface);
 
     /// add @p field to the interface trait and maintains invariant of no overload
     /// @param name the field name
@@ -236,6 +400,9 @@ class ClassType : public CompositeType {
 
     /// check if class implements all interface traits
     bool isAbstract() const;
+    /// @returns the traits of the interfaces the class declares, the methods it must implement, memoized
+    ///          as getClassImplTraits
+    const TraitTable &getRequiredTraits() const;
 
     bool implements(InterfaceType *type) const;
     bool isDerivedFrom(ClassType *type) const;
@@ -247,10 +414,14 @@ class ClassType : public CompositeType {
     const std::map<std::string, MemberAttrType *> &getMembers() const { return members; }
     const std::map<std::string, MemberAttrType *> &getMethods() const { return methods; }
 
-    /// @note must not have cyclic inheritance
-    std::vector<Method> getClassImplTraits() const;
+    /// @returns the methods of the class and its baseclasses, computed once and kept until one of them changes,
+    ///          the reference is valid only until the next change to the hierarchy
+    /// @note must not have cyclic inheritance, safe to call concurrently as getInterfaceTraits
+    const TraitTable &getClassImplTraits() const;
 
   private:
+    bool dropTraits() override;
+
     /// Search parents for override method attribute error
     /// @returns MemberAttrType which has the defined method, nullptr otherwise
     MemberAttrType *hasOverrideAttrError(const std::string &name, MemberAttrType *method);
@@ -264,6 +435,8 @@ class ClassType : public CompositeType {
 
     std::map<std::string, MemberAttrType *> members;
     std::map<std::string, MemberAttrType *> methods;
+    MemoizedTraits implTraits;
+    MemoizedTraits requiredTraits;
 };
 
 /// Represents a reference
@@ -271,7 +444,9 @@ class ClassType : public CompositeType {
 class ReferenceType : public Type {
   public:
     explicit ReferenceType(ReferenceableType *refType, bool nullable = true)
-        : refType(refType), nullable(nullable) {}
+        : Type(TypeKind::Reference), refType(refType), nullable(nullable) {}
+
+    static bool classof(const Type *type) { return type->getKind() == TypeKind::Reference; }
 
     bool isNullable() const { return nullable; }
     ReferenceableType *getRefType() const { return refType; }
@@ -4,16 +4,37 @@
 
 #include "TypeContext.h"
 
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
 #include <ostream>
 
 namespace reflex {
 
+namespace {
+
+/// Mixes @p value into @p seed, pointers alone are poor hashes as their low bits are aligned
+size_t hashCombine(size_t seed, size_t value) {
+    value *= 0x9e3779b97f4a7c15ULL;
+    return seed ^ ((value ^ (value >> 32)) + 0x9e3779b9 + (seed << 6) + (seed >> 2));
+}
+
+size_t hashPointer(const void *pointer) {
+    return reinterpret_cast<uintptr_t>(pointer);
+}
+
+}
+
 TypeContext::TypeContext() {
     voidType = std::make_unique<VoidType>();
     builtinType.push_back(std::make_unique<BuiltinType>(BuiltinType::Integer));
     builtinType.push_back(std::make_unique<BuiltinType>(BuiltinType::Number));
     builtinType.push_back(std::make_unique<BuiltinType>(BuiltinType::Character));
     builtinType.push_back(std::make_unique<BuiltinType>(BuiltinType::Boolean));
+    // in the order of their fixed ids
+    assignID(voidType.get());
+    for (auto &builtin: builtinType) assignID(builtin.get());
+    assert(getBuiltinType(BuiltinType::Boolean)->getID() == TypeID::Boolean);
 }
 
 VoidType *TypeContext::getVoidType() const {
@@ -25,76 +46,161 @@ BuiltinType *TypeContext::getBuiltinType(BuiltinType::BaseType typ) const {
 }
 
 ArrayType *TypeContext::getArrayType(Type *elementTyp, std::optional<size_t> size) {
-    auto res = std::find_if(arrayType.begin(), arrayType.end(),
-                            [&size, elementTyp](const auto &existing) {
-                              return existing->getElementType() == elementTyp
-                                  && existing->getSize() == size;
-                            });
-    if (res == arrayType.end()) {
-        arrayType.push_back(std::make_unique<ArrayType>(elementTyp, size));
-        return arrayType.back().get();
-    }
-    return res->get();
+    return arrayType.getOrCreate({elementTyp, size}, [&] {
+      auto created = std::make_unique<ArrayType>(elementTyp, size);
+      assignID(created.get());
+      return created;
+    });
 }
 
 FunctionType *TypeContext::getFunctionType(Type *returnType, const std::vector<Type *> &paramTyp) {
-    auto res = std::find_if(funcType.begin(), funcType.end(),
-                            [&paramTyp, returnType](const auto &existing) {
-                              return existing->getParamTypes() == paramTyp
-                                  && existing->getReturnType() == returnType;
-                            });
-    if (res != funcType.end()) {
-        return res->get();
-    }
-    funcType.push_back(std::make_unique<FunctionType>(paramTyp, returnType));
-    return funcType.back().get();
+    return funcType.getOrCreate({returnType, paramTyp}, [&] {
+      auto created = std::make_unique<FunctionType>(paramTyp, returnType);
+      assignID(created.get());
+      return created;
+    });
 }
 
 MemberAttrType *TypeContext::getMemberType(Visibility visibility, CompositeType *parent, Type *type) {
-    auto res = std::find_if(memberType.begin(), memberType.end(),
-                            [=](const auto &existing) {
-                              return existing->getMemberAttrType() == type
-                                  && existing->getParent() == parent
-                                  && existing->getVisibility() == visibility;
-                            });
-    if (res != memberType.end()) {
-        return res->get();
-    }
-    memberType.push_back(std::make_unique<MemberAttrType>(visibility, parent, type));
-    return memberType.back().get();
+    return memberType.getOrCreate({visibility, parent, type}, [&] {
+      auto created = std::make_unique<MemberAttrType>(visibility, parent, type);
+      assignID(created.get());
+      return created;
+    });
 }
 
 ClassType *TypeContext::getClassType(const std::string &name, AggregateDecl *decl) {
-    if (classType.contains(name)) {
-        if (!classType[name]->getDecl())
-            classType[name]->setDecl(decl);
-        return classType[name].get();
-    }
-    classType[name] = std::make_unique<ClassType>(name, decl);
-    return classType[name].get();
+    auto klass = classType.getOrCreate(name, [&] {
+      auto created = std::make_unique<ClassType>(name, decl);
+      assignID(created.get());
+      return created;
+    });
+    if (decl && !klass->getDecl()) klass->setDecl(decl);
+    return klass;
 }
 
 InterfaceType *TypeContext::getInterfaceType(const std::string &name, AggregateDecl *decl) {
-    if (interfaceType.contains(name)) {
-        if (!interfaceType[name]->getDecl())
-            interfaceType[name]->setDecl(decl);
-        return interfaceType[name].get();
-    }
-    interfaceType[name] = std::make_unique<InterfaceType>(name, decl);
-    return interfaceType[name].get();
+    auto interface = interfaceType.getOrCreate(name, [&] {
+      auto created = std::make_unique<InterfaceType>(name, decl);
+      assignID(created.get());
+      return created;
+    });
+    if (decl && !interface->getDecl()) interface->setDecl(decl);
+    return interface;
 }
 
 ReferenceType *TypeContext::getReferenceType(ReferenceableType *type, bool nullable) {
-    auto res = std::find_if(referenceType.begin(), referenceType.end(),
-                            [=](const auto &existing) {
-                              return existing->getRefType() == type
-                                  && existing->isNullable() == nullable;
-                            });
-    if (res == referenceType.end()) {
-        referenceType.push_back(std::make_unique<ReferenceType>(type, nullable));
-        return referenceType.back().get();
+    return referenceType.getOrCreate({type, nullable}, [&] {
+      auto created = std::make_unique<ReferenceType>(type, nullable);
+      assignID(created.get());
+      return created;
+    });
+}
+
+void TypeContext::assignID(Type *type) {
+    uint8_t flags = 0;
+    auto operand = TypeID::Invalid;
+    std::vector<TypeID> params;
+    if (type->isReferenceType()) flags |= TypeInfoTable::Reference;
+    if (isa<ReferenceableType>(type)) flags |= TypeInfoTable::Referenceable;
+    if (isa<CompositeType>(type)) flags |= TypeInfoTable::Composite;
+    if (auto array = dyn_cast<ArrayType>(type)) {
+        operand = array->getElementType()->getID();
+    } else if (auto func = dyn_cast<FunctionType>(type)) {
+        operand = func->getReturnType()->getID();
+        for (auto param: func->getParamTypes()) params.push_back(param->getID());
+    } else if (auto member = dyn_cast<MemberAttrType>(type)) {
+        operand = member->getMemberAttrType()->getID();
+    } else if (auto ref = dyn_cast<ReferenceType>(type)) {
+        if (ref->isNullable()) flags |= TypeInfoTable::Nullable;
+        if (ref->getRefType()) operand = ref->getRefType()->getID();
     }
-    return res->get();
+    type->id = typeInfo.append(type, flags, operand, params);
+}
+
+void TypeContext::buildHierarchy() {
+    std::vector<ClassType *> classes;
+    std::vector<InterfaceType *> interfaces;
+    classType.forEach([&](ClassType *klass) { classes.push_back(klass); });
+    interfaceType.forEach([&](InterfaceType *interface) { interfaces.push_back(interface); });
+    hierarchy = TypeHierarchy(classes, interfaces, getTypeCount());
+    for (auto klass: classes) klass->hierarchy = &hierarchy;
+    for (auto interface: interfaces) interface->hierarchy = &hierarchy;
+}
+
+void TypeContext::buildTraits() {
+    interfaceType.forEach([](InterfaceType *interface) { interface->getInterfaceTraits(); });
+    classType.forEach([](ClassType *klass) {
+      klass->getClassImplTraits();
+      klass->getRequiredTraits();
+    });
+}
+
+bool TypeContext::isIndexed(const CompositeType *type, const CompositeType *other) const {
+    return !hierarchy.isStale() && hierarchy.contains(type) && hierarchy.contains(other);
+}
+
+bool TypeContext::isDerivedFrom(ClassType *klass, ClassType *base) const {
+    if (isIndexed(klass, base)) return hierarchy.isDerivedFrom(klass, base);
+    return klass->isDerivedFrom(base);
+}
+
+bool TypeContext::isDerivedFrom(InterfaceType *interface, InterfaceType *base) const {
+    if (isIndexed(interface, base)) return hierarchy.isDerivedFrom(interface, base);
+    return interface->isDerivedFrom(base);
+}
+
+bool TypeContext::implements(ClassType *klass, InterfaceType *interface) const {
+    if (isIndexed(klass, interface)) return hierarchy.implements(klass, interface);
+    return klass->implements(interface);
+}
+
+bool TypeContext::FunctionKey::operator==(const FunctionKey &other) const {
+    return returnType == other.returnType && std::ranges::equal(paramTypes, other.paramTypes);
+}
+
+size_t TypeContext::StructuralHash::operator()(const ArrayKey &key) const {
+    return hashCombine(hashCombine(hashPointer(key.elementType), key.size.has_value()), key.size.value_or(0));
+}
+
+size_t TypeContext::StructuralHash::operator()(const FunctionKey &key) const {
+    auto seed = hashCombine(hashPointer(key.returnType), key.paramTypes.size());
+    for (auto param: key.paramTypes) seed = hashCombine(seed, hashPointer(param));
+    return seed;
+}
+
+size_t TypeContext::StructuralHash::operator()(const MemberKey &key) const {
+    auto seed = hashCombine(hashPointer(key.parent), hashPointer(key.type));
+    return hashCombine(seed, static_cast<size_t>(key.visibility));
+}
+
+size_t TypeContext::StructuralHash::operator()(const ReferenceKey &key) const {
+    return hashCombine(hashPointer(key.type), key.nullable);
+}
+
+size_t TypeContext::StructuralHash::operator()(std::string_view name) const {
+    return std::hash<std::string_view>{}(name);
+}
+
+// the keys of stored types refer to their own parameter list and name
+TypeContext::ArrayKey TypeContext::StructuralKey::operator()(const ArrayType *type) const {
+    return {type->getElementType(), type->getSize()};
+}
+
+TypeContext::FunctionKey TypeContext::StructuralKey::operator()(const FunctionType *type) const {
+    return {type->getReturnType(), type->getParamTypes()};
+}
+
+TypeContext::MemberKey TypeContext::StructuralKey::operator()(const MemberAttrType *type) const {
+    return {type->getVisibility(), type->getParent(), type->getMemberAttrType()};
+}
+
+TypeContext::ReferenceKey TypeContext::StructuralKey::operator()(const ReferenceType *type) const {
+    return {type->getRefType(), type->isNullable()};
+}
+
+std::string_view TypeContext::StructuralKey::operator()(const CompositeType *type) const {
+    return type->getDeclName();
 }
 
 void TypeContext::dump(std::ostream &os) {
@@ -105,53 +211,53 @@ void TypeContext::dump(std::ostream &os) {
         os << "  " << builtin->getTypeString() << " " << std::hex << builtin.get() << std::endl;
     }
     os << "ArrayType:" << std::endl;
-    for (const auto &arr: arrayType) {
-        os << "  " << arr->getTypeString() << " " << std::hex << arr.get() << std::endl;
-    }
+    arrayType.forEach([&](const Type *arr) {
+      os << "  " << arr->getTypeString() << " " << std::hex << arr << std::endl;
+    });
     os << "FunctionType:" << std::endl;
-    for (const auto &func: funcType) {
-        os << "  " << func->getTypeString() << " " << std::hex << func.get() << std::endl;
-    }
+    funcType.forEach([&](const Type *func) {
+      os << "  " << func->getTypeString() << " " << std::hex << func << std::endl;
+    });
     os << "ReferenceType:" << std::endl;
-    for (const auto &ref: referenceType) {
-        os << "  " << ref->getTypeString() << " " << std::hex << ref.get() << std::endl;
-    }
+    referenceType.forEach([&](const Type *ref) {
+      os << "  " << ref->getTypeString() << " " << std::hex << ref << std::endl;
+    });
     os << "InterfaceType:" << std::endl;
-    for (const auto &[name, interface]: interfaceType) {
-        os << "  interface " << interface->getTypeString() << " ";
-        if (!interface->getInterfaces().empty()) {
-            os << ": " << interface->getInterfaces()[0]->getTypeString();
-            for (size_t i = 1; i < interface->getInterfaces().size(); ++i) {
-                os << ", " << interface->getInterfaces()[i]->getTypeString();
-            }
-            os << " ";
-        }
-        os << std::hex << interface.get() << ":" << std::endl;
-        for (const auto &[method, type]: interface->getMethods()) {
-            os << "    +" << method << ": " << type->getTypeString() << std::endl;
-        }
-    }
+    interfaceType.forEach([&](InterfaceType *interface) {
+      os << "  interface " << interface->getTypeString() << " ";
+      if (!interface->getInterfaces().empty()) {
+          os << ": " << interface->getInterfaces()[0]->getTypeString();
+          for (size_t i = 1; i < interface->getInterfaces().size(); ++i) {
+              os << ", " << interface->getInterfaces()[i]->getTypeString();
+          }
+          os << " ";
+      }
+      os << std::hex << interface << ":" << std::endl;
+      for (const auto &[method, type]: interface->getMethods()) {
+          os << "    +" << method << ": " << type->getTypeString() << std::endl;
+      }
+    });
     os << "ClassType:" << std::endl;
-    for (const auto &[name, klass]: classType) {
-        os << "  class " << klass->getTypeString() << " ";
-        if (klass->getBaseclass()) {
-            os << "(" << klass->getBaseclass()->getTypeString() << ") ";
-        }
-        if (!klass->getInterfaces().empty()) {
-            os << ": " << klass->getInterfaces()[0];
-            for (size_t i = 1; i < klass->getInterfaces().size(); ++i) {
-                os << ", " << klass->getInterfaces()[i];
-            }
-            os << " ";
-        }
-        os << std::hex << klass.get() << ":" << std::endl;
-        for (const auto &[field, type]: klass->getMembers()) {
-            os << "    -" << field << ": " << type->getTypeString() << std::endl;
-        }
-        for (const auto &[method, type]: klass->getMethods()) {
-            os << "    +" << method << ": " << type->getTypeString() << std::endl;
-        }
-    }
+    classType.forEach([&](ClassType *klass) {
+      os << "  class " << klass->getTypeString() << " ";
+      if (klass->getBaseclass()) {
+          os << "(" << klass->getBaseclass()->getTypeString() << ") ";
+      }
+      if (!klass->getInterfaces().empty()) {
+          os << ": " << klass->getInterfaces()[0];
+          for (size_t i = 1; i < klass->getInterfaces().size(); ++i) {
+              os << ", " << klass->getInterfaces()[i];
+          }
+          os << " ";
+      }
+      os << std::hex << klass << ":" << std::endl;
+      for (const auto &[field, type]: klass->getMembers()) {
+          os << "    -" << field << ": " << type->getTypeString() << std::endl;
+      }
+      for (const auto &[method, type]: klass->getMethods()) {
+          os << "    +" << method << ": " << type->getTypeString() << std::endl;
+      }
+    });
 }
 
 }
@@ -6,13 +6,25 @@
 #define REFLEX_SRC_TYPE_TYPECONTEXT_H_
 
 #include "Type.h"
+#include "TypeHierarchy.h"
+#include "TypeInfoTable.h"
+#include "TypeTable.h"
 
+#include <span>
 #include <string>
-#include <unordered_map>
+#include <string_view>
 #include <memory>
 
 namespace reflex {
 
+/// Creates and owns all types, structurally equal types are the same object
+/// - array, function, member and reference types are hash-consed, getting one is a single hashed probe
+///   on its structure instead of a scan over all types of its kind
+/// - class and interface types are identified by name
+/// - all get methods are safe to call from several threads, see TypeTable
+/// - every type gets a dense TypeID, queries on a TypeID are loads from the TypeInfoTable
+/// @note attaching a declaration to an existing class or interface type, and mutating the types
+///       themselves, is left to the single threaded declaration passes
 class TypeContext {
   public:
     TypeContext();
@@ -26,17 +38,95 @@ class TypeContext {
     InterfaceType *getInterfaceType(const std::string &name, AggregateDecl *decl = nullptr);
     ReferenceType *getReferenceType(ReferenceableType *type, bool nullable = true);
 
+    Type *getType(TypeID id) const { return typeInfo.getType(id); }
+    TypeKind getKind(TypeID id) const { return typeInfo.getKind(id); }
+    bool isReferenceType(TypeID id) const { return typeInfo.getFlags(id) & TypeInfoTable::Reference; }
+    /// Looks @p type up by its id, a type not created by a TypeContext has no id and is asked directly
+    bool isReferenceType(const Type *type) const {
+        const auto id = type->getID();
+        return id == TypeID::Invalid ? type->isReferenceType() : isReferenceType(id);
+    }
+    bool isNullable(TypeID id) const { return typeInfo.getFlags(id) & TypeInfoTable::Nullable; }
+    bool isReferenceableType(TypeID id) const { return typeInfo.getFlags(id) & TypeInfoTable::Referenceable; }
+    bool isCompositeType(TypeID id) const { return typeInfo.getFlags(id) & TypeInfoTable::Composite; }
+    /// @returns the element type of an array, the return type of a function, the type a reference
+    ///          refers to or the type of a member, Invalid for other types and the null reference
+    TypeID getOperandType(TypeID id) const { return typeInfo.getOperand(id); }
+    /// @returns the parameter types of a function type, empty for other types
+    std::span<const TypeID> getParamTypes(TypeID id) const { return typeInfo.getParams(id); }
+    [[nodiscard]] size_t getTypeCount() const { return typeInfo.size(); }
+
+    /// Indexes the inheritance of all class and interface types for the subtype queries below
+    /// @note to be called once inheritance is declared, and again whenever it changes
+    void buildHierarchy();
+    /// Computes the traits of every class and interface up front, so later passes only read them
+    /// @note to be called once methods are declared, a change to the hierarchy drops the affected tables
+    void buildTraits();
+    /// Subtype queries, constant time on the types indexed by the last buildHierarchy,
+    /// falling back to walking the hierarchy for types created since and once an indexed type
+    /// gained a baseclass or interface
+    bool isDerivedFrom(ClassType *klass, ClassType *base) const;
+    bool isDerivedFrom(InterfaceType *interface, InterfaceType *base) const;
+    bool implements(ClassType *klass, InterfaceType *interface) const;
+
     void dump(std::ostream &os);
 
   private:
+    /// Records the metadata of the newly created @p type and gives it the next TypeID
+    void assignID(Type *type);
+    /// @returns if both types are covered by an index that is not stale
+    bool isIndexed(const CompositeType *type, const CompositeType *other) const;
+
+    /// Structure of a uniqued type, the keys of stored types refer to the parameter list of the type itself
+    struct ArrayKey {
+      Type *elementType;
+      std::optional<size_t> size;
+      bool operator==(const ArrayKey &) const = default;
+    };
+    struct FunctionKey {
+      Type *returnType;
+      std::span<Type *const> paramTypes;
+      bool operator==(const FunctionKey &other) const;
+    };
+    struct MemberKey {
+      Visibility visibility;
+      CompositeType *parent;
+      Type *type;
+      bool operator==(const MemberKey &) const = default;
+    };
+    struct ReferenceKey {
+      ReferenceableType *type;
+      bool nullable;
+      bool operator==(const ReferenceKey &) const = default;
+    };
+    struct StructuralHash {
+      size_t operator()(const ArrayKey &key) const;
+      size_t operator()(const FunctionKey &key) const;
+      size_t operator()(const MemberKey &key) const;
+      size_t operator()(const ReferenceKey &key) const;
+      size_t operator()(std::string_view name) const;
+    };
+    struct StructuralKey {
+      ArrayKey operator()(const ArrayType *type) const;
+      FunctionKey operator()(const FunctionType *type) const;
+      MemberKey operator()(const MemberAttrType *type) const;
+      ReferenceKey operator()(const ReferenceType *type) const;
+      std::string_view operator()(const CompositeType *type) const;
+    };
+    template<class T, class Key>
+    using Table = TypeTable<T, Key, StructuralKey, StructuralHash>;
+
     std::unique_ptr<VoidType> voidType;
     std::vector<std::unique_ptr<BuiltinType>> builtinType;
-    std::vector<std::unique_ptr<ArrayType>> arrayType;
-    std::vector<std::unique_ptr<FunctionType>> funcType;
-    std::vector<std::unique_ptr<MemberAttrType>> memberType;
-    std::unordered_map<std::string, std::unique_ptr<ClassType>> classType;
-    std::unordered_map<std::string, std::unique_ptr<InterfaceType>> interfaceType;
-    std::vector<std::unique_ptr<ReferenceType>> referenceType;
+    Table<ArrayType, ArrayKey> arrayType;
+    Table<FunctionType, FunctionKey> funcType;
+    Table<MemberAttrType, MemberKey> memberType;
+    Table<ClassType, std::string_view> classType;
+    Table<InterfaceType, std::string_view> interfaceType;
+    Table<ReferenceType, ReferenceKey> referenceType;
+
+    TypeInfoTable typeInfo;
+    TypeHierarchy hierarchy;
 };
 
 }
@@ -0,0 +1,82 @@
+//
+// Created by henry on 2022-06-01.
+//
+
+#include "TypeHierarchy.h"
+
+#include <utility>
+
+namespace reflex {
+
+TypeHierarchy::TypeHierarchy(std::span<ClassType *const> classes,
+                             std::span<InterfaceType *const> interfaces,
+                             size_t typeCount)
+    : rows(typeCount, NotIndexed), intervals(classes.size()), classCount(classes.size()),
+      words((interfaces.size() + 63) / 64) {
+    for (uint32_t row = 0; row < classes.size(); ++row) {
+        rows[static_cast<uint32_t>(classes[row]->getID())] = row;
+    }
+    for (uint32_t row = 0; row < interfaces.size(); ++row) {
+        rows[static_cast<uint32_t>(interfaces[row]->getID())] = classCount + row;
+    }
+    bits.assign((classes.size() + interfaces.size()) * words, 0);
+    auto orRow = [&](uint32_t row, uint32_t from) {
+      for (size_t word = 0; word < words; ++word) bits[row * words + word] |= bits[from * words + word];
+    };
+
+    // interfaces in post order, the bitsets of the interfaces derived from are complete before they are merged
+    std::vector<bool> done(interfaces.size());
+    std::vector<std::pair<uint32_t, size_t>> stack;
+    for (uint32_t start = 0; start < interfaces.size(); ++start) {
+        if (done[start]) continue;
+        stack.emplace_back(start, 0);
+        while (!stack.empty()) {
+            auto [index, next] = stack.back();
+            const auto &bases = interfaces[index]->getInterfaces();
+            if (next < bases.size()) {
+                ++stack.back().second;
+                auto base = rowOf(bases[next]) - classCount;
+                if (!done[base]) stack.emplace_back(base, 0);
+                continue;
+            }
+            const auto row = classCount + index;
+            bits[row * words + index / 64] |= uint64_t{1} << (index % 64);
+            for (auto base: bases) orRow(row, rowOf(base));
+            done[index] = true;
+            stack.pop_back();
+        }
+    }
+
+    // classes in preorder of the baseclass forest, a baseclass is complete before its subclasses
+    std::vector<std::vector<uint32_t>> subclasses(classes.size());
+    std::vector<uint32_t> roots;
+    for (uint32_t row = 0; row < classes.size(); ++row) {
+        if (auto base = classes[row]->getBaseclass()) {
+            subclasses[rowOf(base)].push_back(row);
+        } else {
+            roots.push_back(row);
+        }
+    }
+    uint32_t number = 0;
+    auto enter = [&](uint32_t row) {
+      intervals[row].first = number++;
+      for (auto interface: classes[row]->getInterfaces()) orRow(row, rowOf(interface));
+      if (auto base = classes[row]->getBaseclass()) orRow(row, rowOf(base));
+      stack.emplace_back(row, 0);
+    };
+    for (auto root: roots) {
+        enter(root);
+        while (!stack.empty()) {
+            auto [row, next] = stack.back();
+            if (next < subclasses[row].size()) {
+                ++stack.back().second;
+                enter(subclasses[row][next]);
+                continue;
+            }
+            intervals[row].last = number - 1;
+            stack.pop_back();
+        }
+    }
+}
+
+}
@@ -0,0 +1,82 @@
+//
+// Created by henry on 2022-06-01.
+//
+
+#ifndef REFLEX_SRC_TYPE_TYPEHIERARCHY_H_
+#define REFLEX_SRC_TYPE_TYPEHIERARCHY_H_
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "Type.h"
+
+namespace reflex {
+
+/// Snapshot of the class and interface hierarchies answering subtype queries in constant time
+/// - classes form a forest by their baseclass, each class is numbered in preorder and keeps the last
+///   number of its subtree, a class derives from another iff its number lies in the other's interval
+/// - each class and interface has a bitset over all interfaces, set for every interface it derives from
+///   or implements, including through its baseclass
+/// - types are found by TypeID, a query is a few array loads
+/// @note the index does not follow inheritance added after it was built, a type gaining a baseclass or
+///       interface marks it stale until it is rebuilt
+class TypeHierarchy {
+  public:
+    TypeHierarchy() = default;
+
+    /// Indexes @p classes and @p interfaces, the baseclass and interfaces of each must be among them
+    /// @param typeCount one past the largest TypeID of the indexed types
+    TypeHierarchy(std::span<ClassType *const> classes, std::span<InterfaceType *const> interfaces, size_t typeCount);
+
+    /// Marks the index out of date, its answers may no longer hold
+    void invalidate() { stale = true; }
+    [[nodiscard]] bool isStale() const { return stale; }
+
+    /// @returns if @p type was indexed
+    bool contains(const CompositeType *type) const {
+        auto id = static_cast<uint32_t>(type->getID());
+        return id < rows.size() && rows[id] != NotIndexed;
+    }
+
+    /// @note both types must be indexed, as for all queries
+    bool isDerivedFrom(const ClassType *klass, const ClassType *base) const {
+        const auto &derived = intervals[rowOf(klass)], &ancestor = intervals[rowOf(base)];
+        return ancestor.first <= derived.first && derived.first <= ancestor.last;
+    }
+    bool isDerivedFrom(const InterfaceType *interface, const InterfaceType *base) const {
+        return hasInterface(rowOf(interface), base);
+    }
+    bool implements(const ClassType *klass, const InterfaceType *interface) const {
+        return hasInterface(rowOf(klass), interface);
+    }
+
+  private:
+    static constexpr uint32_t NotIndexed = UINT32_MAX;
+
+    /// Preorder number of a class and the last preorder number in its subtree
+    struct Interval {
+      uint32_t first;
+      uint32_t last;
+    };
+
+    uint32_t rowOf(const Type *type) const { return rows[static_cast<uint32_t>(type->getID())]; }
+
+    bool hasInterface(uint32_t row, const InterfaceType *interface) const {
+        const auto bit = rowOf(interface) - classCount;
+        return (bits[row * words + bit / 64] >> (bit % 64)) & 1;
+    }
+
+    // row of every indexed type by TypeID, classes come first and interfaces after them
+    std::vector<uint32_t> rows;
+    std::vector<Interval> intervals;
+    // a bitset of words 64-bit words per row, bit i stands for the interface in row classCount + i
+    std::vector<uint64_t> bits;
+    uint32_t classCount = 0;
+    size_t words = 0;
+    bool stale = false;
+};
+
+}
+
+#endif //REFLEX_SRC_TYPE_TYPEHIERARCHY_H_
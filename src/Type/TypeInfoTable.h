@@ -0,0 +1,111 @@
+//
+// Created by henry on 2022-05-31.
+//
+
+#ifndef REFLEX_SRC_TYPE_TYPEINFOTABLE_H_
+#define REFLEX_SRC_TYPE_TYPEINFOTABLE_H_
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <span>
+
+#include "Type.h"
+#include "Utils/Arena.h"
+
+namespace reflex {
+
+/// Append-only column of a TypeInfoTable
+/// - rows live in segments of doubling size, a segment is never moved once allocated
+/// - a row may be read while later rows are appended, by any thread the row's TypeID was handed to
+template<class T>
+class TypeColumn {
+  public:
+    static constexpr unsigned FirstSegmentBits = 8;
+
+    const T &operator[](uint32_t index) const {
+        auto [segment, offset] = locate(index);
+        return segments[segment][offset];
+    }
+
+    /// Stores @p value in row @p index
+    /// @note rows must be set in order, the first row of a segment allocates it
+    void set(uint32_t index, const T &value) {
+        auto [segment, offset] = locate(index);
+        if (offset == 0) segments[segment] = std::make_unique<T[]>(size_t{1} << (segment + FirstSegmentBits));
+        segments[segment][offset] = value;
+    }
+
+  private:
+    /// Segment s holds rows [2^(s+B) - 2^B, 2^(s+B+1) - 2^B) where B is FirstSegmentBits
+    static std::pair<size_t, size_t> locate(uint32_t index) {
+        const auto biased = uint64_t{index} + (uint64_t{1} << FirstSegmentBits);
+        const size_t segment = std::bit_width(biased) - 1 - FirstSegmentBits;
+        return {segment, biased - (uint64_t{1} << (segment + FirstSegmentBits))};
+    }
+
+    std::array<std::unique_ptr<T[]>, 33 - FirstSegmentBits> segments;
+};
+
+/// Metadata of the types of a TypeContext indexed by TypeID, stored as one column per field
+/// - a check on a type loads the one field it needs instead of chasing a Type pointer into a virtual call
+/// - appending is serialized by a mutex, reads never lock
+class TypeInfoTable {
+  public:
+    enum Flags : uint8_t {
+      Reference = 1 << 0,      // a ReferenceType, or a member of one
+      Nullable = 1 << 1,       // a nullable ReferenceType
+      Referenceable = 1 << 2,  // an array, function, interface or class type
+      Composite = 1 << 3,      // an interface or class type
+    };
+
+    /// Records @p type with its @p flags, its @p operand type and the @p params of a function type
+    /// @returns the id of @p type, one past the id returned before
+    TypeID append(Type *type, uint8_t flags, TypeID operand, std::span<const TypeID> params) {
+        std::lock_guard lock(mutex);
+        const auto index = count.load(std::memory_order_relaxed);
+        auto paramStorage = paramArena.allocate<TypeID>(params.size());
+        std::ranges::copy(params, paramStorage);
+        types.set(index, type);
+        kinds.set(index, type->getKind());
+        flagColumn.set(index, flags);
+        operands.set(index, operand);
+        paramColumn.set(index, {paramStorage, params.size()});
+        count.store(index + 1, std::memory_order_release);
+        return static_cast<TypeID>(index);
+    }
+
+    /// @note @p id must have been returned by append, Invalid has no row
+    Type *getType(TypeID id) const { return types[row(id)]; }
+    TypeKind getKind(TypeID id) const { return kinds[row(id)]; }
+    uint8_t getFlags(TypeID id) const { return flagColumn[row(id)]; }
+    TypeID getOperand(TypeID id) const { return operands[row(id)]; }
+    std::span<const TypeID> getParams(TypeID id) const { return paramColumn[row(id)]; }
+    [[nodiscard]] size_t size() const { return count.load(std::memory_order_acquire); }
+
+  private:
+    uint32_t row(TypeID id) const {
+        assert(id != TypeID::Invalid && "type info of a type not created by a TypeContext");
+        assert(static_cast<uint32_t>(id) < size() && "type info of an unknown TypeID");
+        return static_cast<uint32_t>(id);
+    }
+
+    std::mutex mutex;
+    std::atomic<uint32_t> count = 0;
+    BumpArena paramArena;
+
+    TypeColumn<Type *> types;
+    TypeColumn<TypeKind> kinds;
+    TypeColumn<uint8_t> flagColumn;
+    TypeColumn<TypeID> operands;
+    TypeColumn<std::span<const TypeID>> paramColumn;
+};
+
+}
+
+#endif //REFLEX_SRC_TYPE_TYPEINFOTABLE_H_
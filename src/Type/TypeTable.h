@@ -0,0 +1,108 @@
+//
+// Created by henry on 2022-05-30.
+//
+
+#ifndef REFLEX_SRC_TYPE_TYPETABLE_H_
+#define REFLEX_SRC_TYPE_TYPETABLE_H_
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace reflex {
+
+/// Owns the uniqued types of one kind and finds them by structure, safe for concurrent use
+/// - KeyOf maps a type to its Key, Hash hashes a Key, keys are compared with ==
+/// - finding an existing type is lock-free, a probe over the atomic slots of one shard
+/// - creating a type locks only the shard its hash selects, lookups are never blocked
+/// - types are never moved or destroyed before the table, pointer identity is stable
+/// @note the tables a shard grew out of are kept until the table is destroyed, as lock-free
+///       readers may still be probing them
+template<class T, class Key, class KeyOf, class Hash>
+class TypeTable {
+  public:
+    static constexpr size_t ShardCount = 16;
+
+    /// @returns the type with @p key, calling @p create for a std::unique_ptr<T> if there is none
+    /// @note @p create runs under the lock of a shard and must not use this table
+    template<class Create>
+    T *getOrCreate(const Key &key, Create &&create) {
+        const auto hash = Hash{}(key);
+        auto &shard = shards[hash >> (64 - std::countr_zero(ShardCount))];
+        if (auto found = find(shard.table.load(std::memory_order_acquire), key, hash)) return found;
+
+        std::lock_guard lock(shard.mutex);
+        auto table = shard.table.load(std::memory_order_relaxed);
+        if (auto found = find(table, key, hash)) return found;
+        auto type = shard.types.emplace_back(create()).get();
+        if (!table || 2 * shard.types.size() > table->capacity) table = grow(shard);
+        insert(*table, type, hash);
+        return type;
+    }
+
+    /// Calls @p fn on every type, shard by shard in creation order
+    /// @note not safe while types are being created
+    template<class Fn>
+    void forEach(Fn &&fn) const {
+        for (const auto &shard: shards) {
+            for (const auto &type: shard.types) fn(type.get());
+        }
+    }
+
+  private:
+    /// Open addressing with linear probing, a slot is published by storing its type after its hash
+    struct Table {
+      explicit Table(size_t capacity)
+          : capacity(capacity), types(new std::atomic<T *>[capacity]{}), hashes(new std::atomic<size_t>[capacity]{}) {}
+
+      size_t capacity;
+      std::unique_ptr<std::atomic<T *>[]> types;
+      std::unique_ptr<std::atomic<size_t>[]> hashes;
+    };
+
+    struct alignas(64) Shard {
+      std::atomic<Table *> table{nullptr};
+      std::mutex mutex;
+      std::vector<std::unique_ptr<Table>> tables;
+      std::vector<std::unique_ptr<T>> types;
+    };
+
+    static T *find(const Table *table, const Key &key, size_t hash) {
+        if (!table) return nullptr;
+        for (auto slot = hash & (table->capacity - 1);; slot = (slot + 1) & (table->capacity - 1)) {
+            auto type = table->types[slot].load(std::memory_order_acquire);
+            if (!type) return nullptr;
+            if (table->hashes[slot].load(std::memory_order_relaxed) == hash && KeyOf{}(type) == key) return type;
+        }
+    }
+
+    static void insert(Table &table, T *type, size_t hash) {
+        auto slot = hash & (table.capacity - 1);
+        while (table.types[slot].load(std::memory_order_relaxed)) slot = (slot + 1) & (table.capacity - 1);
+        table.hashes[slot].store(hash, std::memory_order_relaxed);
+        table.types[slot].store(type, std::memory_order_release);
+    }
+
+    /// Publishes a table of twice the capacity holding the types of @p shard but the newest one
+    static Table *grow(Shard &shard) {
+        auto old = shard.table.load(std::memory_order_relaxed);
+        auto table = shard.tables.emplace_back(std::make_unique<Table>(old ? 2 * old->capacity : 16)).get();
+        for (size_t slot = 0; old && slot < old->capacity; ++slot) {
+            if (auto type = old->types[slot].load(std::memory_order_relaxed)) {
+                insert(*table, type, old->hashes[slot].load(std::memory_order_relaxed));
+            }
+        }
+        shard.table.store(table, std::memory_order_release);
+        return table;
+    }
+
+    std::array<Shard, ShardCount> shards;
+};
+
+}
+
+#endif //REFLEX_SRC_TYPE_TYPETABLE_H_
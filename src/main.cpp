@@ -18,7 +18,7 @@ int main(int argc, char *argv[]) {
     auto &file = srcManager.open("language_test.reflex");
 
     ASTContext astContext;
-    Lexer lexer(file, file.content(), getTokenDescription(), getKeywordDescription());
+    Lexer lexer(file);
     Parser parser(astContext, lexer);
     try {
         auto astRoot = parser.parseCompilationUnit();
@@ -45,9 +45,12 @@ int main(int argc, char *argv[]) {
         rtti.printLayout(std::cout);
 
     } catch (UnrecoverableError &err) {
-        std::cout << err.getErrorLocation()->getLocationString() << std::endl;
-        err.getErrorLocation()->printSourceRegion(std::cout, true);
+        std::cout << err.getErrorLocation().getLocationString() << std::endl;
+        err.getErrorLocation().printSourceRegion(std::cout, true);
         std::cout << err.getErrorMessage() << std::endl;
+        // the parser keeps going after a syntax error, the first one is reported above
+        auto &errors = parser.getErrors();
+        for (size_t i = 1; i < errors.size(); ++i) errors[i]->printErrorMessage(std::cout);
     }
 
     return 0;
@@ -0,0 +1,106 @@
+//
+// Created by henry on 2022-05-22.
+//
+
+#include "ASTContext.h"
+
+#include <cstdint>
+
+#include "ASTLiteral.h"
+#include "ASTStatement.h"
+#include "gtest/gtest.h"
+
+namespace reflex {
+namespace {
+
+TEST(BumpArenaTest, AllocationsAreAlignedAndDisjoint) {
+    BumpArena arena;
+    auto byte = arena.allocate<char>();
+    auto word = arena.allocate<uint64_t>();
+    auto pair = arena.allocate<long double>(2);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(word) % alignof(uint64_t), 0);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(pair) % alignof(long double), 0);
+    EXPECT_LT(reinterpret_cast<std::byte *>(byte), reinterpret_cast<std::byte *>(word));
+    EXPECT_LE(reinterpret_cast<std::byte *>(word + 1), reinterpret_cast<std::byte *>(pair));
+    EXPECT_EQ(arena.getSlabCount(), 1);
+}
+
+TEST(BumpArenaTest, OversizedAllocationsKeepTheCurrentSlab) {
+    BumpArena arena;
+    auto first = static_cast<std::byte *>(arena.allocate(16, 8));
+    auto large = arena.allocate(BumpArena::InitialSlabSize * 4, 8);
+    auto second = static_cast<std::byte *>(arena.allocate(16, 8));
+    EXPECT_NE(large, nullptr);
+    EXPECT_EQ(second, first + 16);
+    EXPECT_EQ(arena.getSlabCount(), 2);
+    EXPECT_EQ(arena.getBytesAllocated(), 32 + BumpArena::InitialSlabSize * 4);
+}
+
+TEST(BumpArenaTest, SlabsGrowGeometrically) {
+    BumpArena arena;
+    size_t total = 0;
+    while (arena.getSlabCount() < 4) {
+        arena.allocate(1024, 8);
+        total += 1024;
+    }
+    // 64K + 128K + 256K filled before the fourth slab is needed
+    EXPECT_EQ(total, BumpArena::InitialSlabSize * 7 + 1024);
+}
+
+struct Tracked : ASTNode {
+    Tracked(std::vector<int> &log, int id) : ASTNode(ASTKind::EmptyStmt, nullptr), log(log), id(id) {}
+    ~Tracked() override { log.push_back(id); }
+    std::vector<int> &log;
+    int id;
+};
+
+TEST(ASTContextTest, DestroysNodesInReverseCreationOrder) {
+    std::vector<int> log;
+    {
+        ASTContext context;
+        for (int i = 0; i < 3; ++i) context.create<Tracked>(log, i);
+        EXPECT_EQ(context.getNodeCount(), 3);
+        EXPECT_GE(context.getBytesAllocated(), 3 * sizeof(Tracked));
+    }
+    EXPECT_EQ(log, (std::vector<int>{2, 1, 0}));
+}
+
+TEST(ASTContextTest, MovedContextOwnsTheNodes) {
+    std::vector<int> log;
+    {
+        ASTContext context;
+        context.create<Tracked>(log, 0);
+        auto literal = context.create<NumberLiteral>(nullptr, "42");
+        ASTContext moved(std::move(context));
+        EXPECT_TRUE(log.empty());
+        EXPECT_EQ(literal->getLiteral(), "42");
+    }
+    EXPECT_EQ(log, (std::vector<int>{0}));
+}
+
+TEST(ASTContextTest, ShortChildListsAreInline) {
+    ASTContext context;
+    std::vector<Statement *> stmts{context.create<EmptyStmt>(nullptr), context.create<EmptyStmt>(nullptr)};
+    const auto bytes = context.getBytesAllocated();
+    auto list = context.createList<Statement *>(stmts);
+    EXPECT_EQ(context.getBytesAllocated(), bytes);
+    stmts.clear();
+    ASSERT_EQ(list.size(), 2);
+    EXPECT_EQ(list[0]->getKind(), ASTKind::EmptyStmt);
+    EXPECT_TRUE(context.createList<Statement *>(stmts).empty());
+}
+
+TEST(ASTContextTest, LongChildListsAreAllocatedOnceInTheArena) {
+    ASTContext context;
+    std::vector<EmptyStmt *> stmts;
+    for (int i = 0; i < 6; ++i) stmts.push_back(context.create<EmptyStmt>(nullptr));
+    const auto bytes = context.getBytesAllocated();
+    auto list = context.createList<Statement *>(stmts);
+    EXPECT_EQ(context.getBytesAllocated(), bytes + 6 * sizeof(Statement *));
+    auto block = context.create<BlockStmt>(nullptr, list);
+    EXPECT_TRUE(std::ranges::equal(block->getStmts(), stmts));
+    EXPECT_EQ(block->getStmts().data(), list.data());
+}
+
+}
+}
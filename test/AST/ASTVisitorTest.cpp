@@ -0,0 +1,92 @@
+//
+// Created by henry on 2022-05-25.
+//
+
+#include "ASTVisitor.h"
+#include "ASTContext.h"
+
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace reflex {
+namespace {
+
+/// Prints expressions in prefix form, only visits what the tests construct
+class PrefixPrinter : public ASTExprVisitor<PrefixPrinter, std::string>,
+                      public ASTStmtVisitor<PrefixPrinter, size_t> {
+  public:
+    using ASTExprVisitor::visit;
+    using ASTStmtVisitor::visit;
+
+    std::string visit(DeclRefExpr &expr) { return expr.getReferenceName(); }
+    std::string visit(UnaryExpr &expr) { return "(! " + visit(expr.getExpr()) + ")"; }
+    std::string visit(BinaryExpr &expr) { return "(+ " + visit(expr.getLhs()) + " " + visit(expr.getRhs()) + ")"; }
+    std::string visit(NewExpr &) { return "new"; }
+    std::string visit(ImplicitCastExpr &) { return "implicit"; }
+    std::string visit(CastExpr &) { return "cast"; }
+    std::string visit(IndexExpr &) { return "index"; }
+    std::string visit(SelectorExpr &) { return "selector"; }
+    std::string visit(ArgumentExpr &) { return "call"; }
+    std::string visit(NumberLiteral &literal) { return literal.getLiteral(); }
+    std::string visit(StringLiteral &literal) { return literal.getLiteral(); }
+    std::string visit(BooleanLiteral &literal) { return literal.getLiteral(); }
+    std::string visit(NullLiteral &) { return "null"; }
+    std::string visit(ArrayLiteral &) { return "array"; }
+    std::string visit(FunctionLiteral &) { return "lambda"; }
+
+    // statements return the number of expression statements below them
+    size_t visit(BlockStmt &stmt) {
+        size_t count = 0;
+        for (auto nested: stmt.getStmts()) count += visit(nested);
+        return count;
+    }
+    size_t visit(ExpressionStmt &stmt) {
+        printed.push_back(visit(stmt.getExpr()));
+        return 1;
+    }
+    size_t visit(ReturnStmt &) { return 0; }
+    size_t visit(BreakStmt &) { return 0; }
+    size_t visit(ContinueStmt &) { return 0; }
+    size_t visit(IfStmt &) { return 0; }
+    size_t visit(ForStmt &) { return 0; }
+    size_t visit(WhileStmt &) { return 0; }
+    size_t visit(EmptyStmt &) { return 0; }
+    size_t visit(AssignmentStmt &) { return 0; }
+    size_t visit(IncDecStmt &) { return 0; }
+    size_t visit(DeclStmt &) { return 0; }
+
+    std::vector<std::string> printed;
+};
+
+TEST(ASTVisitorTest, DispatchesOnKindWithTypedResults) {
+    ASTContext context;
+    auto one = context.create<NumberLiteral>(nullptr, "1");
+    auto x = context.create<Identifier>(nullptr, nullptr, Symbol("x"));
+    auto sum = context.create<BinaryExpr>(nullptr, Operator::BinaryOperator::Add, one, x);
+    auto negated = context.create<UnaryExpr>(nullptr, Operator::UnaryOperator::LogicalNot, sum);
+
+    PrefixPrinter printer;
+    Expression *root = negated;
+    EXPECT_EQ(printer.visit(root), "(! (+ 1 x))");
+
+    std::vector<Statement *> stmts{
+        context.create<ExpressionStmt>(nullptr, negated),
+        context.create<EmptyStmt>(nullptr),
+        context.create<ExpressionStmt>(nullptr, x),
+    };
+    Statement *block = context.create<BlockStmt>(nullptr, context.createList<Statement *>(stmts));
+    EXPECT_EQ(printer.visit(block), 2);
+    EXPECT_EQ(printer.printed, (std::vector<std::string>{"(! (+ 1 x))", "x"}));
+}
+
+TEST(ASTVisitorTest, ModuleSelectorFallsBackToDeclRefExpr) {
+    ASTContext context;
+    auto child = context.create<Identifier>(nullptr, nullptr, Symbol("y"));
+    Expression *selector = context.create<ModuleSelector>(nullptr, nullptr, Symbol("m"), child);
+    PrefixPrinter printer;
+    EXPECT_EQ(printer.visit(selector), cast<DeclRefExpr>(selector)->getReferenceName());
+}
+
+}
+}
@@ -0,0 +1,76 @@
+//
+// Created by henry on 2022-05-24.
+//
+
+#include "ASTContext.h"
+#include "ASTExpression.h"
+#include "ASTLiteral.h"
+#include "ASTStatement.h"
+#include "ASTType.h"
+#include "TypeContext.h"
+
+#include "gtest/gtest.h"
+
+namespace reflex {
+namespace {
+
+TEST(CastingTest, ASTKindRanges) {
+    ASTContext context;
+    ASTNode *number = context.create<NumberLiteral>(nullptr, "1");
+    ASTNode *index = context.create<IndexExpr>(nullptr, static_cast<Expression *>(number), static_cast<Expression *>(number));
+    ASTNode *stmt = context.create<BreakStmt>(nullptr);
+    ASTNode *type = context.create<BaseTypenameExpr>(nullptr, Symbol{});
+
+    EXPECT_EQ(number->getKind(), ASTKind::NumberLiteral);
+    EXPECT_TRUE(isa<BasicLiteral>(number));
+    EXPECT_TRUE(isa<Literal>(number));
+    EXPECT_TRUE(isa<Expression>(number));
+    EXPECT_FALSE(isa<Statement>(number));
+
+    EXPECT_TRUE(isa<Expression>(index));
+    EXPECT_FALSE(isa<Literal>(index));
+    EXPECT_FALSE(isa<DeclRefExpr>(index));
+
+    EXPECT_TRUE(isa<Statement>(stmt));
+    EXPECT_FALSE(isa<SimpleStmt>(stmt));
+    EXPECT_FALSE(isa<Expression>(stmt));
+
+    EXPECT_TRUE(isa<ReferenceTypenameExpr>(type));
+    EXPECT_TRUE(isa<ASTTypeExpr>(type));
+    EXPECT_FALSE(isa<ArrayTypeExpr>(type));
+    EXPECT_FALSE(isa<Expression>(type));
+}
+
+TEST(CastingTest, DynCastIsNullSafe) {
+    ASTContext context;
+    ASTNode *boolean = context.create<BooleanLiteral>(nullptr, "true");
+    ASTNode *null = nullptr;
+
+    EXPECT_EQ(dyn_cast<BooleanLiteral>(boolean), boolean);
+    EXPECT_EQ(dyn_cast<NullLiteral>(boolean), nullptr);
+    EXPECT_EQ(dyn_cast<Expression>(null), nullptr);
+    EXPECT_FALSE(isa<Expression>(null));
+
+    const ASTNode *constant = boolean;
+    const BooleanLiteral *literal = cast<BooleanLiteral>(constant);
+    EXPECT_EQ(literal, boolean);
+}
+
+TEST(CastingTest, TypeKinds) {
+    TypeContext context;
+    Type *integer = context.getBuiltinType(BuiltinType::Integer);
+    Type *array = context.getArrayType(context.getBuiltinType(BuiltinType::Integer));
+    Type *reference = context.getReferenceType(cast<ArrayType>(array));
+
+    EXPECT_TRUE(isa<BuiltinType>(integer));
+    EXPECT_FALSE(isa<ReferenceableType>(integer));
+    EXPECT_TRUE(isa<ReferenceableType>(array));
+    EXPECT_FALSE(isa<CompositeType>(array));
+    EXPECT_TRUE(isa<ReferenceType>(reference));
+    EXPECT_EQ(cast<ReferenceType>(reference)->getRefType(), array);
+    EXPECT_EQ(dyn_cast<ClassType>(array), nullptr);
+    EXPECT_TRUE(isa<VoidType>(context.getVoidType()));
+}
+
+}
+}
@@ -0,0 +1,153 @@
+//
+// Created by henry on 2022-05-23.
+//
+
+#include "FlatAST.h"
+
+#include <algorithm>
+#include <sstream>
+
+#include "ASTContext.h"
+#include "ASTDeclaration.h"
+#include "AstPrinter.h"
+#include "FlatAstPrinter.h"
+#include "Lexer.h"
+#include "Operator.h"
+#include "Parser.h"
+#include "SourceManager.h"
+#include "gtest/gtest.h"
+
+namespace reflex {
+namespace {
+
+class FlatASTTest : public ::testing::Test {
+  protected:
+    FlatAST lower(const std::string &source) {
+        std::istringstream stream(source);
+        file = std::make_unique<SourceFile>("FlatASTTest", stream);
+        Lexer lexer(*file);
+        Parser parser(context, lexer);
+        unit = parser.parseCompilationUnit();
+        return FlatAST(*unit);
+    }
+
+    std::unique_ptr<SourceFile> file;
+    ASTContext context;
+    CompilationUnit *unit = nullptr;
+};
+
+const std::string Program = R"(
+interface Shape {
+    public func area() -> num;
+}
+
+class Square : Shape {
+    public var side: num;
+    public func area() -> num {
+        return side * side;
+    }
+}
+
+var count: int = 0;
+
+func main(argc: int, argv: char[]) -> int {
+    var square: Square = new Square;
+    while (count < argc) {
+        count = count + 1;
+        print(argv[count], cast<int>(square.area()));
+    }
+    if (count == 0) {
+        count++;
+    }
+    return -count;
+}
+)";
+
+TEST_F(FlatASTTest, IdsArePreorder) {
+    auto ast = lower(Program);
+    std::vector<FlatAST::NodeID> stack{ast.getRoot()}, children;
+    FlatAST::NodeID expected = ast.getRoot();
+    while (!stack.empty()) {
+        auto node = stack.back();
+        stack.pop_back();
+        EXPECT_EQ(node, expected++) << getFlatKindString(ast.getKind(node));
+        children.clear();
+        ast.getChildren(node, children);
+        stack.insert(stack.end(), children.rbegin(), children.rend());
+    }
+    EXPECT_EQ(expected, ast.size());
+}
+
+TEST_F(FlatASTTest, EveryNodeIsLowered) {
+    auto ast = lower(Program);
+    EXPECT_EQ(ast.getKind(FlatAST::NullNode), FlatKind::Null);
+    EXPECT_EQ(ast.getKind(ast.getRoot()), FlatKind::CompilationUnit);
+    // the parser may allocate nodes that do not end up in the tree
+    EXPECT_LE(ast.size(), context.getNodeCount() + 1);
+}
+
+TEST_F(FlatASTTest, DeclarationsKeepTheirOperands) {
+    auto ast = lower(Program);
+    auto decls = ast.getList(ast.getOperands(ast.getRoot()).rhs);
+    ASSERT_EQ(decls.size(), 4);
+    EXPECT_EQ(ast.getKind(decls[0]), FlatKind::InterfaceDecl);
+    EXPECT_EQ(ast.getKind(decls[1]), FlatKind::ClassDecl);
+    EXPECT_EQ(ast.getKind(decls[2]), FlatKind::VariableDecl);
+    EXPECT_EQ(ast.getKind(decls[3]), FlatKind::FunctionDecl);
+
+    auto square = decls[1];
+    EXPECT_EQ(ast.getSymbol(square).str(), "Square");
+    auto record = ast.getOperands(square).rhs;
+    EXPECT_EQ(ast.getExtra(record), FlatAST::NullNode);
+    auto interfaces = ast.getList(ast.getExtra(record + 1));
+    ASSERT_EQ(interfaces.size(), 1);
+    EXPECT_EQ(ast.getSymbol(interfaces[0]).str(), "Shape");
+    auto members = ast.getList(record + 2);
+    ASSERT_EQ(members.size(), 2);
+    EXPECT_EQ(ast.getKind(members[0]), FlatKind::FieldDecl);
+    EXPECT_EQ(ast.getKind(members[1]), FlatKind::MethodDecl);
+
+    auto global = decls[2];
+    EXPECT_EQ(ast.getOperator(global), 1);
+    auto initializer = ast.getExtra(ast.getOperands(global).rhs + 1);
+    EXPECT_EQ(ast.getKind(initializer), FlatKind::NumberLiteral);
+    EXPECT_EQ(ast.getSymbol(initializer).str(), "0");
+
+    auto main = decls[3];
+    auto params = ast.getList(ast.getOperands(main).rhs + 2);
+    ASSERT_EQ(params.size(), 2);
+    EXPECT_EQ(ast.getSymbol(params[1]).str(), "argv");
+    EXPECT_EQ(ast.getKind(ast.getExtra(ast.getOperands(params[1]).rhs)), FlatKind::ArrayTypeExpr);
+}
+
+TEST_F(FlatASTTest, ExpressionsKeepOperatorsAndLocations) {
+    auto ast = lower(Program);
+    size_t binaries = 0;
+    for (FlatAST::NodeID node = 0; node < ast.size(); ++node) {
+        if (ast.getKind(node) != FlatKind::BinaryExpr) continue;
+        ++binaries;
+        auto [lhs, rhs] = ast.getOperands(node);
+        EXPECT_LT(node, lhs);
+        EXPECT_LT(lhs, rhs);
+        // a binary expression is located at its operator
+        EXPECT_LT(ast.getLocation(lhs).getBegin(), ast.getLocation(node).getBegin());
+        EXPECT_LT(ast.getLocation(node).getBegin(), ast.getLocation(rhs).getBegin());
+    }
+    EXPECT_EQ(binaries, 4);
+
+    EXPECT_EQ(std::ranges::count(ast.getKinds(), FlatKind::ArgumentExpr), 2);
+}
+
+TEST_F(FlatASTTest, PrintsLikeThePointerAST) {
+    SourceManager srcManager;
+    for (std::string_view source: {std::string_view(Program), srcManager.open("TestFiles/ScopeTest.reflex.test").content()}) {
+        auto ast = lower(std::string(source));
+        std::ostringstream pointerOutput, flatOutput;
+        AstPrinter(pointerOutput).visit(*unit);
+        FlatAstPrinter(flatOutput, ast).print();
+        EXPECT_EQ(flatOutput.str(), pointerOutput.str());
+    }
+}
+
+}
+}
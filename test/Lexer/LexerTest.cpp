@@ -0,0 +1,243 @@
+//
+// Created by henry on 2022-05-14.
+//
+
+#include "Lexer.h"
+#include "TokenBuffer.h"
+#include "RegexLexer.h"
+#include "ScannerTable.h"
+#include "KeywordTable.h"
+#include "SourceManager.h"
+
+#include <optional>
+#include <random>
+#include <sstream>
+
+#include "gtest/gtest.h"
+
+namespace reflex {
+namespace {
+
+std::string describe(const Token &token) {
+    return token.getTokenType().getTypeString() + " '" + std::string(token.getLexeme()) + "' "
+        + token.getLocInfo().getStringRepr() + " #" + token.getSymbol().str();
+}
+
+template<class LexerImpl, class... Args>
+std::vector<std::string> tokenize(const std::string &input, const Args &...args) {
+    std::istringstream stream(input);
+    SourceFile file("LexerTest", stream);
+    LexerImpl lexer(file, args...);
+    std::vector<std::string> tokens;
+    try {
+        while (true) {
+            auto token = lexer.nextToken();
+            tokens.push_back(describe(token));
+            if (token.getTokenType().getValue() == TokenType::EndOfFile) break;
+        }
+    } catch (std::exception &err) {
+        tokens.emplace_back(err.what());
+    }
+    return tokens;
+}
+
+void expectSameAsOracle(const std::string &input) {
+    EXPECT_EQ(tokenize<Lexer>(input), tokenize<RegexLexer>(input)) << "input: " << input;
+}
+
+TEST(LexerTest, ScannerTableMatchesLongestToken) {
+    TokenType::Value type;
+    EXPECT_EQ(Scanner.match("->x", type), 2);
+    EXPECT_EQ(type, TokenType::ReturnArrow);
+    EXPECT_EQ(Scanner.match("::x", type), 2);
+    EXPECT_EQ(type, TokenType::NameSeparator);
+    EXPECT_EQ(Scanner.match("12.5.", type), 4);
+    EXPECT_EQ(type, TokenType::NumberLiteral);
+    EXPECT_EQ(Scanner.match("1.x", type), 1);
+    EXPECT_EQ(type, TokenType::NumberLiteral);
+    EXPECT_EQ(Scanner.match(".5", type), 1);
+    EXPECT_EQ(type, TokenType::Period);
+    EXPECT_EQ(Scanner.match("/* a */ b */", type), 7);
+    EXPECT_EQ(type, TokenType::MultiComment);
+    EXPECT_EQ(Scanner.match("/* a", type), 1);
+    EXPECT_EQ(type, TokenType::Div);
+    EXPECT_EQ(Scanner.match("#", type), 0);
+}
+
+TEST(LexerTest, KeywordTableClassifiesKeywords) {
+    for (const auto &[keyword, type]: KeywordList) {
+        EXPECT_EQ(Keywords.classify(keyword), type) << keyword;
+    }
+    for (const auto ident: {"constant", "va", "x", "interfaces", "Class", "iff", "e", "_for", "null0"}) {
+        EXPECT_EQ(Keywords.classify(ident), TokenType::Identifier) << ident;
+    }
+}
+
+TEST(LexerTest, MatchesOracleOnProgram) {
+    expectSameAsOracle(
+        "class Point : Base, IA {\n"
+        "    public var x: num;\n"
+        "    public func __init__(x: int, y: int) -> Point {\n"
+        "        this.x = x; // assign\n"
+        "        /* multi\n"
+        " line */ var arr: int[] = {1, 2, 3.14, 0.5};\n"
+        "        for (var i: int = 0; i < 10; i++) { i += 1; i -= 1; }\n"
+        "        while (!a && b || c != d and e or f) { break; continue; }\n"
+        "        if (a <= b >= c == d) { return cast<int>(a % b); } else {}\n"
+        "        var s: char[] = \"string\nliteral\";\n"
+        "        @annotation ~x lib::std::io;\n"
+        "    }\n"
+        "}\n"
+    );
+}
+
+TEST(LexerTest, MatchesOracleOnEdgeCases) {
+    expectSameAsOracle("1.2.3 1. .5 a.b 12abc a1_b2");
+    expectSameAsOracle("-->--=->-<=>=<>::::");
+    expectSameAsOracle("/* unterminated");
+    expectSameAsOracle("/*/ a */ /**/ /***/");
+    expectSameAsOracle("// comment\r\nx");
+    expectSameAsOracle("\"unterminated");
+    expectSameAsOracle("x # y");
+    expectSameAsOracle("truefalse true false null if else");
+    expectSameAsOracle("");
+}
+
+TEST(LexerTest, MatchesOracleOnRandomInput) {
+    const std::string alphabet = " \t\n\rab_Z09.:;,~=!<>+-*/%|&@[](){}\"";
+    std::mt19937 rng(20220514);
+    std::uniform_int_distribution<size_t> pick(0, alphabet.size() - 1);
+    for (size_t i = 0; i < 300; ++i) {
+        std::string input;
+        for (size_t j = 0; j < 40; ++j) input += alphabet[pick(rng)];
+        expectSameAsOracle(input);
+    }
+}
+
+TEST(LexerTest, SkipsTrivia) {
+    const std::string input = "var x /* block\n comment */ = 1; // line\n  \t\n x // end";
+    auto expected = tokenize<Lexer>(input);
+    std::erase_if(expected, [](const std::string &token) {
+        return token.starts_with("WHITESPACE") || token.starts_with("SINGLE_COMMENT")
+            || token.starts_with("MULTI_COMMENT");
+    });
+
+    std::istringstream stream(input);
+    SourceFile file("LexerTest", stream);
+    Lexer lexer(file);
+    std::vector<CommentRange> comments;
+    lexer.setSkipTrivia(true);
+    lexer.setCommentSink(&comments);
+    std::vector<std::string> tokens;
+    while (true) {
+        auto token = lexer.nextToken();
+        tokens.push_back(describe(token));
+        if (token.getTokenType().getValue() == TokenType::EndOfFile) break;
+    }
+    EXPECT_EQ(tokens, expected);
+
+    std::vector<std::string_view> commentText;
+    for (auto [begin, end]: comments) commentText.push_back(file.content().substr(begin, end - begin));
+    EXPECT_EQ(commentText, (std::vector<std::string_view>{"/* block\n comment */", "// line", "// end"}));
+}
+
+TEST(LexerTest, TokenBufferMatchesTriviaSkippingLexer) {
+    const std::string input = "class A { /* c */ var x: int = 1; // end\n func f() -> A { return x.y; } }";
+    std::istringstream expectedStream(input);
+    SourceFile expectedFile("LexerTest", expectedStream);
+    Lexer expectedLexer(expectedFile);
+    expectedLexer.setSkipTrivia(true);
+
+    std::istringstream stream(input);
+    SourceFile file("LexerTest", stream);
+    Lexer lexer(file);
+    TokenBuffer tokens(lexer);
+    for (size_t i = 0; i < tokens.size(); ++i) {
+        auto expected = expectedLexer.nextToken();
+        EXPECT_EQ(describe(tokens.getToken(i)), describe(expected)) << i;
+        EXPECT_EQ(tokens.getKind(i), expected.getTokenType().getValue());
+    }
+    EXPECT_EQ(tokens.getKind(tokens.size() - 1), TokenType::EndOfFile);
+    EXPECT_EQ(tokens.getKind(tokens.size() + 10), TokenType::EndOfFile);
+    EXPECT_EQ(tokens.getLexeme(tokens.size()), "EOF");
+    EXPECT_EQ(tokens.getSymbol(1).str(), "A");
+}
+
+std::string generateLargeInput(size_t bytes, unsigned seed) {
+    const std::vector<std::string> pieces{
+        "class A {\n", "  var x: int = 1;\n", "\"string\nwith // newline /* inside\"", "// comment \" quote\n",
+        "/* block\n \" comment\n */", "x / y;\n", "\n\n", "f(a, b);\r\n", "}\n", "/**/", "//\n"
+    };
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<size_t> pick(0, pieces.size() - 1);
+    std::string input;
+    while (input.size() < bytes) input += pieces[pick(rng)];
+    return input;
+}
+
+void expectParallelSameAsSequential(const std::string &input, size_t threads) {
+    std::istringstream stream(input);
+    SourceFile file("LexerTest", stream);
+    Lexer lexer(file);
+    std::string expectedError, actualError;
+    std::optional<TokenBuffer> expected, actual;
+    try { expected.emplace(lexer); } catch (LexerError &err) { expectedError = err.what(); }
+    try { actual.emplace(file, threads); } catch (LexerError &err) { actualError = err.what(); }
+
+    EXPECT_EQ(actualError, expectedError);
+    ASSERT_EQ(actual.has_value(), expected.has_value());
+    if (!expected) return;
+    ASSERT_EQ(actual->size(), expected->size());
+    for (size_t i = 0; i < expected->size(); ++i) {
+        ASSERT_EQ(actual->getKind(i), expected->getKind(i)) << i;
+        ASSERT_EQ(actual->getLocation(i), expected->getLocation(i)) << i;
+        ASSERT_EQ(actual->getSymbol(i), expected->getSymbol(i)) << i;
+    }
+}
+
+TEST(LexerTest, SplitPointsAreOutsideStringsAndComments) {
+    const auto input = generateLargeInput(1 << 20, 20220521);
+    const auto splits = TokenBuffer::findSplitPoints(input, 8);
+    EXPECT_GE(splits.size(), 6);
+    size_t last = 0;
+    for (auto split: splits) {
+        EXPECT_GT(split, last);
+        EXPECT_EQ(input[split - 1], '\n');
+        last = split;
+    }
+    EXPECT_TRUE(TokenBuffer::findSplitPoints("\"unterminated\n\n\n\n", 4).empty());
+    EXPECT_TRUE(TokenBuffer::findSplitPoints("/* unterminated\n\n\n\n", 4).empty());
+}
+
+TEST(LexerTest, ParallelLexingMatchesSequential) {
+    for (size_t threads: {1, 2, 3, 8}) {
+        expectParallelSameAsSequential(generateLargeInput(2 << 20, threads), threads);
+    }
+    auto withError = generateLargeInput(2 << 20, 4);
+    withError.insert(withError.size() * 3 / 4, "# first error");
+    withError.insert(withError.size() * 7 / 8, "# second error");
+    expectParallelSameAsSequential(withError, 8);
+    expectParallelSameAsSequential(generateLargeInput(2 << 20, 5) + "/* unterminated", 8);
+}
+
+TEST(LexerTest, MatchesOracleOnLongRunsWithEveryScanKernel) {
+    const std::vector<std::string> pieces{
+        "    ", "\t\t", "\n", "\r\n", "identifier_", "Z09", "// line comment", "/* block", "**", "*/", "/",
+        "\"", "1.5", ";", "*", "(", "=="
+    };
+    std::mt19937 rng(20220517);
+    std::uniform_int_distribution<size_t> pick(0, pieces.size() - 1);
+    for (size_t i = 0; i < 100; ++i) {
+        std::string input;
+        while (input.size() < 400) input += pieces[pick(rng)];
+        const auto expected = tokenize<RegexLexer>(input);
+        for (auto isa: {ScanISA::Scalar, ScanISA::SSE42, ScanISA::AVX2}) {
+            if (!ScanKernels::isSupported(isa)) continue;
+            EXPECT_EQ(tokenize<Lexer>(input, ScanKernels::get(isa)), expected)
+                << getScanISAString(isa) << " input: " << input;
+        }
+    }
+}
+
+}
+}
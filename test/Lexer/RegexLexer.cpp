@@ -0,0 +1,80 @@
+//
+// Created by henry on 2022-05-14.
+//
+
+#include "RegexLexer.h"
+
+#include "Lexer.h"
+#include "SourceManager.h"
+
+namespace reflex {
+
+RegexLexer::RegexLexer(SourceFile &source, const TokenDesc &tokDesc, KeywordDesc keyDesc)
+    : source(source), content(source.content()), state{0, 1, 1}, keywordDesc(std::move(keyDesc)) {
+    for (const auto&[type, regexExpr]: tokDesc) {
+        std::regex parsedRegex{"^(" + regexExpr + ")"};
+        tokenDesc.emplace_back(type, std::move(parsedRegex));
+    }
+}
+
+bool RegexLexer::hasNext() const {
+    return state.index < content.size();
+}
+
+static std::string getErrorTokenLookahead(const std::string &content, size_t lookahead = 20) {
+    size_t end = content.length();
+    return content.substr(0, std::min(end, lookahead));
+}
+
+void RegexLexer::updateInternalState(const std::string &lexeme) {
+    state.index += lexeme.length();
+    for (const char c: lexeme) {
+        if (c == '\n') {
+            state.line += 1;
+            state.col = 1;
+        } else {
+            state.col += 1;
+        }
+    }
+}
+
+RegexLexer::LexerState RegexLexer::getLastValidSourceLoc() {
+    if (state.col == 1) {
+        if (state.line == 1) return {0, 1, 1};
+        return {state.index,
+                state.line - 1,
+                source.line(state.line - 1).size() + 1};
+    }
+    return state;
+}
+
+Token RegexLexer::nextToken() {
+    if (!hasNext())
+        return {TokenType::EndOfFile, "EOF", source.getLastValidPosition()};
+
+    const std::string current = content.substr(state.index);
+
+    for (const auto &[type, regex]: tokenDesc) {
+        std::smatch matches;
+        if (std::regex_search(current, matches, regex)) {
+            auto lexeme = matches[0].str();
+            auto view = std::string_view(content).substr(state.index, lexeme.size());
+            auto lastState = state;
+            updateInternalState(lexeme);
+            auto currState = getLastValidSourceLoc();
+            const auto loc = source.createSourceLocation(
+                lastState.line, lastState.col,
+                currState.line, currState.col - 1
+            );
+            if (type.getValue() == TokenType::Identifier) {
+                auto tokenType = keywordDesc.count(lexeme) ? keywordDesc[lexeme] : type;
+                return {tokenType.getValue(), view, loc, Symbol(view)};
+            }
+            return {type.getValue(), view, loc};
+        }
+    }
+
+    throw LexerError("Unknown Token: " + getErrorTokenLookahead(current) + ".");
+}
+
+}
@@ -0,0 +1,48 @@
+//
+// Created by henry on 2022-05-14.
+//
+
+#ifndef REFLEX_TEST_LEXER_REGEXLEXER_H_
+#define REFLEX_TEST_LEXER_REGEXLEXER_H_
+
+#include <string>
+#include <regex>
+
+#include "Token.h"
+#include "TokenDesc.h"
+
+namespace reflex {
+
+using TokenRegexDesc = std::vector<std::pair<TokenType, std::regex>>;
+
+class SourceFile;
+
+/// Reference lexer matching the regex token description in priority order,
+/// used as the oracle for the table driven Lexer
+class RegexLexer {
+    struct LexerState {
+      size_t index;
+      size_t line;
+      size_t col;
+    };
+  public:
+    explicit RegexLexer(SourceFile &source,
+                        const TokenDesc &tokDesc = getTokenDescription(),
+                        KeywordDesc keyDesc = getKeywordDescription());
+
+    [[nodiscard]] bool hasNext() const;
+    Token nextToken();
+  private:
+    void updateInternalState(const std::string &lexeme);
+    LexerState getLastValidSourceLoc();
+
+    SourceFile &source;
+    std::string content;
+    LexerState state;
+    TokenRegexDesc tokenDesc;
+    KeywordDesc keywordDesc;
+};
+
+}
+
+#endif //REFLEX_TEST_LEXER_REGEXLEXER_H_
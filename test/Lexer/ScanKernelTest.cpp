@@ -0,0 +1,76 @@
+//
+// Created by henry on 2022-05-17.
+//
+
+#include "ScanKernels.h"
+
+#include <random>
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace reflex {
+namespace {
+
+std::string generateBuffer(const std::string &alphabet, size_t length, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<size_t> pick(0, alphabet.size() - 1);
+    std::string buffer;
+    for (size_t i = 0; i < length; ++i) buffer += alphabet[pick(rng)];
+    return buffer;
+}
+
+/// Every kernel of every supported instruction set must agree with the scalar kernels from every offset
+void expectSameAsScalar(const std::string &buffer) {
+    const auto &scalar = ScanKernels::get(ScanISA::Scalar);
+    const char *end = buffer.data() + buffer.size();
+    for (auto isa: {ScanISA::SSE42, ScanISA::AVX2}) {
+        if (!ScanKernels::isSupported(isa)) continue;
+        const auto &kernels = ScanKernels::get(isa);
+        EXPECT_EQ(kernels.isa, isa);
+        for (const char *pos = buffer.data(); pos <= end; ++pos) {
+            const auto offset = pos - buffer.data();
+            EXPECT_EQ(kernels.skipWhitespace(pos, end), scalar.skipWhitespace(pos, end)) << offset;
+            EXPECT_EQ(kernels.findLineEnd(pos, end), scalar.findLineEnd(pos, end)) << offset;
+            EXPECT_EQ(kernels.findBlockCommentEnd(pos, end), scalar.findBlockCommentEnd(pos, end)) << offset;
+            EXPECT_EQ(kernels.skipIdentifier(pos, end), scalar.skipIdentifier(pos, end)) << offset;
+            EXPECT_EQ(kernels.findQuoteOrSlash(pos, end), scalar.findQuoteOrSlash(pos, end)) << offset;
+        }
+    }
+}
+
+TEST(ScanKernelTest, ScalarKernels) {
+    const auto &scalar = ScanKernels::get(ScanISA::Scalar);
+    const std::string input = " \t\v\f\r\nab_Z9 x// c\r\n*/";
+    const char *begin = input.data();
+    const char *end = begin + input.size();
+    EXPECT_EQ(scalar.skipWhitespace(begin, end), begin + 6);
+    EXPECT_EQ(scalar.skipIdentifier(begin + 6, end), begin + 11);
+    EXPECT_EQ(scalar.findLineEnd(begin + 13, end), begin + 17);
+    EXPECT_EQ(scalar.findBlockCommentEnd(begin, end), end);
+    EXPECT_EQ(scalar.findBlockCommentEnd(begin, end - 1), nullptr);
+    EXPECT_EQ(scalar.skipWhitespace(end, end), end);
+}
+
+TEST(ScanKernelTest, BestIsSupported) {
+    EXPECT_TRUE(ScanKernels::isSupported(ScanKernels::best().isa));
+    EXPECT_TRUE(ScanKernels::isSupported(ScanISA::Scalar));
+}
+
+TEST(ScanKernelTest, MatchesScalarOnRandomBuffers) {
+    expectSameAsScalar(generateBuffer(" \t\n\r\v\f", 300, 1));
+    expectSameAsScalar(generateBuffer("aZ_09 \n", 300, 2));
+    expectSameAsScalar(generateBuffer("abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789_", 300, 3));
+    expectSameAsScalar(generateBuffer("*/ ab", 300, 4));
+    expectSameAsScalar(generateBuffer("\"abcdefgh/", 300, 6));
+    expectSameAsScalar(generateBuffer(std::string("\0\x7f\x80\xff`{@[/:", 11) + "aZ", 300, 5));
+}
+
+TEST(ScanKernelTest, MatchesScalarOnLongRuns) {
+    std::string buffer(100, ' ');
+    buffer += std::string(100, 'x') + "\n" + std::string(100, '*') + "/";
+    expectSameAsScalar(buffer);
+}
+
+}
+}
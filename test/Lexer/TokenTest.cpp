@@ -4,6 +4,8 @@
 
 #include "Token.h"
 
+#include "Operator.h"
+#include "TokenDesc.h"
 #include "gtest/gtest.h"
 
 namespace reflex {
@@ -15,5 +17,47 @@ TEST(TokenTest, Construction) {
     EXPECT_EQ(token.getLexeme(), "Identifier");
 }
 
+TEST(TokenTest, TokenInfoMapsEveryOperatorLexeme) {
+    size_t binary = 0, other = 0;
+    auto check = [&](std::string_view lexeme, TokenType::Value type) {
+        Token token{type, lexeme, {}};
+        if (token.isBinaryOp()) {
+            ++binary;
+            EXPECT_EQ(Operator::getBinaryOperator(Operator::createBinaryOperatorFromToken(token)), lexeme);
+        }
+        if (token.isUnaryOp()) {
+            ++other;
+            EXPECT_EQ(Operator::getUnaryOperator(Operator::createUnaryOperatorFromToken(token)), lexeme);
+        }
+        if (token.isAssignment()) {
+            ++other;
+            EXPECT_EQ(Operator::getAssignOperator(Operator::createAssignOperatorFromToken(token)), lexeme);
+        }
+        if (token.isPostfixOp()) {
+            ++other;
+            EXPECT_EQ(Operator::getPostfixOperator(Operator::createPostfixOperatorFromToken(token)), lexeme);
+        }
+    };
+    for (const auto &[lexeme, type]: PunctuatorDesc) check(lexeme, type);
+    for (const auto &[lexeme, type]: KeywordList) check(lexeme, type);
+    EXPECT_EQ(binary, 15);
+    EXPECT_EQ(other, 7);
+    EXPECT_THROW(Operator::createBinaryOperatorFromToken(Token(TokenType::LogicalNot, "!", {})), Operator::InvalidOperator);
+}
+
+TEST(TokenTest, TokenInfoPrecedenceAndClasses) {
+    EXPECT_LT(getTokenInfo(TokenType::Or).prec, getTokenInfo(TokenType::And).prec);
+    EXPECT_LT(getTokenInfo(TokenType::And).prec, getTokenInfo(TokenType::Compare).prec);
+    EXPECT_LT(getTokenInfo(TokenType::Compare).prec, getTokenInfo(TokenType::Add).prec);
+    EXPECT_LT(getTokenInfo(TokenType::Add).prec, getTokenInfo(TokenType::Star).prec);
+    EXPECT_EQ(getTokenInfo(TokenType::Assign).prec, 0);
+    EXPECT_TRUE(getTokenInfo(TokenType::Sub).is(TokenInfo::UnaryOp));
+    EXPECT_TRUE(getTokenInfo(TokenType::Sub).is(TokenInfo::BinaryOp));
+    EXPECT_TRUE(getTokenInfo(TokenType::Annotation).is(TokenInfo::Declaration));
+    EXPECT_TRUE(getTokenInfo(TokenType::MultiComment).is(TokenInfo::Trivial));
+    EXPECT_TRUE(getTokenInfo(TokenType::NullLiteral).is(TokenInfo::BasicLiteral));
+    EXPECT_FALSE(getTokenInfo(TokenType::Identifier).flags);
+}
+
 }
 }
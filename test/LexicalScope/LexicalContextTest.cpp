@@ -46,7 +46,7 @@ TEST_F(LexicalContextTest, CreateCompositeScope) {
         Visibility::Public,
         std::string("TestClass"),
         nullptr,
-        std::vector<ReferenceTypenameExpr *>()
+        ASTList<ReferenceTypenameExpr *>()
     );
     auto [classScope, member] = globalScope->createCompositeScope(classDecl);
 
@@ -67,7 +67,7 @@ TEST_F(LexicalContextTest, CreateCompositeScope) {
 TEST_F(LexicalContextTest, CreateFunctionScope) {
     auto funcDecl = astContext.create<FunctionDecl>(
         nullptr, "TestFunction",
-        std::vector<ParamDecl *>(),
+        ASTList<ParamDecl *>(),
         nullptr, nullptr
     );
     auto [funcScope, member] = globalScope->createFunctionScope(funcDecl);
@@ -89,7 +89,7 @@ TEST_F(LexicalContextTest, CreateFunctionScope) {
 TEST_F(LexicalContextTest, CreateMethodScope) {
     auto methodDecl = astContext.create<MethodDecl>(
         nullptr, "TestMethod",
-        std::vector<ParamDecl *>(),
+        ASTList<ParamDecl *>(),
         nullptr, nullptr, nullptr,
         Visibility::Public
     );
@@ -106,13 +106,13 @@ TEST_F(LexicalContextTest, CreateMethodScope) {
 TEST_F(LexicalContextTest, CreateBlockScope) {
     auto funcDecl = astContext.create<FunctionDecl>(
         nullptr, "TestFunction",
-        std::vector<ParamDecl *>(),
+        ASTList<ParamDecl *>(),
         nullptr, nullptr
     );
     auto [funcScope, member] = globalScope->createFunctionScope(funcDecl);
 
-    auto blockDecl1 = astContext.create<BlockStmt>(nullptr, std::vector<Statement *>());
-    auto blockDecl2 = astContext.create<BlockStmt>(nullptr, std::vector<Statement *>());
+    auto blockDecl1 = astContext.create<BlockStmt>(nullptr, ASTList<Statement *>());
+    auto blockDecl2 = astContext.create<BlockStmt>(nullptr, ASTList<Statement *>());
 
     auto [blockScope1, blockMember1] = funcScope->createBlockScope(blockDecl1);
     auto [blockScope2, blockMember2] = funcScope->createBlockScope(blockDecl2);
@@ -127,13 +127,13 @@ TEST_F(LexicalContextTest, CreateBlockScope) {
 TEST_F(LexicalContextTest, CreateLambdaScope) {
     auto funcDecl = astContext.create<FunctionDecl>(
         nullptr, "TestFunction",
-        std::vector<ParamDecl *>(),
+        ASTList<ParamDecl *>(),
         nullptr, nullptr
     );
     auto [funcScope, member] = globalScope->createFunctionScope(funcDecl);
 
-    auto lambdaDecl1 = astContext.create<FunctionLiteral>(nullptr, std::vector<ParamDecl *>(), nullptr, nullptr);
-    auto lambdaDecl2 = astContext.create<FunctionLiteral>(nullptr, std::vector<ParamDecl *>(), nullptr, nullptr);
+    auto lambdaDecl1 = astContext.create<FunctionLiteral>(nullptr, ASTList<ParamDecl *>(), nullptr, nullptr);
+    auto lambdaDecl2 = astContext.create<FunctionLiteral>(nullptr, ASTList<ParamDecl *>(), nullptr, nullptr);
 
     auto [lambdaScope1, lambdaMember1] = funcScope->createLambdaScope(lambdaDecl1);
     auto [lambdaScope2, lambdaMember2] = funcScope->createLambdaScope(lambdaDecl2);
@@ -148,7 +148,7 @@ TEST_F(LexicalContextTest, CreateLambdaScope) {
 TEST_F(LexicalContextTest, DebugDump) {
     auto funcDecl = astContext.create<FunctionDecl>(
         nullptr, "TestFunction",
-        std::vector<ParamDecl *>(),
+        ASTList<ParamDecl *>(),
         nullptr, nullptr
     );
     auto [funcScope, member] = globalScope->createFunctionScope(funcDecl);
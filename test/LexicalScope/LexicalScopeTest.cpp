@@ -30,8 +30,7 @@ class LexicalScopeTest : public ::testing::Test {
 
     virtual void SetUp() {
         auto &file = srcManager.open("TestFiles/ScopeTest.reflex.test");
-        lexer = std::make_unique<Lexer>(file, file.content(),
-                                        getTokenDescription(), getKeywordDescription());
+        lexer = std::make_unique<Lexer>(file);
         parser = std::make_unique<Parser>(astContext, *lexer);
         root = parser->parseCompilationUnit();
 
@@ -0,0 +1,103 @@
+//
+// Created by henry on 2022-05-27.
+//
+
+#include "Parser.h"
+
+#include "ParsedSource.h"
+#include "gtest/gtest.h"
+
+namespace reflex {
+namespace {
+
+constexpr size_t Depth = 1'000'000;
+
+std::string repeat(std::string_view text, size_t count) {
+    std::string out;
+    out.reserve(text.size() * count);
+    for (size_t i = 0; i < count; ++i) out += text;
+    return out;
+}
+
+// the AST is inspected with loops only since it is far too deep to recurse
+Expression *initializer(const ParsedSource &parsed) {
+    return cast<VariableDecl>(parsed.unit->getDecls()[0])->getInitializer();
+}
+BlockStmt *body(const ParsedSource &parsed) { return cast<FunctionDecl>(parsed.unit->getDecls()[0])->getBody(); }
+
+TEST(DeepNestingTest, Parentheses) {
+    ParsedSource parsed("var a: int = " + repeat("(", Depth) + "1" + repeat(")", Depth) + ";");
+    EXPECT_TRUE(isa<NumberLiteral>(initializer(parsed)));
+}
+
+TEST(DeepNestingTest, UnaryOperators) {
+    ParsedSource parsed("var a: bool = " + repeat("!", Depth) + "b;");
+    size_t depth = 0;
+    auto expr = initializer(parsed);
+    for (; auto unary = dyn_cast<UnaryExpr>(expr); expr = unary->getExpr()) ++depth;
+    EXPECT_EQ(depth, Depth);
+    EXPECT_TRUE(isa<DeclRefExpr>(expr));
+}
+
+TEST(DeepNestingTest, BinaryChains) {
+    ParsedSource left("var a: int = 1" + repeat(" + 1", Depth) + ";");
+    size_t depth = 0;
+    auto expr = initializer(left);
+    for (; auto binary = dyn_cast<BinaryExpr>(expr); expr = binary->getLhs()) ++depth;
+    EXPECT_EQ(depth, Depth);
+
+    ParsedSource right("var a: int = " + repeat("1 + (", Depth) + "1" + repeat(")", Depth) + ";");
+    depth = 0;
+    expr = initializer(right);
+    for (; auto binary = dyn_cast<BinaryExpr>(expr); expr = binary->getRhs()) ++depth;
+    EXPECT_EQ(depth, Depth);
+}
+
+TEST(DeepNestingTest, MixedExpressionFrames) {
+    const char *open[] = {"f(", "a[", "{", "cast<int>(", "(", "-"};
+    const char *close[] = {")", "]", "}", ")", ")", ""};
+    std::string prefix, suffix;
+    for (size_t i = 0; i < Depth; ++i) {
+        prefix += open[i % std::size(open)];
+        suffix += close[(Depth - 1 - i) % std::size(close)];
+    }
+    ParsedSource parsed("var a: int = " + prefix + "x" + suffix + ";");
+
+    size_t nodes = 0;
+    auto expr = initializer(parsed);
+    while (!isa<DeclRefExpr>(expr)) {
+        if (auto call = dyn_cast<ArgumentExpr>(expr)) expr = call->getArguments()[0];
+        else if (auto index = dyn_cast<IndexExpr>(expr)) expr = index->getIndex();
+        else if (auto array = dyn_cast<ArrayLiteral>(expr)) expr = array->getInitList()[0];
+        else if (auto conversion = dyn_cast<CastExpr>(expr)) expr = conversion->getFrom();
+        else expr = cast<UnaryExpr>(expr)->getExpr();
+        ++nodes;
+    }
+    // parentheses do not create nodes
+    EXPECT_EQ(nodes, Depth - Depth / std::size(open));
+}
+
+TEST(DeepNestingTest, Blocks) {
+    ParsedSource parsed("func f() -> void " + repeat("{", Depth) + repeat("}", Depth));
+    size_t depth = 1;
+    for (auto block = body(parsed); !block->getStmts().empty(); block = cast<BlockStmt>(block->getStmts()[0])) ++depth;
+    EXPECT_EQ(depth, Depth);
+}
+
+TEST(DeepNestingTest, IfAndWhileStatements) {
+    ParsedSource parsed("func f() -> void {" + repeat("if (a) { while (b) { ", Depth / 2) + "c = 1;"
+                        + repeat("} }", Depth / 2) + "}");
+    size_t depth = 0;
+    auto block = body(parsed);
+    for (;;) {
+        auto stmt = block->getStmts()[0];
+        if (auto ifStmt = dyn_cast<IfStmt>(stmt)) block = ifStmt->getPrimaryBlock();
+        else if (auto whileStmt = dyn_cast<WhileStmt>(stmt)) block = whileStmt->getBody();
+        else break;
+        ++depth;
+    }
+    EXPECT_EQ(depth, Depth);
+}
+
+}
+}
@@ -0,0 +1,110 @@
+//
+// Created by henry on 2022-05-25.
+//
+
+#include "Parser.h"
+
+#include <sstream>
+
+#include "AstPrinter.h"
+#include "LexicalContext.h"
+#include "LexicalContextDeclTypePass.h"
+#include "LexicalContextForwardPass.h"
+#include "ParsedSource.h"
+#include "SemanticAnalysisPass.h"
+#include "TypeContext.h"
+#include "gtest/gtest.h"
+
+namespace reflex {
+namespace {
+
+const std::string Program = R"(
+class Counter {
+    public var count: int;
+    public func add(step: int) -> int {
+        var next: int = count + step;
+        count = next;
+        return next;
+    }
+}
+
+var total: int = 0;
+
+func apply(counter: Counter, times: int) -> int {
+    while (times > 0) {
+        total = total + counter.add(times * 2);
+        times = times - 1;
+    }
+    if (total < 0) {
+        return 0;
+    }
+    return total;
+}
+
+interface Shape {
+    public func area() -> num;
+}
+)";
+
+/// @returns the printed AST of @p parsed after all semantic passes
+std::string analyze(ParsedSource &parsed) {
+    auto unit = parsed.unit;
+    LexicalContext lexicalContext;
+    TypeContext typeContext;
+    auto global = LexicalContextForwardPass(lexicalContext, typeContext).performPass(unit);
+    LexicalContextDeclTypePass(typeContext).performPass(unit);
+    SemanticAnalysisPass(typeContext, parsed.context, global).visit(*unit);
+    std::ostringstream output;
+    AstPrinter(output).visit(*unit);
+    return output.str();
+}
+
+TEST(DeferredBodyTest, BodiesAreSkippedUntilAccessed) {
+    ParsedSource parsed(Program, true);
+    auto unit = parsed.unit;
+    auto nodes = parsed.context.getNodeCount();
+    auto apply = cast<FunctionDecl>(unit->getDecls()[2]);
+    auto add = cast<ClassDecl>(unit->getDecls()[0])->getMethods()[0];
+    auto area = cast<InterfaceDecl>(unit->getDecls()[3])->getMethods()[0];
+
+    EXPECT_TRUE(apply->hasBody());
+    EXPECT_TRUE(apply->isBodyDeferred());
+    EXPECT_TRUE(add->isBodyDeferred());
+    EXPECT_FALSE(area->hasBody());
+
+    auto body = apply->getBody();
+    ASSERT_NE(body, nullptr);
+    EXPECT_FALSE(apply->isBodyDeferred());
+    EXPECT_EQ(body->getStmts().size(), 3);
+    EXPECT_EQ(apply->getBody(), body);
+    EXPECT_GT(parsed.context.getNodeCount(), nodes);
+    EXPECT_TRUE(add->isBodyDeferred());
+}
+
+TEST(DeferredBodyTest, NestedFunctionLiteralsAreDeferred) {
+    ParsedSource parsed(R"(
+func outer() -> void {
+    var f = func(x: int) -> int {
+        var g = func() -> int { return x; };
+        return x;
+    };
+}
+)", true);
+    auto outer = cast<FunctionDecl>(parsed.unit->getDecls()[0]);
+    auto decl = cast<DeclStmt>(outer->getBody()->getStmts()[0]);
+    auto literal = cast<FunctionLiteral>(cast<VariableDecl>(decl->getDecl())->getInitializer());
+    EXPECT_TRUE(literal->isBodyDeferred());
+    EXPECT_EQ(literal->getBody()->getStmts().size(), 2);
+}
+
+TEST(DeferredBodyTest, UnbalancedBodyIsAnError) {
+    EXPECT_THROW(ParsedSource("func broken() -> void { if (a) { return; }", true), UnrecoverableError);
+}
+
+TEST(DeferredBodyTest, AnalysisMatchesEagerParsing) {
+    ParsedSource deferred(Program, true), eager(Program, false);
+    EXPECT_EQ(analyze(deferred), analyze(eager));
+}
+
+}
+}
@@ -0,0 +1,102 @@
+//
+// Created by henry on 2022-05-28.
+//
+
+#include "Parser.h"
+
+#include <sstream>
+
+#include "ASTContext.h"
+#include "Lexer.h"
+#include "SourceManager.h"
+#include "gtest/gtest.h"
+
+namespace reflex {
+namespace {
+
+/// Parses @p source, which must have syntax errors
+/// @returns the message of every recorded error
+std::vector<std::string> parseErrors(const std::string &source) {
+    std::istringstream stream(source);
+    SourceFile file("ErrorRecoveryTest", stream);
+    Lexer lexer(file);
+    ASTContext context;
+    Parser parser(context, lexer);
+    std::string thrown;
+    try {
+        parser.parseCompilationUnit();
+    } catch (UnrecoverableError &err) {
+        thrown = err.getErrorMessage();
+    }
+    std::vector<std::string> messages;
+    for (auto &error: parser.getErrors()) messages.push_back(error->getMessage());
+    EXPECT_FALSE(messages.empty());
+    if (!messages.empty()) {
+        EXPECT_EQ(thrown, "error: " + messages.front());
+    }
+    return messages;
+}
+
+TEST(ErrorRecoveryTest, StatementsResumeAfterSemicolon) {
+    auto errors = parseErrors(R"(
+func f() -> void {
+    var a: int = (1;
+    a = 2;
+    a = b[1;
+    return a;
+}
+)");
+    EXPECT_EQ(errors, (std::vector<std::string>{
+        "expected RIGHT_PAREN but got SEMICOLON",
+        "expected RIGHT_BRACKET but got SEMICOLON",
+    }));
+}
+
+TEST(ErrorRecoveryTest, BlocksResumeAtClosingBrace) {
+    auto errors = parseErrors(R"(
+func f(a: int) -> void {
+    while (a) {
+        return a
+    }
+    while (a b) { a = 1; }
+    return a;
+}
+var g: int = (2;
+func h() -> void { return 1 }
+)");
+    EXPECT_EQ(errors, (std::vector<std::string>{
+        "expected SEMICOLON but got RIGHT_BRACE",
+        "expected RIGHT_PAREN but got IDENTIFIER",
+        "expected RIGHT_PAREN but got SEMICOLON",
+        "expected SEMICOLON but got RIGHT_BRACE",
+    }));
+}
+
+TEST(ErrorRecoveryTest, MembersResumeWithNextMember) {
+    auto errors = parseErrors(R"(
+class C {
+    public var x: int = (1;
+    hidden var y: int;
+    public var z: int;
+    public func m() -> void { z = ; }
+}
+interface I {
+    public func n() -> void
+    public func o() -> void;
+}
+)");
+    EXPECT_EQ(errors, (std::vector<std::string>{
+        "expected RIGHT_PAREN but got SEMICOLON",
+        "unknown access modifier hidden",
+        "expected FUNC but got SEMICOLON",
+        "expected LEFT_BRACE but got IDENTIFIER",
+    }));
+}
+
+TEST(ErrorRecoveryTest, UnterminatedBodyStopsAtEndOfFile) {
+    auto errors = parseErrors("func f() -> void { if (a) { return a; }");
+    EXPECT_EQ(errors, (std::vector<std::string>{"expected FUNC but got EOF"}));
+}
+
+}
+}
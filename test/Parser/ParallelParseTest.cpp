@@ -0,0 +1,90 @@
+//
+// Created by henry on 2022-05-26.
+//
+
+#include "Parser.h"
+
+#include <sstream>
+
+#include "ASTContext.h"
+#include "AstPrinter.h"
+#include "Lexer.h"
+#include "SourceManager.h"
+#include "gtest/gtest.h"
+
+namespace reflex {
+namespace {
+
+/// Repeats declarations until there are enough tokens for several parser threads
+std::string generateProgram(size_t repeats) {
+    std::ostringstream program;
+    for (size_t i = 0; i < repeats; ++i) {
+        program << "class Node" << i << " {\n"
+                << "    public var value: int;\n"
+                << "    public func get() -> int { if (value > 0) { return value; } return 0; }\n"
+                << "}\n"
+                << "var counter" << i << ": int = " << i << ";\n"
+                << "var callback" << i << " = func(x: int) -> int { return x + " << i << "; };\n"
+                << "func run" << i << "(n: int) -> int { while (n > 0) { n = n - 1; } return n; }\n"
+                << "interface Shape" << i << " { public func area() -> num; }\n";
+    }
+    return program.str();
+}
+
+/// Parses @p source with @p threads threads and prints the AST
+std::string parse(const std::string &source, size_t threads, bool defer = false) {
+    std::istringstream stream(source);
+    SourceFile file("ParallelParseTest", stream);
+    Lexer lexer(file);
+    ASTContext context;
+    Parser parser(context, lexer);
+    parser.setDeferFunctionBodies(defer);
+    auto unit = threads ? parser.parseCompilationUnit(threads) : parser.parseCompilationUnit();
+    std::ostringstream output;
+    AstPrinter(output).visit(*unit);
+    return output.str();
+}
+
+TEST(ParallelParseTest, BoundariesAreTopLevelDeclarations) {
+    std::istringstream stream(R"(
+var f = func() -> int { var g: int = 1; return g; };
+class A { public func m() -> void { } }
+func h() -> void { }
+interface I { public func n() -> void; }
+)");
+    SourceFile file("ParallelParseTest", stream);
+    Lexer lexer(file);
+    TokenBuffer tokens(lexer);
+    std::vector<TokenType::Value> kinds;
+    for (auto boundary: Parser::findDeclBoundaries(tokens)) kinds.push_back(tokens.getKind(boundary));
+    EXPECT_EQ(kinds, (std::vector<TokenType::Value>{TokenType::Class, TokenType::Func, TokenType::Interface}));
+}
+
+TEST(ParallelParseTest, MatchesSequentialParse) {
+    auto program = generateProgram(1500);
+    auto sequential = parse(program, 0);
+    EXPECT_EQ(parse(program, 4), sequential);
+    EXPECT_EQ(parse(program, 1), sequential);
+    EXPECT_EQ(parse(program, 4, true), parse(program, 0, true));
+}
+
+TEST(ParallelParseTest, ErrorsMatchSequentialParse) {
+    auto program = generateProgram(1500);
+    program.insert(program.size() * 3 / 4, "\nfunc broken( -> int { }\n");
+    std::string sequential, parallel;
+    try {
+        parse(program, 0);
+    } catch (UnrecoverableError &error) {
+        sequential = error.getErrorMessage();
+    }
+    try {
+        parse(program, 4);
+    } catch (UnrecoverableError &error) {
+        parallel = error.getErrorMessage();
+    }
+    EXPECT_FALSE(sequential.empty());
+    EXPECT_EQ(parallel, sequential);
+}
+
+}
+}
@@ -0,0 +1,39 @@
+//
+// Created by henry on 2022-05-27.
+//
+
+#ifndef REFLEX_TEST_PARSER_PARSEDSOURCE_H_
+#define REFLEX_TEST_PARSER_PARSEDSOURCE_H_
+
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include "ASTContext.h"
+#include "Lexer.h"
+#include "Parser.h"
+#include "SourceManager.h"
+
+namespace reflex {
+
+/// Keeps the source, context and parser of one parse alive, deferred bodies need all three
+class ParsedSource {
+  public:
+    explicit ParsedSource(const std::string &source, bool deferBodies = false) {
+        std::istringstream stream(source);
+        file = std::make_unique<SourceFile>("ParsedSource", stream);
+        Lexer lexer(*file);
+        parser = std::make_unique<Parser>(context, lexer);
+        parser->setDeferFunctionBodies(deferBodies);
+        unit = parser->parseCompilationUnit();
+    }
+
+    std::unique_ptr<SourceFile> file;
+    ASTContext context;
+    std::unique_ptr<Parser> parser;
+    CompilationUnit *unit;
+};
+
+}
+
+#endif //REFLEX_TEST_PARSER_PARSEDSOURCE_H_
@@ -0,0 +1,75 @@
+//
+// Created by henry on 2022-05-19.
+//
+
+#include "SourceManager.h"
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#include "gtest/gtest.h"
+
+namespace reflex {
+namespace {
+
+std::string writeTempFile(const std::string &name, const std::string &content) {
+    auto path = (std::filesystem::temp_directory_path() / name).string();
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file << content;
+    return path;
+}
+
+/// A mapped file must look exactly like the same content read from a stream
+void expectSameAsStream(const std::string &content) {
+    auto path = writeTempFile("reflex_source_file_test.reflex", content);
+    std::istringstream stream(content);
+    SourceFile expected("stream", stream);
+    SourceFile mapped(path);
+
+    EXPECT_EQ(mapped.content(), expected.content()) << content.size();
+    ASSERT_EQ(mapped.totalLine(), expected.totalLine());
+    for (size_t line = 1; line <= mapped.totalLine(); ++line) {
+        EXPECT_EQ(mapped.line(line), expected.line(line)) << line;
+    }
+    std::filesystem::remove(path);
+}
+
+TEST(SourceFileTest, MappedFileMatchesStream) {
+    expectSameAsStream("");
+    expectSameAsStream("\n");
+    expectSameAsStream("var x;");
+    expectSameAsStream("var x;\n\nfunc f() {\n}\n");
+}
+
+TEST(SourceFileTest, MappedFileAtPageBoundaries) {
+    for (size_t size: {4094, 4095, 4096, 4097, 8192, 65536 + 17}) {
+        std::string content;
+        for (size_t i = 0; content.size() < size; ++i) content += i % 7 ? 'a' : '\n';
+        expectSameAsStream(content);
+        content.back() = '\n';
+        expectSameAsStream(content);
+    }
+}
+
+TEST(SourceFileTest, LineIndex) {
+    std::string content;
+    for (size_t i = 0; i < 100; ++i) content += std::string(i % 19, 'x') + "\n";
+    std::istringstream stream(content);
+    SourceFile file("LineIndex", stream);
+    ASSERT_EQ(file.totalLine(), 101);
+    for (size_t i = 0; i < 100; ++i) EXPECT_EQ(file.line(i + 1), std::string(i % 19, 'x') + "\n");
+    EXPECT_EQ(file.line(101), "\n");
+}
+
+TEST(SourceFileTest, OpenMissingFile) {
+    SourceManager manager;
+    EXPECT_THROW(manager.open("reflex_missing_file.reflex"), SourceError);
+    auto path = writeTempFile("reflex_source_manager_test.reflex", "var x;\n");
+    EXPECT_EQ(manager.open(path).content(), "var x;\n\n");
+    EXPECT_THROW(manager.open(path), SourceError);
+    std::filesystem::remove(path);
+}
+
+}
+}
@@ -0,0 +1,54 @@
+//
+// Created by henry on 2022-05-18.
+//
+
+#include "SourceManager.h"
+
+#include <sstream>
+
+#include "gtest/gtest.h"
+
+namespace reflex {
+namespace {
+
+TEST(SourceLocationTest, ResolvesLineAndColumnLazily) {
+    std::istringstream stream("var x;\n\nfunc f() {\n}");
+    SourceFile file("SourceLocationTest", stream);
+
+    auto loc = file.createSourceLocation(8, 20);
+    EXPECT_EQ(loc.getStartLocation(), std::make_pair(size_t{3}, size_t{1}));
+    EXPECT_EQ(loc.getEndLocation(), std::make_pair(size_t{4}, size_t{1}));
+    EXPECT_EQ(loc.getStringRepr(), "<3:1, 4:1>");
+    EXPECT_EQ(loc.getLocationString(), "SourceLocationTest: <3:1, 4:1>");
+    EXPECT_EQ(&loc.getSource(), &file);
+
+    EXPECT_EQ(file.createSourceLocation(3, 1, 4, 1), loc);
+    EXPECT_EQ(file.getLastValidPosition().getStringRepr(), "<4:2, 4:2>");
+}
+
+TEST(SourceLocationTest, MergeCoversBothLocations) {
+    std::istringstream stream("{ a; b; }");
+    SourceFile file("SourceLocationTest", stream);
+    auto merged = SourceManager::mergeSourceLocation(file.createSourceLocation(8, 9), file.createSourceLocation(0, 1));
+    EXPECT_EQ(merged.getStringRepr(), "<1:1, 1:9>");
+    EXPECT_EQ(SourceManager::mergeSourceLocation(nullptr, merged), merged);
+    EXPECT_EQ(SourceManager::mergeSourceLocation(merged, nullptr), merged);
+}
+
+TEST(SourceLocationTest, InvalidLocations) {
+    SourceLocation none;
+    SourceLocation null = nullptr;
+    EXPECT_FALSE(none);
+    EXPECT_EQ(none, null);
+
+    std::istringstream stream("abc");
+    SourceFile file("SourceLocationTest", stream);
+    EXPECT_TRUE(file.createSourceLocation(0, 3));
+    EXPECT_THROW(static_cast<void>(file.createSourceLocation(2, 1)), InvalidSourceLocationError);
+    EXPECT_THROW(static_cast<void>(file.createSourceLocation(0, 100)), InvalidSourceLocationError);
+    EXPECT_THROW(static_cast<void>(file.createSourceLocation(1, 5, 1, 5)), InvalidSourceLocationError);
+    EXPECT_THROW(static_cast<void>(SourceFile::get(UINT32_MAX)), InvalidSourceLocationError);
+}
+
+}
+}
@@ -0,0 +1,68 @@
+//
+// Created by henry on 2022-05-15.
+//
+
+#include "StringInterner.h"
+
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace reflex {
+namespace {
+
+TEST(StringInternerTest, SameStringSameSymbol) {
+    StringInterner interner;
+    auto a = interner.intern("identifier");
+    auto b = interner.intern(std::string("identifier"));
+    auto c = interner.intern("other");
+    EXPECT_EQ(a, b);
+    EXPECT_NE(a, c);
+    EXPECT_EQ(interner.str(a), "identifier");
+    EXPECT_EQ(interner.str(c), "other");
+    EXPECT_TRUE(interner.intern("").empty());
+}
+
+TEST(StringInternerTest, GlobalSymbolConversion) {
+    Symbol symbol = "TestSymbol";
+    EXPECT_EQ(symbol, Symbol(std::string("TestSymbol")));
+    EXPECT_EQ(symbol.str(), "TestSymbol");
+    EXPECT_TRUE(Symbol().empty());
+    EXPECT_EQ(Symbol().str(), "");
+}
+
+TEST(StringInternerTest, StringsAreStableAcrossGrowth) {
+    StringInterner interner;
+    auto first = interner.intern("first");
+    const auto *firstStr = &interner.str(first);
+    std::vector<Symbol> symbols;
+    for (size_t i = 0; i < 10000; ++i) {
+        symbols.push_back(interner.intern("name" + std::to_string(i)));
+    }
+    EXPECT_EQ(&interner.str(first), firstStr);
+    for (size_t i = 0; i < symbols.size(); ++i) {
+        EXPECT_EQ(interner.str(symbols[i]), "name" + std::to_string(i));
+    }
+}
+
+TEST(StringInternerTest, ConcurrentIntern) {
+    StringInterner interner;
+    constexpr size_t threadCount = 4;
+    constexpr size_t nameCount = 2000;
+    std::vector<std::vector<Symbol>> results(threadCount);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < threadCount; ++t) {
+        threads.emplace_back([&interner, &results, t]() {
+          for (size_t i = 0; i < nameCount; ++i) {
+              results[t].push_back(interner.intern("name" + std::to_string(i)));
+          }
+        });
+    }
+    for (auto &thread: threads) thread.join();
+    for (size_t t = 1; t < threadCount; ++t) EXPECT_EQ(results[t], results[0]);
+    EXPECT_EQ(interner.size(), nameCount + 1);
+}
+
+}
+}
@@ -8,6 +8,8 @@
 #include "TypeContext.h"
 
 #include <memory>
+#include <thread>
+#include <vector>
 
 namespace reflex {
 namespace {
@@ -104,5 +106,55 @@ TEST_F(ClassTypeTest, IsAbstract) {
     EXPECT_FALSE(A->isAbstract());
 }
 
+TEST_F(ClassTypeTest, IsAbstractFollowsChangesToInterfacesAndBaseclasses) {
+    auto IA = typeContext.getInterfaceType("IA");
+    auto IB = typeContext.getInterfaceType("IB");
+    ASSERT_NO_THROW(IB->addInterface(IA));
+    auto A = typeContext.getClassType("A");
+    auto B = typeContext.getClassType("B");
+    ASSERT_NO_THROW(B->setBaseclass(A));
+    B->addInterface(IB);
+    EXPECT_FALSE(B->isAbstract());
+
+    // a method required through the interface hierarchy
+    auto MA = typeContext.getMemberType(Visibility::Public, IA, funcType);
+    ASSERT_NO_THROW(IA->addMethod("method", MA));
+    EXPECT_TRUE(B->isAbstract());
+
+    // implemented by the baseclass
+    ASSERT_NO_THROW(A->addMethod("method", MA));
+    EXPECT_FALSE(B->isAbstract());
+    EXPECT_EQ(B->getClassImplTraits().find("method"), MA);
+}
+
+TEST_F(ClassTypeTest, ConcurrentTraitLookupsShareOneTable) {
+    auto IA = typeContext.getInterfaceType("IA");
+    IA->addMethod("method", typeContext.getMemberType(Visibility::Public, IA, funcType));
+    std::vector<ClassType *> chain{typeContext.getClassType("C0")};
+    for (size_t i = 1; i < 50; ++i) {
+        chain.push_back(typeContext.getClassType("C" + std::to_string(i)));
+        chain[i]->setBaseclass(chain[i - 1]);
+        chain[i]->addInterface(IA);
+    }
+    chain[0]->addMethod("method", typeContext.getMemberType(Visibility::Public, chain[0], funcType));
+
+    // every thread builds the traits of the whole chain, the tables are published once
+    constexpr size_t ThreadCount = 8;
+    std::vector<const TraitTable *> seen(ThreadCount);
+    std::vector<char> abstract(ThreadCount);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < ThreadCount; ++t) {
+        threads.emplace_back([&, t] {
+          abstract[t] = chain.back()->isAbstract();
+          seen[t] = &chain.back()->getClassImplTraits();
+        });
+    }
+    for (auto &thread: threads) thread.join();
+    for (size_t t = 0; t < ThreadCount; ++t) {
+        EXPECT_FALSE(abstract[t]);
+        EXPECT_EQ(seen[t], &chain.back()->getClassImplTraits());
+    }
+}
+
 }
 }
@@ -104,5 +104,48 @@ TEST_F(InterfaceTypeTest, InterfaceTrait) {
                             }), 1);
 }
 
+TEST_F(InterfaceTypeTest, InterfaceTraitsFollowChangesToBases) {
+    auto IA = typeContext.getInterfaceType("IA");
+    auto IB = typeContext.getInterfaceType("IB");
+    auto IC = typeContext.getInterfaceType("IC");
+    ASSERT_NO_THROW(IB->addInterface(IA));
+    ASSERT_NO_THROW(IC->addInterface(IB));
+    EXPECT_TRUE(IC->getInterfaceTraits().empty());
+
+    auto MA = typeContext.getMemberType(Visibility::Public, IA, funcType);
+    ASSERT_NO_THROW(IA->addMethod("methodA", MA));
+    EXPECT_EQ(IC->getInterfaceTraits().find("methodA"), MA);
+
+    auto ID = typeContext.getInterfaceType("ID");
+    auto MD = typeContext.getMemberType(Visibility::Public, ID, funcType);
+    ASSERT_NO_THROW(ID->addMethod("methodD", MD));
+    // memoized until the hierarchy changes, the reference must not be kept across the change below
+    EXPECT_EQ(&IC->getInterfaceTraits(), &IC->getInterfaceTraits());
+    ASSERT_NO_THROW(IB->addInterface(ID));
+    EXPECT_EQ(IC->getInterfaceTraits().size(), 2);
+    EXPECT_EQ(IC->getInterfaceTraits().find("methodD"), MD);
+    EXPECT_EQ(IC->getInterfaceTraits().find("methodC"), nullptr);
+}
+
+TEST_F(InterfaceTypeTest, OverrideConflictJoinedByDiamond) {
+    auto IA = typeContext.getInterfaceType("IA");
+    auto IB = typeContext.getInterfaceType("IB");
+    auto IC = typeContext.getInterfaceType("IC");
+    auto otherFuncType = typeContext.getFunctionType(typeContext.getVoidType(),
+                                                     {typeContext.getBuiltinType(BuiltinType::Boolean)});
+    ASSERT_NO_THROW(IA->addMethod("method", typeContext.getMemberType(Visibility::Public, IA, funcType)));
+    auto conflicting = typeContext.getMemberType(Visibility::Public, IB, otherFuncType);
+    ASSERT_NO_THROW(IB->addMethod("method", conflicting));
+    ASSERT_NO_THROW(IC->addInterface(IA));
+    ASSERT_NO_THROW(IC->addInterface(IB));
+    EXPECT_FALSE(IC->getInterfaceTraits().agreesWith("method", IA->getMethods().at("method")));
+    try {
+        IC->addMethod("method", typeContext.getMemberType(Visibility::Public, IC, funcType));
+        FAIL() << "expected a TypeError";
+    } catch (TypeError &err) {
+        EXPECT_NE(std::string(err.what()).find(conflicting->getTypeString()), std::string::npos);
+    }
+}
+
 }
 }
@@ -6,6 +6,9 @@
 
 #include "TypeContext.h"
 
+#include <algorithm>
+#include <thread>
+
 namespace reflex {
 namespace {
 
@@ -166,5 +169,89 @@ TEST_F(TypeContextTest, ReferenceTypeIdentity) {
     EXPECT_NE(type3, type2);
 }
 
+TEST_F(TypeContextTest, StructuralIdentityAcrossManyTypes) {
+    std::vector<FunctionType *> functions;
+    for (size_t i = 0; i < 1000; ++i) {
+        std::vector<Type *> params{context.getArrayType(IntType, i), IntType};
+        functions.push_back(context.getFunctionType(IntType, params));
+    }
+    for (size_t i = 0; i < 1000; ++i) {
+        // a parameter list equal to, but not the same vector as, the one the type was created with
+        std::vector<Type *> params{context.getArrayType(IntType, i), IntType};
+        EXPECT_EQ(context.getFunctionType(IntType, params), functions[i]);
+        EXPECT_EQ(context.getArrayType(IntType, i)->getSize(), i);
+    }
+    EXPECT_NE(context.getArrayType(IntType), context.getArrayType(IntType, 0));
+    EXPECT_NE(context.getFunctionType(IntType, {}), context.getFunctionType(context.getVoidType(), {}));
+}
+
+TEST_F(TypeContextTest, ConcurrentLookupsAgreeOnIdentity) {
+    constexpr size_t ThreadCount = 8, TypeCount = 500;
+    std::vector<std::vector<Type *>> seen(ThreadCount);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < ThreadCount; ++t) {
+        threads.emplace_back([&, t] {
+          // every thread interns the same types, in a different order
+          for (size_t n = 0; n < TypeCount; ++n) {
+              auto i = (n + t * 61) % TypeCount;
+              auto array = context.getArrayType(IntType, i);
+              auto klass = context.getClassType("C" + std::to_string(i), nullptr);
+              std::vector<Type *> params{array, klass};
+              seen[t].push_back(array);
+              seen[t].push_back(context.getFunctionType(IntType, params));
+              seen[t].push_back(context.getReferenceType(klass, i % 2));
+          }
+          std::ranges::rotate(seen[t], seen[t].end() - 3 * ((t * 61) % TypeCount));
+        });
+    }
+    for (auto &thread: threads) thread.join();
+    for (size_t t = 1; t < ThreadCount; ++t) EXPECT_EQ(seen[t], seen[0]);
+    std::vector<Type *> params{context.getArrayType(IntType, 7), context.getClassType("C7", nullptr)};
+    EXPECT_EQ(context.getFunctionType(IntType, params), seen[0][3 * 7 + 1]);
+}
+
+TEST_F(TypeContextTest, TypeIDsDescribeTheirTypes) {
+    EXPECT_EQ(context.getVoidType()->getID(), TypeID::Void);
+    EXPECT_EQ(IntType->getID(), TypeID::Integer);
+    EXPECT_EQ(context.getBuiltinType(BuiltinType::Boolean)->getID(), TypeID::Boolean);
+
+    auto array = context.getArrayType(IntType, 3);
+    std::vector<Type *> params{array, CompType};
+    auto func = context.getFunctionType(context.getVoidType(), params);
+    auto ref = context.getReferenceType(array, false);
+    auto member = context.getMemberType(Visibility::Public, CompType, ref);
+    EXPECT_EQ(context.getKind(array->getID()), TypeKind::Array);
+    EXPECT_EQ(context.getOperandType(array->getID()), TypeID::Integer);
+    EXPECT_EQ(context.getOperandType(func->getID()), TypeID::Void);
+    EXPECT_TRUE(std::ranges::equal(context.getParamTypes(func->getID()),
+                                   std::vector<TypeID>{array->getID(), CompType->getID()}));
+    EXPECT_TRUE(context.isReferenceType(ref->getID()));
+    EXPECT_FALSE(context.isNullable(ref->getID()));
+    EXPECT_EQ(context.getOperandType(ref->getID()), array->getID());
+    EXPECT_TRUE(context.isReferenceType(member->getID()));
+    EXPECT_TRUE(context.isCompositeType(CompType->getID()));
+    EXPECT_TRUE(context.isReferenceableType(func->getID()));
+    EXPECT_FALSE(context.isReferenceableType(ref->getID()));
+    EXPECT_EQ(context.getOperandType(context.getReferenceType(nullptr)->getID()), TypeID::Invalid);
+}
+
+TEST_F(TypeContextTest, TypeIDsAreDense) {
+    const auto before = context.getTypeCount();
+    for (size_t i = 0; i < 2000; ++i) context.getArrayType(IntType, i);
+    context.getArrayType(IntType, 0);
+    ASSERT_EQ(context.getTypeCount(), before + 2000);
+    for (uint32_t id = 0; id < context.getTypeCount(); ++id) {
+        EXPECT_EQ(context.getType(static_cast<TypeID>(id))->getID(), static_cast<TypeID>(id));
+    }
+}
+
+TEST_F(TypeContextTest, TypesWithoutIDAreAskedDirectly) {
+    ReferenceType unowned(context.getArrayType(IntType, 3));
+    ASSERT_EQ(unowned.getID(), TypeID::Invalid);
+    EXPECT_TRUE(context.isReferenceType(&unowned));
+    EXPECT_TRUE(context.isReferenceType(context.getReferenceType(CompType)));
+    EXPECT_FALSE(context.isReferenceType(IntType));
+}
+
 }
 }
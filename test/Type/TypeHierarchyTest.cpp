@@ -0,0 +1,111 @@
+//
+// Created by henry on 2022-06-01.
+//
+
+#include "gtest/gtest.h"
+
+#include "TypeContext.h"
+#include "TypeHierarchy.h"
+
+#include <string>
+#include <vector>
+
+namespace reflex {
+namespace {
+
+class TypeHierarchyTest : public ::testing::Test {
+  protected:
+    /// Builds classes C0..C9 where Ci derives from C(i/3), and interfaces I0..I9 where Ii derives
+    /// from I(i-1) and I(i-2), the class Ci implementing Ii for even i
+    void SetUp() override {
+        for (int i = 0; i < 10; ++i) {
+            classes.push_back(typeContext.getClassType("C" + std::to_string(i)));
+            interfaces.push_back(typeContext.getInterfaceType("I" + std::to_string(i)));
+        }
+        for (int i = 1; i < 10; ++i) {
+            classes[i]->setBaseclass(classes[i / 3]);
+            interfaces[i]->addInterface(interfaces[i - 1]);
+            if (i > 1) interfaces[i]->addInterface(interfaces[i - 2]);
+        }
+        for (int i = 0; i < 10; i += 2) classes[i]->addInterface(interfaces[i]);
+        typeContext.buildHierarchy();
+    }
+
+    TypeContext typeContext;
+    std::vector<ClassType *> classes;
+    std::vector<InterfaceType *> interfaces;
+};
+
+TEST_F(TypeHierarchyTest, AgreesWithWalkingTheHierarchy) {
+    for (auto klass: classes) {
+        for (auto base: classes) {
+            EXPECT_EQ(typeContext.isDerivedFrom(klass, base), klass->isDerivedFrom(base))
+                << klass->getTypeString() << " " << base->getTypeString();
+        }
+        for (auto interface: interfaces) {
+            EXPECT_EQ(typeContext.implements(klass, interface), klass->implements(interface))
+                << klass->getTypeString() << " " << interface->getTypeString();
+        }
+    }
+    for (auto interface: interfaces) {
+        for (auto base: interfaces) {
+            EXPECT_EQ(typeContext.isDerivedFrom(interface, base), interface->isDerivedFrom(base))
+                << interface->getTypeString() << " " << base->getTypeString();
+        }
+    }
+    EXPECT_TRUE(typeContext.isDerivedFrom(classes[9], classes[0]));
+    EXPECT_FALSE(typeContext.isDerivedFrom(classes[4], classes[2]));
+    EXPECT_TRUE(typeContext.implements(classes[7], interfaces[0]));
+    EXPECT_FALSE(typeContext.implements(classes[1], interfaces[2]));
+}
+
+TEST_F(TypeHierarchyTest, TypesCreatedAfterTheIndexAreWalked) {
+    auto klass = typeContext.getClassType("Late");
+    klass->setBaseclass(classes[5]);
+    klass->addInterface(interfaces[3]);
+    EXPECT_TRUE(typeContext.isDerivedFrom(klass, classes[1]));
+    EXPECT_TRUE(typeContext.implements(klass, interfaces[1]));
+    EXPECT_FALSE(typeContext.implements(klass, interfaces[4]));
+}
+
+TEST_F(TypeHierarchyTest, InheritanceAddedAfterTheIndexIsWalked) {
+    EXPECT_FALSE(typeContext.implements(classes[4], interfaces[9]));
+    classes[1]->addInterface(interfaces[9]);
+    EXPECT_TRUE(typeContext.implements(classes[4], interfaces[9]));
+
+    auto late = typeContext.getInterfaceType("Late");
+    interfaces[0]->addInterface(late);
+    EXPECT_TRUE(typeContext.isDerivedFrom(interfaces[9], late));
+    EXPECT_TRUE(typeContext.implements(classes[0], late));
+
+    typeContext.buildHierarchy();
+    EXPECT_TRUE(typeContext.implements(classes[4], interfaces[9]));
+    EXPECT_TRUE(typeContext.implements(classes[2], late));
+    EXPECT_FALSE(typeContext.isDerivedFrom(late, interfaces[0]));
+}
+
+TEST(TypeHierarchyCycleTest, DeepDiamondsAreWalkedOnce) {
+    // each interface derives twice from the previous one, walking every path would take 2^200 steps
+    TypeContext typeContext;
+    std::vector<InterfaceType *> chain{typeContext.getInterfaceType("I0")};
+    for (int i = 1; i <= 200; ++i) {
+        auto left = typeContext.getInterfaceType("L" + std::to_string(i));
+        auto right = typeContext.getInterfaceType("R" + std::to_string(i));
+        auto joined = typeContext.getInterfaceType("I" + std::to_string(i));
+        left->addInterface(chain.back());
+        right->addInterface(chain.back());
+        joined->addInterface(left);
+        joined->addInterface(right);
+        chain.push_back(joined);
+    }
+    EXPECT_TRUE(chain.back()->isDerivedFrom(chain.front()));
+    EXPECT_THROW(chain.front()->addInterface(chain.back()), TypeError);
+    auto klass = typeContext.getClassType("C");
+    klass->addInterface(chain.back());
+    EXPECT_FALSE(klass->implements(typeContext.getInterfaceType("Unrelated")));
+    typeContext.buildHierarchy();
+    EXPECT_TRUE(typeContext.implements(klass, chain.front()));
+}
+
+}
+}